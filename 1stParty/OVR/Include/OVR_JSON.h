@@ -50,10 +50,12 @@ limitations under the License.
 #ifndef OVR_JSON_h
 #define OVR_JSON_h
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <string>
 #include <list>
+#include <unordered_map>
 #include <fstream>
 
 #include "OVR_Types.h"
@@ -70,6 +72,26 @@ limitations under the License.
 #include <limits.h>
 #include <ctype.h>
 
+// The string scanner tests 16 bytes at a time and the number parser reads 8 digits at a
+// time. These reads may go past the terminating null, though never into another page,
+// which is safe but trips the address sanitizer.
+#if !OVR_CC_HAS_FEATURE( address_sanitizer ) && !defined( __SANITIZE_ADDRESS__ )
+#if OVR_BYTE_ORDER == OVR_LITTLE_ENDIAN
+#define OVR_JSON_SCAN_DIGITS
+#endif
+#if defined( __SSE2__ ) || defined( _M_X64 )
+#include <emmintrin.h>
+#define OVR_JSON_SCAN_SSE2
+#elif defined( OVR_CPU_ARM_NEON ) || defined( __ARM_NEON )
+#include <arm_neon.h>
+#define OVR_JSON_SCAN_NEON
+#endif
+#endif
+
+#if defined( OVR_CC_MSVC )
+#include <intrin.h>
+#endif
+
 
 
 namespace OVR {
@@ -101,37 +123,39 @@ inline char* JSON_strdup(const char* str)
 
 //-----------------------------------------------------------------------------
 // Render the number from the given item into a string.
-inline char* PrintNumber(double d)
+// str must hold at least 64 chars.
+inline void FormatNumber(double d, char* str)
 {
-	char *str;
 	int valueint = (int)d;
 
 	if (fabs(((double)valueint)-d) <= DBL_EPSILON && d <= INT_MAX && d >= INT_MIN)
 	{
-		str=(char*)malloc(21);   // 2^64+1 can be represented in 21 chars.
-		if (str)
-			OVR_sprintf(str, 21, "%d", valueint);
+		OVR_sprintf(str, 21, "%d", valueint);   // 2^64+1 can be represented in 21 chars.
 	}
 	else
 	{
-		str=(char*)malloc(64);    // This is a nice tradeoff.
-		if (str)
-		{
-			// The JSON Standard, section 7.8.3, specifies that decimals are always expressed with '.' and
-			// not some locale-specific decimal such as ',' or ' '. However, since we are using the C standard
-			// library below to write a floating point number, we need to make sure that it's writing a '.'
-			// and not something else. We can't change the locale (even temporarily) here, as it will affect
-			// the whole process by default. That are compiler-specific ways to change this per-thread, but
-			// below we implement the simple solution of simply fixing the decimal after the string was written.
-
-			if (fabs(floor(d)-d) <= DBL_EPSILON && fabs(d) < 1.0e60)
-				OVR_sprintf(str, 64, "%.0f", d);
-			else if (fabs(d) < 1.0e-6 || fabs(d) > 1.0e9)
-				OVR_sprintf(str, 64, "%e", d);
-			else
-				OVR_sprintf(str, 64, "%f", d);
-		}
+		// The JSON Standard, section 7.8.3, specifies that decimals are always expressed with '.' and
+		// not some locale-specific decimal such as ',' or ' '. However, since we are using the C standard
+		// library below to write a floating point number, we need to make sure that it's writing a '.'
+		// and not something else. We can't change the locale (even temporarily) here, as it will affect
+		// the whole process by default. That are compiler-specific ways to change this per-thread, but
+		// below we implement the simple solution of simply fixing the decimal after the string was written.
+
+		if (fabs(floor(d)-d) <= DBL_EPSILON && fabs(d) < 1.0e60)
+			OVR_sprintf(str, 64, "%.0f", d);
+		else if (fabs(d) < 1.0e-6 || fabs(d) > 1.0e9)
+			OVR_sprintf(str, 64, "%e", d);
+		else
+			OVR_sprintf(str, 64, "%f", d);
 	}
+}
+
+// Render the number provided to a string. Use free when done with return value.
+inline char* PrintNumber(double d)
+{
+	char *str=(char*)malloc(64);    // This is a nice tradeoff.
+	if (str)
+		FormatNumber(d, str);
 	return str;
 }
 
@@ -235,8 +259,130 @@ inline char* PrintString(const char* str)
 	return out;
 }
 
+//-----------------------------------------------------------------------------
+// Scanning helpers
+
+// Index of the lowest set bit; bits must not be zero.
+inline int LowestBitIndex(uint64_t bits)
+{
+#if defined( OVR_CC_MSVC ) && defined( _WIN64 )
+	unsigned long index;
+	_BitScanForward64( &index, bits );
+	return static_cast< int >( index );
+#elif defined( OVR_CC_MSVC )
+	int index = 0;
+	for ( ; ( bits & 1 ) == 0; bits >>= 1 )
+	{
+		index++;
+	}
+	return index;
+#else
+	return __builtin_ctzll( bits );
+#endif
+}
+
+// Number of leading zero bits; bits must not be zero.
+inline int LeadingZeroBits(uint64_t bits)
+{
+#if defined( OVR_CC_MSVC ) && defined( _WIN64 )
+	unsigned long index;
+	_BitScanReverse64( &index, bits );
+	return 63 - static_cast< int >( index );
+#elif defined( OVR_CC_MSVC )
+	int count = 0;
+	for ( ; ( bits >> 63 ) == 0; bits <<= 1 )
+	{
+		count++;
+	}
+	return count;
+#else
+	return __builtin_clzll( bits );
+#endif
+}
+
+// Full 64 x 64 -> 128 bit product. Returns the low half.
+inline uint64_t MultiplyFull64(uint64_t a, uint64_t b, uint64_t& high)
+{
+#if defined( __SIZEOF_INT128__ )
+	const unsigned __int128 r = static_cast< unsigned __int128 >( a ) * b;
+	high = static_cast< uint64_t >( r >> 64 );
+	return static_cast< uint64_t >( r );
+#elif defined( OVR_CC_MSVC ) && defined( _M_X64 )
+	return _umul128( a, b, &high );
+#else
+	const uint64_t aLo = static_cast< uint32_t >( a ), aHi = a >> 32;
+	const uint64_t bLo = static_cast< uint32_t >( b ), bHi = b >> 32;
+	const uint64_t p0 = aLo * bLo, p1 = aLo * bHi, p2 = aHi * bLo, p3 = aHi * bHi;
+	const uint64_t mid = ( p0 >> 32 ) + static_cast< uint32_t >( p1 ) + static_cast< uint32_t >( p2 );
+	high = p3 + ( p1 >> 32 ) + ( p2 >> 32 ) + ( mid >> 32 );
+	return ( mid << 32 ) | static_cast< uint32_t >( p0 );
+#endif
+}
+
+#if defined( OVR_JSON_SCAN_SSE2 )
+static const int SCAN_MASK_BITS = 1;     // mask bits per byte
+
+// Bit mask of the quotes, backslashes and nulls in the 16 bytes at block.
+inline uint64_t StringRunMask(const char* block)
+{
+	const __m128i v = _mm_load_si128( reinterpret_cast< const __m128i * >( block ) );
+	const __m128i hit = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( '\"' ) ), _mm_cmpeq_epi8( v, _mm_set1_epi8( '\\' ) ) ),
+										_mm_cmpeq_epi8( v, _mm_setzero_si128() ) );
+	return static_cast< uint32_t >( _mm_movemask_epi8( hit ) );
+}
+#elif defined( OVR_JSON_SCAN_NEON )
+static const int SCAN_MASK_BITS = 4;
+
+// NEON has no movemask; narrow each 0x00/0xFF byte lane of the compare result to a nibble.
+inline uint64_t NeonMask(uint8x16_t cmp)
+{
+	return vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( cmp ), 4 ) ), 0 );
+}
+
+// Bit mask of the quotes, backslashes and nulls in the 16 bytes at block, 4 bits per byte.
+inline uint64_t StringRunMask(const char* block)
+{
+	const uint8x16_t v = vld1q_u8( reinterpret_cast< const uint8_t * >( block ) );
+	return NeonMask( vorrq_u8( vorrq_u8( vceqq_u8( v, vdupq_n_u8( '\"' ) ), vceqq_u8( v, vdupq_n_u8( '\\' ) ) ),
+								vceqq_u8( v, vdupq_n_u8( 0 ) ) ) );
+}
+#endif
+
+// Returns a pointer to the first quote, backslash or null at or after p.
+inline const char* ScanStringRun(const char* p)
+{
+#if defined( OVR_JSON_SCAN_SSE2 ) || defined( OVR_JSON_SCAN_NEON )
+	// Loads are 16-byte aligned so they can't cross into an unmapped page past the null;
+	// the bytes of the first block that come before p are masked off.
+	const int misalign = static_cast< int >( reinterpret_cast< uintptr_t >( p ) & 15 );
+	const char* block = p - misalign;
+	uint64_t mask = StringRunMask( block ) >> ( misalign * SCAN_MASK_BITS );
+	if ( mask != 0 )
+	{
+		return p + ( LowestBitIndex( mask ) / SCAN_MASK_BITS );
+	}
+	for ( ; ; )
+	{
+		block += 16;
+		mask = StringRunMask( block );
+		if ( mask != 0 )
+		{
+			return block + ( LowestBitIndex( mask ) / SCAN_MASK_BITS );
+		}
+	}
+#else
+	while ( *p != '\"' && *p != '\\' && *p != '\0' )
+	{
+		p++;
+	}
+	return p;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 // Utility to jump whitespace and cr/lf
+// Whitespace runs are short, and a vector load here often overlaps the terminator
+// JsonDocument just stored, which stalls; a byte loop measured faster.
 static const char* skip(const char* in)
 {
 	while (in && *in && (unsigned char)*in<=' ')
@@ -244,6 +390,800 @@ static const char* skip(const char* in)
 	return in;
 }
 
+// If the 8 characters at p are all digits, converts them and returns true.
+inline bool ReadEightDigits(const char* p, uint32_t& value)
+{
+#if defined( OVR_JSON_SCAN_DIGITS )
+	if ( ( reinterpret_cast< uintptr_t >( p ) & 4095 ) > 4096 - 8 )
+	{
+		return false;   // the read could cross into the next page
+	}
+	uint64_t v;
+	memcpy( &v, p, sizeof( v ) );
+	// Every byte must be 0x30 - 0x39: the high nibbles are 3, and adding 6 doesn't carry.
+	if ( ( ( v & 0xF0F0F0F0F0F0F0F0ull ) | ( ( ( v + 0x0606060606060606ull ) & 0xF0F0F0F0F0F0F0F0ull ) >> 4 ) ) != 0x3333333333333333ull )
+	{
+		return false;
+	}
+	// Combine pairs, then quads, then the two halves, with the first digit most significant.
+	v -= 0x3030303030303030ull;
+	v = ( v * 10 ) + ( v >> 8 );
+	v = ( ( ( v & 0x000000FF000000FFull ) * 0x000F424000000064ull ) + ( ( ( v >> 16 ) & 0x000000FF000000FFull ) * 0x0000271000000001ull ) ) >> 32;
+	value = static_cast< uint32_t >( v );
+	return true;
+#else
+	OVR_UNUSED2( p, value );
+	return false;
+#endif
+}
+
+// Slow path of ParseNumber for numbers that can't be converted exactly with a double
+// multiply or divide. Rewrites the digits as a plain "<digits>e<exp>" string, so the
+// decimal point can't be misread under another locale, and has strtod round it.
+inline double ParseNumberSlow(const char* num, const char* end, const bool negative, int explicitExponent)
+{
+	static const int MAX_DIGITS = 768;
+	char    buffer[MAX_DIGITS + 32];
+	int     length = 0;
+	int     exponent = explicitExponent;
+	bool    fraction = false;
+	bool    truncated = false;
+
+	if (negative)
+	{
+		buffer[length++] = '-';
+	}
+	const int firstDigit = length;
+	for (const char* p = num; p < end && *p != 'e' && *p != 'E'; p++)
+	{
+		if (*p == '.')
+		{
+			fraction = true;
+		}
+		else if (*p >= '0' && *p <= '9')
+		{
+			if (length == firstDigit && *p == '0')
+			{
+				exponent -= fraction ? 1 : 0;   // leading zeros aren't significant
+			}
+			else if (length - firstDigit < MAX_DIGITS)
+			{
+				buffer[length++] = *p;
+				exponent -= fraction ? 1 : 0;
+			}
+			else
+			{
+				truncated |= (*p != '0');
+				exponent += fraction ? 0 : 1;
+			}
+		}
+	}
+	if (length == firstDigit)
+	{
+		return negative ? -0.0 : 0.0;
+	}
+	if (truncated)
+	{
+		// A trailing non-zero digit keeps the rounding of halfway cases correct.
+		buffer[length++] = '1';
+		exponent--;
+	}
+	OVR_sprintf(buffer + length, sizeof(buffer) - length, "e%d", exponent);
+	return strtod(buffer, nullptr);
+}
+
+// Converts mantissa * 10^exponent to the nearest double with the Eisel-Lemire algorithm,
+// which needs only a 128 bit product with a truncated power of ten. Returns false for the
+// rare halfway or out of range cases it can't decide, which must take the slow path.
+inline bool ParseNumberEiselLemire(uint64_t mantissa, const int exponent, const bool negative, double& out)
+{
+	// 10^e for e in [MIN_POWER, MAX_POWER], scaled to 128 bits and rounded down, high word first.
+	// Exponents outside this range are rare enough in practice to leave to strtod.
+	static const int MIN_POWER = -64;
+	static const int MAX_POWER = 64;
+	static const uint64_t powersOfTen[MAX_POWER - MIN_POWER + 1][2] =
+	{
+		{ 0xA87FEA27A539E9A5, 0x3F2398D747B36224 }, { 0xD29FE4B18E88640E, 0x8EEC7F0D19A03AAD },
+		{ 0x83A3EEEEF9153E89, 0x1953CF68300424AC }, { 0xA48CEAAAB75A8E2B, 0x5FA8C3423C052DD7 },
+		{ 0xCDB02555653131B6, 0x3792F412CB06794D }, { 0x808E17555F3EBF11, 0xE2BBD88BBEE40BD0 },
+		{ 0xA0B19D2AB70E6ED6, 0x5B6ACEAEAE9D0EC4 }, { 0xC8DE047564D20A8B, 0xF245825A5A445275 },
+		{ 0xFB158592BE068D2E, 0xEED6E2F0F0D56712 }, { 0x9CED737BB6C4183D, 0x55464DD69685606B },
+		{ 0xC428D05AA4751E4C, 0xAA97E14C3C26B886 }, { 0xF53304714D9265DF, 0xD53DD99F4B3066A8 },
+		{ 0x993FE2C6D07B7FAB, 0xE546A8038EFE4029 }, { 0xBF8FDB78849A5F96, 0xDE98520472BDD033 },
+		{ 0xEF73D256A5C0F77C, 0x963E66858F6D4440 }, { 0x95A8637627989AAD, 0xDDE7001379A44AA8 },
+		{ 0xBB127C53B17EC159, 0x5560C018580D5D52 }, { 0xE9D71B689DDE71AF, 0xAAB8F01E6E10B4A6 },
+		{ 0x9226712162AB070D, 0xCAB3961304CA70E8 }, { 0xB6B00D69BB55C8D1, 0x3D607B97C5FD0D22 },
+		{ 0xE45C10C42A2B3B05, 0x8CB89A7DB77C506A }, { 0x8EB98A7A9A5B04E3, 0x77F3608E92ADB242 },
+		{ 0xB267ED1940F1C61C, 0x55F038B237591ED3 }, { 0xDF01E85F912E37A3, 0x6B6C46DEC52F6688 },
+		{ 0x8B61313BBABCE2C6, 0x2323AC4B3B3DA015 }, { 0xAE397D8AA96C1B77, 0xABEC975E0A0D081A },
+		{ 0xD9C7DCED53C72255, 0x96E7BD358C904A21 }, { 0x881CEA14545C7575, 0x7E50D64177DA2E54 },
+		{ 0xAA242499697392D2, 0xDDE50BD1D5D0B9E9 }, { 0xD4AD2DBFC3D07787, 0x955E4EC64B44E864 },
+		{ 0x84EC3C97DA624AB4, 0xBD5AF13BEF0B113E }, { 0xA6274BBDD0FADD61, 0xECB1AD8AEACDD58E },
+		{ 0xCFB11EAD453994BA, 0x67DE18EDA5814AF2 }, { 0x81CEB32C4B43FCF4, 0x80EACF948770CED7 },
+		{ 0xA2425FF75E14FC31, 0xA1258379A94D028D }, { 0xCAD2F7F5359A3B3E, 0x096EE45813A04330 },
+		{ 0xFD87B5F28300CA0D, 0x8BCA9D6E188853FC }, { 0x9E74D1B791E07E48, 0x775EA264CF55347D },
+		{ 0xC612062576589DDA, 0x95364AFE032A819D }, { 0xF79687AED3EEC551, 0x3A83DDBD83F52204 },
+		{ 0x9ABE14CD44753B52, 0xC4926A9672793542 }, { 0xC16D9A0095928A27, 0x75B7053C0F178293 },
+		{ 0xF1C90080BAF72CB1, 0x5324C68B12DD6338 }, { 0x971DA05074DA7BEE, 0xD3F6FC16EBCA5E03 },
+		{ 0xBCE5086492111AEA, 0x88F4BB1CA6BCF584 }, { 0xEC1E4A7DB69561A5, 0x2B31E9E3D06C32E5 },
+		{ 0x9392EE8E921D5D07, 0x3AFF322E62439FCF }, { 0xB877AA3236A4B449, 0x09BEFEB9FAD487C2 },
+		{ 0xE69594BEC44DE15B, 0x4C2EBE687989A9B3 }, { 0x901D7CF73AB0ACD9, 0x0F9D37014BF60A10 },
+		{ 0xB424DC35095CD80F, 0x538484C19EF38C94 }, { 0xE12E13424BB40E13, 0x2865A5F206B06FB9 },
+		{ 0x8CBCCC096F5088CB, 0xF93F87B7442E45D3 }, { 0xAFEBFF0BCB24AAFE, 0xF78F69A51539D748 },
+		{ 0xDBE6FECEBDEDD5BE, 0xB573440E5A884D1B }, { 0x89705F4136B4A597, 0x31680A88F8953030 },
+		{ 0xABCC77118461CEFC, 0xFDC20D2B36BA7C3D }, { 0xD6BF94D5E57A42BC, 0x3D32907604691B4C },
+		{ 0x8637BD05AF6C69B5, 0xA63F9A49C2C1B10F }, { 0xA7C5AC471B478423, 0x0FCF80DC33721D53 },
+		{ 0xD1B71758E219652B, 0xD3C36113404EA4A8 }, { 0x83126E978D4FDF3B, 0x645A1CAC083126E9 },
+		{ 0xA3D70A3D70A3D70A, 0x3D70A3D70A3D70A3 }, { 0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCC },
+		{ 0x8000000000000000, 0x0000000000000000 }, { 0xA000000000000000, 0x0000000000000000 },
+		{ 0xC800000000000000, 0x0000000000000000 }, { 0xFA00000000000000, 0x0000000000000000 },
+		{ 0x9C40000000000000, 0x0000000000000000 }, { 0xC350000000000000, 0x0000000000000000 },
+		{ 0xF424000000000000, 0x0000000000000000 }, { 0x9896800000000000, 0x0000000000000000 },
+		{ 0xBEBC200000000000, 0x0000000000000000 }, { 0xEE6B280000000000, 0x0000000000000000 },
+		{ 0x9502F90000000000, 0x0000000000000000 }, { 0xBA43B74000000000, 0x0000000000000000 },
+		{ 0xE8D4A51000000000, 0x0000000000000000 }, { 0x9184E72A00000000, 0x0000000000000000 },
+		{ 0xB5E620F480000000, 0x0000000000000000 }, { 0xE35FA931A0000000, 0x0000000000000000 },
+		{ 0x8E1BC9BF04000000, 0x0000000000000000 }, { 0xB1A2BC2EC5000000, 0x0000000000000000 },
+		{ 0xDE0B6B3A76400000, 0x0000000000000000 }, { 0x8AC7230489E80000, 0x0000000000000000 },
+		{ 0xAD78EBC5AC620000, 0x0000000000000000 }, { 0xD8D726B7177A8000, 0x0000000000000000 },
+		{ 0x878678326EAC9000, 0x0000000000000000 }, { 0xA968163F0A57B400, 0x0000000000000000 },
+		{ 0xD3C21BCECCEDA100, 0x0000000000000000 }, { 0x84595161401484A0, 0x0000000000000000 },
+		{ 0xA56FA5B99019A5C8, 0x0000000000000000 }, { 0xCECB8F27F4200F3A, 0x0000000000000000 },
+		{ 0x813F3978F8940984, 0x4000000000000000 }, { 0xA18F07D736B90BE5, 0x5000000000000000 },
+		{ 0xC9F2C9CD04674EDE, 0xA400000000000000 }, { 0xFC6F7C4045812296, 0x4D00000000000000 },
+		{ 0x9DC5ADA82B70B59D, 0xF020000000000000 }, { 0xC5371912364CE305, 0x6C28000000000000 },
+		{ 0xF684DF56C3E01BC6, 0xC732000000000000 }, { 0x9A130B963A6C115C, 0x3C7F400000000000 },
+		{ 0xC097CE7BC90715B3, 0x4B9F100000000000 }, { 0xF0BDC21ABB48DB20, 0x1E86D40000000000 },
+		{ 0x96769950B50D88F4, 0x1314448000000000 }, { 0xBC143FA4E250EB31, 0x17D955A000000000 },
+		{ 0xEB194F8E1AE525FD, 0x5DCFAB0800000000 }, { 0x92EFD1B8D0CF37BE, 0x5AA1CAE500000000 },
+		{ 0xB7ABC627050305AD, 0xF14A3D9E40000000 }, { 0xE596B7B0C643C719, 0x6D9CCD05D0000000 },
+		{ 0x8F7E32CE7BEA5C6F, 0xE4820023A2000000 }, { 0xB35DBF821AE4F38B, 0xDDA2802C8A800000 },
+		{ 0xE0352F62A19E306E, 0xD50B2037AD200000 }, { 0x8C213D9DA502DE45, 0x4526F422CC340000 },
+		{ 0xAF298D050E4395D6, 0x9670B12B7F410000 }, { 0xDAF3F04651D47B4C, 0x3C0CDD765F114000 },
+		{ 0x88D8762BF324CD0F, 0xA5880A69FB6AC800 }, { 0xAB0E93B6EFEE0053, 0x8EEA0D047A457A00 },
+		{ 0xD5D238A4ABE98068, 0x72A4904598D6D880 }, { 0x85A36366EB71F041, 0x47A6DA2B7F864750 },
+		{ 0xA70C3C40A64E6C51, 0x999090B65F67D924 }, { 0xD0CF4B50CFE20765, 0xFFF4B4E3F741CF6D },
+		{ 0x82818F1281ED449F, 0xBFF8F10E7A8921A4 }, { 0xA321F2D7226895C7, 0xAFF72D52192B6A0D },
+		{ 0xCBEA6F8CEB02BB39, 0x9BF4F8A69F764490 }, { 0xFEE50B7025C36A08, 0x02F236D04753D5B4 },
+		{ 0x9F4F2726179A2245, 0x01D762422C946590 }, { 0xC722F0EF9D80AAD6, 0x424D3AD2B7B97EF5 },
+		{ 0xF8EBAD2B84E0D58B, 0xD2E0898765A7DEB2 }, { 0x9B934C3B330C8577, 0x63CC55F49F88EB2F },
+		{ 0xC2781F49FFCFA6D5, 0x3CBF6B71C76B25FB },
+	};
+
+	if (exponent < MIN_POWER || exponent > MAX_POWER || mantissa == 0)
+	{
+		return false;
+	}
+	const uint64_t * power = powersOfTen[exponent - MIN_POWER];
+
+	const int leadingZeros = LeadingZeroBits(mantissa);
+	mantissa <<= leadingZeros;
+	// 217706 / 2^16 is log2( 10 ), 1023 is the double exponent bias.
+	uint64_t exponent2 = static_cast< uint64_t >( ( ( 217706 * exponent ) >> 16 ) + 64 + 1023 - leadingZeros );
+
+	uint64_t hi;
+	uint64_t lo = MultiplyFull64(mantissa, power[0], hi);
+	if ((hi & 0x1FF) == 0x1FF && lo + mantissa < mantissa)
+	{
+		// The truncated bits of the power could carry into the result; include them.
+		uint64_t yHi;
+		const uint64_t yLo = MultiplyFull64(mantissa, power[1], yHi);
+		uint64_t mergedHi = hi;
+		const uint64_t mergedLo = lo + yHi;
+		if (mergedLo < lo)
+		{
+			mergedHi++;
+		}
+		if ((mergedHi & 0x1FF) == 0x1FF && mergedLo + 1 == 0 && yLo + mantissa < mantissa)
+		{
+			return false;
+		}
+		hi = mergedHi;
+		lo = mergedLo;
+	}
+
+	const uint64_t msb = hi >> 63;
+	uint64_t bits = hi >> (msb + 9);
+	exponent2 -= 1 ^ msb;
+
+	if (lo == 0 && (hi & 0x1FF) == 0 && (bits & 3) == 1)
+	{
+		return false;   // exactly halfway between two doubles
+	}
+
+	bits = (bits + (bits & 1)) >> 1;
+	if ((bits >> 53) != 0)
+	{
+		bits >>= 1;
+		exponent2++;
+	}
+	if (exponent2 - 1 >= 0x7FF - 1)
+	{
+		return false;   // subnormal, infinite or zero
+	}
+	bits = (exponent2 << 52) | (bits & 0x000FFFFFFFFFFFFFull) | (negative ? 0x8000000000000000ull : 0);
+	memcpy(&out, &bits, sizeof(out));
+	return true;
+}
+
+// Parses the number starting at num into out, rounded to the nearest double.
+// Returns a pointer to the first character after the number.
+inline const char* ParseNumber(const char* num, double& out)
+{
+	// Powers of ten that are exact as doubles.
+	static const double exactPowers[] =
+	{
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	static const int MAX_EXPONENT = 100000;
+
+	const char* start = num;
+	bool        negative = false;
+	uint64_t    mantissa = 0;
+	int         numDigits = 0;          // significant digits in mantissa
+	int         exponent = 0;
+	bool        truncated = false;
+
+	if (*num == '-')
+	{
+		negative = true;
+		num++;
+	}
+	if (*num == '0')
+	{
+		num++;            // is zero
+	}
+
+	if (*num>='1' && *num<='9')
+	{
+		uint32_t eight;
+		while (numDigits <= 19 - 8 && ReadEightDigits(num, eight))
+		{
+			mantissa = mantissa * 100000000 + eight;
+			numDigits += 8;
+			num += 8;
+		}
+		while (*num>='0' && *num<='9')
+		{
+			if (numDigits < 19)
+			{
+				mantissa = mantissa * 10 + (*num - '0');
+				numDigits++;
+			}
+			else
+			{
+				truncated = true;
+				exponent++;
+			}
+			num++;
+		}
+	}
+
+	if (*num=='.' && num[1]>='0' && num[1]<='9')  // Fractional part?
+	{
+		num++;
+		for (;;)
+		{
+			// Leading zeros of the fraction have to be counted one at a time.
+			uint32_t eight;
+			while (mantissa != 0 && numDigits <= 19 - 8 && ReadEightDigits(num, eight))
+			{
+				mantissa = mantissa * 100000000 + eight;
+				numDigits += 8;
+				exponent -= 8;
+				num += 8;
+			}
+			if (*num<'0' || *num>'9')
+			{
+				break;
+			}
+			if (numDigits < 19)
+			{
+				mantissa = mantissa * 10 + (*num - '0');
+				numDigits += (mantissa != 0) ? 1 : 0;   // leading zeros aren't significant
+				exponent--;
+			}
+			else
+			{
+				truncated = true;
+			}
+			num++;
+		}
+	}
+
+	int explicitExponent = 0;
+	if (*num=='e' || *num=='E')        // Exponent?
+	{
+		bool negativeExponent = false;
+		num++;
+		if (*num == '+')
+		{
+			num++;
+		}
+		else if (*num=='-')
+		{
+			negativeExponent = true;
+			num++;
+		}
+
+		while (*num >= '0' && *num <= '9')
+		{
+			if (explicitExponent < MAX_EXPONENT)
+			{
+				explicitExponent = (explicitExponent * 10) + (*num - '0');
+			}
+			num++;
+		}
+		explicitExponent = negativeExponent ? -explicitExponent : explicitExponent;
+	}
+	exponent += explicitExponent;
+
+	if (mantissa == 0 && !truncated)
+	{
+		out = negative ? -0.0 : 0.0;
+	}
+	else if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+	{
+		// Both operands are exact, so the single rounding of the multiply or divide is exact.
+		const double m = static_cast< double >( mantissa );
+		out = (exponent < 0) ? m / exactPowers[-exponent] : m * exactPowers[exponent];
+		out = negative ? -out : out;
+	}
+	else if (!ParseNumberEiselLemire(mantissa, exponent, negative, out))
+	{
+		out = ParseNumberSlow(start + (negative ? 1 : 0), num, negative, explicitExponent);
+	}
+	else if (truncated)
+	{
+		// Digits past the 19th were dropped, so the value is in [mantissa, mantissa + 1).
+		// If both ends round to the same double, that's the answer.
+		double upper;
+		if (!ParseNumberEiselLemire(mantissa + 1, exponent, negative, upper) || upper != out)
+		{
+			out = ParseNumberSlow(start + (negative ? 1 : 0), num, negative, explicitExponent);
+		}
+	}
+	return num;
+}
+
+// Decodes the quoted string that starts at str into out, resolving escape sequences and
+// transcoding \u escapes to UTF-8. The decoded text is never longer than the quoted text,
+// so out may be str + 1 to decode in place. The result is not null-terminated; *outEnd is
+// set to one past the last decoded character.
+// Returns a pointer to the first character after the closing quote.
+inline const char* DecodeString(const char* str, char* out, char** outEnd)
+{
+	const char* ptr = str+1;
+	const char* p;
+	char*       ptr2 = out;
+	int         len;
+	unsigned    uc, uc2;
+
+	for (;;)
+	{
+		// Copy the run up to the next quote, escape or null in one go.
+		const char* run = ScanStringRun(ptr);
+		if (ptr2 != ptr)
+		{
+			memmove(ptr2, ptr, run - ptr);
+		}
+		ptr2 += run - ptr;
+		ptr = run;
+		if (*ptr != '\\')
+		{
+			break;
+		}
+		ptr++;
+		switch (*ptr)
+		{
+			case 'b': *ptr2++ = '\b';    break;
+			case 'f': *ptr2++ = '\f';    break;
+			case 'n': *ptr2++ = '\n';    break;
+			case 'r': *ptr2++ = '\r';    break;
+			case 't': *ptr2++ = '\t';    break;
+
+			// Transcode utf16 to utf8.
+			case 'u':
+
+				// Get the unicode char.
+				p = ParseHex(&uc, 4, ptr + 1);
+				if (ptr != p)
+					ptr = p - 1;
+
+				if ((uc>=0xDC00 && uc<=0xDFFF) || uc==0)
+					break;    // Check for invalid.
+
+				// UTF16 surrogate pairs.
+				if (uc>=0xD800 && uc<=0xDBFF)
+				{
+					if (ptr[1]!='\\' || ptr[2]!='u')
+						break;    // Missing second-half of surrogate.
+
+					p= ParseHex(&uc2, 4, ptr + 3);
+					if (ptr != p)
+						ptr = p - 1;
+
+					if (uc2<0xDC00 || uc2>0xDFFF)
+						break;    // Invalid second-half of surrogate.
+
+					uc = 0x10000 + (((uc&0x3FF)<<10) | (uc2&0x3FF));
+				}
+
+				len=4;
+
+				if (uc<0x80)
+					len=1;
+				else if (uc<0x800)
+					len=2;
+				else if (uc<0x10000)
+					len=3;
+
+				ptr2+=len;
+
+				switch (len)
+				{
+					case 4: *--ptr2 =static_cast<char>((uc | 0x80) & 0xBF); uc >>= 6;
+						//no break, fall through
+					case 3: *--ptr2 =static_cast<char>((uc | 0x80) & 0xBF); uc >>= 6;
+						//no break
+					case 2: *--ptr2 =static_cast<char>((uc | 0x80) & 0xBF); uc >>= 6;
+						//no break
+					case 1: *--ptr2 = (char)(uc | firstByteMark[len]);
+						//no break
+				}
+				ptr2+=len;
+				break;
+
+			default:
+				if (*ptr) { *ptr2++ = *ptr; }
+				break;
+		}
+		if (*ptr) { ptr++; }
+	}
+
+	*outEnd = ptr2;
+	if (*ptr=='\"')
+		ptr++;
+
+	return ptr;
+}
+
+
+//-----------------------------------------------------------------------------
+// ***** JsonNameIndex
+
+// Open addressing hash of the member names of an object, so looking up a member of
+// a wide object doesn't compare against every name. Slots hold the member index + 1,
+// 0 is an empty slot. When names repeat, the first member with the name is found,
+// same as a linear scan.
+class JsonNameIndex
+{
+public:
+	// Objects with fewer members than this are faster to scan.
+	static const unsigned MIN_ITEMS = 8;
+
+					JsonNameIndex() : Count( 0 ) {}
+
+	bool            IsBuiltFor( const unsigned count ) const { return !Slots.empty() && Count == count; }
+	void            Clear() { Slots.clear(); Count = 0; }
+
+	template< typename GetNameFn >
+	void            Build( const unsigned count, GetNameFn getName )
+	{
+		unsigned size = 16;
+		while ( size < count * 2 )
+		{
+			size <<= 1;
+		}
+		Slots.assign( size, 0 );
+		Count = count;
+
+		const unsigned mask = size - 1;
+		for ( unsigned i = 0; i < count; i++ )
+		{
+			const char * name = getName( i );
+			for ( unsigned slot = Hash( name ) & mask; ; slot = ( slot + 1 ) & mask )
+			{
+				if ( Slots[slot] == 0 )
+				{
+					Slots[slot] = i + 1;
+					break;
+				}
+				if ( OVR_strcmp( getName( Slots[slot] - 1 ), name ) == 0 )
+				{
+					break;  // keep the first member with this name
+				}
+			}
+		}
+	}
+
+	// Returns the index of the member, or -1.
+	template< typename GetNameFn >
+	int             Find( const char * name, GetNameFn getName ) const
+	{
+		const unsigned mask = static_cast< unsigned >( Slots.size() ) - 1;
+		for ( unsigned slot = Hash( name ) & mask; Slots[slot] != 0; slot = ( slot + 1 ) & mask )
+		{
+			if ( OVR_strcmp( getName( Slots[slot] - 1 ), name ) == 0 )
+			{
+				return static_cast< int >( Slots[slot] - 1 );
+			}
+		}
+		return -1;
+	}
+
+	static uint32_t Hash( const char * s )
+	{
+		uint32_t h = 2166136261u;
+		for ( ; *s != '\0'; s++ )
+		{
+			h = ( h ^ static_cast< uint8_t >( *s ) ) * 16777619u;
+		}
+		return h;
+	}
+
+private:
+	std::vector< uint32_t > Slots;
+	unsigned                Count;      // number of members when the index was built
+};
+
+
+//-----------------------------------------------------------------------------
+// ***** JsonWriter
+
+// JsonWriter streams JSON text into a single growable buffer, and from there to a FILE
+// when it's given one, so writing a tree costs no allocation per node. Pretty output
+// matches JSON::PrintValue( depth, true ) byte for byte and compact output matches
+// PrintValue( depth, false ).
+//
+// Write a JSON tree with WriteValue, or build the output one value at a time:
+//
+//	OVR::JsonWriter writer( file, true );
+//	writer.BeginObject();
+//	writer.WriteName( "version" );
+//	writer.WriteNumber( 1.0 );
+//	writer.EndObject();
+//	if ( !writer.Finish() ) ...
+
+class JSON;
+
+class JsonWriter
+{
+public:
+	// Writes into memory; read the text back with GetText after Finish.
+	explicit        JsonWriter( const bool pretty, const int depth = 0 ) :
+						File( nullptr ),
+						Length( 0 ),
+						Pretty( pretty ),
+						BaseDepth( depth ),
+						Failed( false )
+					{
+						Buffer.resize( 4096 );
+					}
+	// Writes to file, buffering up to FILE_BUFFER_SIZE bytes at a time. The file is not closed.
+					JsonWriter( FILE * file, const bool pretty ) :
+						File( file ),
+						Length( 0 ),
+						Pretty( pretty ),
+						BaseDepth( 0 ),
+						Failed( file == nullptr )
+					{
+						Buffer.resize( FILE_BUFFER_SIZE );
+					}
+
+	// Writes a whole tree, or a single value inside an array or after WriteName.
+	void            WriteValue( const JSON & json );
+
+	void            BeginObject()
+	{
+		beginValue();
+		Put( '{' );
+		if ( Pretty )
+		{
+			Put( '\n' );
+		}
+		Frames.push_back( Frame( true, valueDepth() + 1 ) );
+	}
+	void            EndObject()
+	{
+		OVR_ASSERT( !Frames.empty() && Frames.back().IsObject );
+		const Frame frame = Frames.back();
+		Frames.pop_back();
+		if ( Pretty )
+		{
+			// An empty object closes one level further out; PrintValue always did it this way.
+			if ( frame.Count > 0 )
+			{
+				Put( '\n' );
+			}
+			PutTabs( frame.Count > 0 ? frame.Depth - 1 : frame.Depth - 2 );
+		}
+		Put( '}' );
+	}
+	void            BeginArray()
+	{
+		beginValue();
+		Put( '[' );
+		Frames.push_back( Frame( false, valueDepth() + 1 ) );
+	}
+	void            EndArray()
+	{
+		OVR_ASSERT( !Frames.empty() && !Frames.back().IsObject );
+		Frames.pop_back();
+		Put( ']' );
+	}
+
+	// Starts the next member of the current object.
+	void            WriteName( const char * name )
+	{
+		OVR_ASSERT( !Frames.empty() && Frames.back().IsObject );
+		Frame & frame = Frames.back();
+		if ( frame.Count++ > 0 )
+		{
+			Put( ',' );
+			if ( Pretty )
+			{
+				Put( '\n' );
+			}
+		}
+		if ( Pretty )
+		{
+			PutTabs( frame.Depth );
+		}
+		PutString( name );
+		Put( ':' );
+		if ( Pretty )
+		{
+			Put( '\t' );
+		}
+	}
+
+	void            WriteNull()                     { beginValue(); Put( "null", 4 ); }
+	void            WriteBool( const bool value )   { beginValue(); value ? Put( "true", 4 ) : Put( "false", 5 ); }
+	void            WriteString( const char * value ) { beginValue(); PutString( value ); }
+	void            WriteNumber( const double value )
+	{
+		beginValue();
+		char text[64];
+		OVR::FormatNumber( value, text );
+		Put( text, OVR_strlen( text ) );
+	}
+
+	// Marks the output as failed, for values that can't be written.
+	void            SetFailed()                     { Failed = true; }
+
+	// Writes out anything still buffered. Returns false if any write failed.
+	bool            Finish()
+	{
+		if ( File != nullptr )
+		{
+			Flush();
+		}
+		else
+		{
+			Put( '\0' );
+			Length--;
+		}
+		return !Failed;
+	}
+
+	// The text written so far, null-terminated after Finish. Only used without a file.
+	const char *    GetText() const                 { return Buffer.data(); }
+	size_t          GetLength() const               { return Length; }
+	bool            HasFailed() const               { return Failed; }
+
+private:
+	static const size_t FILE_BUFFER_SIZE = 64 * 1024;
+
+	struct Frame
+	{
+		Frame( const bool isObject, const int depth ) : IsObject( isObject ), Depth( depth ), Count( 0 ) {}
+
+		bool    IsObject;
+		int     Depth;      // depth of the members or elements
+		int     Count;      // members or elements written so far
+	};
+
+	FILE *              File;
+	std::vector< char > Buffer;
+	size_t              Length;
+	std::vector< Frame > Frames;
+	bool                Pretty;
+	int                 BaseDepth;
+	bool                Failed;
+
+	int             valueDepth() const { return Frames.empty() ? BaseDepth : Frames.back().Depth; }
+
+	// Array elements are separated here; object members are separated by WriteName.
+	void            beginValue()
+	{
+		if ( !Frames.empty() && !Frames.back().IsObject && Frames.back().Count++ > 0 )
+		{
+			Pretty ? Put( ", ", 2 ) : Put( ',' );
+		}
+	}
+
+	// Makes room for count more bytes.
+	void            Reserve( const size_t count )
+	{
+		if ( Length + count <= Buffer.size() )
+		{
+			return;
+		}
+		if ( File != nullptr )
+		{
+			Flush();
+			if ( count <= Buffer.size() )
+			{
+				return;
+			}
+		}
+		Buffer.resize( std::max( Buffer.size() * 2, Length + count ) );
+	}
+	void            Flush()
+	{
+		if ( Length > 0 && fwrite( Buffer.data(), 1, Length, File ) != Length )
+		{
+			Failed = true;
+		}
+		Length = 0;
+	}
+	void            Put( const char c )
+	{
+		Reserve( 1 );
+		Buffer[Length++] = c;
+	}
+	void            Put( const char * text, const size_t count )
+	{
+		Reserve( count );
+		memcpy( Buffer.data() + Length, text, count );
+		Length += count;
+	}
+	void            PutTabs( int count )
+	{
+		for ( ; count > 0; count-- )
+		{
+			Put( '\t' );
+		}
+	}
+	// Quotes and escapes str like PrintString, copying runs that need no escaping in one go.
+	void            PutString( const char * str )
+	{
+		Put( '\"' );
+		for ( const char * run = str; ; )
+		{
+			const char * p = run;
+			while ( (unsigned char)*p > 31 && *p != '\"' && *p != '\\' )
+			{
+				p++;
+			}
+			Put( run, p - run );
+			if ( *p == '\0' )
+			{
+				break;
+			}
+			char escaped[8];
+			switch ( *p )
+			{
+				case '\\':  Put( "\\\\", 2 ); break;
+				case '\"':  Put( "\\\"", 2 ); break;
+				case '\b':  Put( "\\b", 2 );  break;
+				case '\f':  Put( "\\f", 2 );  break;
+				case '\n':  Put( "\\n", 2 );  break;
+				case '\r':  Put( "\\r", 2 );  break;
+				case '\t':  Put( "\\t", 2 );  break;
+				default:
+					OVR_sprintf( escaped, sizeof( escaped ), "\\u%04x", (unsigned char)*p );
+					Put( escaped, 6 );
+					break;
+			}
+			run = p + 1;
+		}
+		Put( '\"' );
+	}
+};
+
 
 //-----------------------------------------------------------------------------
 // ***** JSON
@@ -255,7 +1195,7 @@ static const char* skip(const char* in)
 class JSON
 {
 public:
-	std::list< std::shared_ptr< JSON > > Children;
+	std::vector< std::shared_ptr< JSON > > Children;
 	JSONItemType    Type;       // Type of this JSON node.
 	std::string     Name;       // Name part of the {Name, Value} pair in a parent object.
 	std::string     Value;
@@ -348,34 +1288,20 @@ public:
 		return json;
 	}
 
-	// Saves a JSON object to a file.
+	// Saves a JSON object to a file, streaming it out as it's formatted.
 	bool            Save(const char* path) const
 	{
-		std::ofstream os;
-		os.open( path, std::ios::out | std::ios::trunc );
-		if ( !os.is_open() )
+		FILE * file = fopen( path, "w" );
+		if ( file == nullptr )
 		{
 			return false;
 		}
 
-		char* text = PrintValue(0, true);
-		if (text)
-		{
-			intptr_t len = OVR_strlen(text);
-			OVR_ASSERT( len <= (intptr_t)(int)len );
-
-			os.write( (char*)text, (int)len );
-			// save stream state
-			bool writeComplete = !!os;
-			os.close();
-
-			free(text);
-			return writeComplete;
-		}
-		else
-		{
-			return false;
-		}
+		JsonWriter writer( file, true );
+		writer.WriteValue( *this );
+		bool writeComplete = writer.Finish();
+		writeComplete &= ( fclose( file ) == 0 );
+		return writeComplete;
 	}
 	// Child item access functions
 	void            AddItem(const char *string, std::shared_ptr<JSON> item)
@@ -398,61 +1324,57 @@ public:
 	std::shared_ptr<JSON>           GetLastItem()            { return (!Children.empty()) ? Children.back() : nullptr; }
 	const std::shared_ptr<JSON>     GetLastItem() const      { return (!Children.empty()) ? Children.back() : nullptr; }
 
-	// Counts the number of items in the object; these methods are inefficient.
 	unsigned                        GetItemCount() const     { return static_cast< unsigned >( Children.size() ); }
 	std::shared_ptr<JSON>           GetItemByIndex(unsigned index)
 	{
-		for ( const std::shared_ptr<JSON> & child : Children )
-		{
-			if ( index-- == 0 )
-			{
-				return child;
-			}
-		}
-		return nullptr;
+		return ( index < Children.size() ) ? Children[index] : nullptr;
 	}
 	const std::shared_ptr<JSON>     GetItemByIndex(unsigned index) const
 	{
-		for ( const std::shared_ptr<JSON> & child : Children )
+		return ( index < Children.size() ) ? Children[index] : nullptr;
+	}
+
+	// Objects with many members build a name index on the first lookup, so lookups
+	// are not thread safe, even on a const JSON. The index is rebuilt when items are
+	// added, but assumes the Name of an item isn't changed after it was added.
+	int                             GetItemIndexByName(const char* name) const
+	{
+		const unsigned count = GetItemCount();
+		if ( count >= JsonNameIndex::MIN_ITEMS )
 		{
-			if ( index-- == 0 )
+			auto getName = [this]( const unsigned i ) { return Children[i]->Name.c_str(); };
+			if ( !NameIndex.IsBuiltFor( count ) )
 			{
-				return child;
+				NameIndex.Build( count, getName );
 			}
+			return NameIndex.Find( name, getName );
 		}
-		return nullptr;
-	}
-	std::shared_ptr<JSON>           GetItemByName(const char* name)
-	{
-		for ( const std::shared_ptr<JSON> & child : Children )
+		for ( unsigned i = 0; i < count; i++ )
 		{
-			if ( OVR_strcmp( child->Name.c_str(), name ) == 0 )
+			if ( OVR_strcmp( Children[i]->Name.c_str(), name ) == 0 )
 			{
-				return child;
+				return static_cast< int >( i );
 			}
 		}
-		return nullptr;
+		return -1;
+	}
+	std::shared_ptr<JSON>           GetItemByName(const char* name)
+	{
+		const int index = GetItemIndexByName( name );
+		return ( index >= 0 ) ? Children[index] : nullptr;
 	}
 	const std::shared_ptr<JSON>     GetItemByName(const char* name) const
 	{
-		for ( const std::shared_ptr<JSON> & child : Children )
-		{
-			if ( OVR_strcmp( child->Name.c_str(), name ) == 0 )
-			{
-				return child;
-			}
-		}
-		return nullptr;
+		const int index = GetItemIndexByName( name );
+		return ( index >= 0 ) ? Children[index] : nullptr;
 	}
 	void                            ReplaceNodeWith(const char* name, const std::shared_ptr<JSON> newNode)
 	{
-		for ( auto it = Children.begin(); it != Children.end(); ++it )
+		const int index = GetItemIndexByName( name );
+		if ( index >= 0 )
 		{
-			if ( OVR_strcmp( (*it)->Name.c_str(), name ) == 0 )
-			{
-				*it = newNode;
-				return;
-			}
+			Children[index] = newNode;
+			NameIndex.Clear();  // the new node may have a different name
 		}
 	}
 
@@ -518,7 +1440,7 @@ public:
 	void            AddArrayNumber(double n)        { AddArrayElement(CreateNumber(n)); }
 	void            AddArrayString(const char* s)   { AddArrayElement(CreateString(s)); }
 
-	// Accessed array elements; currently inefficient.
+	// Accessed array elements.
 	int             GetArraySize() const
 	{
 		if (Type == JSON_Array)
@@ -553,37 +1475,27 @@ public:
 		}
 	}
 
-	// Return text value of JSON. Use free when done with return value
+	// Return text value of JSON. Use free when done with return value.
+	// Use JsonWriter directly to avoid the extra copy.
 	char*           PrintValue(int depth, bool fmt) const
 	{
-		char *out=nullptr;
-
-		switch (Type)
+		JsonWriter writer( fmt, depth );
+		writer.WriteValue( *this );
+		if ( !writer.Finish() )
 		{
-			case JSON_Null:      out = JSON_strdup("null");    break;
-			case JSON_Bool:
-				if (dValue == 0)
-					out = JSON_strdup("false");
-				else
-					out = JSON_strdup("true");
-				break;
-			case JSON_Number:    out = PrintNumber(dValue); break;
-			case JSON_String:    out = PrintString(Value.c_str()); break;
-			case JSON_Array:     out = PrintArray(depth, fmt); break;
-			case JSON_Object:    out = PrintObject(depth, fmt); break;
-			case JSON_None:
-			{
-				 OVR_ASSERT(false);
-#if defined( OVR_OS_ANDROID )
-				 OVR_LOG("JSON::PrintValue - Bad JSON type.");
-#endif
-				 break;
-			}
+			return nullptr;
+		}
+		char* out = (char*)malloc( writer.GetLength() + 1 );
+		if ( out )
+		{
+			memcpy( out, writer.GetText(), writer.GetLength() + 1 );
 		}
 		return out;
 	}
 
 protected:
+	mutable JsonNameIndex           NameIndex;
+
 	static std::shared_ptr<JSON>    createHelper(JSONItemType itemType, double dval, const char* strVal = nullptr)
 	{
 		std::shared_ptr<JSON> item = std::make_shared<JSON>(itemType);
@@ -630,77 +1542,25 @@ protected:
 		}
 		if (*buff=='-' || (*buff>='0' && *buff<='9'))
 		{
-			return parseNumber(buff);
-		}
-		if (*buff=='[')
-		{
-			return parseArray(buff, perror);
-		}
-		if (*buff=='{')
-		{
-			return parseObject(buff, perror);
-		}
-
-		return AssignError(perror, (std::string( "Syntax Error: Invalid syntax: ") + buff).c_str() );
-	}
-	const char*     parseNumber(const char *num)
-	{
-		const char* num_start = num;
-		double      n=0, sign=1, scale=0;
-		int         subscale     = 0,
-					signsubscale = 1;
-
-		// Could use sscanf for this?
-		if (*num == '-')
-		{
-			sign=-1,num++;    // Has sign?
-		}
-		if (*num == '0')
-		{
-			num++;            // is zero
-		}
-
-		if (*num>='1' && *num<='9')
-		{
-			do
-			{
-				n = (n*10.0) + (*num++ - '0');
-			}
-			while (*num>='0' && *num<='9');    // Number?
+			return parseNumber(buff);
 		}
-
-		if (*num=='.' && num[1]>='0' && num[1]<='9')
+		if (*buff=='[')
 		{
-			num++;
-			do
-			{
-				n=(n*10.0)+(*num++ -'0');
-				scale--;
-			}
-			while (*num>='0' && *num<='9');  // Fractional part?
+			return parseArray(buff, perror);
 		}
-
-		if (*num=='e' || *num=='E')        // Exponent?
+		if (*buff=='{')
 		{
-			num++;
-			if (*num == '+')
-			{
-				num++;
-			}
-			else if (*num=='-')
-			{
-				signsubscale=-1;
-				num++;        // With sign?
-			}
-
-			while (*num >= '0' && *num <= '9')
-			{
-				subscale = (subscale * 10) + (*num++ - '0');    // Number?
-			}
+			return parseObject(buff, perror);
 		}
 
-		// Number = +/- number.fraction * 10^+/- exponent
-		n = sign*n*pow(10.0, (scale + subscale*signsubscale));
+		return AssignError(perror, (std::string( "Syntax Error: Invalid syntax: ") + buff).c_str() );
+	}
+	const char*     parseNumber(const char *num)
+	{
+		const char* num_start = num;
+		double      n = 0.0;
+
+		num = ParseNumber(num, n);
 
 		// Assign parsed value.
 		Type = JSON_Number;
@@ -814,29 +1674,28 @@ protected:
 	const char*     parseString(const char* str, const char** perror)
 	{
 		const char* ptr = str+1;
-		const char* p;
 		char*       ptr2;
 		char*       out;
 		int         len=0;
-		unsigned    uc, uc2;
 
 		if (*str!='\"')
 		{
 			return AssignError(perror, "Syntax Error: Missing quote");
 		}
 
-		while (*ptr!='\"' && *ptr && ++len)
+		for (;;)
 		{
-			if (*ptr++ == '\\')
+			const char* run = ScanStringRun(ptr);
+			len += static_cast< int >( run - ptr );
+			ptr = run;
+			if (*ptr != '\\')
 			{
-				if ( *ptr )
-				{
-					ptr++;    // Skip escaped quotes.
-				}
-				else
-				{
-					// we reached the end of the file too soon, stop
-				}
+				break;
+			}
+			len++;
+			if (*++ptr)
+			{
+				ptr++;    // Skip escaped quotes.
 			}
 		}
 
@@ -845,332 +1704,476 @@ protected:
 		if (!out)
 			return 0;
 
-		ptr = str+1;
-		ptr2= out;
+		ptr = DecodeString(str, out, &ptr2);
+		*ptr2 = 0;
 
-		while (*ptr!='\"' && *ptr)
-		{
-			if (*ptr!='\\')
+		// Make a copy of the string
+		Value=out;
+		free(out);
+		Type=JSON_String;
+
+		return ptr;
+	}
+
+	friend class JsonReader;
+};
+
+inline void JsonWriter::WriteValue( const JSON & json )
+{
+	switch ( json.Type )
+	{
+		case JSON_Null:     WriteNull(); break;
+		case JSON_Bool:     WriteBool( json.dValue != 0 ); break;
+		case JSON_Number:   WriteNumber( json.dValue ); break;
+		case JSON_String:   WriteString( json.Value.c_str() ); break;
+		case JSON_Array:
+			BeginArray();
+			for ( const std::shared_ptr< JSON > & child : json.Children )
 			{
-				*ptr2++ = *ptr++;
+				WriteValue( *child );
 			}
-			else
+			EndArray();
+			break;
+		case JSON_Object:
+			BeginObject();
+			for ( const std::shared_ptr< JSON > & child : json.Children )
 			{
-				ptr++;
-				switch (*ptr)
-				{
-					case 'b': *ptr2++ = '\b';    break;
-					case 'f': *ptr2++ = '\f';    break;
-					case 'n': *ptr2++ = '\n';    break;
-					case 'r': *ptr2++ = '\r';    break;
-					case 't': *ptr2++ = '\t';    break;
+				WriteName( child->Name.c_str() );
+				WriteValue( *child );
+			}
+			EndObject();
+			break;
+		case JSON_None:
+			OVR_ASSERT( false );
+#if defined( OVR_OS_ANDROID )
+			OVR_LOG( "JsonWriter::WriteValue - Bad JSON type." );
+#endif
+			SetFailed();
+			break;
+	}
+}
 
-					// Transcode utf16 to utf8.
-					case 'u':
+//-----------------------------------------------------------------------------
+// ***** JsonDocument
+
+// Flat alternative to the JSON tree for data that is only read, such as glTF
+// files and font descriptions. JSON::Parse allocates a shared_ptr node, a list
+// entry and name / value strings for every value in the file. JsonDocument::Parse
+// instead stores all nodes in a single array, with the children of each array or
+// object in one contiguous index range, and keeps names and string values as
+// null-terminated views into its own copy of the source text. Escaped strings are
+// decoded in place, so a parse makes a handful of allocations no matter how big
+// the file is.
+//
+// Read a JsonDocument with JsonReader, exactly like a JSON tree:
+//
+//	OVR::JsonDocument doc;
+//	if ( doc.Parse( text, &error ) )
+//	{
+//		const JsonReader model( doc );
+//		...
+//	}
+//
+// Nodes returned by JsonReader point into the document, so the document must
+// outlive any reader or element obtained from it.
 
-						// Get the unicode char.
-						p = ParseHex(&uc, 4, ptr + 1);
-						if (ptr != p)
-							ptr = p - 1;
+class JsonDocument;
 
-						if ((uc>=0xDC00 && uc<=0xDFFF) || uc==0)
-							break;    // Check for invalid.
+struct JsonNode
+{
+	JSONItemType    Type;
+	uint32_t        NameOffset;     // offset of the name text in the document, if a member of an object
+	uint32_t        ValueOffset;    // offset of the string, or of the source text of a number or bool
+	uint32_t        ValueLength;
+	uint32_t        FirstChild;     // index of the first child node, children are contiguous
+	uint32_t        NumChildren;
+	double          dValue;
+};
 
-						// UTF16 surrogate pairs.
-						if (uc>=0xD800 && uc<=0xDBFF)
-						{
-							if (ptr[1]!='\\' || ptr[2]!='u')
-								break;    // Missing second-half of surrogate.
+// A reference to a node in either a JSON tree or a JsonDocument.
+// The node accessors mirror JSON so code written against std::shared_ptr<JSON> nodes
+// works unchanged, including the "node->GetFloatValue()" style of access.
+class JsonElement
+{
+public:
+					JsonElement() : Document( nullptr ), Index( 0 ) {}
+					JsonElement( std::nullptr_t ) : Document( nullptr ), Index( 0 ) {}
+					JsonElement( const std::shared_ptr<JSON> & node ) : Node( node ), Document( nullptr ), Index( 0 ) {}
+					JsonElement( const JsonDocument * document, const uint32_t index ) : Document( document ), Index( index ) {}
+
+	bool                IsValid() const { return Node != nullptr || Document != nullptr; }
+	explicit operator   bool() const { return IsValid(); }
+	bool                operator==( std::nullptr_t ) const { return !IsValid(); }
+	bool                operator!=( std::nullptr_t ) const { return IsValid(); }
+	const JsonElement * operator->() const { return this; }
+
+	// Only elements of a JSON tree have a node, elements of a JsonDocument return null.
+	operator            std::shared_ptr<JSON>() const { return Node; }
+	const std::shared_ptr<JSON> & GetTreeNode() const { return Node; }
+
+	const JsonDocument *    GetDocument() const { return Document; }
+	uint32_t                GetIndex() const { return Index; }
+
+	JSONItemType    GetType() const;
+	const char *    GetName() const;
+
+	unsigned        GetItemCount() const;
+	int             GetArraySize() const { return GetType() == JSON_Array ? static_cast< int >( GetItemCount() ) : 0; }
+	JsonElement     GetItemByIndex( unsigned index ) const;
+	JsonElement     GetItemByName( const char * name ) const;
+
+	bool            GetBoolValue() const;
+	int32_t         GetInt32Value() const;
+	int64_t         GetInt64Value() const;
+	float           GetFloatValue() const;
+	double          GetDoubleValue() const;
+	std::string     GetStringValue() const;
 
-							p= ParseHex(&uc2, 4, ptr + 3);
-							if (ptr != p)
-								ptr = p - 1;
+private:
+	std::shared_ptr<JSON>   Node;
+	const JsonDocument *    Document;
+	uint32_t                Index;
 
-							if (uc2<0xDC00 || uc2>0xDFFF)
-								break;    // Invalid second-half of surrogate.
+	double          GetNumber() const;
+};
 
-							uc = 0x10000 + (((uc&0x3FF)<<10) | (uc2&0x3FF));
-						}
+class JsonDocument
+{
+public:
+					JsonDocument() : Root( INVALID_NODE ) {}
 
-						len=4;
+	// Parses buff, which must be null-terminated. The text is copied so buff may be
+	// freed once this returns. Returns false and fills in *perror on a parse error.
+	bool            Parse( const char * buff, const char ** perror = nullptr )
+	{
+		return Parse( buff, ( buff != nullptr ) ? OVR_strlen( buff ) : 0, perror );
+	}
+	bool            Parse( const char * buff, const size_t length, const char ** perror = nullptr )
+	{
+		Clear();
+		if ( perror != nullptr )
+		{
+			*perror = nullptr;
+		}
+		if ( buff == nullptr || length >= static_cast< size_t >( UINT32_MAX ) )
+		{
+			AssignError( perror, "Error: Invalid buffer" );
+			return false;
+		}
 
-						if (uc<0x80)
-							len=1;
-						else if (uc<0x800)
-							len=2;
-						else if (uc<0x10000)
-							len=3;
+		// Offset 0 is kept as an empty string for the names of array elements.
+		Text.resize( length + 2 );
+		Text[0] = '\0';
+		memcpy( Text.data() + 1, buff, length );
+		Text[length + 1] = '\0';
 
-						ptr2+=len;
+		// A rough guess that avoids most of the regrowth on typical files.
+		Nodes.reserve( length / 16 + 1 );
 
-						switch (len)
-						{
-							case 4: *--ptr2 =static_cast<char>((uc | 0x80) & 0xBF); uc >>= 6;
-								//no break, fall through
-							case 3: *--ptr2 =static_cast<char>((uc | 0x80) & 0xBF); uc >>= 6;
-								//no break
-							case 2: *--ptr2 =static_cast<char>((uc | 0x80) & 0xBF); uc >>= 6;
-								//no break
-							case 1: *--ptr2 = (char)(uc | firstByteMark[len]);
-								//no break
-						}
-						ptr2+=len;
-						break;
+		std::vector< JsonNode > stack;
+		stack.reserve( 64 );
 
-					default:
-						if (*ptr) { *ptr2++ = *ptr; }
-						break;
-				}
-				if (*ptr) { ptr++; }
-			}
+		JsonNode root;
+		root.NameOffset = 0;
+		if ( parseValue( skip( Text.data() + 1 ), root, stack, perror ) == nullptr )
+		{
+			Clear();
+			return false;
 		}
-
-		*ptr2 = 0;
-		if (*ptr=='\"')
-			ptr++;
-
-		// Make a copy of the string
-		Value=out;
-		free(out);
-		Type=JSON_String;
-
-		return ptr;
+		Root = static_cast< uint32_t >( Nodes.size() );
+		Nodes.push_back( root );
+		return true;
 	}
 
-	char*           PrintObject(int depth, bool fmt) const
+	void            Clear()
 	{
-		char**   entries = 0, **names = 0;
-		char*    out = 0;
-		char*    ptr, *ret, *str;
-		intptr_t len = 7, i = 0, j;
-		bool     fail = false;
+		Text.clear();
+		Nodes.clear();
+		NameIndices.clear();
+		Root = INVALID_NODE;
+	}
 
-		// Count the number of entries.
-		int numentries = GetItemCount();
+	bool            IsValid() const { return Root != INVALID_NODE; }
+	JsonElement     GetRoot() const { return IsValid() ? JsonElement( this, Root ) : JsonElement(); }
 
-		// Explicitly handle empty object case
-		if (numentries == 0)
-		{
-			out=(char*)malloc(fmt?depth+4:4);
-			if (!out)
-				return 0;
-			ptr=out;
-			*ptr++='{';
+	uint32_t        GetNumNodes() const { return static_cast< uint32_t >( Nodes.size() ); }
+	const JsonNode & GetNode( const uint32_t index ) const { return Nodes[index]; }
+	const char *    GetText( const uint32_t offset ) const { return Text.data() + offset; }
 
-			if (fmt)
+	// Returns the node index of the first child of parentIndex called name, or -1.
+	// Wide objects build a name index on the first lookup, which is not thread safe.
+	int             FindChildByName( const uint32_t parentIndex, const char * name ) const
+	{
+		const JsonNode & parent = Nodes[parentIndex];
+		const uint32_t first = parent.FirstChild;
+		if ( parent.NumChildren >= JsonNameIndex::MIN_ITEMS )
+		{
+			auto getName = [this, first]( const unsigned i ) { return GetText( Nodes[first + i].NameOffset ); };
+			JsonNameIndex & index = NameIndices[parentIndex];
+			if ( !index.IsBuiltFor( parent.NumChildren ) )
 			{
-				*ptr++='\n';
-				for (i=0;i<depth-1;i++)
-					*ptr++='\t';
+				index.Build( parent.NumChildren, getName );
 			}
-			*ptr++='}';
-			*ptr++='\0';
-			return out;
+			const int i = index.Find( name, getName );
+			return ( i >= 0 ) ? static_cast< int >( first + i ) : -1;
 		}
-		// Allocate space for the names and the objects
-		entries=(char**)malloc(numentries*sizeof(char*));
-		if (!entries)
-			return 0;
-		names=(char**)malloc(numentries*sizeof(char*));
-
-		if (!names)
+		for ( uint32_t i = first; i < first + parent.NumChildren; i++ )
 		{
-			free(entries);
-			return 0;
+			if ( OVR_strcmp( GetText( Nodes[i].NameOffset ), name ) == 0 )
+			{
+				return static_cast< int >( i );
+			}
 		}
-		memset(entries,0,sizeof(char*)*numentries);
-		memset(names,0,sizeof(char*)*numentries);
+		return -1;
+	}
 
-		// Collect all the results into our arrays:
-		depth++;
-		if (fmt)
-			len+=depth;
+private:
+	static const uint32_t INVALID_NODE = UINT32_MAX;
 
-		for ( const std::shared_ptr<JSON> child : Children )
-		{
-			names[i]     = str = PrintString(child->Name.c_str());
-			entries[i++] = ret = child->PrintValue(depth, fmt);
+	std::vector< char >     Text;
+	std::vector< JsonNode > Nodes;
+	uint32_t                Root;
 
-			if (str && ret)
-			{
-				len += OVR_strlen(ret)+OVR_strlen(str)+2+(fmt?2+depth:0);
-			}
-			else
-			{
-				fail = true;
-				break;
-			}
-		}
+	mutable std::unordered_map< uint32_t, JsonNameIndex > NameIndices;   // by object node index
 
-		// Try to allocate the output string
-		if (!fail)
-			out=(char*)malloc(len);
-		if (!out)
-			fail=true;
+	uint32_t        offsetOf( const char * p ) const { return static_cast< uint32_t >( p - Text.data() ); }
 
-		// Handle failure
-		if (fail)
-		{
-			for (i=0;i<numentries;i++)
-			{
-				if (names[i])
-					free(names[i]);
+	static void     initNode( JsonNode & node )
+	{
+		node.Type = JSON_None;
+		node.NameOffset = 0;
+		node.ValueOffset = 0;
+		node.ValueLength = 0;
+		node.FirstChild = 0;
+		node.NumChildren = 0;
+		node.dValue = 0.0;
+	}
 
-				if (entries[i])
-					free(entries[i]);}
+	// Finished children are collected on stack. When an array or object is closed its
+	// children are moved from the stack to Nodes as one block, which keeps siblings contiguous.
+	const char *    parseValue( const char * buff, JsonNode & node, std::vector< JsonNode > & stack, const char ** perror )
+	{
+		const uint32_t nameOffset = node.NameOffset;
+		initNode( node );
+		node.NameOffset = nameOffset;
 
-			free(names);
-			free(entries);
-			return 0;
+		if ( !strncmp( buff, "null", 4 ) )
+		{
+			node.Type = JSON_Null;
+			node.ValueOffset = offsetOf( buff );
+			node.ValueLength = 0;
+			return buff + 4;
 		}
-
-		// Compose the output:
-		*out = '{';
-		ptr  = out+1;
-		if (fmt)
+		if ( !strncmp( buff, "false", 5 ) )
+		{
+			node.Type = JSON_Bool;
+			node.ValueOffset = offsetOf( buff );
+			node.ValueLength = 5;
+			return buff + 5;
+		}
+		if ( !strncmp( buff, "true", 4 ) )
+		{
+			node.Type = JSON_Bool;
+			node.ValueOffset = offsetOf( buff );
+			node.ValueLength = 4;
+			node.dValue = 1.0;
+			return buff + 4;
+		}
+		if ( *buff == '\"' )
+		{
+			node.Type = JSON_String;
+			return parseString( buff, node.ValueOffset, node.ValueLength );
+		}
+		if ( *buff == '-' || ( *buff >= '0' && *buff <= '9' ) )
+		{
+			const char * end = ParseNumber( buff, node.dValue );
+			node.Type = JSON_Number;
+			node.ValueOffset = offsetOf( buff );
+			node.ValueLength = static_cast< uint32_t >( end - buff );
+			return end;
+		}
+		if ( *buff == '[' || *buff == '{' )
 		{
-			*ptr++ = '\n';
+			return parseContainer( buff, node, stack, perror );
 		}
-		*ptr = 0;
 
-		for (i=0; i<numentries; i++)
+		// unlike JSON::parseValue, don't point the error at a temporary string
+		return AssignError( perror, "Syntax Error: Invalid syntax" );
+	}
+
+	const char *    parseContainer( const char * buff, JsonNode & node, std::vector< JsonNode > & stack, const char ** perror )
+	{
+		const bool isObject = ( *buff == '{' );
+		const char closing = isObject ? '}' : ']';
+		node.Type = isObject ? JSON_Object : JSON_Array;
+
+		const size_t frameStart = stack.size();
+		buff = skip( buff + 1 );
+		if ( *buff != closing )
 		{
-			if (fmt)
+			for ( ;; )
 			{
-				for (j = 0; j < depth; j++)
+				JsonNode child;
+				child.NameOffset = 0;
+				if ( isObject )
+				{
+					if ( *buff != '\"' )
+					{
+						return AssignError( perror, "Syntax Error: Missing quote" );
+					}
+					uint32_t nameLength = 0;
+					buff = skip( parseString( buff, child.NameOffset, nameLength ) );
+					if ( *buff != ':' )
+					{
+						return AssignError( perror, "Syntax Error: Missing colon" );
+					}
+					buff++;
+				}
+
+				buff = parseValue( skip( buff ), child, stack, perror );
+				if ( buff == nullptr )
 				{
-					*ptr++ = '\t';
+					return nullptr;
 				}
+				stack.push_back( child );
+
+				buff = skip( buff );
+				if ( *buff != ',' )
+				{
+					break;
+				}
+				buff = skip( buff + 1 );
 			}
-			OVR_strcpy(ptr, len - (ptr-out), names[i]);
-			ptr   += OVR_strlen(names[i]);
-			*ptr++ =':';
 
-			if (fmt)
+			if ( *buff != closing )
 			{
-				*ptr++ = '\t';
+				return AssignError( perror, isObject ? "Syntax Error: Missing closing brace" : "Syntax Error: Missing ending bracket" );
 			}
+		}
 
-			OVR_strcpy(ptr, len - (ptr-out), entries[i]);
-			ptr+=OVR_strlen(entries[i]);
+		node.FirstChild = static_cast< uint32_t >( Nodes.size() );
+		node.NumChildren = static_cast< uint32_t >( stack.size() - frameStart );
+		Nodes.insert( Nodes.end(), stack.begin() + frameStart, stack.end() );
+		stack.resize( frameStart );
 
-			if (i != numentries - 1)
-			{
-				*ptr++ = ',';
-			}
+		return buff + 1;
+	}
 
-			if (fmt)
-			{
-				*ptr++ = '\n';
-			}
-			*ptr = 0;
+	// Decodes the string in place and null-terminates it.
+	const char *    parseString( const char * str, uint32_t & outOffset, uint32_t & outLength )
+	{
+		char * out = Text.data() + offsetOf( str ) + 1;
+		char * outEnd = out;
+		const char * end = DecodeString( str, out, &outEnd );
+		*outEnd = '\0';
+		outOffset = offsetOf( out );
+		outLength = static_cast< uint32_t >( outEnd - out );
+		return end;
+	}
+};
 
-			free(names[i]);
-			free(entries[i]);
-		}
+inline JSONItemType JsonElement::GetType() const
+{
+	if ( Document != nullptr )
+	{
+		return Document->GetNode( Index ).Type;
+	}
+	return Node != nullptr ? Node->Type : JSON_None;
+}
 
-		free(names);
-		free(entries);
+inline const char * JsonElement::GetName() const
+{
+	if ( Document != nullptr )
+	{
+		return Document->GetText( Document->GetNode( Index ).NameOffset );
+	}
+	return Node != nullptr ? Node->Name.c_str() : "";
+}
 
-		if (fmt)
-		{
-			for (i = 0; i < depth - 1; i++)
-			{
-				*ptr++ = '\t';
-			}
-		}
-		*ptr++='}';
-		*ptr++='\0';
+inline unsigned JsonElement::GetItemCount() const
+{
+	if ( Document != nullptr )
+	{
+		return Document->GetNode( Index ).NumChildren;
+	}
+	return Node != nullptr ? Node->GetItemCount() : 0;
+}
 
-		return out;
+inline JsonElement JsonElement::GetItemByIndex( unsigned index ) const
+{
+	if ( Document != nullptr )
+	{
+		const JsonNode & node = Document->GetNode( Index );
+		return ( index < node.NumChildren ) ? JsonElement( Document, node.FirstChild + index ) : JsonElement();
 	}
+	return Node != nullptr ? JsonElement( Node->GetItemByIndex( index ) ) : JsonElement();
+}
 
-	char*			PrintArray(int depth, bool fmt) const
+inline JsonElement JsonElement::GetItemByName( const char * name ) const
+{
+	if ( Document != nullptr )
 	{
-		char **  entries;
-		char *   out = 0, *ptr,*ret;
-		intptr_t len = 5;
+		const int i = Document->FindChildByName( Index, name );
+		return ( i >= 0 ) ? JsonElement( Document, static_cast< uint32_t >( i ) ) : JsonElement();
+	}
+	return Node != nullptr ? JsonElement( Node->GetItemByName( name ) ) : JsonElement();
+}
 
-		bool fail = false;
+inline double JsonElement::GetNumber() const
+{
+	if ( Document != nullptr )
+	{
+		return Document->GetNode( Index ).dValue;
+	}
+	return Node != nullptr ? Node->dValue : 0.0;
+}
 
-		// How many entries in the array?
-		int numentries = GetItemCount();
-		if (!numentries)
-		{
-			out=(char*)malloc(3);
-			if (out)
-				OVR_strcpy(out, 3, "[]");
-			return out;
-		}
-		// Allocate an array to hold the values for each
-		entries=(char**)malloc(numentries*sizeof(char*));
-		if (!entries)
-			return 0;
-		memset(entries,0,numentries*sizeof(char*));
+inline bool JsonElement::GetBoolValue() const
+{
+	OVR_ASSERT( ( GetType() == JSON_Number ) || ( GetType() == JSON_Bool ) );
+	OVR_ASSERT( GetNumber() == 0.0 || GetNumber() == 1.0 ); // if this hits, value is out of range
+	return ( GetNumber() != 0.0 );
+}
 
-		//// Retrieve all the results:
-		int entry=0;
-		for ( std::shared_ptr<JSON> child : Children )
-		{
-			if ( entry >= numentries )
-				break;
+inline int32_t JsonElement::GetInt32Value() const
+{
+	OVR_ASSERT( GetType() == JSON_Number );
+	OVR_ASSERT( GetNumber() >= INT_MIN && GetNumber() <= INT_MAX ); // if this hits, value is out of range
+	return (int32_t)GetNumber();
+}
 
-			ret = child->PrintValue(depth+1, fmt);
-			entries[entry] = ret;
-			if (ret)
-				len+=OVR_strlen(ret)+2+(fmt?1:0);
-			else
-			{
-				fail = true;
-				break;
-			}
-			++entry;
-		}
+inline int64_t JsonElement::GetInt64Value() const
+{
+	OVR_ASSERT( GetType() == JSON_Number );
+	OVR_ASSERT( GetNumber() >= -9007199254740992LL && GetNumber() <= 9007199254740992LL ); // 2^53 - if this hits, value is out of range
+	return (int64_t)GetNumber();
+}
 
-		// If we didn't fail, try to malloc the output string
-		if (!fail)
-			out=(char*)malloc(len);
-		// If that fails, we fail.
-		if (!out)
-			fail = true;
+inline float JsonElement::GetFloatValue() const
+{
+	OVR_ASSERT( GetType() == JSON_Number );
+	OVR_ASSERT( GetNumber() >= -FLT_MAX && GetNumber() <= FLT_MAX );  // too large to represent as a float
+	OVR_ASSERT( GetNumber() == 0 || GetNumber() <= -FLT_MIN || GetNumber() >= FLT_MIN );  // if the number is too small to be represented as a float
+	return (float)GetNumber();
+}
 
-		// Handle failure.
-		if (fail)
-		{
-			for (int i=0; i<numentries; i++)
-			{
-				if (entries[i])
-					free(entries[i]);
-			}
-			free(entries);
-			return 0;
-		}
+inline double JsonElement::GetDoubleValue() const
+{
+	OVR_ASSERT( GetType() == JSON_Number );
+	return GetNumber();
+}
 
-		// Compose the output array.
-		*out='[';
-		ptr=out+1;
-		*ptr='\0';
-		for (int i=0; i<numentries; i++)
-		{
-			OVR_strcpy(ptr, len - (ptr-out), entries[i]);
-			ptr+=OVR_strlen(entries[i]);
-			if (i!=numentries-1)
-			{
-				*ptr++=',';
-				if (fmt)
-					*ptr++=' ';
-				*ptr='\0';
-			}
-			free(entries[i]);
-		}
-		free(entries);
-		*ptr++=']';
-		*ptr++='\0';
-		return out;
+inline std::string JsonElement::GetStringValue() const
+{
+	OVR_ASSERT( GetType() == JSON_String || GetType() == JSON_Null ); // May be JSON_Null if the value od a string field was actually the word "null"
+	if ( Document != nullptr )
+	{
+		const JsonNode & node = Document->GetNode( Index );
+		// the JSON tree stores the text of bools and leaves null empty, do the same here
+		return std::string( Document->GetText( node.ValueOffset ), node.ValueLength );
 	}
-
-	friend class JsonReader;
-};
+	return Node != nullptr ? Node->GetStringValue() : std::string();
+}
 
 //-----------------------------------------------------------------------------
 // ***** JsonReader
@@ -1231,39 +2234,86 @@ class JsonReader
 {
 public:
 					JsonReader( const std::shared_ptr<JSON> json ) :
-						Parent( json )
+						Parent( json ),
+						ChildIndex( 0 )
+					{
+						if ( json )
+						{
+							Child = json->Children.begin();
+						}
+					}
+
+					JsonReader( std::vector< std::shared_ptr<JSON> >::iterator it ) : JsonReader( *it ) {}
+
+					JsonReader( const JsonElement & element ) :
+						Parent( element ),
+						ChildIndex( 0 )
 					{
-						if ( Parent )
+						if ( element.GetDocument() != nullptr )
+						{
+							ChildIndex = element.GetDocument()->GetNode( element.GetIndex() ).FirstChild;
+						}
+						else if ( element.GetTreeNode() )
 						{
-							Child = Parent->Children.begin();
+							Child = element.GetTreeNode()->Children.begin();
 						}
 					}
 
-					JsonReader( std::list< std::shared_ptr<JSON> >::iterator it ) : JsonReader( *it ) {}
+					JsonReader( const JsonDocument & document ) : JsonReader( document.GetRoot() ) {}
 
 
-	const std::shared_ptr<JSON> AsParent() const { return Parent; }
+	// Returns null when reading a JsonDocument.
+	const std::shared_ptr<JSON> AsParent() const { return Parent.GetTreeNode(); }
 
 
-	bool			IsValid() const { return Parent != nullptr; }
-	bool			IsObject() const { return Parent != nullptr && Parent->Type == JSON_Object; }
-	bool			IsArray() const { return Parent != nullptr && Parent->Type == JSON_Array; }
-	bool			IsEndOfArray() const { OVR_ASSERT( Parent != nullptr ); return ( Child == Parent->Children.end() ); }
+	bool			IsValid() const { return Parent.IsValid(); }
+	bool			IsObject() const { return Parent.GetType() == JSON_Object; }
+	bool			IsArray() const { return Parent.GetType() == JSON_Array; }
+	bool			IsEndOfArray() const
+	{
+		OVR_ASSERT( Parent.IsValid() );
+		if ( const JsonDocument * doc = Parent.GetDocument() )
+		{
+			return ( ChildIndex == GetEndIndex( doc ) );
+		}
+		return ( Child == Parent.GetTreeNode()->Children.end() );
+	}
 
-	std::list< std::shared_ptr<JSON> >::iterator GetFirstChild() const { return Parent->Children.begin(); }
-	std::list< std::shared_ptr<JSON> >::iterator GetNextChild( std::list< std::shared_ptr<JSON> >::iterator & child ) const
+	// Child iteration by list iterator is only available when reading a JSON tree.
+	std::vector< std::shared_ptr<JSON> >::iterator GetFirstChild() const { return Parent.GetTreeNode()->Children.begin(); }
+	std::vector< std::shared_ptr<JSON> >::iterator GetNextChild( std::vector< std::shared_ptr<JSON> >::iterator & child ) const
 	{
 		auto childClone = child;
 		++childClone;
 		return childClone;
 	}
 
-	const std::shared_ptr<JSON>	GetChildByName( const char * childName ) const
+	const JsonElement	GetChildByName( const char * childName ) const
 	{
 		assert( IsObject() );
 
+		if ( const JsonDocument * doc = Parent.GetDocument() )
+		{
+			const uint32_t end = GetEndIndex( doc );
+			// Check if the the cached child index is valid.
+			if ( ChildIndex < end && OVR_strcmp( doc->GetText( doc->GetNode( ChildIndex ).NameOffset ), childName ) == 0 )
+			{
+				return JsonElement( doc, ChildIndex++ );    // Cache the next child.
+			}
+			// Look the child up by name.
+			const int i = doc->FindChildByName( Parent.GetIndex(), childName );
+			if ( i >= 0 )
+			{
+				ChildIndex = static_cast< uint32_t >( i ) + 1;  // Cache the next child.
+				return JsonElement( doc, static_cast< uint32_t >( i ) );
+			}
+			return JsonElement();
+		}
+
+		const std::shared_ptr<JSON> & parent = Parent.GetTreeNode();
+
 		// Check if the the cached child pointer is valid.
-		if ( Child != Parent->Children.end() )
+		if ( Child != parent->Children.end() )
 		{
 			if ( OVR_strcmp( (*Child)->Name.c_str(), childName ) == 0 )
 			{
@@ -1272,96 +2322,110 @@ public:
 				return c;
 			}
 		}
-		// Itereate over all children.
-		for ( auto c = Parent->Children.begin(); c != Parent->Children.end(); ++c )
+		// Look the child up by name.
+		const int i = parent->GetItemIndexByName( childName );
+		if ( i >= 0 )
 		{
-			if ( OVR_strcmp( (*c)->Name.c_str(), childName ) == 0 )
-			{
-				Child = c;  // Cache the next child.
-				return *c;
-			}
+			Child = parent->Children.begin() + i + 1;  // Cache the next child.
+			return parent->Children[i];
 		}
-		return 0;
+		return JsonElement();
 	}
 	bool			GetChildBoolByName( const char * childName, const bool defaultValue = false ) const
 	{
-		const std::shared_ptr<JSON> c = GetChildByName( childName );
-		return ( c != nullptr ) ? c->GetBoolValue() : defaultValue;
+		const JsonElement c = GetChildByName( childName );
+		return ( c != nullptr ) ? c.GetBoolValue() : defaultValue;
 	}
 	int32_t			GetChildInt32ByName( const char * childName, const int32_t defaultValue = 0 ) const
 	{
-		const std::shared_ptr<JSON> c = GetChildByName( childName );
-		return ( c != nullptr ) ? c->GetInt32Value() : defaultValue;
+		const JsonElement c = GetChildByName( childName );
+		return ( c != nullptr ) ? c.GetInt32Value() : defaultValue;
 	}
 	int64_t			GetChildInt64ByName( const char * childName, const int64_t defaultValue = 0 ) const
 	{
-		const std::shared_ptr<JSON> c = GetChildByName( childName );
-		return ( c != nullptr ) ? c->GetInt64Value() : defaultValue;
+		const JsonElement c = GetChildByName( childName );
+		return ( c != nullptr ) ? c.GetInt64Value() : defaultValue;
 	}
 	float			GetChildFloatByName( const char * childName, const float defaultValue = 0.0f ) const
 	{
-		const std::shared_ptr<JSON> c = GetChildByName( childName );
-		return ( c != nullptr ) ? c->GetFloatValue() : defaultValue;
+		const JsonElement c = GetChildByName( childName );
+		return ( c != nullptr ) ? c.GetFloatValue() : defaultValue;
 	}
 	double			GetChildDoubleByName( const char * childName, const double defaultValue = 0.0 ) const
 	{
-		const std::shared_ptr<JSON> c = GetChildByName( childName );
-		return ( c != nullptr ) ? c->GetDoubleValue() : defaultValue;
+		const JsonElement c = GetChildByName( childName );
+		return ( c != nullptr ) ? c.GetDoubleValue() : defaultValue;
 	}
 	const std::string	GetChildStringByName( const char * childName, const std::string & defaultValue = std::string( "" ) ) const
 	{
-		const std::shared_ptr<JSON> c = GetChildByName( childName );
-		return std::string( ( c != nullptr && c->Type != JSON_Null ) ? c->GetStringValue() : defaultValue );
+		const JsonElement c = GetChildByName( childName );
+		return ( c != nullptr && c.GetType() != JSON_Null ) ? c.GetStringValue() : defaultValue;
 	}
 
-	const std::shared_ptr<JSON> GetNextArrayElement() const
+	const JsonElement GetNextArrayElement() const
 	{
 		assert( IsArray() );
 
+		if ( const JsonDocument * doc = Parent.GetDocument() )
+		{
+			if ( ChildIndex < GetEndIndex( doc ) )
+			{
+				return JsonElement( doc, ChildIndex++ );
+			}
+			return JsonElement();
+		}
+
 		// Check if the the cached child pointer is valid.
-		if ( Child != Parent->Children.end() )
+		if ( Child != Parent.GetTreeNode()->Children.end() )
 		{
 			const std::shared_ptr<JSON> c = *Child;
 			++Child;    // Cache the next child.
 			return c;
 		}
-		return nullptr;
+		return JsonElement();
 	}
 
 	bool            GetNextArrayBool( const bool defaultValue = false ) const
 	{
-		const std::shared_ptr<JSON> c = GetNextArrayElement();
-		return ( c != nullptr ) ? c->GetBoolValue() : defaultValue;
+		const JsonElement c = GetNextArrayElement();
+		return ( c != nullptr ) ? c.GetBoolValue() : defaultValue;
 	}
 	int32_t         GetNextArrayInt32( const int32_t defaultValue = 0 ) const
 	{
-		const std::shared_ptr<JSON> c = GetNextArrayElement();
-		return ( c != nullptr ) ? c->GetInt32Value() : defaultValue;
+		const JsonElement c = GetNextArrayElement();
+		return ( c != nullptr ) ? c.GetInt32Value() : defaultValue;
 	}
 	int64_t         GetNextArrayInt64( const int64_t defaultValue = 0 ) const
 	{
-		const std::shared_ptr<JSON> c = GetNextArrayElement();
-		return ( c != nullptr ) ? c->GetInt64Value() : defaultValue;
+		const JsonElement c = GetNextArrayElement();
+		return ( c != nullptr ) ? c.GetInt64Value() : defaultValue;
 	}
 	float           GetNextArrayFloat( const float defaultValue = 0.0f ) const
 	{
-		const std::shared_ptr<JSON> c = GetNextArrayElement();
-		return ( c != nullptr ) ? c->GetFloatValue() : defaultValue;
+		const JsonElement c = GetNextArrayElement();
+		return ( c != nullptr ) ? c.GetFloatValue() : defaultValue;
 	}
 	double          GetNextArrayDouble( const double defaultValue = 0.0 ) const
 	{
-		const std::shared_ptr<JSON> c = GetNextArrayElement();
-		return ( c != nullptr ) ? c->GetDoubleValue() : defaultValue;
+		const JsonElement c = GetNextArrayElement();
+		return ( c != nullptr ) ? c.GetDoubleValue() : defaultValue;
 	}
 	const std::string   GetNextArrayString( const std::string & defaultValue = std::string( "" ) ) const
 	{
-		const std::shared_ptr<JSON> c = GetNextArrayElement();
-		return std::string( ( c != nullptr ) ? c->GetStringValue() : defaultValue );
+		const JsonElement c = GetNextArrayElement();
+		return ( c != nullptr ) ? c.GetStringValue() : defaultValue;
 	}
 
 private:
-	std::shared_ptr<JSON>	Parent;
-	mutable std::list< std::shared_ptr<JSON> >::iterator Child;		// cached child pointer (iterator)
+	JsonElement		Parent;
+	mutable std::vector< std::shared_ptr<JSON> >::iterator Child;		// cached child pointer (iterator), when reading a JSON tree
+	mutable uint32_t	ChildIndex;		// cached child node index, when reading a JsonDocument
+
+	uint32_t		GetEndIndex( const JsonDocument * doc ) const
+	{
+		const JsonNode & parent = doc->GetNode( Parent.GetIndex() );
+		return parent.FirstChild + parent.NumChildren;
+	}
 };
 
 }
@@ -23,13 +23,16 @@ LOCAL_SRC_FILES		:= 	../../../Src/Appl.cpp \
 						../../../Src/OVR_UTF8Util.cpp \
 						../../../Src/OVR_Uri.cpp \
 						../../../Src/OVR_FileSys.cpp \
+						../../../Src/OVR_AsyncFileReader.cpp \
 						../../../Src/OVR_Stream.cpp \
 						../../../Src/OVR_MappedFile.cpp \
 						../../../Src/OVR_BinaryFile2.cpp \
 						../../../Src/OVR_Lexer2.cpp \
 						../../../Src/MessageQueue.cpp \
+						../../../Src/JobSystem.cpp \
 						../../../Src/Platform/Android/Android.cpp \
 						../../../Src/Misc/Log.c \
+						../../../Src/Misc/FileUtils.cpp \
 						../../../Src/Render/Egl.c \
 						../../../Src/Render/Framebuffer.c \
 						../../../Src/Render/GlSetup.cpp \
@@ -42,6 +45,8 @@ LOCAL_SRC_FILES		:= 	../../../Src/Appl.cpp \
 						../../../Src/Render/BitmapFont.cpp \
 						../../../Src/Render/DebugLines.cpp \
 						../../../Src/Render/TextureManager.cpp \
+						../../../Src/Render/TextureDecode.cpp \
+						../../../Src/Render/TextureTranscode.cpp \
 						../../../Src/Render/EaseFunctions.cpp \
 						../../../Src/Render/TextureAtlas.cpp \
 						../../../Src/Render/ParticleSystem.cpp	\
@@ -68,18 +73,21 @@ LOCAL_SRC_FILES		:= 	../../../Src/Appl.cpp \
  						../../../Src/GUI/VRMenuEvent.cpp \
  						../../../Src/GUI/VRMenuEventHandler.cpp \
  						../../../Src/GUI/Reflection.cpp \
+ 						../../../Src/GUI/ReflectionBinary.cpp \
  						../../../Src/GUI/AnimComponents.cpp \
  						../../../Src/GUI/Fader.cpp \
  						../../../Src/GUI/DefaultComponent.cpp \
  						../../../Src/GUI/ReflectionData.cpp \
  						../../../Src/GUI/ActionComponents.cpp \
  						../../../Src/GUI/MetaDataManager.cpp \
+ 						../../../Src/GUI/DirectoryScanner.cpp \
  						../../../Src/GUI/ProgressBarComponent.cpp \
  						../../../Src/GUI/ScrollBarComponent.cpp \
  						../../../Src/GUI/SwipeHintComponent.cpp \
  						../../../Src/GUI/TextFade_Component.cpp \
  						../../../Src/GUI/SliderComponent.cpp \
  						../../../Src/GUI/FolderBrowser.cpp \
+						../../../Src/GUI/ThumbnailCache.cpp \
  						../../../Src/GUI/GuiSys.cpp \
  						../../../Src/GUI/ScrollManager.cpp \
  						../../../Src/GUI/UI/UITexture.cpp \
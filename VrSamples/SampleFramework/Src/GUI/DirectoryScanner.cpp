@@ -0,0 +1,629 @@
+/************************************************************************************
+
+Filename    :   DirectoryScanner.cpp
+Content     :   Parallel recursive scan of media directories across search paths
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include "DirectoryScanner.h"
+
+#include "Misc/Log.h"
+#include "Misc/FileUtils.h"
+#include "Misc/Hash.h"
+#include "OVR_Std.h"
+
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#if defined( __linux__ )
+#include <sys/syscall.h>
+#endif
+
+namespace OVRFW {
+
+static const uint32_t	DIRECTORY_INDEX_MAGIC	= 0x31584944;	// "DIX1"
+static const uint32_t	DIRECTORY_INDEX_VERSION	= 1;
+
+struct ovrDirectoryIndexHeader
+{
+	uint32_t	Magic;
+	uint32_t	Version;
+	uint32_t	NumListings;
+};
+
+// followed by PathLength bytes of path, then NumNames names, each a uint16_t length and its bytes
+struct ovrListingRecord
+{
+	int64_t		ModTimeSec;
+	int64_t		ModTimeNsec;
+	uint32_t	PathLength;
+	uint32_t	NumNames;
+};
+
+static inline char LowerAscii( char const c )
+{
+	return ( c >= 'A' && c <= 'Z' ) ? static_cast< char >( c - 'A' + 'a' ) : c;
+}
+
+//==============================
+// ovrFileExtensionFilter::ovrFileExtensionFilter
+ovrFileExtensionFilter::ovrFileExtensionFilter( std::vector< std::string > const & goodExtensions, std::vector< std::string > const & badExtensions )
+{
+	auto add = [this]( std::vector< std::string > const & extensions, bool const good )
+	{
+		for ( std::string const & ext : extensions )
+		{
+			ovrExtension e;
+			e.Lower = ext;
+			std::transform( e.Lower.begin(), e.Lower.end(), e.Lower.begin(), LowerAscii );
+			e.Good = good;
+			Extensions.insert( std::make_pair( FNV1a64( e.Lower.c_str(), e.Lower.length() ), e ) );
+			if ( std::find( Lengths.begin(), Lengths.end(), e.Lower.length() ) == Lengths.end() )
+			{
+				Lengths.push_back( e.Lower.length() );
+			}
+		}
+	};
+	add( badExtensions, false );
+	add( goodExtensions, true );
+	std::sort( Lengths.begin(), Lengths.end() );
+}
+
+//==============================
+// ovrFileExtensionFilter::ShouldAdd
+bool ovrFileExtensionFilter::ShouldAdd( char const * path, size_t const pathLen ) const
+{
+	bool good = false;
+	for ( size_t const len : Lengths )
+	{
+		if ( pathLen <= len )
+		{
+			break;
+		}
+		char const * suffix = path + pathLen - len;
+		auto range = Extensions.equal_range( FNV1a64Lower( suffix, len ) );
+		for ( auto it = range.first; it != range.second; ++it )
+		{
+			ovrExtension const & ext = it->second;
+			if ( ext.Lower.length() != len || OVR::OVR_strnicmp( suffix, ext.Lower.c_str(), len ) != 0 )
+			{
+				continue;
+			}
+			if ( !ext.Good )
+			{
+				return false;
+			}
+			good = true;
+		}
+	}
+	return good;
+}
+
+//==============================
+// ovrDirectoryIndex::Load
+bool ovrDirectoryIndex::Load( char const * fileName )
+{
+	Listings.clear();
+
+	std::vector< uint8_t > buffer;
+	if ( !ReadWholeFile( fileName, buffer ) )
+	{
+		return false;
+	}
+
+	size_t offset = 0;
+	auto read = [&buffer, &offset]( void * out, size_t const size ) -> bool
+	{
+		if ( buffer.size() - offset < size )
+		{
+			return false;
+		}
+		memcpy( out, buffer.data() + offset, size );
+		offset += size;
+		return true;
+	};
+
+	ovrDirectoryIndexHeader header;
+	if ( !read( &header, sizeof( header ) ) || header.Magic != DIRECTORY_INDEX_MAGIC || header.Version != DIRECTORY_INDEX_VERSION )
+	{
+		return false;
+	}
+	Listings.reserve( header.NumListings );
+	for ( uint32_t i = 0; i < header.NumListings; i++ )
+	{
+		ovrListingRecord record;
+		std::string path;
+		ovrListing listing;
+		bool ok = read( &record, sizeof( record ) ) && record.PathLength <= buffer.size() - offset;
+		if ( ok )
+		{
+			path.assign( reinterpret_cast< char const * >( buffer.data() + offset ), record.PathLength );
+			offset += record.PathLength;
+			listing.ModTimeSec = record.ModTimeSec;
+			listing.ModTimeNsec = record.ModTimeNsec;
+			listing.Names.resize( std::min< size_t >( record.NumNames, buffer.size() - offset ) );
+			for ( std::string & name : listing.Names )
+			{
+				uint16_t length;
+				ok = read( &length, sizeof( length ) ) && length <= buffer.size() - offset && length > 0;
+				if ( !ok )
+				{
+					break;
+				}
+				name.assign( reinterpret_cast< char const * >( buffer.data() + offset ), length );
+				offset += length;
+			}
+			ok = ok && listing.Names.size() == record.NumNames;
+		}
+		if ( !ok )
+		{
+			ALOGW( "ovrDirectoryIndex: %s is corrupt", fileName );
+			Listings.clear();
+			return false;
+		}
+		Listings[path] = std::move( listing );
+	}
+	return true;
+}
+
+//==============================
+// ovrDirectoryIndex::Save
+bool ovrDirectoryIndex::Save( char const * fileName ) const
+{
+	std::vector< uint8_t > buffer;
+	auto write = [&buffer]( void const * data, size_t const size )
+	{
+		uint8_t const * bytes = static_cast< uint8_t const * >( data );
+		buffer.insert( buffer.end(), bytes, bytes + size );
+	};
+
+	ovrDirectoryIndexHeader header;
+	header.Magic = DIRECTORY_INDEX_MAGIC;
+	header.Version = DIRECTORY_INDEX_VERSION;
+	header.NumListings = static_cast< uint32_t >( Listings.size() );
+	write( &header, sizeof( header ) );
+	for ( auto const & it : Listings )
+	{
+		ovrListingRecord record;
+		record.ModTimeSec = it.second.ModTimeSec;
+		record.ModTimeNsec = it.second.ModTimeNsec;
+		record.PathLength = static_cast< uint32_t >( it.first.length() );
+		record.NumNames = static_cast< uint32_t >( it.second.Names.size() );
+		write( &record, sizeof( record ) );
+		write( it.first.data(), it.first.length() );
+		for ( std::string const & name : it.second.Names )
+		{
+			uint16_t const length = static_cast< uint16_t >( name.length() );
+			write( &length, sizeof( length ) );
+			write( name.data(), length );
+		}
+	}
+
+	// a reader never sees a partial index, and two scans saving at once each write a whole one
+	if ( !WriteFileAtomically( fileName, buffer ) )
+	{
+		ALOGW( "ovrDirectoryIndex: failed to write %s", fileName );
+		return false;
+	}
+	return true;
+}
+
+//==============================
+// ovrDirectoryIndex::Find
+ovrDirectoryIndex::ovrListing const * ovrDirectoryIndex::Find( std::string const & path, int64_t const modTimeSec, int64_t const modTimeNsec ) const
+{
+	auto it = Listings.find( path );
+	if ( it == Listings.end() || it->second.ModTimeSec != modTimeSec || it->second.ModTimeNsec != modTimeNsec )
+	{
+		return nullptr;
+	}
+	return &it->second;
+}
+
+//==============================
+// ovrDirectoryIndex::Add
+void ovrDirectoryIndex::Add( std::string const & path, ovrListing && listing )
+{
+	Listings[path] = std::move( listing );
+}
+
+// Calls onEntry( name, nameLength, isDirectory ) for each regular file and
+// directory that does not start with a '.'.
+template< typename OnEntry >
+static void ReportEntry( int const dirFd, char const * name, unsigned char type, OnEntry & onEntry )
+{
+	if ( name[0] == '.' )
+	{
+		return;
+	}
+	if ( type == DT_UNKNOWN )
+	{
+		// not all file systems fill in the type
+		struct stat st;
+		if ( fstatat( dirFd, name, &st, AT_SYMLINK_NOFOLLOW ) != 0 )
+		{
+			return;
+		}
+		type = S_ISDIR( st.st_mode ) ? DT_DIR : ( S_ISREG( st.st_mode ) ? DT_REG : DT_UNKNOWN );
+	}
+	if ( type == DT_DIR || type == DT_REG )
+	{
+		onEntry( name, strlen( name ), type == DT_DIR );
+	}
+}
+
+#if defined( __linux__ )
+// The record getdents64 fills in. Bionic and glibc don't declare it.
+struct ovrLinuxDirent64
+{
+	uint64_t		Ino;
+	int64_t			Off;
+	unsigned short	RecLen;
+	unsigned char	Type;
+	char			Name[1];
+};
+#endif
+
+template< typename OnEntry >
+static void ReadDirectoryEntries( int const dirFd, OnEntry onEntry )
+{
+#if defined( __linux__ )
+	// one system call fills the buffer with as many entries as fit, where readdir
+	// copies them out one at a time
+	alignas( 8 ) char buffer[16 * 1024];
+	for ( ; ; )
+	{
+		long const bytes = syscall( SYS_getdents64, dirFd, buffer, sizeof( buffer ) );
+		if ( bytes <= 0 )
+		{
+			break;
+		}
+		for ( long offset = 0; offset < bytes; )
+		{
+			ovrLinuxDirent64 const * entry = reinterpret_cast< ovrLinuxDirent64 const * >( buffer + offset );
+			offset += entry->RecLen;
+			ReportEntry( dirFd, entry->Name, entry->Type, onEntry );
+		}
+	}
+#else
+	// fdopendir takes ownership of the descriptor
+	int const fd = dup( dirFd );
+	DIR * dir = fdopendir( fd );
+	if ( dir == NULL )
+	{
+		close( fd );
+		return;
+	}
+	struct dirent * entry;
+	while ( ( entry = readdir( dir ) ) != NULL )
+	{
+		ReportEntry( dirFd, entry->d_name, entry->d_type, onEntry );
+	}
+	closedir( dir );
+#endif
+}
+
+//==============================
+// ovrDirectoryScanner::ovrDirectoryScanner
+ovrDirectoryScanner::ovrDirectoryScanner( std::vector< std::string > const & searchPaths,
+		std::vector< std::string > const & goodExtensions, std::vector< std::string > const & badExtensions )
+	: Filter( goodExtensions, badExtensions )
+	, SearchPaths( searchPaths )
+	, Started( false )
+	, ScanStartTime( 0 )
+	, Cancelled( false )
+{
+	for ( std::string const & searchPath : SearchPaths )
+	{
+		SearchPathFds.push_back( open( searchPath.empty() ? "." : searchPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC ) );
+	}
+}
+
+//==============================
+// ovrDirectoryScanner::~ovrDirectoryScanner
+ovrDirectoryScanner::~ovrDirectoryScanner()
+{
+	std::vector< ovrJobHandle > jobs;
+	{
+		std::lock_guard< std::mutex > lock( Mutex );
+		Cancelled = true;
+		jobs.swap( Jobs );
+	}
+	// jobs that have not started return as soon as they see Cancelled
+	if ( !jobs.empty() )
+	{
+		ovrJobSystem::GetShared().Wait( jobs.data(), static_cast< int >( jobs.size() ) );
+	}
+
+	for ( int const fd : SearchPathFds )
+	{
+		if ( fd >= 0 )
+		{
+			close( fd );
+		}
+	}
+}
+
+//==============================
+// ovrDirectoryScanner::SetIndexFile
+void ovrDirectoryScanner::SetIndexFile( char const * fileName )
+{
+	assert( !Started );
+	IndexFile = fileName;
+}
+
+//==============================
+// ovrDirectoryScanner::Start
+void ovrDirectoryScanner::Start( char const * relativePath )
+{
+	assert( !Started );
+	Started = true;
+
+	if ( !IndexFile.empty() )
+	{
+		OldIndex.Load( IndexFile.c_str() );
+		ScanStartTime = static_cast< int64_t >( time( nullptr ) );
+	}
+
+	ovrPending root;
+	root.RelativePath = relativePath;
+	root.Job = SubmitScan( root.RelativePath );
+	Order.push_back( root );
+}
+
+//==============================
+// ovrDirectoryScanner::SubmitScan
+ovrJobHandle ovrDirectoryScanner::SubmitScan( std::string const & relativePath )
+{
+	std::lock_guard< std::mutex > lock( Mutex );
+	if ( Cancelled )
+	{
+		return ovrJobHandle();
+	}
+	ovrJobHandle const job = ovrJobSystem::GetShared().Submit( JOB_PRIORITY_BACKGROUND,
+			[this, relativePath]() { ScanDirectory( relativePath ); } );
+	Jobs.push_back( job );
+	return job;
+}
+
+//==============================
+// ovrDirectoryScanner::ScanDirectory
+void ovrDirectoryScanner::ScanDirectory( std::string const & relativePath )
+{
+	{
+		std::lock_guard< std::mutex > lock( Mutex );
+		if ( Cancelled )
+		{
+			return;
+		}
+	}
+
+	struct ovrEntry
+	{
+		std::string	Name;			// directories end in a slash, which is part of their sort order
+		int			SearchPath;
+	};
+	std::vector< ovrEntry > entries;
+	std::unordered_set< std::string > lowerNames;
+	std::string lower;
+	int searchPath = 0;
+	auto addEntry = [&]( char const * name, size_t const len, bool const isDir )
+	{
+		if ( !isDir && !Filter.ShouldAdd( name, len ) )
+		{
+			return;
+		}
+		lower.assign( name, len );
+		std::transform( lower.begin(), lower.end(), lower.begin(), LowerAscii );
+		if ( !lowerNames.insert( lower ).second )
+		{
+			return;	// already found in an earlier search path
+		}
+		ovrEntry entry;
+		entry.Name.assign( name, len );
+		if ( isDir )
+		{
+			entry.Name += '/';
+		}
+		entry.SearchPath = searchPath;
+		entries.push_back( std::move( entry ) );
+	};
+
+	bool const useIndex = !IndexFile.empty();
+	char const * dirName = relativePath.empty() ? "." : relativePath.c_str();
+	for ( searchPath = 0; searchPath < static_cast< int >( SearchPathFds.size() ); searchPath++ )
+	{
+		int const searchPathFd = SearchPathFds[searchPath];
+		if ( searchPathFd < 0 )
+		{
+			continue;
+		}
+
+		if ( !useIndex )
+		{
+			int const dirFd = openat( searchPathFd, dirName, O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+			if ( dirFd >= 0 )
+			{
+				ReadDirectoryEntries( dirFd, addEntry );
+				close( dirFd );
+			}
+			continue;
+		}
+
+		// The time is read before the entries, so a change made while they are read
+		// gives the directory a newer time than the one recorded, and it is read again next scan.
+		struct stat st;
+		if ( fstatat( searchPathFd, dirName, &st, 0 ) != 0 || !S_ISDIR( st.st_mode ) )
+		{
+			continue;
+		}
+		std::string const fullPath = SearchPaths[searchPath] + relativePath;
+		int64_t const modTimeSec = static_cast< int64_t >( st.st_mtim.tv_sec );
+		int64_t const modTimeNsec = static_cast< int64_t >( st.st_mtim.tv_nsec );
+
+		ovrDirectoryIndex::ovrListing listing;
+		// Overlapping search paths, such as a folder and one of its subfolders, make two jobs
+		// visit the same directory, so the cached listing is copied and OldIndex stays read only.
+		if ( ovrDirectoryIndex::ovrListing const * cached = OldIndex.Find( fullPath, modTimeSec, modTimeNsec ) )
+		{
+			listing = *cached;
+			for ( std::string const & name : listing.Names )
+			{
+				bool const isDir = name.back() == '/';
+				addEntry( name.c_str(), isDir ? name.length() - 1 : name.length(), isDir );
+			}
+		}
+		else
+		{
+			int const dirFd = openat( searchPathFd, dirName, O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+			if ( dirFd < 0 )
+			{
+				continue;
+			}
+			listing.ModTimeSec = modTimeSec;
+			listing.ModTimeNsec = modTimeNsec;
+			ReadDirectoryEntries( dirFd, [&]( char const * name, size_t const len, bool const isDir )
+			{
+				listing.Names.push_back( std::string( name, len ) );
+				if ( isDir )
+				{
+					listing.Names.back() += '/';
+				}
+				addEntry( name, len, isDir );
+			} );
+			close( dirFd );
+		}
+
+		// On file systems with coarse times a directory can change again within the same
+		// time stamp, so one changed around the start of the scan is read again next scan.
+		if ( modTimeSec < ScanStartTime - 2 )
+		{
+			std::lock_guard< std::mutex > lock( Mutex );
+			NewIndex.Add( fullPath, std::move( listing ) );
+		}
+	}
+
+	std::sort( entries.begin(), entries.end(), []( ovrEntry const & a, ovrEntry const & b ) { return a.Name < b.Name; } );
+
+	ovrResult result;
+	result.Dir.RelativePath = relativePath;
+	for ( ovrEntry const & entry : entries )
+	{
+		std::string path = relativePath + entry.Name;
+		if ( entry.Name.back() == '/' )
+		{
+			result.Dir.SubDirs.push_back( path );
+		}
+		else
+		{
+			result.Dir.FullPaths.push_back( SearchPaths[entry.SearchPath] + path );
+			result.Dir.Files.push_back( std::move( path ) );
+		}
+	}
+
+	// Queue the subdirectories before publishing this one, so the consumer always has their jobs.
+	// A worker runs its own jobs last in first out, so queuing them in reverse reads the tree
+	// in about the order the consumer takes it, and other workers steal the last directories.
+	result.SubDirJobs.resize( result.Dir.SubDirs.size() );
+	for ( int i = static_cast< int >( result.Dir.SubDirs.size() ) - 1; i >= 0; i-- )
+	{
+		result.SubDirJobs[i] = SubmitScan( result.Dir.SubDirs[i] );
+	}
+
+	std::lock_guard< std::mutex > lock( Mutex );
+	Results[relativePath] = std::move( result );
+}
+
+//==============================
+// ovrDirectoryScanner::TakeResult
+bool ovrDirectoryScanner::TakeResult( ovrScannedDirectory & dir )
+{
+	if ( Order.empty() )
+	{
+		return false;
+	}
+
+	ovrResult result;
+	{
+		std::lock_guard< std::mutex > lock( Mutex );
+		auto it = Results.find( Order.back().RelativePath );
+		if ( it == Results.end() )
+		{
+			return false;
+		}
+		result = std::move( it->second );
+		Results.erase( it );
+	}
+
+	// depth first: the subdirectories come next, the first one at the back
+	Order.pop_back();
+	for ( int i = static_cast< int >( result.Dir.SubDirs.size() ) - 1; i >= 0; i-- )
+	{
+		ovrPending pending;
+		pending.RelativePath = result.Dir.SubDirs[i];
+		pending.Job = result.SubDirJobs[i];
+		Order.push_back( pending );
+	}
+	dir = std::move( result.Dir );
+
+	if ( Order.empty() && !IndexFile.empty() )
+	{
+		// Every directory has been read. The save job owns the index, so it can outlive the
+		// scanner, and the caller doesn't wait on the write.
+		std::shared_ptr< ovrDirectoryIndex > index = std::make_shared< ovrDirectoryIndex >();
+		{
+			std::lock_guard< std::mutex > lock( Mutex );
+			std::swap( *index, NewIndex );
+		}
+		std::string const fileName = IndexFile;
+		ovrJobSystem::GetShared().Submit( JOB_PRIORITY_BACKGROUND, [index, fileName]()
+		{
+			index->Save( fileName.c_str() );
+		} );
+	}
+	return true;
+}
+
+//==============================
+// ovrDirectoryScanner::NextDirectory
+bool ovrDirectoryScanner::NextDirectory( ovrScannedDirectory & dir )
+{
+	return TakeResult( dir );
+}
+
+//==============================
+// ovrDirectoryScanner::WaitNextDirectory
+bool ovrDirectoryScanner::WaitNextDirectory( ovrScannedDirectory & dir )
+{
+	while ( !Order.empty() )
+	{
+		// a job publishes its result before it is done, so test this first
+		bool const done = Order.back().Job.IsDone();
+		if ( TakeResult( dir ) )
+		{
+			return true;
+		}
+		if ( done )
+		{
+			// only happens if the job was never submitted
+			ALOGW( "ovrDirectoryScanner: no result for '%s'", Order.back().RelativePath.c_str() );
+			Order.pop_back();
+			continue;
+		}
+		ovrJobSystem::GetShared().Wait( Order.back().Job );
+	}
+	return false;
+}
+
+}	// namespace OVRFW
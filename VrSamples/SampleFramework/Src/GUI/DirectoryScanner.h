@@ -0,0 +1,182 @@
+/************************************************************************************
+
+Filename    :   DirectoryScanner.h
+Content     :   Parallel recursive scan of media directories across search paths
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+#include "JobSystem.h"
+
+namespace OVRFW {
+
+//==============================================================
+// ovrFileExtensionFilter
+//
+// Case-insensitive suffix test against lists of good and bad extensions, with
+// the same result as OvrMetaData::ShouldAddFile. The lowercased extensions are
+// hashed once, grouped by length, so testing a name costs one hash per distinct
+// extension length rather than a string compare per extension.
+//==============================================================
+class ovrFileExtensionFilter
+{
+public:
+	ovrFileExtensionFilter( std::vector< std::string > const & goodExtensions, std::vector< std::string > const & badExtensions );
+
+	// False if the path ends in a bad extension, otherwise true if it ends in a good one.
+	bool	ShouldAdd( char const * path, size_t const pathLen ) const;
+
+private:
+	struct ovrExtension
+	{
+		std::string	Lower;
+		bool		Good;
+	};
+
+	std::vector< size_t >	Lengths;	// distinct extension lengths, shortest first
+	std::unordered_multimap< uint64_t, ovrExtension >	Extensions;	// keyed by hash of the lowercased extension
+};
+
+//==============================================================
+// ovrDirectoryIndex
+//
+// Directory listings from an earlier scan, each with the modification time its
+// directory had when it was read. Adding, removing or renaming an entry updates
+// the time of the directory it is in, so a directory whose time has not changed
+// can be listed from the index instead of being read again.
+//
+// The index is saved to a temporary file that is then renamed over the old one,
+// so an interrupted save leaves the previous index intact.
+//==============================================================
+class ovrDirectoryIndex
+{
+public:
+	struct ovrListing
+	{
+		ovrListing() : ModTimeSec( 0 ), ModTimeNsec( 0 ) {}
+
+		int64_t						ModTimeSec;
+		int64_t						ModTimeNsec;
+		std::vector< std::string >	Names;		// directories end in a slash
+	};
+
+	// Returns false and leaves the index empty if the file is missing or not a valid index.
+	bool			Load( char const * fileName );
+	bool			Save( char const * fileName ) const;
+
+	// Returns the listing of the full directory path if it was read at the given modification time.
+	ovrListing const *	Find( std::string const & path, int64_t const modTimeSec, int64_t const modTimeNsec ) const;
+	void			Add( std::string const & path, ovrListing && listing );
+	int				GetNumListings() const { return static_cast< int >( Listings.size() ); }
+
+private:
+	std::unordered_map< std::string, ovrListing >	Listings;
+};
+
+//==============================================================
+// ovrScannedDirectory
+//==============================================================
+struct ovrScannedDirectory
+{
+	std::string					RelativePath;	// as passed to the scanner for the root, otherwise with a trailing slash
+	std::vector< std::string >	Files;			// relative paths of the files that passed the filter, sorted
+	std::vector< std::string >	FullPaths;		// full path of each file
+	std::vector< std::string >	SubDirs;		// relative paths with a trailing slash, sorted
+};
+
+//==============================================================
+// ovrDirectoryScanner
+//
+// Lists a directory tree that may be spread over several search paths, with
+// one job per directory on the shared job system, so directories are read in
+// parallel and a directory's subdirectories are queued as soon as it has been
+// read. Each job reads its directory in every search path, relative to a
+// descriptor opened once per search path, and on Linux reads entries in bulk
+// with getdents64 instead of one readdir call per entry.
+//
+// Entries that start with a '.' are skipped, only regular files and directories
+// are listed, and names are unique without regard to case. A name found in more than one search path is taken from the
+// first one, which is where GetFullPath would have found it.
+//
+// Directories can be taken as soon as they have been read, in the same order
+// as a serial depth-first scan that visits names in sorted order would produce
+// them, so a caller can show the first folders while the rest are still being
+// read and still end up with the same folder order.
+//
+// With an index file, directories that have not changed since the last scan are
+// listed from the index, which costs a stat instead of reading the directory.
+// The index is rewritten in the background once the last directory is taken.
+//==============================================================
+class ovrDirectoryScanner
+{
+public:
+							ovrDirectoryScanner( std::vector< std::string > const & searchPaths,
+									std::vector< std::string > const & goodExtensions,
+									std::vector< std::string > const & badExtensions );
+	// Stops queuing directories and waits for the jobs that were already submitted.
+							~ovrDirectoryScanner();
+
+	// Loads the index of the last scan from fileName, and saves the index of this one there.
+	// Call before Start.
+	void					SetIndexFile( char const * fileName );
+	// Starts scanning relativePath, which should be empty or end in a slash. Only call once.
+	void					Start( char const * relativePath );
+
+	// The methods below should only be called by the thread that called Start.
+
+	// Returns the next directory in order if it has been read.
+	bool					NextDirectory( ovrScannedDirectory & dir );
+	// Returns the next directory in order, running scan jobs until it has been read.
+	// Returns false once all directories have been returned.
+	bool					WaitNextDirectory( ovrScannedDirectory & dir );
+	// True once all directories have been returned.
+	bool					IsComplete() const { return Started && Order.empty(); }
+
+private:
+	struct ovrPending
+	{
+		std::string		RelativePath;
+		ovrJobHandle	Job;
+	};
+
+	struct ovrResult
+	{
+		ovrScannedDirectory			Dir;
+		std::vector< ovrJobHandle >	SubDirJobs;	// one per entry of Dir.SubDirs
+	};
+
+	ovrFileExtensionFilter	Filter;
+	std::vector< std::string >	SearchPaths;
+	std::vector< int >		SearchPathFds;	// -1 for search paths that could not be opened
+	bool					Started;
+	std::vector< ovrPending >	Order;		// directories still to return, the next one at the back
+	std::string				IndexFile;
+	ovrDirectoryIndex		OldIndex;		// only read once the scan has started
+	int64_t					ScanStartTime;
+
+	std::mutex				Mutex;			// guards everything below
+	bool					Cancelled;
+	std::unordered_map< std::string, ovrResult >	Results;	// read but not yet returned, by relative path
+	std::vector< ovrJobHandle >	Jobs;		// every job submitted, for the destructor
+	ovrDirectoryIndex		NewIndex;
+
+	// not copyable
+							ovrDirectoryScanner( ovrDirectoryScanner const & ) = delete;
+	ovrDirectoryScanner &	operator=( ovrDirectoryScanner const & ) = delete;
+
+	// Submits a job to read relativePath. Returns an invalid handle once cancelled.
+	ovrJobHandle			SubmitScan( std::string const & relativePath );
+	void					ScanDirectory( std::string const & relativePath );
+	bool					TakeResult( ovrScannedDirectory & dir );
+};
+
+}	// namespace OVRFW
@@ -13,6 +13,8 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #include "FolderBrowser.h"
 
 #include <stdio.h>
+#include <float.h>
+#include <algorithm>
 
 #include "VRMenuMgr.h"
 #include "GuiSys.h"
@@ -31,6 +33,7 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 
 #include "PackageFiles.h"
 #include "OVR_FileSys.h"
+#include "Render/TextureDecode.h"
 
 using OVR::Matrix4f;
 using OVR::Vector2f;
@@ -41,13 +44,6 @@ using OVR::Quatf;
 using OVR::Posef;
 
 
-// Returns true if head equals check plus zero or more characters.
-inline bool MatchesHead( const char * head, const char * check )
-{
-	const int l = static_cast<int>( OVR::OVR_strlen( head ) );
-	return 0 == OVR::OVR_strncmp( head, check, l );
-}
-
 namespace OVRFW {
 
 const float OvrFolderBrowser::CONTROLER_COOL_DOWN = 0.2f; // Controller goes to rest very frequently so cool down helps
@@ -304,7 +300,7 @@ private:
 				{
 					ALOG( "Hiding %s - unloading thumbs", folder->CategoryTag.c_str() );
 					folder->Visible = false;
-					folder->UnloadThumbnails( guiSys, FolderBrowser.GetDefaultThumbnailTextureId(), FolderBrowser.GetThumbWidth(), FolderBrowser.GetThumbHeight() );
+					FolderBrowser.UnloadFolderThumbnails( guiSys, *folder );
 				}
 
 				flags |= VRMenuObjectFlags_t( VRMENUOBJECT_DONT_RENDER ) | VRMENUOBJECT_DONT_HIT_ALL;
@@ -722,7 +718,7 @@ private:
 				if ( panel->Visible )
 				{
 					panel->Visible = false;
-					panel->LoadDefaultThumbnail( guiSys, FolderBrowser.GetDefaultThumbnailTextureId(), FolderBrowser.GetThumbWidth(), FolderBrowser.GetThumbHeight() );
+					FolderBrowser.UnloadPanelThumbnail( guiSys, *panel );
 				}
 			}
 			panelObject->SetFlags( flags );
@@ -805,7 +801,9 @@ OvrFolderBrowser::OvrFolderBrowser(
 	, NoMedia( false )
 	, AllowPanelTouchUp( false )
 	, TextureCommands( 10000 )
-	, BackgroundCommands( 10000 )
+	, NumThumbnailJobs( 0 )
+	, ThumbnailState( THUMBNAIL_PAUSE )
+	, ThumbnailResults( 1024 )
 	, ControllerDirectionLock( NO_LOCK )
 	, LastControllerInputTimeStamp( 0.0f )
 	, IsTouchDownPosistionTracked( false )
@@ -865,8 +863,6 @@ OvrFolderBrowser::OvrFolderBrowser(
 		}
 	}
 
-	ThumbnailLoadingThread = std::thread( &OvrFolderBrowser::ThumbnailThread, this );
-
 	PanelWidth = panelWidth * VRMenuObject::DEFAULT_TEXEL_SCALE;
 	PanelHeight = panelHeight * VRMenuObject::DEFAULT_TEXEL_SCALE;
 	Radius = radius_;
@@ -888,17 +884,21 @@ VRMenuComponent* OvrFolderBrowser::CreateFolderBrowserSwipeComponent( OvrFolderB
 OvrFolderBrowser::~OvrFolderBrowser()
 {
 	ALOG( "OvrFolderBrowser::~OvrFolderBrowser" );
-	// Wake up thumbnail thread if needed and shut it down
-	ThumbnailThreadState.store( THUMBNAIL_THREAD_SHUTDOWN );
-	ThumbnailThreadCondition.notify_all();
-
-	ALOG( "OvrFolderBrowser::~OvrFolderBrowser - shutting down msg queue ..." );
-	BackgroundCommands.Shutdown();
+	// Drop the thumbnail requests and wait for the loads in flight
+	std::vector< ovrJobHandle > thumbnailJobs;
+	{
+		std::lock_guard< std::mutex > lk( ThumbnailMutex );
+		ThumbnailState = THUMBNAIL_SHUTDOWN;
+		ThumbnailRequests.clear();
+		thumbnailJobs.swap( ThumbnailJobs );
+	}
+	ALOG( "OvrFolderBrowser::~OvrFolderBrowser - waiting for thumbnail jobs ..." );
+	ovrJobSystem::GetShared().Wait( thumbnailJobs.data(), static_cast< int >( thumbnailJobs.size() ) );
 
-	if ( ThumbnailLoadingThread.joinable() )
+	ovrThumbnailResult result;
+	while ( ThumbnailResults.TryPop( result ) )
 	{
-		ALOG( "OvrFolderBrowser::~OvrFolderBrowser - joining ThumbnailLoadingThread ..." );
-		ThumbnailLoadingThread.join();
+		free( result.Data );
 	}
 
 	for ( FolderView * folder : Folders )
@@ -909,6 +909,7 @@ OvrFolderBrowser::~OvrFolderBrowser()
 			delete folder;
 		}
 	}
+	ThumbnailAtlas.Close();
 
 	if ( ThumbPanelBG != NULL )
 	{
@@ -928,6 +929,18 @@ OvrFolderBrowser::~OvrFolderBrowser()
 void OvrFolderBrowser::Frame_Impl( OvrGuiSys & guiSys, ovrApplFrameIn const & vrFrame )
 {
 	// Check for thumbnail loads
+	ovrThumbnailResult result;
+	while ( ThumbnailResults.TryPop( result ) )
+	{
+		if ( result.TileIndex >= 0 )
+		{
+			LoadThumbnailTileToTexture( guiSys, result.FolderIndex, result.PanelId, result.TileIndex, result.Tile );
+		}
+		else
+		{
+			LoadThumbnailToTexture( guiSys, result.FolderIndex, result.PanelId, result.Data, result.Width, result.Height );
+		}
+	}
 	while ( 1 )
 	{
 		const char * cmd = TextureCommands.GetNextMessage();
@@ -941,6 +954,9 @@ void OvrFolderBrowser::Frame_Impl( OvrGuiSys & guiSys, ovrApplFrameIn const & vr
 		free( ( void * )cmd );
 	}
 
+	// Cancel requests for panels that went out of view and reorder the rest
+	UpdateThumbnailRequests( guiSys );
+
 	// --
 	// Logic for restricted scrolling
 	unsigned int controllerInput = vrFrame.AllButtons;
@@ -1013,14 +1029,18 @@ void OvrFolderBrowser::Open_Impl( OvrGuiSys & guiSys )
 	// Rebuild favorites if not empty
 	OnBrowserOpen( guiSys );
 
-	// Wake up thumbnail thread
-	ThumbnailThreadState.store( THUMBNAIL_THREAD_WORK );
-	ThumbnailThreadCondition.notify_all();
+	// Resume thumbnail loading
+	ResumeThumbnailJobs();
 }
 
 void OvrFolderBrowser::Close_Impl( OvrGuiSys & guiSys )
 {
-	ThumbnailThreadState.store( THUMBNAIL_THREAD_PAUSE );
+	// Jobs finish the thumbnail they are loading and stop
+	std::lock_guard< std::mutex > lk( ThumbnailMutex );
+	if ( ThumbnailState == THUMBNAIL_WORK )
+	{
+		ThumbnailState = THUMBNAIL_PAUSE;
+	}
 }
 
 void OvrFolderBrowser::OneTimeInit( OvrGuiSys & guiSys )
@@ -1029,6 +1049,10 @@ void OvrFolderBrowser::OneTimeInit( OvrGuiSys & guiSys )
 	const ovrJava & java = *reinterpret_cast< const ovrJava* >( guiSys.GetContext()->ContextForVrApi() );
 	ovrFileSys::GetPathIfValidPermission( java, EST_PRIMARY_EXTERNAL_STORAGE, EFT_CACHE, "", permissionFlags_t( PERMISSION_WRITE ), AppCachePath );
 	assert( !AppCachePath.empty() );
+	if ( !ThumbnailAtlas.Open( ( AppCachePath + "thumbcache_" ).c_str(), ThumbWidth, ThumbHeight, MAX_THUMBNAIL_CACHE_PAGES ) )
+	{
+		ALOGW( "OvrFolderBrowser::OneTimeInit - thumbnail cache disabled" );
+	}
 
 	ovrFileSys::PushBackSearchPathIfValid( java, EST_SECONDARY_EXTERNAL_STORAGE, EFT_ROOT, "RetailMedia/", ThumbSearchPaths );
 	ovrFileSys::PushBackSearchPathIfValid( java, EST_SECONDARY_EXTERNAL_STORAGE, EFT_ROOT, "", ThumbSearchPaths );
@@ -1553,131 +1577,237 @@ void OvrFolderBrowser::UpdateFolderTitle( OvrGuiSys & guiSys, const FolderView *
 	}
 }
 
-void OvrFolderBrowser::ThumbnailThread()
+void OvrFolderBrowser::QueueThumbnailRequest( ovrThumbnailRequest && request )
 {
-	// thread->SetThreadName( "FolderBrowser" );
+	std::lock_guard< std::mutex > lk( ThumbnailMutex );
+	if ( ThumbnailState == THUMBNAIL_SHUTDOWN )
+	{
+		return;
+	}
+	// A panel that scrolls out and back in before its request is cancelled is already queued
+	for ( const ovrThumbnailRequest & queued : ThumbnailRequests )
+	{
+		if ( queued.FolderIndex == request.FolderIndex && queued.PanelId == request.PanelId )
+		{
+			return;
+		}
+	}
+	ThumbnailRequests.push_back( std::move( request ) );
+	StartThumbnailJobs();
+}
 
-	for ( ;; )
+// Called every frame. Requests are only cancelled and prioritized here, on the main
+// thread, so the jobs never look at folders or panels.
+void OvrFolderBrowser::UpdateThumbnailRequests( OvrGuiSys & guiSys )
+{
+	std::lock_guard< std::mutex > lk( ThumbnailMutex );
+	if ( ThumbnailRequests.empty() )
+	{
+		return;
+	}
+
+	const int activeFolderIndex = GetActiveFolderIndex( guiSys );
+	for ( size_t i = 0; i < ThumbnailRequests.size(); )
 	{
-		BackgroundCommands.SleepUntilMessage();
+		ovrThumbnailRequest & request = ThumbnailRequests[ i ];
 
-		switch ( ThumbnailThreadState.load() )
+		const FolderView * folder = GetFolderView( request.FolderIndex );
+		int panelIndex = -1;
+		if ( folder != NULL && folder->Visible )
 		{
-		case THUMBNAIL_THREAD_WORK:
-			break;
-		case THUMBNAIL_THREAD_PAUSE:
-		{
-			ALOG( "OvrFolderBrowser::ThumbnailThread PAUSED" );
+			const int numPanels = static_cast< int >( folder->Panels.size() );
+			for ( int index = 0; index < numPanels; ++index )
 			{
-				while ( ThumbnailThreadState.load() == THUMBNAIL_THREAD_PAUSE )
+				const PanelView * panel = folder->Panels.at( index );
+				if ( panel->Id == request.PanelId )
 				{
-					std::unique_lock< std::mutex > lk( ThumbnailThreadMutex );
-					ThumbnailThreadCondition.wait( lk );
+					panelIndex = panel->Visible ? index : -1;
+					break;
 				}
 			}
-			ALOG( "OvrFolderBrowser::ThumbnailThread PAUSED DONE" );
+		}
+
+		if ( panelIndex < 0 )
+		{
+			// scrolled out of view before it was loaded
+			if ( i + 1 < ThumbnailRequests.size() )
+			{
+				request = std::move( ThumbnailRequests.back() );
+			}
+			ThumbnailRequests.pop_back();
 			continue;
 		}
-		case THUMBNAIL_THREAD_SHUTDOWN:
-			ALOG( "OvrFolderBrowser::ThumbnailThread shutting down" );
-			return;
+
+		int currentPanelIndex = 0;
+		const VRMenuObject * swipeObject = guiSys.GetVRMenuMgr().ToObject( folder->SwipeHandle );
+		const OvrFolderSwipeComponent * swipeComp = swipeObject != NULL ? swipeObject->GetComponentById< OvrFolderSwipeComponent >() : NULL;
+		if ( swipeComp != NULL )
+		{
+			currentPanelIndex = swipeComp->CurrentPanelIndex();
 		}
 
-		const char * msg = BackgroundCommands.GetNextMessage();
-		ALOG( "BackgroundCommands: %s", msg );
+		// a folder above or below counts as far away as the edge of the visible panels
+		request.Priority = static_cast< float >( abs( panelIndex - currentPanelIndex ) +
+				abs( request.FolderIndex - activeFolderIndex ) * static_cast< int >( NumSwipePanels ) );
+		++i;
+	}
+}
 
-		if ( MatchesHead( "load ", msg ) )
-		{
-			int folderId = -1;
-			int panelId = -1;
+void OvrFolderBrowser::ResumeThumbnailJobs()
+{
+	std::lock_guard< std::mutex > lk( ThumbnailMutex );
+	if ( ThumbnailState == THUMBNAIL_PAUSE )
+	{
+		ThumbnailState = THUMBNAIL_WORK;
+		StartThumbnailJobs();
+	}
+}
 
-			sscanf( msg, "load %i %i", &folderId, &panelId );
-			assert( folderId >= 0 && panelId >= 0 );
+// ThumbnailMutex must be held.
+void OvrFolderBrowser::StartThumbnailJobs()
+{
+	if ( ThumbnailState != THUMBNAIL_WORK )
+	{
+		return;
+	}
 
-			// Do we still need to load this?
-			const FolderView * folder = GetFolderView( folderId );
-			// ThumbnailsLoaded is set to false when the category goes out of view - do not load the thumbnail
-			if ( folder && folder->Visible )
-			{
-				if ( panelId >= 0 && panelId < static_cast< int >( folder->Panels.size() ) )
-				{
-					const PanelView * panel = folder->Panels.at( panelId );
-					if ( panel && panel->Visible )
-					{
-						const char * fileName = strstr( msg, ":" ) + 1;
+	ThumbnailJobs.erase( std::remove_if( ThumbnailJobs.begin(), ThumbnailJobs.end(),
+			[]( ovrJobHandle const & h ) { return h.IsDone(); } ), ThumbnailJobs.end() );
 
-						const std::string fullPath( fileName );
+	while ( NumThumbnailJobs < MAX_THUMBNAIL_JOBS && NumThumbnailJobs < static_cast< int >( ThumbnailRequests.size() ) )
+	{
+		NumThumbnailJobs++;
+		ThumbnailJobs.push_back( ovrJobSystem::GetShared().Submit( JOB_PRIORITY_BACKGROUND, [this]() { ThumbnailJob(); } ) );
+	}
+}
 
-						int		width;
-						int		height;
-						unsigned char * data = LoadThumbnail( fileName, width, height );
-						if ( data != NULL )
-						{
-							TextureCommands.PostPrintf( "thumb %i %i %p %i %i",
-								folderId, panelId, data, width, height );
-						}
-						else
-						{
-							ALOGW( "Thumbnail load fail for: %s", fileName );
-						}
-					}
-				}
+// Loads the highest priority request until there are none left or loading is paused.
+void OvrFolderBrowser::ThumbnailJob()
+{
+	for ( ;; )
+	{
+		ovrThumbnailRequest request;
+		{
+			std::lock_guard< std::mutex > lk( ThumbnailMutex );
+			if ( ThumbnailState != THUMBNAIL_WORK || ThumbnailRequests.empty() )
+			{
+				NumThumbnailJobs--;
+				return;
 			}
-
+			auto best = std::min_element( ThumbnailRequests.begin(), ThumbnailRequests.end(),
+					[]( ovrThumbnailRequest const & a, ovrThumbnailRequest const & b ) { return a.Priority < b.Priority; } );
+			request = std::move( *best );
+			if ( best + 1 != ThumbnailRequests.end() )
+			{
+				*best = std::move( ThumbnailRequests.back() );
+			}
+			ThumbnailRequests.pop_back();
 		}
-		else if ( MatchesHead( "httpThumb", msg ) )
-		{
-			int folderId = -1;
-			int panelId = -1;
-			char panoUrl[ 1024 ] = {};
-			char cacheDestination[ 1024 ] = {};
 
-			sscanf( msg, "httpThumb %s %s %d %d", panoUrl, cacheDestination, &folderId, &panelId );
+		ovrThumbnailResult result;
+		result.FolderIndex = request.FolderIndex;
+		result.PanelId = request.PanelId;
+		result.TileIndex = -1;
+		result.Data = NULL;
+		result.Width = 0;
+		result.Height = 0;
 
-			// Do we still need to load this?
-			const FolderView * folder = GetFolderView( folderId );
-			// ThumbnailsLoaded is set to false when the category goes out of view - do not load the thumbnail
-			if ( folder && folder->Visible )
+		if ( ThumbnailAtlas.FindTile( request.FileName.c_str(), result.TileIndex, result.Tile ) )
+		{
+			if ( !ThumbnailResults.TryPush( std::move( result ) ) )
 			{
-				if ( panelId >= 0 && panelId < static_cast< int >( folder->Panels.size() ) )
-				{
-					const PanelView * panel = folder->Panels.at( panelId );
-					if ( panel && panel->Visible )
-					{
-						int		width;
-						int		height;
-						unsigned char * data = RetrieveRemoteThumbnail(
-							panoUrl,
-							cacheDestination,
-							folderId,
-							panelId,
-							width,
-							height );
-
-						if ( data != NULL )
-						{
-							TextureCommands.PostPrintf( "thumb %i %i %p %i %i",
-								folderId, panelId, data, width, height );
-						}
-						else
-						{
-							ALOGW( "Thumbnail download fail for: %s", panoUrl );
-						}
-					}
-				}
+				ALOGW( "Thumbnail result queue full, dropping: %s", request.FileName.c_str() );
+			}
+			continue;
+		}
+		result.TileIndex = -1;
+
+		int width = 0;
+		int height = 0;
+		unsigned char * data = NULL;
+		if ( request.RemoteUrl.empty() )
+		{
+			data = LoadThumbnail( request.FileName.c_str(), width, height );
+			if ( data == NULL )
+			{
+				ALOGW( "Thumbnail load fail for: %s", request.FileName.c_str() );
+				continue;
 			}
 		}
 		else
 		{
-			ALOG( "OvrFolderBrowser::ThumbnailThread received unhandled message: %s", msg );
-			assert( false );
+			data = RetrieveRemoteThumbnail( request.RemoteUrl.c_str(), request.FileName.c_str(),
+					request.FolderIndex, request.PanelId, width, height );
+			if ( data == NULL )
+			{
+				ALOGW( "Thumbnail download fail for: %s", request.RemoteUrl.c_str() );
+				continue;
+			}
 		}
 
-		free( ( void * )msg );
+		ShrinkThumbnail( data, width, height );
+
+		if ( !CacheThumbnail( request.FileName, data, width, height, result ) )
+		{
+			result.Data = data;
+			result.Width = width;
+			result.Height = height;
+		}
+		if ( !ThumbnailResults.TryPush( std::move( result ) ) )
+		{
+			ALOGW( "Thumbnail result queue full, dropping: %s", request.FileName.c_str() );
+			free( result.Data );
+		}
 	}
 }
 
-// THUMBFIX: call this to load final thumbnail onto the panel
+// Large images cost upload time and memory on the main thread, so anything at least twice
+// the thumbnail size is box filtered down by a whole factor, keeping its aspect ratio.
+void OvrFolderBrowser::ShrinkThumbnail( unsigned char * data, int & width, int & height ) const
+{
+	const int factor = std::min( width / ThumbWidth, height / ThumbHeight );
+	if ( factor < 2 )
+	{
+		return;
+	}
+	BoxDownsampleRGBA( data, width, height, factor );
+	width /= factor;
+	height /= factor;
+}
+
+// Compresses the thumbnail to a tile and adds it to the thumbnail cache, freeing data on success.
+bool OvrFolderBrowser::CacheThumbnail( const std::string & fileName, unsigned char * data, int const width, int const height,
+		ovrThumbnailResult & result )
+{
+	if ( !ThumbnailAtlas.IsOpen() )
+	{
+		return false;
+	}
+
+	// tiles are exactly the thumbnail size, which is what the panel stretched the texture to anyway
+	std::vector< uint8_t > thumb( static_cast< size_t >( ThumbWidth ) * ThumbHeight * 4 );
+	if ( width == ThumbWidth && height == ThumbHeight )
+	{
+		memcpy( thumb.data(), data, thumb.size() );
+	}
+	else
+	{
+		ResampleRGBA( data, width, height, thumb.data(), ThumbWidth, ThumbHeight );
+	}
+	ApplyThumbAntialiasing( thumb.data(), ThumbWidth, ThumbHeight );
+
+	ThumbnailAtlas.EncodeTile( thumb.data(), result.Tile );
+	if ( !ThumbnailAtlas.AddTile( fileName.c_str(), result.Tile, result.TileIndex ) )
+	{
+		result.TileIndex = -1;
+		result.Tile.clear();
+		return false;
+	}
+	free( data );
+	return true;
+}
+
+// Legacy "thumb" commands posted to TextureCommands.
 void OvrFolderBrowser::LoadThumbnailToTexture( OvrGuiSys & guiSys, const char * thumbnailCommand )
 {
 	int folderId;
@@ -1687,35 +1817,32 @@ void OvrFolderBrowser::LoadThumbnailToTexture( OvrGuiSys & guiSys, const char *
 	int height;
 
 	sscanf( thumbnailCommand, "thumb %i %i %p %i %i", &folderId, &panelId, &data, &width, &height );
+	LoadThumbnailToTexture( guiSys, folderId, panelId, data, width, height );
+}
+
+// Returns the panel a loaded thumbnail is for, or NULL if it no longer needs it.
+OvrFolderBrowser::PanelView * OvrFolderBrowser::FindThumbnailPanel( int const folderId, int const panelId )
+{
 	if ( folderId < 0 || panelId < 0 )
 	{
-		delete data;
-		return;
+		return NULL;
 	}
 
 	FolderView * folder = GetFolderView( folderId );
 	if ( folder == NULL )
 	{
 		ALOGW( "OvrFolderBrowser::LoadThumbnailToTexture failed to find FolderView at %i", folderId );
-		free( data );
-		return;
-	}
-
-	std::vector<PanelView*> * panels = &folder->Panels;
-	if ( panels == NULL )
-	{
-		ALOGW( "OvrFolderBrowser::LoadThumbnailToTexture failed to get panels array from folder" );
-		free( data );
-		return;
+		return NULL;
 	}
 
 	PanelView * panel = NULL;
 
 	// find panel using panelId
-	const int numPanels = static_cast< int >( panels->size() );
+	std::vector<PanelView*> & panels = folder->Panels;
+	const int numPanels = static_cast< int >( panels.size() );
 	for ( int index = 0; index < numPanels; ++index )
 	{
-		PanelView* currentPanel = panels->at( index );
+		PanelView* currentPanel = panels.at( index );
 		if ( currentPanel->Id == panelId )
 		{
 			panel = currentPanel;
@@ -1723,16 +1850,33 @@ void OvrFolderBrowser::LoadThumbnailToTexture( OvrGuiSys & guiSys, const char *
 		}
 	}
 
-	if ( panel == NULL ) // Panel not found as it was moved. Delete data and bail
+	if ( panel == NULL ) // Panel not found as it was moved
 	{
 		ALOGW( "OvrFolderBrowser::LoadThumbnailToTexture failed to find panel id %d in folder %d", panelId, folderId );
+		return NULL;
+	}
+
+	if ( !panel->Visible ) // Scrolled out of view while loading, it is requested again when shown
+	{
+		return NULL;
+	}
+	return panel;
+}
+
+// THUMBFIX: call this to load final thumbnail onto the panel
+void OvrFolderBrowser::LoadThumbnailToTexture( OvrGuiSys & guiSys, int const folderId, int const panelId,
+		unsigned char * data, int const width, int const height )
+{
+	PanelView * panel = FindThumbnailPanel( folderId, panelId );
+	if ( panel == NULL )
+	{
 		free( data );
 		return;
 	}
 
 	if ( !ApplyThumbAntialiasing( data, width, height ) )
 	{
-		ALOGW( "OvrFolderBrowser::LoadThumbnailToTexture Failed to apply AA to %s", thumbnailCommand );
+		ALOGW( "OvrFolderBrowser::LoadThumbnailToTexture Failed to apply AA to panel id %d in folder %d", panelId, folderId );
 	}
 
 	// Grab the Panel from VRMenu
@@ -1745,6 +1889,8 @@ void OvrFolderBrowser::LoadThumbnailToTexture( OvrGuiSys & guiSys, const char *
 
 	if ( texId )
 	{
+		ReleasePanelThumbnail( guiSys, *panel );
+
 		panelObject->SetSurfaceTexture( 0, 0, SURFACE_TEXTURE_DIFFUSE,
 			texId, ThumbWidth, ThumbHeight );
 
@@ -1756,6 +1902,86 @@ void OvrFolderBrowser::LoadThumbnailToTexture( OvrGuiSys & guiSys, const char *
 	}
 }
 
+// Points the panel at its tile in the thumbnail cache's page texture.
+void OvrFolderBrowser::LoadThumbnailTileToTexture( OvrGuiSys & guiSys, int const folderId, int const panelId,
+		int const tileIndex, std::vector< uint8_t > const & tile )
+{
+	PanelView * panel = FindThumbnailPanel( folderId, panelId );
+	if ( panel == NULL )
+	{
+		return;
+	}
+
+	VRMenuObject * panelObject = guiSys.GetVRMenuMgr().ToObject( panel->GetThumbnailHandle() );
+	assert( panelObject );
+
+	// acquired before the previous tile is released, so a shared page is not freed and recreated
+	Vector4f cropUV;
+	GlTexture texId = ThumbnailAtlas.AcquireTile( tileIndex, tile, cropUV );
+	if ( texId )
+	{
+		ReleasePanelThumbnail( guiSys, *panel );
+
+		panelObject->SetSurfaceTexture( 0, 0, SURFACE_TEXTURE_DIFFUSE,
+			texId, ThumbWidth, ThumbHeight );
+		panelObject->SetSurfaceCropUV( 0, cropUV );
+		panelObject->RegenerateSurfaceGeometry( 0, false );
+
+		panel->TextureId = texId;
+		panel->AtlasTile = tileIndex;
+	}
+}
+
+// Points the panel back at the default thumbnail and frees the texture or tile it showed.
+void OvrFolderBrowser::ReleasePanelThumbnail( OvrGuiSys & guiSys, PanelView & panel )
+{
+	const GLuint defaultTextureId = GetDefaultThumbnailTextureId();
+	if ( panel.AtlasTile < 0 && ( panel.TextureId == 0 || panel.TextureId == defaultTextureId ) )
+	{
+		return;
+	}
+
+	VRMenuObject * panelObject = guiSys.GetVRMenuMgr().ToObject( panel.GetThumbnailHandle() );
+	if ( panelObject != NULL )
+	{
+		panelObject->SetSurfaceTexture( 0, 0, SURFACE_TEXTURE_DIFFUSE,
+			defaultTextureId, ThumbWidth, ThumbHeight );
+		if ( panel.AtlasTile >= 0 )
+		{
+			panelObject->SetSurfaceCropUV( 0, Vector4f( 0.0f, 0.0f, 1.0f, 1.0f ) );
+			panelObject->RegenerateSurfaceGeometry( 0, false );
+		}
+	}
+
+	if ( panel.AtlasTile >= 0 )
+	{
+		ThumbnailAtlas.ReleaseTile( panel.AtlasTile );
+		panel.AtlasTile = -1;
+	}
+	else
+	{
+		glDeleteTextures( 1, &panel.TextureId );
+	}
+	panel.TextureId = defaultTextureId;
+}
+
+void OvrFolderBrowser::UnloadPanelThumbnail( OvrGuiSys & guiSys, PanelView & panel )
+{
+	ReleasePanelThumbnail( guiSys, panel );
+	panel.LoadDefaultThumbnail( guiSys, GetDefaultThumbnailTextureId(), ThumbWidth, ThumbHeight );
+}
+
+void OvrFolderBrowser::UnloadFolderThumbnails( OvrGuiSys & guiSys, FolderView & folder )
+{
+	for ( PanelView * panel : folder.Panels )
+	{
+		if ( panel )
+		{
+			UnloadPanelThumbnail( guiSys, *panel );
+		}
+	}
+}
+
 void OvrFolderBrowser::LoadFolderViewPanels( OvrGuiSys & guiSys, const OvrMetaData & metaData, const OvrMetaData::Category & category, const int folderIndex, FolderView & folder,
 		std::vector< VRMenuObjectParms const * >& outParms )
 {
@@ -1829,7 +2055,7 @@ void OvrFolderBrowser::QueueAsyncThumbnailLoad( const OvrMetaDatum * panoData, c
 		}
 	}
 
-	// Create or load thumbnail - request built up here to be processed ThumbnailThread
+	// Create or load thumbnail - request built up here to be processed by ThumbnailJob
 	const std::string panoUrl = ThumbUrl( panoData );
 	const std::string thumbName = ThumbName( panoUrl );
 	std::string finalThumb;
@@ -1849,7 +2075,13 @@ void OvrFolderBrowser::QueueAsyncThumbnailLoad( const OvrMetaDatum * panoData, c
 		}
 		else // download and cache it
 		{
-			BackgroundCommands.PostPrintf( "httpThumb %s %s %d %d", panoUrl.c_str(), appCacheThumbPath, folderIndex, panelId );
+			ovrThumbnailRequest request;
+			request.FolderIndex = folderIndex;
+			request.PanelId = panelId;
+			request.FileName = appCacheThumbPath;
+			request.RemoteUrl = panoUrl;
+			request.Priority = FLT_MAX;	// set by UpdateThumbnailRequests
+			QueueThumbnailRequest( std::move( request ) );
 			return;
 		}
 	}
@@ -1882,10 +2114,13 @@ void OvrFolderBrowser::QueueAsyncThumbnailLoad( const OvrMetaDatum * panoData, c
 
 	if ( !finalThumb.empty() )
 	{
-		char cmd[ 1024 ];
-		OVR::OVR_sprintf( cmd, 1024, "load %i %i:%s", folderIndex, panelId, finalThumb.c_str() );
-		ALOG( "Thumb cmd: %s", cmd );
-		BackgroundCommands.PostString( cmd );
+		ALOG( "Thumb load %i %i:%s", folderIndex, panelId, finalThumb.c_str() );
+		ovrThumbnailRequest request;
+		request.FolderIndex = folderIndex;
+		request.PanelId = panelId;
+		request.FileName = finalThumb;
+		request.Priority = FLT_MAX;	// set by UpdateThumbnailRequests
+		QueueThumbnailRequest( std::move( request ) );
 	}
 	else
 	{
@@ -2260,7 +2495,8 @@ void OvrFolderBrowser::FolderView::FreeThumbnailTextures( const GLuint defaultTe
 {
 	for ( PanelView * panel : Panels )
 	{
-		if ( panel && ( panel->TextureId != defaultTextureId ) )
+		// a thumbnail cache tile's page is owned by the cache
+		if ( panel && ( panel->TextureId != defaultTextureId ) && panel->AtlasTile < 0 )
 		{
 			glDeleteTextures( 1, &panel->TextureId  );
 			panel->TextureId = 0;
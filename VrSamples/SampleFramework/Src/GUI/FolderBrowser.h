@@ -14,13 +14,13 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 
 #include <vector>
 #include <string>
-#include <thread>
 #include <mutex>
-#include <condition_variable>
-#include <atomic>
 
 #include "VRMenu.h"
 #include "MessageQueue.h"
+#include "MPSCQueue.h"
+#include "JobSystem.h"
+#include "ThumbnailCache.h"
 #include "MetaDataManager.h"
 #include "ScrollManager.h"
 #include "VRMenuComponent.h"
@@ -43,6 +43,7 @@ public:
 		PanelView() 
 			: Id( -1 )
 			, TextureId( 0 )
+			, AtlasTile( -1 )
 			, Visible( false )
             , MenuId( 0 )
 		{}
@@ -50,6 +51,7 @@ public:
 		PanelView( int id )
 			: Id( id )
 			, TextureId( 0 )
+			, AtlasTile( -1 )
 			, Visible( false )
             , MenuId( 0 )
 		{}
@@ -57,6 +59,7 @@ public:
         PanelView( int id, GLuint textId )
             : Id( id )
             , TextureId( textId )
+			, AtlasTile( -1 )
 			, Visible( false )
             , MenuId( 0 )
         {}
@@ -73,8 +76,9 @@ public:
 
         const int				Id;					// Unique id for thumbnail loading
         menuHandle_t			Handle;				// Handle to the panel
-		GLuint					TextureId;			// Texture id - PanelView maintains ownership
-		volatile bool			Visible;			// Set in main thread and queried in thumbnail thread
+		GLuint					TextureId;			// Texture id - PanelView maintains ownership unless AtlasTile is set
+		int						AtlasTile;			// Thumbnail cache tile shown, or -1 - TextureId is then its page
+		bool					Visible;			// Set in main thread, thumbnail requests are cancelled when cleared
 
         VRMenuId_t              MenuId;
 	};
@@ -100,7 +104,7 @@ public:
 		menuHandle_t			SwipeHandle;		// Handle to root for panels
 		menuHandle_t			ScrollBarHandle;	// Handle to the scrollbar object
 		float					MaxRotation;		// Used by SwipeComponent 
-		volatile bool			Visible;			// Set in main thread and queried in thumbnail thread
+		bool					Visible;			// Set in main thread, thumbnail requests are cancelled when cleared
 		std::vector<PanelView *>		Panels;
 	};
 
@@ -178,6 +182,9 @@ public:
 	bool						ApplyThumbAntialiasing( unsigned char * inOutBuffer, int width, int height ) const;
 	GLuint						GetDefaultThumbnailTextureId() const		{ return DefaultPanelTextureIds[ 0 ]; }
 	void						QueueAsyncThumbnailLoad( const OvrMetaDatum * panoData, const int folderIndex, const int panelId );
+	// Shows the default thumbnail and frees the texture or cache tile the panel showed
+	void						UnloadPanelThumbnail( OvrGuiSys & guiSys, PanelView & panel );
+	void						UnloadFolderThumbnails( OvrGuiSys & guiSys, FolderView & folder );
 
 protected:
 	OvrFolderBrowser( OvrGuiSys & guiSys,
@@ -203,7 +210,9 @@ protected:
 	// Called when a panel is activated
 	virtual void				OnPanelActivated( OvrGuiSys & guiSys, const OvrMetaDatum * panelData ) = 0;
 
-	// Called on a background thread to load thumbnail
+	// Called on a background thread to load thumbnail. Several thumbnails may be loaded at
+	// once, so this must be thread safe. Returns a buffer allocated with malloc. Images larger
+	// than twice the thumbnail size are box filtered down before they are uploaded.
 	virtual	unsigned char *		LoadThumbnail( const char * filename, int & width, int & height ) = 0;
 
 	// Returns the proper thumbnail URL
@@ -217,7 +226,7 @@ protected:
 
 	// Optional interface
 	//
-	// Request external thumbnail - called on main thread
+	// Request external thumbnail - called on a background thread, like LoadThumbnail
 	virtual unsigned char *		RetrieveRemoteThumbnail(
 			const char * /*url*/,
 			const char * /*cacheDestinationFile*/,
@@ -276,8 +285,47 @@ protected:
 	int							MediaCount; // Used to determine if no media was loaded
 
 private:
-	void				ThumbnailThread();
+	// A thumbnail waiting to be loaded. Only panels that are visible have requests, and
+	// the request closest to the center of view is loaded first.
+	struct ovrThumbnailRequest
+	{
+		int				FolderIndex;
+		int				PanelId;
+		std::string		FileName;		// thumbnail to load, or where to cache a remote one
+		std::string		RemoteUrl;		// if not empty, retrieved with RetrieveRemoteThumbnail
+		float			Priority;		// distance from the center of view in panels, lowest loads first
+	};
+
+	// Either a cache tile or, when the thumbnail could not be cached, an RGBA image.
+	struct ovrThumbnailResult
+	{
+		int				FolderIndex;
+		int				PanelId;
+		int				TileIndex;		// -1 if Data is set
+		std::vector< uint8_t >	Tile;
+		unsigned char *	Data;
+		int				Width;
+		int				Height;
+	};
+
+	static const int	MAX_THUMBNAIL_JOBS = 3;
+	static const int	MAX_THUMBNAIL_CACHE_PAGES = 32;
+
+	void				QueueThumbnailRequest( ovrThumbnailRequest && request );
+	void				UpdateThumbnailRequests( OvrGuiSys & guiSys );
+	void				ResumeThumbnailJobs();
+	void				StartThumbnailJobs();
+	void				ThumbnailJob();
+	void				ShrinkThumbnail( unsigned char * data, int & width, int & height ) const;
+	bool				CacheThumbnail( const std::string & fileName, unsigned char * data, int const width, int const height,
+										ovrThumbnailResult & result );
+	PanelView *			FindThumbnailPanel( int const folderId, int const panelId );
+	void				ReleasePanelThumbnail( OvrGuiSys & guiSys, PanelView & panel );
 	void				LoadThumbnailToTexture( OvrGuiSys & guiSys, const char * thumbnailCommand );
+	void				LoadThumbnailToTexture( OvrGuiSys & guiSys, int const folderId, int const panelId,
+										unsigned char * data, int const width, int const height );
+	void				LoadThumbnailTileToTexture( OvrGuiSys & guiSys, int const folderId, int const panelId,
+										int const tileIndex, std::vector< uint8_t > const & tile );
 
 	friend class OvrPanel_OnUp;
 	void				OnPanelUp( OvrGuiSys & guiSys, const OvrMetaDatum * data );
@@ -335,19 +383,25 @@ private:
 
 	RootDirection		OnEnterMenuRootAdjust;
 	
-	// Checked at Frame() time for commands from the thumbnail/create thread
+	// Checked at Frame() time for "thumb" commands posted by subclasses
 	ovrMessageQueue		TextureCommands;
-	ovrMessageQueue		BackgroundCommands;
 
-	enum eThumbnailThreadState
+	enum eThumbnailState
 	{
-		THUMBNAIL_THREAD_WORK,
-		THUMBNAIL_THREAD_PAUSE,
-		THUMBNAIL_THREAD_SHUTDOWN
+		THUMBNAIL_WORK,
+		THUMBNAIL_PAUSE,		// the menu is closed, requests wait until it is opened
+		THUMBNAIL_SHUTDOWN
 	};
-	std::atomic< eThumbnailThreadState > 	ThumbnailThreadState;
-	std::mutex								ThumbnailThreadMutex;
-	std::condition_variable					ThumbnailThreadCondition;
+	// Requests are loaded by up to MAX_THUMBNAIL_JOBS jobs on the shared job system.
+	std::mutex							ThumbnailMutex;
+	std::vector< ovrThumbnailRequest >	ThumbnailRequests;	// guarded by ThumbnailMutex
+	std::vector< ovrJobHandle >			ThumbnailJobs;		// guarded by ThumbnailMutex
+	int									NumThumbnailJobs;	// guarded by ThumbnailMutex
+	eThumbnailState						ThumbnailState;		// guarded by ThumbnailMutex
+	// Checked at Frame() time for loaded thumbnails
+	ovrMPSCQueue< ovrThumbnailResult >	ThumbnailResults;
+	// Compressed thumbnails kept across launches, in AppCachePath
+	ovrThumbnailCache					ThumbnailAtlas;
 
 	std::vector< std::string >		ThumbSearchPaths;
 	std::string						AppCachePath;
@@ -367,8 +421,6 @@ private:
 	bool							IsTouchDownPosistionTracked;
 	OVR::Vector3f 						TouchDownPosistion; // First event in touch relative is considered as touch down position
 	eScrollDirectionLockType		TouchDirectionLocked;
-
-	std::thread						ThumbnailLoadingThread;
 };
 
 
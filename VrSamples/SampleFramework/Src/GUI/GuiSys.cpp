@@ -162,6 +162,8 @@ public:
 
 	virtual HitTestResult	TestRayIntersection( const Vector3f & start, const Vector3f & dir ) const override;
 
+	virtual void			SetShowEventStats( bool const show ) override { ShowEventStats = show; }
+
 	virtual void			AddMenu( VRMenu * menu ) override;
 	virtual VRMenu *		GetMenu( char const * menuName ) const override;
 	virtual std::vector< std::string > GetAllMenuNames() const override;
@@ -222,6 +224,7 @@ private:
 	static bool				SkipSubmit;
 	static bool				SkipFont;
 	static bool				SkipCursor;
+	static bool				ShowEventStats;
 
 private:
 	int						FindMenuIndex( char const * menuName ) const;
@@ -268,6 +271,7 @@ bool OvrGuiSysLocal::SkipRender = false;
 bool OvrGuiSysLocal::SkipSubmit = false;
 bool OvrGuiSysLocal::SkipFont = false;
 bool OvrGuiSysLocal::SkipCursor = false;
+bool OvrGuiSysLocal::ShowEventStats = false;
 
 //==============================
 // OvrGuiSysLocal::
@@ -780,6 +784,11 @@ void OvrGuiSysLocal::Frame( const ovrApplFrameIn & vrFrame, Matrix4f const & cen
 				1.0f, InfoText.Color, InfoText.Text.c_str() );
 	}
 
+	// finish any textures that were decoded in the background since last frame
+	TextureManager->UploadPendingTextures();
+
+	VRMenuEventHandler::ResetDispatchCount();
+
 	{
 		/// OVR_PERF_TIMER( OvrGuiSys_Frame_Menus_Frame );
 		// go backwards through the list so we can use unordered remove when a menu finishes closing
@@ -800,6 +809,12 @@ void OvrGuiSysLocal::Frame( const ovrApplFrameIn & vrFrame, Matrix4f const & cen
 		}
 	}
 
+	if ( ShowEventStats )
+	{
+		ALOG( "OvrGuiSys: %i active menus, %i events dispatched", static_cast< int >( ActiveMenus.size() ),
+				VRMenuEventHandler::GetDispatchCount() );
+	}
+
 	{
 		/// OVR_PERF_TIMER( OvrGuiSys_GazeCursor_Frame );
 		GazeCursor->Frame( centerViewMatrix, traceMat, vrFrame.DeltaSeconds );
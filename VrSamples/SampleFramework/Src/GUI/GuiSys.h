@@ -93,6 +93,9 @@ public:
 
 	virtual HitTestResult	TestRayIntersection( const OVR::Vector3f & start, const OVR::Vector3f & dir ) const = 0;
 
+	// When enabled, logs the number of active menus and of events dispatched to components every frame.
+	virtual void			SetShowEventStats( bool const show ) = 0;
+
 	//-------------------------------------------------------------
 	// Menu management
 	
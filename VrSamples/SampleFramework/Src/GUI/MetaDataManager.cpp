@@ -19,19 +19,11 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #include <algorithm>
 #include <locale>
 
-#include <dirent.h>
-#include <unistd.h>
-
 using OVR::JSON;
 using OVR::JsonReader;
 
 namespace OVRFW {
 
-void SortStringArray( std::vector<std::string> & strings )
-{
-	std::sort( strings.begin(), strings.end() );
-}
-
 // if pathToAppend is an empty string, this just adds a slash
 void AppendPath( std::string & startPath, const char * pathToAppend )
 {
@@ -50,67 +42,6 @@ void AppendPath( std::string & startPath, const char * pathToAppend )
 	startPath += pathToAppend;
 }
 
-// DirPath should by a directory with a trailing slash.
-// Returns all files in all search paths, as unique relative paths.
-// Subdirectories will have a trailing slash.
-// All files and directories that start with . are skipped.
-std::unordered_map< std::string, std::string > RelativeDirectoryFileList( const std::vector< std::string > & searchPaths, const char * RelativeDirPath )
-{
-	//Check each of the mirrors in searchPaths and build up a list of unique strings
-	std::unordered_map< std::string, std::string > uniqueStrings;
-	std::string relativeDirPathString = std::string( RelativeDirPath );
-
-#if defined( OVR_BUILD_DEBUG )
-	ALOG( "RelativeDirectoryFileList searchPaths=%d relative='%s'", (int)searchPaths.size(), relativeDirPathString.c_str() );
-#endif
-
-	const int numSearchPaths = static_cast< const int >( searchPaths.size() );
-	for ( int index = 0; index < numSearchPaths; ++index )
-	{
-		const std::string fullPath = searchPaths[index] + relativeDirPathString;
-		DIR * dir = opendir( fullPath.c_str() );
-		if ( dir != NULL )
-		{
-			struct dirent * entry;
-			while ( ( entry = readdir( dir ) ) != NULL )
-			{
-				if ( entry->d_name[ 0 ] == '.' )
-				{
-					continue;
-				}
-				if ( entry->d_type == DT_DIR )
-				{
-					std::string s = relativeDirPathString;
-					s += entry->d_name;
-					s += "/";
-#if defined( OVR_BUILD_DEBUG )
-					ALOG( "RelativeDirectoryFileList adding - %s", s.c_str() );
-#endif
-
-					std::string lowerCaseS = s.c_str();
-					std::transform( lowerCaseS.begin(), lowerCaseS.end(), lowerCaseS.begin(), ::tolower );
-					uniqueStrings[ lowerCaseS ] = s;
-				}
-				else if ( entry->d_type == DT_REG )
-				{
-					std::string s = relativeDirPathString;
-					s += entry->d_name;
-#if defined( OVR_BUILD_DEBUG )
-					ALOG( "RelativeDirectoryFileList adding - %s", s.c_str() );
-#endif
-
-					std::string lowerCaseS = s.c_str();
-					std::transform( lowerCaseS.begin(), lowerCaseS.end(), lowerCaseS.begin(), ::tolower );
-					uniqueStrings[ lowerCaseS ] = s;
-				}
-			}
-			closedir( dir );
-		}
-	}
-
-	return uniqueStrings;
-}
-
 std::string ExtractFileBase( const std::string & s )
 {
 	const int l = static_cast<int>( s.length() );
@@ -141,17 +72,6 @@ std::string ExtractFileBase( const std::string & s )
 	return std::string( &s[ start ], end - start );
 }
 
-bool MatchesExtension( const char * fileName, const char * ext )
-{
-	const int extLen = static_cast<int>( OVR::OVR_strlen( ext ) );
-	const int sLen = static_cast<int>( OVR::OVR_strlen( fileName ) );
-	if ( sLen < extLen + 1 )
-	{
-		return false;
-	}
-	return ( 0 == strcmp( &fileName[ sLen - extLen ], ext ) );
-}
-
 //==============================
 // OvrMetaData
 
@@ -169,78 +89,96 @@ void OvrMetaData::InitFromDirectory( const char * relativePath, const std::vecto
 {
 	ALOG( "OvrMetaData::InitFromDirectory( %s )", relativePath );
 
-	// Find all the files - checks all search paths
-	std::unordered_map< std::string, std::string > uniqueFileList = RelativeDirectoryFileList( searchPaths, relativePath );
-	std::vector<std::string> fileList;
-	for ( auto iter = uniqueFileList.begin(); iter != uniqueFileList.end(); ++iter )
+	// Directories are read in parallel, and added in depth-first order as soon as each is ready
+	ovrDirectoryScanner scanner( searchPaths, fileExtensions.GoodExtensions, fileExtensions.BadExtensions );
+	if ( !DirectoryIndexFile.empty() )
+	{
+		scanner.SetIndexFile( DirectoryIndexFile.c_str() );
+	}
+	scanner.Start( relativePath );
+	ovrScannedDirectory dir;
+	while ( scanner.WaitNextDirectory( dir ) )
+	{
+		AddScannedDirectory( dir );
+	}
+}
+
+void OvrMetaData::BeginInitFromDirectory( const char * relativePath, const std::vector< std::string > & searchPaths, const OvrMetaDataFileExtensions & fileExtensions )
+{
+	ALOG( "OvrMetaData::BeginInitFromDirectory( %s )", relativePath );
+
+	Scanner.reset( new ovrDirectoryScanner( searchPaths, fileExtensions.GoodExtensions, fileExtensions.BadExtensions ) );
+	if ( !DirectoryIndexFile.empty() )
+	{
+		Scanner->SetIndexFile( DirectoryIndexFile.c_str() );
+	}
+	Scanner->Start( relativePath );
+}
+
+bool OvrMetaData::UpdateInitFromDirectory()
+{
+	if ( Scanner == nullptr )
+	{
+		return true;
+	}
+
+	ovrScannedDirectory dir;
+	while ( Scanner->NextDirectory( dir ) )
 	{
-#if defined( OVR_BUILD_DEBUG )
-		/// We map the lowercase variant (for searching) as a key to the real MixedCase actual file name
-		/// make sure we use the real MixedCase name hence forth ( aka ->second )
-		ALOG( "OvrMetaData  fileList[ '%s' ] = '%s'", iter->first.c_str(), iter->second.c_str() );
-#endif
-		fileList.push_back( iter->second );
+		AddScannedDirectory( dir );
+	}
+
+	if ( !Scanner->IsComplete() )
+	{
+		return false;
 	}
-	SortStringArray( fileList );
+	Scanner.reset();
+	return true;
+}
+
+void OvrMetaData::AddScannedDirectory( const ovrScannedDirectory & dir )
+{
 	Category currentCategory;
-	currentCategory.CategoryTag = ExtractFileBase( relativePath );
+	currentCategory.CategoryTag = ExtractFileBase( dir.RelativePath );
 	// The label is the same as the tag by default.
 	//Will be replaced if definition found in loaded metadata
 	currentCategory.LocaleKey = currentCategory.CategoryTag;
 
 	ALOG( "OvrMetaData start category: %s", currentCategory.CategoryTag.c_str() );
-	std::vector< std::string > subDirs;
-	// Grab the categories and loose files
-	for ( const std::string & s : fileList )
+	// The scanner has already filtered the files by extension
+	for ( int i = 0; i < static_cast< int >( dir.Files.size() ); ++i )
 	{
+		const std::string & s = dir.Files[i];
 		ALOG( "OvrMetaData category: %s file: %s", currentCategory.CategoryTag.c_str(), s.c_str() );
 
-		const std::string fileBase = ExtractFileBase( s );
-		// subdirectory - add category
-		if ( MatchesExtension( s.c_str(), "/" ) )
-		{
-			subDirs.push_back( s );
-			continue;
-		}
-
-		// See if we want this loose-file
-		if ( !ShouldAddFile( s.c_str(), fileExtensions ) )
-		{
-			continue;
-		}
-
 		// Add loose file
+		const std::string fileBase = ExtractFileBase( s );
 		const int dataIndex = static_cast< int >( MetaData.size() );
 		OvrMetaDatum * datum = CreateMetaDatum( fileBase.c_str() );
 		if ( datum )
 		{
 			datum->Id = dataIndex;
 			datum->Tags.push_back( currentCategory.CategoryTag );
-			if ( GetFullPath( searchPaths, s.c_str(), datum->Url ) )
-			{
-				// always use the lowercase version of the URL to search the map
-				std::string lowerCaseUrl = datum->Url.c_str();
-				auto & loc = std::use_facet<std::ctype<char>>( std::locale() );
-				loc.tolower( &lowerCaseUrl[0], &lowerCaseUrl[0] + lowerCaseUrl.length() );
+			datum->Url = dir.FullPaths[i];
 
-				auto datumIter = UrlToIndex.find( lowerCaseUrl );
-				if ( datumIter == UrlToIndex.end() )
-				{
-					// always use the lowercase version of the URL as map key
-					UrlToIndex[ lowerCaseUrl ] = dataIndex;
-					MetaData.push_back( datum );
-					ALOG( "OvrMetaData adding datum %s with index %d to %s", datum->Url.c_str(), dataIndex, currentCategory.CategoryTag.c_str() );
-					// Register with category
-					currentCategory.DatumIndicies.push_back( dataIndex );
-				}
-				else
-				{
-					ALOGW( "OvrMetaData::InitFromDirectory found duplicate url %s", datum->Url.c_str() );
-				}
+			// always use the lowercase version of the URL to search the map
+			std::string lowerCaseUrl = datum->Url.c_str();
+			auto & loc = std::use_facet<std::ctype<char>>( std::locale() );
+			loc.tolower( &lowerCaseUrl[0], &lowerCaseUrl[0] + lowerCaseUrl.length() );
+
+			auto datumIter = UrlToIndex.find( lowerCaseUrl );
+			if ( datumIter == UrlToIndex.end() )
+			{
+				// always use the lowercase version of the URL as map key
+				UrlToIndex[ lowerCaseUrl ] = dataIndex;
+				MetaData.push_back( datum );
+				ALOG( "OvrMetaData adding datum %s with index %d to %s", datum->Url.c_str(), dataIndex, currentCategory.CategoryTag.c_str() );
+				// Register with category
+				currentCategory.DatumIndicies.push_back( dataIndex );
 			}
 			else
 			{
-				ALOGW( "OvrMetaData::InitFromDirectory failed to find %s", s.c_str() );
+				ALOGW( "OvrMetaData::InitFromDirectory found duplicate url %s", datum->Url.c_str() );
 			}
 		}
 	}
@@ -249,12 +187,6 @@ void OvrMetaData::InitFromDirectory( const char * relativePath, const std::vecto
 	{
 		Categories.push_back( currentCategory );
 	}
-
-	// Recurse into subdirs
-	for ( const std::string & subDir : subDirs )
-	{
-		InitFromDirectory( subDir.c_str(), searchPaths, fileExtensions );
-	}
 }
 
 void OvrMetaData::InitFromFileList( const std::vector< std::string > & fileList, const OvrMetaDataFileExtensions & fileExtensions )
@@ -449,6 +381,10 @@ void OvrMetaData::InitFromDirectoryMergeMeta( const char * relativePath, const s
 
 	std::shared_ptr<JSON> dataFile = CreateOrGetStoredMetaFile( appFileStoragePath.c_str(), metaFile );
 
+	if ( DirectoryIndexFile.empty() )
+	{
+		DirectoryIndexFile = FilePath + ".dirs";
+	}
 	InitFromDirectory( relativePath, searchPaths, fileExtensions );
 	ProcessMetaData( dataFile, searchPaths, metaFile );
 }
@@ -836,7 +772,8 @@ void OvrMetaData::ExtractMetaData( std::shared_ptr<JSON> dataFile, const std::ve
 				// Get the absolute path if this is a local file
 				if ( !isRemote )
 				{
-					foundPath = GetFullPath( searchPaths, relativeUrl.c_str(), metaDatum->Url );
+					foundPath = FindScannedUrl( searchPaths, relativeUrl, metaDatum->Url ) ||
+						GetFullPath( searchPaths, relativeUrl.c_str(), metaDatum->Url );
 					if ( !foundPath )
 					{
 						// if we fail to find the file, check for encrypted extension (TODO: Might put this into a virtual function if necessary, benign for now)
@@ -945,30 +882,59 @@ void OvrMetaData::Serialize()
 	ALOG( "OvrMetaData::Serialize updated %s", FilePath.c_str() );
 }
 
-void OvrMetaData::RegenerateCategoryIndices()
+// Files found by InitFromDirectory are known to exist, so look for a url among them
+// before GetFullPath stats it in every search path.
+bool OvrMetaData::FindScannedUrl( const std::vector< std::string > & searchPaths, const std::string & url, std::string & outUrl ) const
 {
-	for ( Category & cat : Categories )
+	if ( UrlToIndex.empty() )
 	{
-		cat.DatumIndicies.clear();
+		return false;
 	}
 
-	// Delete any data only tagged as "Favorite" - this is a fix for user created "Favorite" folder which is a special case
-	// Not doing this will show photos already favorited that the user cannot unfavorite
-	for ( int metaDataIndex = 0; metaDataIndex < static_cast< int >( MetaData.size() ); ++metaDataIndex )
+	auto & loc = std::use_facet<std::ctype<char>>( std::locale() );
+	std::string lowerCaseUrl;
+	for ( int i = -1; i < static_cast< int >( searchPaths.size() ); ++i )
 	{
-		OvrMetaDatum & metaDatum = *MetaData.at( metaDataIndex );
-		std::vector< std::string > & tags = metaDatum.Tags;
-
-		assert( metaDatum.Tags.size() > 0 );
-		if ( tags.size() == 1 )
+		lowerCaseUrl = i < 0 ? url : searchPaths[ i ] + url;
+		loc.tolower( &lowerCaseUrl[0], &lowerCaseUrl[0] + lowerCaseUrl.length() );
+		auto iter = UrlToIndex.find( lowerCaseUrl );
+		if ( iter != UrlToIndex.end() && iter->second < static_cast< int >( MetaData.size() ) )
 		{
-			if ( tags.at( 0 ) == FAVORITES_TAG )
+			// the index is only valid until data is removed, so check it still refers to this url
+			const std::string & scannedUrl = MetaData[ iter->second ]->Url;
+			if ( scannedUrl.length() == lowerCaseUrl.length() && OVR::OVR_stricmp( scannedUrl.c_str(), lowerCaseUrl.c_str() ) == 0 )
 			{
-				ALOG( "Removing broken metadatum %s", metaDatum.Url.c_str() );
-				MetaData.erase( MetaData.cbegin() + metaDataIndex );
+				outUrl = scannedUrl;
+				return true;
 			}
 		}
 	}
+	return false;
+}
+
+void OvrMetaData::RegenerateCategoryIndices()
+{
+	// Map tags to categories once instead of searching the categories for every tag.
+	// Like GetCategory, the first category with a tag wins.
+	std::unordered_map< std::string, int > categoryIndices;
+	for ( int catIndex = 0; catIndex < static_cast< int >( Categories.size() ); ++catIndex )
+	{
+		Categories[ catIndex ].DatumIndicies.clear();
+		categoryIndices.insert( std::make_pair( Categories[ catIndex ].CategoryTag, catIndex ) );
+	}
+
+	// Delete any data only tagged as "Favorite" - this is a fix for user created "Favorite" folder which is a special case
+	// Not doing this will show photos already favorited that the user cannot unfavorite
+	MetaData.erase( std::remove_if( MetaData.begin(), MetaData.end(), []( const OvrMetaDatum * metaDatum )
+	{
+		assert( metaDatum->Tags.size() > 0 );
+		if ( metaDatum->Tags.size() == 1 && metaDatum->Tags.at( 0 ) == FAVORITES_TAG )
+		{
+			ALOG( "Removing broken metadatum %s", metaDatum->Url.c_str() );
+			return true;
+		}
+		return false;
+	} ), MetaData.end() );
 
 	// Fix the indices
 	for ( int metaDataIndex = 0; metaDataIndex < static_cast< int >( MetaData.size() ); ++metaDataIndex )
@@ -992,8 +958,10 @@ void OvrMetaData::RegenerateCategoryIndices()
 		{
 			if ( !tag.empty() )
 			{
-				if ( Category * category = GetCategory( tag ) )
+				auto categoryIter = categoryIndices.find( tag );
+				if ( categoryIter != categoryIndices.end() )
 				{
+					Category * category = &Categories[ categoryIter->second ];
 					ALOG( "OvrMetaData inserting index %d for datum %s to %s", metaDataIndex, datum.Url.c_str(), category->CategoryTag.c_str() );
 
 					// fix the metadata index itself
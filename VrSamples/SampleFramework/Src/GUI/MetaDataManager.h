@@ -15,8 +15,10 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <memory>
 
 #include "OVR_JSON.h"
+#include "DirectoryScanner.h"
 
 namespace OVRFW {
 
@@ -70,6 +72,18 @@ public:
 	// Init meta data from contents on disk
 	void					InitFromDirectory( const char * relativePath, const std::vector< std::string > & searchPaths, const OvrMetaDataFileExtensions & fileExtensions );
 
+	// Starts the same scan as InitFromDirectory in the background and returns at once
+	void					BeginInitFromDirectory( const char * relativePath, const std::vector< std::string > & searchPaths, const OvrMetaDataFileExtensions & fileExtensions );
+
+	// Adds the categories of the directories read since the last call, in the order InitFromDirectory
+	// would add them. They are dirty, so OvrFolderBrowser::BuildDirtyMenu will show them.
+	// Returns true once the scan is done.
+	bool					UpdateInitFromDirectory();
+
+	// Directory listings are kept in this file between scans, so folders that have not changed
+	// are not read again. InitFromDirectoryMergeMeta keeps them next to the meta file.
+	void					SetDirectoryIndexFile( const char * fileName )	{ DirectoryIndexFile = fileName; }
+
 	// Init meta data from a passed in list of files
 	void					InitFromFileList( const std::vector< std::string > & fileList, const OvrMetaDataFileExtensions & fileExtensions );
 
@@ -139,6 +153,8 @@ protected:
 	std::shared_ptr<OVR::JSON>	MetaDataToJson() const;
 	void					WriteMetaFile( const char * metaFile ) const;
 	bool 					ShouldAddFile( const char * filename, const OvrMetaDataFileExtensions & fileExtensions ) const;
+	void					AddScannedDirectory( const ovrScannedDirectory & dir );
+	bool					FindScannedUrl( const std::vector< std::string > & searchPaths, const std::string & url, std::string & outUrl ) const;
 	void					ExtractVersion( std::shared_ptr<OVR::JSON> dataFile, double & outVersion ) const;
 	void					ExtractCategories( std::shared_ptr<OVR::JSON> dataFile, std::vector< Category > & outCategories ) const;
 	void					ExtractMetaData( std::shared_ptr<OVR::JSON> dataFile, const std::vector< std::string > & searchPaths, std::unordered_map< std::string, OvrMetaDatum * > & outMetaData ) const;
@@ -151,6 +167,8 @@ private:
 	std::vector< OvrMetaDatum * >	MetaData;
 	std::unordered_map< std::string, int >	UrlToIndex;
 	double							Version;
+	std::unique_ptr< ovrDirectoryScanner >	Scanner;	// set while a BeginInitFromDirectory scan is running
+	std::string						DirectoryIndexFile;
 };
 
 }
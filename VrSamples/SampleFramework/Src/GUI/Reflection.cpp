@@ -11,14 +11,16 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 
 #include "Reflection.h"
 #include "ReflectionData.h"
+#include "ReflectionBinary.h"
 
 #include "Misc/Log.h"
+#include "Misc/Hash.h"
 #include "Locale/OVR_Locale.h"
 
 #include "OVR_TypesafeNumber.h"
 
 #include <alloca.h>
-#include <cstdlib> // for strtoll
+#include <cstdlib> // for strtol
 
 namespace OVRFW {
 
@@ -28,12 +30,12 @@ namespace OVRFW {
 //==============================================================================================
 
 template< typename Type >
-bool EnumForName( ovrEnumInfo const * enumInfos, char const * const name, Type & out )
+bool EnumForName( ovrEnumInfo const * enumInfos, ovrLexerToken const & name, Type & out )
 {
 	int enumMax = INT_MIN;
 	for ( int i = 0; enumInfos[i].Name != NULL; ++i )
 	{
-		if ( OVR::OVR_strcmp( enumInfos[i].Name, name ) == 0 )
+		if ( name.Equals( enumInfos[i].Name ) )
 		{
 			out = static_cast< Type >( enumInfos[i].Value );
 			return true;
@@ -49,13 +51,12 @@ bool EnumForName( ovrEnumInfo const * enumInfos, char const * const name, Type &
 
 ovrParseResult ExpectPunctuation( const char * name, ovrLexer & lex, const char * expected )
 {
-	const int MAX_TOKEN = 128;
-	char token[MAX_TOKEN];
-	ovrLexer::ovrResult res = lex.ExpectPunctuation( expected, token, MAX_TOKEN );
+	ovrLexerToken token;
+	ovrLexer::ovrResult res = lex.ExpectPunctuation( expected, token );
 	if ( res != ovrLexer::LEX_RESULT_OK )
 	{
 		return ovrParseResult( ovrLexer::LEX_RESULT_UNEXPECTED_TOKEN, 
-				"Error parsing '%s': Expected one of '%s', got '%s'", name, expected, token );
+				"Error parsing '%s': Expected one of '%s', got '%.*s'", name, expected, token.GetPrintLength(), token.GetText() );
 	}
 	return ovrParseResult();
 }
@@ -63,18 +64,17 @@ ovrParseResult ExpectPunctuation( const char * name, ovrLexer & lex, const char
 ovrParseResult ParseBool( ovrReflection & /*refl*/, ovrLocale const & /*locale*/, const char * name, ovrLexer & lex, ovrTypeInfo const * /*atomicInfo*/, void * outPtr, size_t const /*arraySize*/ )
 {
 	bool & out = *static_cast< bool* >( outPtr );
-	size_t const MAX_TOKEN = 128;
-	char token[MAX_TOKEN];
+	ovrLexerToken token;
 	
-	ovrLexer::ovrResult res = lex.NextToken( token, MAX_TOKEN );
+	ovrLexer::ovrResult res = lex.NextToken( token );
 	if ( res == ovrLexer::LEX_RESULT_OK )
 	{
-		if ( !OVR::OVR_strcmp( token, "false" ) || !OVR::OVR_strcmp( token, "0" ) )
+		if ( token.Equals( "false" ) || token.Equals( "0" ) )
 		{
 			out = false;
 			return ovrParseResult();
 		}
-		else if ( !OVR::OVR_strcmp( token, "true" ) || !OVR::OVR_strcmp( token, "1" ) )
+		else if ( token.Equals( "true" ) || token.Equals( "1" ) )
 		{
 			out = true;
 			return ovrParseResult();
@@ -87,13 +87,11 @@ ovrParseResult ParseBool( ovrReflection & /*refl*/, ovrLocale const & /*locale*/
 ovrParseResult ParseInt( ovrReflection & /*refl*/, ovrLocale const & /*locale*/, const char * name, ovrLexer & lex, ovrTypeInfo const * /*atomicInfo*/, void * outPtr, size_t const /*arraySize*/ )
 {
 	int & out = *static_cast< int* >( outPtr );
-	size_t const MAX_TOKEN = 128;
-	char token[MAX_TOKEN];
 	
 	ovrLexer::ovrResult res = lex.ParseInt( out, 0 );
 	if ( res != ovrLexer::LEX_RESULT_OK )
 	{
-		return ovrParseResult( res, "Error parsing '%s': expected int, got '%s'", name, token );
+		return ovrParseResult( res, "Error parsing '%s': expected int", name );
 	}
 	return ovrParseResult();
 }
@@ -101,13 +99,11 @@ ovrParseResult ParseInt( ovrReflection & /*refl*/, ovrLocale const & /*locale*/,
 ovrParseResult ParseFloat( ovrReflection & /*refl*/, ovrLocale const & /*locale*/, const char * name, ovrLexer & lex, ovrTypeInfo const * /*atomicInfo*/, void * outPtr, size_t const /*arraySize*/ )
 {
 	float & out = *static_cast< float* >( outPtr );
-	size_t const MAX_TOKEN = 128;
-	char token[MAX_TOKEN];
 	
 	ovrLexer::ovrResult res = lex.ParseFloat( out, 0.0f );
 	if ( res != ovrLexer::LEX_RESULT_OK )
 	{
-		return ovrParseResult( res, "Error parsing '%s': expected float, got '%s'", name, token );
+		return ovrParseResult( res, "Error parsing '%s': expected float", name );
 	}
 	return ovrParseResult();
 }
@@ -115,13 +111,11 @@ ovrParseResult ParseFloat( ovrReflection & /*refl*/, ovrLocale const & /*locale*
 ovrParseResult ParseDouble( ovrReflection & /*refl*/, ovrLocale const & /*locale*/, const char * name, ovrLexer & lex, ovrTypeInfo const * /*atomicInfo*/, void * outPtr, size_t const /*arraySize*/ )
 {
 	double & out = *static_cast< double* >( outPtr );
-	size_t const MAX_TOKEN = 128;
-	char token[MAX_TOKEN];
 	
 	ovrLexer::ovrResult res = lex.ParseDouble( out, 0.0 );
 	if ( res != ovrLexer::LEX_RESULT_OK )
 	{
-		return ovrParseResult( res, "Error parsing '%s': expected double, got '%s'", name, token );
+		return ovrParseResult( res, "Error parsing '%s': expected double", name );
 	}
 	return ovrParseResult();
 }
@@ -129,18 +123,17 @@ ovrParseResult ParseDouble( ovrReflection & /*refl*/, ovrLocale const & /*locale
 ovrParseResult ParseEnum( ovrReflection & /*refl*/, ovrLocale const & /*locale*/, const char * name, ovrLexer & lex, ovrTypeInfo const * atomicInfo, void * outPtr, size_t const /*arraySize*/ )
 {
 	int & out = *static_cast< int* >( outPtr );
-	size_t const MAX_TOKEN = 128;
-	char token[MAX_TOKEN];
+	ovrLexerToken token;
 	
-	ovrLexer::ovrResult res = lex.NextToken( token, MAX_TOKEN );
+	ovrLexer::ovrResult res = lex.NextToken( token );
 	if ( res != ovrLexer::LEX_RESULT_OK )
 	{
-		return ovrParseResult( res, "Error parsing '%s': expected enum, got '%s'", name, token );
+		return ovrParseResult( res, "Error parsing '%s': expected enum, got '%.*s'", name, token.GetPrintLength(), token.GetText() );
 	}
 
 	if ( !EnumForName( atomicInfo->EnumInfos, token, out ) )
 	{
-		return ovrParseResult( ovrLexer::LEX_RESULT_UNEXPECTED_TOKEN, "Error parsing '%s': expected enum, got '%s'", name, token );
+		return ovrParseResult( ovrLexer::LEX_RESULT_UNEXPECTED_TOKEN, "Error parsing '%s': expected enum, got '%.*s'", name, token.GetPrintLength(), token.GetText() );
 	}
 	return ovrParseResult();
 }
@@ -152,14 +145,11 @@ ovrParseResult ParseTypesafeNumber_int( ovrReflection & /*refl*/, ovrLocale cons
 	
 	TempTypesafeNumber & out = *static_cast< TempTypesafeNumber* >( outPtr );
 	
-	size_t const MAX_TOKEN = 128;
-	char token[MAX_TOKEN];
-	
 	int value;
 	ovrLexer::ovrResult res = lex.ParseInt( value, 0 );
 	if ( res != ovrLexer::LEX_RESULT_OK )
 	{
-		return ovrParseResult( res, "Error parsing '%s': expected int, got '%s'", name, token );
+		return ovrParseResult( res, "Error parsing '%s': expected int", name );
 	}
 	out.Set( value );
 
@@ -173,15 +163,12 @@ ovrParseResult ParseTypesafeNumber_long_long( ovrReflection & /*refl*/, ovrLocal
 	
 	TempTypesafeNumber & out = *static_cast< TempTypesafeNumber* >( outPtr );
 	
-	size_t const MAX_TOKEN = 128;
-	char token[MAX_TOKEN];
-	
-	ovrLexer::ovrResult res = lex.NextToken( token, MAX_TOKEN );
+	long long value;
+	ovrLexer::ovrResult res = lex.ParseLongLong( value, 0 );
 	if ( res != ovrLexer::LEX_RESULT_OK ) 
 	{
-		return ovrParseResult( res, "Error parsing '%s': expected long long, got '%s'", name, token );
+		return ovrParseResult( res, "Error parsing '%s': expected long long", name );
 	}
-	long long value = strtoll( token, nullptr, 10 );
 	out.Set( value );
 	return ovrParseResult();
 }
@@ -189,80 +176,88 @@ ovrParseResult ParseTypesafeNumber_long_long( ovrReflection & /*refl*/, ovrLocal
 ovrParseResult ParseBitFlags( ovrReflection & /*refl*/, ovrLocale const & /*locale*/, const char * name, ovrLexer & lex, ovrTypeInfo const * atomicInfo, void * outPtr, size_t const /*arraySize*/ )
 {
 	int & out = *static_cast< int* >( outPtr );
-	size_t const MAX_TOKEN = 128;
-	char token[MAX_TOKEN];
+	ovrLexerToken token;
 
 	out = 0;
 
 	ovrLexer::ovrResult res;
 	for( ; ; )
 	{
-		res = lex.NextToken( token, MAX_TOKEN );
+		res = lex.NextToken( token );
 		if ( res != ovrLexer::LEX_RESULT_OK )
 		{
-			return ovrParseResult( res, "Error parsing '%s': expected enum, got '%s'", name, token );
+			return ovrParseResult( res, "Error parsing '%s': expected enum, got '%.*s'", name, token.GetPrintLength(), token.GetText() );
 		}
 
 		int e;
 		bool ok = EnumForName( atomicInfo->EnumInfos, token, e );
 		if ( !ok )
 		{			
-			return ovrParseResult( ovrLexer::LEX_RESULT_UNEXPECTED_TOKEN, "Error parsing '%s': exepected enum, got '%s'", name, token );
+			return ovrParseResult( ovrLexer::LEX_RESULT_UNEXPECTED_TOKEN, "Error parsing '%s': exepected enum, got '%.*s'", name, token.GetPrintLength(), token.GetText() );
 		}
 		out |= ( 1 << e );
 		
-		res = lex.PeekToken( token, MAX_TOKEN );
+		res = lex.PeekToken( token );
 		if ( res != ovrLexer::LEX_RESULT_OK )
 		{
-			return ovrParseResult( ovrLexer::LEX_RESULT_UNEXPECTED_TOKEN, "Error parsing '%s': expected '|' or ';', got '%s'", name, token );
+			return ovrParseResult( ovrLexer::LEX_RESULT_UNEXPECTED_TOKEN, "Error parsing '%s': expected '|' or ';', got '%.*s'", name, token.GetPrintLength(), token.GetText() );
 		}
-		else if ( !OVR::OVR_strcmp( token, ";" ) )
+		else if ( token.IsChar( ';' ) )
 		{
 			return ovrParseResult();
 		}
-		else if ( !OVR::OVR_strcmp( token, "|" ) )
+		else if ( token.IsChar( '|' ) )
 		{
 			// consume the OR operator
-			lex.NextToken( token, MAX_TOKEN );
+			lex.NextToken( token );
 		}
 	}
 }
 
-ovrParseResult ParseString( ovrReflection & /*refl*/, ovrLocale const & locale, const char * name, ovrLexer & lex, ovrTypeInfo const * /*atomicInfo*/, void * outPtr, size_t const /*arraySize*/ )
+ovrParseResult ParseString( ovrReflection & refl, ovrLocale const & locale, const char * name, ovrLexer & lex, ovrTypeInfo const * /*atomicInfo*/, void * outPtr, size_t const /*arraySize*/ )
 {
 	std::string & out = *static_cast< std::string* >( outPtr );
-	size_t const MAX_TOKEN = 1024;
-	char token[MAX_TOKEN];
+	ovrLexerToken token;
 
-	ovrLexer::ovrResult res = lex.NextToken( token, MAX_TOKEN );
+	ovrLexer::ovrResult res = lex.NextToken( token );
 	if ( res != ovrLexer::LEX_RESULT_OK )
 	{
-		return ovrParseResult( res, "Error parsing '%s': expected string, got '%s'", name, token );
+		return ovrParseResult( res, "Error parsing '%s': expected string, got '%.*s'", name, token.GetPrintLength(), token.GetText() );
 	}
-	
+
+	// compiled data keeps the token rather than the result so that it is localized when it is loaded
+	if ( refl.GetBinaryWriter() != nullptr )
+	{
+		refl.GetBinaryWriter()->WriteString( token );
+	}
+
+	AssignLocalizedString( locale, token, out );
+	return ovrParseResult();
+}
+
+void AssignLocalizedString( ovrLocale const & locale, ovrLexerToken const & token, std::string & out )
+{
 	// we find the start of the string because it may be preceeded by a format specifier (~~w0, ~~RRGGBBAA, etc.)
-	char const * keyPtr = strstr( token, "@string/" );
-	if ( keyPtr != nullptr )
+	ptrdiff_t const keyIndex = token.Find( "@string/" );
+	if ( keyIndex >= 0 )
 	{
-		intptr_t const keyIndex = keyPtr - token;
+		// the key runs to the end of the token, which isn't 0-terminated
+		std::string const key( token.GetText() + keyIndex, token.GetLength() - keyIndex );
 		std::string temp;
-		locale.GetLocalizedString( keyPtr, keyPtr, temp );
-		token[keyIndex] = '\0';
-		out += token;
+		locale.GetLocalizedString( key.c_str(), key.c_str(), temp );
+		out.append( token.GetText(), keyIndex );
 		out += temp;
 	}
 	else
 	{
-		out = token;
+		out.assign( token.GetText(), token.GetLength() );
 	}
-	return ovrParseResult();
 }
 
 ovrParseResult ParseIntVector( ovrReflection & /*refl*/, ovrLocale const & /*locale*/, const char * name, ovrLexer & lex, ovrTypeInfo const * atomicInfo, void * outPtr, size_t const /*arraySize*/ )
 {
 	int * out = static_cast< int* >( outPtr );
-	size_t const MAX_TOKEN = 1024;
-	char token[MAX_TOKEN];
+	ovrLexerToken token;
 
 	ovrParseResult parseRes = ExpectPunctuation( name, lex, "(" );
 	if ( !parseRes ) { return parseRes; }
@@ -278,9 +273,9 @@ ovrParseResult ParseIntVector( ovrReflection & /*refl*/, ovrLocale const & /*loc
 		ovrLexer::ovrResult res = lex.ParseInt( out[i], 0 );
 		if ( res != ovrLexer::LEX_RESULT_OK ) { return ovrParseResult( res, "Error parsing '%s': expected int", name ); }
 		
-		res = lex.ExpectPunctuation( ",)", token, MAX_TOKEN );
-		if ( res != ovrLexer::LEX_RESULT_OK ) { return ovrParseResult( res, "Error parsing '%s': expected ',' or '}', got '%s", name, token ); }
-		if ( !OVR::OVR_strcmp( token, ")" ) )
+		res = lex.ExpectPunctuation( ",)", token );
+		if ( res != ovrLexer::LEX_RESULT_OK ) { return ovrParseResult( res, "Error parsing '%s': expected ',' or '}', got '%.*s", name, token.GetPrintLength(), token.GetText() ); }
+		if ( token.IsChar( ')' ) )
 		{
 			break;	// end of vector
 		}
@@ -292,8 +287,7 @@ ovrParseResult ParseIntVector( ovrReflection & /*refl*/, ovrLocale const & /*loc
 ovrParseResult ParseFloatVector( ovrReflection & /*refl*/, ovrLocale const & /*locale*/, const char * name, ovrLexer & lex, ovrTypeInfo const * atomicInfo, void * outPtr, size_t const /*arraySize*/ )
 {
 	float * out = static_cast< float* >( outPtr );
-	size_t const MAX_TOKEN = 1024;
-	char token[MAX_TOKEN];
+	ovrLexerToken token;
 
 	ovrParseResult parseRes = ExpectPunctuation( name, lex, "(" );
 	if ( !parseRes ) { return parseRes; }
@@ -309,9 +303,9 @@ ovrParseResult ParseFloatVector( ovrReflection & /*refl*/, ovrLocale const & /*l
 		ovrLexer::ovrResult res = lex.ParseFloat( out[i], 0.0f );
 		if ( res != ovrLexer::LEX_RESULT_OK ) { return ovrParseResult( res, "Error parsing '%s': expected float", name ); }
 		
-		res = lex.ExpectPunctuation( ",)", token, MAX_TOKEN );
-		if ( res != ovrLexer::LEX_RESULT_OK ) { return ovrParseResult( res, "Error parsing '%s': expected ',' or '}', got '%s", name, token ); }
-		if ( !OVR::OVR_strcmp( token, ")" ) )
+		res = lex.ExpectPunctuation( ",)", token );
+		if ( res != ovrLexer::LEX_RESULT_OK ) { return ovrParseResult( res, "Error parsing '%s': expected ',' or '}', got '%.*s", name, token.GetPrintLength(), token.GetText() ); }
+		if ( token.IsChar( ')' ) )
 		{
 			break;	// end of vector
 		}
@@ -340,12 +334,13 @@ ovrParseResult::ovrParseResult( ovrLexer::ovrResult const result, char const * f
 	Error = buffer;
 }
 
-static bool IsInteger( char const * token )
+static bool IsInteger( ovrLexerToken const & token )
 {
-	size_t const len = OVR::OVR_strlen( token );
+	size_t const len = token.GetLength();
+	char const * text = token.GetText();
 	for ( size_t i = 0; i < len; ++i )
 	{
-		if ( ( i == 0 && token[i] == '-' ) || ( token[i] >= '0' && token[i] <= '9' ) )
+		if ( ( i == 0 && text[i] == '-' ) || ( text[i] >= '0' && text[i] <= '9' ) )
 		{
 			continue;
 		}
@@ -357,15 +352,14 @@ static bool IsInteger( char const * token )
 ovrParseResult ParseArray( ovrReflection & refl, ovrLocale const & locale, const char * name, ovrLexer & lex, 
 		ovrTypeInfo const * arrayTypeInfo, void * arrayPtr, size_t const arraySize )
 {
-	const int MAX_TOKEN = 1024;
-	char token[MAX_TOKEN];
+	ovrLexerToken token;
 
 	// next token must be either the size of the array or an opening brace
-	ovrLexer::ovrResult result = lex.NextToken( token, MAX_TOKEN );
+	ovrLexer::ovrResult result = lex.NextToken( token );
 	if ( result != ovrLexer::LEX_RESULT_OK ) { return ovrParseResult( result, "Error parsing '%s'", name ); }
 
 	int count; 
-	if ( !OVR::OVR_strcmp( token, "{" ) )
+	if ( token.IsChar( '{' ) )
 	{
 		// a count of 0 for dynamic arrays means grow as items are added
 		count = static_cast< int >( ( arrayTypeInfo->ArrayType == ovrArrayType::OVR_POINTER || arrayTypeInfo->ArrayType == ovrArrayType::OVR_OBJECT ) ? 0 : arraySize );
@@ -377,12 +371,13 @@ ovrParseResult ParseArray( ovrReflection & refl, ovrLocale const & locale, const
 			return ovrParseResult( ovrLexer::LEX_RESULT_ERROR, "Error parsing '%s': size of array should not be specified for non-dynamic arrays.", name );
 		}
 
-		if ( !IsInteger( token ) ) 
+		char countText[32];
+		if ( !IsInteger( token ) || !token.CopyTo( countText, sizeof( countText ) ) ) 
 		{ 
 			return ovrParseResult( ovrLexer::LEX_RESULT_ERROR, "Error parsing '%s': expected integer", name ); 
 		}
 		assert( arrayTypeInfo->ResizeArrayFn != nullptr );
-		count = strtol( token, nullptr, 10 );
+		count = strtol( countText, nullptr, 10 );
 		if ( count <= 0 )
 		{
 			return ovrParseResult( ovrLexer::LEX_RESULT_ERROR, "Error parsing '%s': invalid array size %i", name, count ); 
@@ -393,17 +388,25 @@ ovrParseResult ParseArray( ovrReflection & refl, ovrLocale const & locale, const
 		if ( !parseRes ) { return parseRes; }
 	}
 
+	ovrReflectionBinaryWriter * writer = refl.GetBinaryWriter();
+	if ( writer != nullptr )
+	{
+		writer->BeginArray( count, !token.IsChar( '{' ) );
+	}
+
 	// in an array, each entry is a type name
 	for ( int index = 0; ; ++index )
 	{
-		ovrLexer::ovrResult res = lex.NextToken( token, MAX_TOKEN );
-		if ( res == ovrLexer::LEX_RESULT_EOF ) { return ovrParseResult(); }
-		if ( res ) { return ovrParseResult( res, "Error %d parsing '%s'", name ); }
-
-		if ( !OVR::OVR_strcmp( token, "}" ) )
+		ovrLexer::ovrResult res = lex.NextToken( token );
+		if ( res == ovrLexer::LEX_RESULT_EOF || ( res == ovrLexer::LEX_RESULT_OK && token.IsChar( '}' ) ) )
 		{
+			if ( writer != nullptr )
+			{
+				writer->EndArray();
+			}
 			return ovrParseResult();
 		}
+		if ( res ) { return ovrParseResult( res, "Error %d parsing '%s'", name ); }
 
 		if ( index >= count )
 		{
@@ -422,7 +425,7 @@ ovrParseResult ParseArray( ovrReflection & refl, ovrLocale const & locale, const
 		const ovrTypeInfo * elementTypeInfo = refl.FindTypeInfo( token );
 		if ( elementTypeInfo == nullptr ) 
 		{ 
-			return ovrParseResult( ovrLexer::LEX_RESULT_ERROR, "Error %d parsing '%s': Unknown type '%s'", name, token ); 
+			return ovrParseResult( ovrLexer::LEX_RESULT_ERROR, "Error %d parsing '%s': Unknown type '%.*s'", name, token.GetPrintLength(), token.GetText() ); 
 		}
 
 		if ( arrayTypeInfo->ArrayType == ovrArrayType::C_OBJECT || arrayTypeInfo->ArrayType == ovrArrayType::C_POINTER )
@@ -432,13 +435,18 @@ ovrParseResult ParseArray( ovrReflection & refl, ovrLocale const & locale, const
 
 			int idx = 0;
 			res = lex.ParseInt( idx, 0 );
-			if ( res ) { return ovrParseResult( res, "Error parsing '%s': expected array index, got '%s'", name, token ); }
+			if ( res ) { return ovrParseResult( res, "Error parsing '%s': expected array index", name ); }
 
 			parseRes = ExpectPunctuation( name, lex, "]" );
 			if ( !parseRes ) { return parseRes; }
 
 			if ( idx != index ) { return ovrParseResult( ovrLexer::LEX_RESULT_ERROR, "Error parsing '%s': expected index %d, got %d", name, index, idx ); }
 		}
+
+		if ( writer != nullptr )
+		{
+			writer->BeginElement( index, elementTypeInfo );
+		}
 	
 		// if the array is not an array of pointers, do a placement new on the stack to avoid heap fragmentation
 		void * placementBuffer = nullptr;
@@ -463,6 +471,11 @@ ovrParseResult ParseArray( ovrReflection & refl, ovrLocale const & locale, const
 			parseRes = elementTypeInfo->ParseFn( refl, locale, name, lex, elementTypeInfo, elementPtr, 0 );
 			if ( !parseRes ) { return parseRes; }
 
+			if ( writer != nullptr )
+			{
+				writer->WriteValue( elementTypeInfo, elementPtr );
+			}
+
 			parseRes = ExpectPunctuation( name, lex, ";" );
 			if ( !parseRes ) { return parseRes; }
 		}
@@ -486,9 +499,9 @@ void BuildScope( ovrReflection & refl, ovrTypeInfo const * typeInfo, std::string
 	scope += typeInfo->TypeName;
 }
 
-ovrReflectionOverload const * ovrReflection::FindOverload( char const * scope ) const
+static ovrReflectionOverload const * FindOverloadInList( std::vector< ovrReflectionOverload * > const & overloads, char const * scope )
 {
-	for ( ovrReflectionOverload const * o : Overloads )
+	for ( ovrReflectionOverload const * o : overloads )
 	{
 		if ( OVR::OVR_strcmp( o->GetScope(), scope ) == 0 )
 		{
@@ -498,12 +511,32 @@ ovrReflectionOverload const * ovrReflection::FindOverload( char const * scope )
 	return nullptr;
 }
 
-ovrParseResult ParseObject( ovrReflection & refl, ovrLocale const & locale, const char * name, ovrLexer & lex, 
-		ovrTypeInfo const * objectTypeInfo, void * objPtr, const size_t /*arraySize*/ )
+ovrReflectionOverload const * ovrReflection::FindOverload( char const * scope ) const
 {
+	return FindOverloadInList( Overloads, scope );
+}
+
+void ApplyMemberOverloads( ovrReflection & refl, ovrTypeInfo const * objectTypeInfo, void * objPtr )
+{
+	static std::vector< ovrReflectionOverload * > const noOverloads;
+	ApplyMemberOverloads( refl, objectTypeInfo, objPtr, noOverloads );
+}
+
+void ApplyMemberOverloads( ovrReflection & refl, ovrTypeInfo const * objectTypeInfo, void * objPtr,
+		std::vector< ovrReflectionOverload * > const & pendingOverloads )
+{
+	if ( !refl.HasOverloads() && pendingOverloads.empty() )
+	{
+		return;
+	}
+
 	std::string scope;
 	BuildScope( refl, objectTypeInfo, scope );
 	ovrReflectionOverload const * o = refl.FindOverload( scope.c_str() );
+	if ( o == nullptr )
+	{
+		o = FindOverloadInList( pendingOverloads, scope.c_str() );
+	}
 	if ( o != nullptr && o->OverloadsMemberVar() )
 	{
 		ovrMemberInfo const * overloadedMemberVar = refl.FindMemberReflectionInfo( objectTypeInfo->MemberInfo, o->GetName() );
@@ -521,30 +554,34 @@ ovrParseResult ParseObject( ovrReflection & refl, ovrLocale const & locale, cons
 			}
 		}
 	}
+}
+
+ovrParseResult ParseObject( ovrReflection & refl, ovrLocale const & locale, const char * name, ovrLexer & lex, 
+		ovrTypeInfo const * objectTypeInfo, void * objPtr, const size_t /*arraySize*/ )
+{
+	ApplyMemberOverloads( refl, objectTypeInfo, objPtr );
 
-	const int MAX_TOKEN = 1024;
-	char token[MAX_TOKEN];
+	ovrReflectionBinaryWriter * writer = refl.GetBinaryWriter();
+	ovrLexerToken token;
 
-	ovrLexer::ovrResult result = lex.ExpectPunctuation( "{", token, MAX_TOKEN );
-	if ( result ) { return ovrParseResult( result, "Error parsing '%s': Expected '{', got '%s'", name, token ); }
+	ovrLexer::ovrResult result = lex.ExpectPunctuation( "{", token );
+	if ( result ) { return ovrParseResult( result, "Error parsing '%s': Expected '{', got '%.*s'", name, token.GetPrintLength(), token.GetText() ); }
 
 	// in an object, each entry is a member variable name
 	for ( ; ; ) 
 	{
-		ovrLexer::ovrResult res = lex.NextToken( token, MAX_TOKEN );
-		if ( res == ovrLexer::LEX_RESULT_EOF ) { return ovrParseResult(); }
-		if ( res ) { return ovrParseResult( res, "Error %d parsing '%s'", name ); }
-
-		if ( !OVR::OVR_strcmp( token, "}" ) )
+		ovrLexer::ovrResult res = lex.NextToken( token );
+		if ( res == ovrLexer::LEX_RESULT_EOF || ( res == ovrLexer::LEX_RESULT_OK && token.IsChar( '}' ) ) )
 		{
 			break;
 		}
+		if ( res ) { return ovrParseResult( res, "Error %d parsing '%s'", name ); }
 
 		ovrMemberInfo const * memberInfo = refl.FindMemberReflectionInfoRecursive( objectTypeInfo, token );
 		if ( memberInfo == nullptr )
 		{
 			assert( memberInfo != nullptr );
-			return ovrParseResult( res, "Error parsing '%s': Unknown member '%s", name, token );
+			return ovrParseResult( res, "Error parsing '%s': Unknown member '%.*s", name, token.GetPrintLength(), token.GetText() );
 		}
 
 		void * memberPtr = static_cast< char* >( objPtr ) + memberInfo->Offset;
@@ -556,6 +593,11 @@ ovrParseResult ParseObject( ovrReflection & refl, ovrLocale const & locale, cons
 			return ovrParseResult( res, "Error parsing '%s': Unknown type '%s'", name, memberInfo->TypeName );
 		}
 
+		if ( writer != nullptr )
+		{
+			writer->BeginMember( memberInfo, memberTypeInfo );
+		}
+
 		if ( memberTypeInfo->ParseFn != nullptr )	// if we have a special-case parse function, use it
 		{
 			assert( memberTypeInfo->ParseFn != nullptr );
@@ -569,6 +611,11 @@ ovrParseResult ParseObject( ovrReflection & refl, ovrLocale const & locale, cons
 			ovrParseResult parseRes = memberTypeInfo->ParseFn( refl, locale, name, lex, memberTypeInfo, memberPtr, memberInfo->ArraySize );
 			if ( !parseRes ) { return parseRes; }
 
+			if ( writer != nullptr )
+			{
+				writer->WriteValue( memberTypeInfo, memberPtr );
+			}
+
 			if ( memberInfo->Operator != ovrTypeOperator::ARRAY )
 			{
 				parseRes = ExpectPunctuation( name, lex, ";" );
@@ -584,9 +631,36 @@ ovrParseResult ParseObject( ovrReflection & refl, ovrLocale const & locale, cons
 		}
 	}
 
+	if ( writer != nullptr )
+	{
+		writer->EndObject();
+	}
 	return ovrParseResult();
 }
 
+ovrParseKind GetParseKind( ParseFn_t const parseFn )
+{
+	if ( parseFn == nullptr )
+	{
+		return ovrParseKind::NONE;
+	}
+	if ( parseFn == ParseString )
+	{
+		return ovrParseKind::STRING;
+	}
+	if ( parseFn == ParseArray )
+	{
+		return ovrParseKind::ARRAY;
+	}
+	if ( parseFn == ParseBool || parseFn == ParseInt || parseFn == ParseFloat || parseFn == ParseDouble ||
+			parseFn == ParseEnum || parseFn == ParseBitFlags || parseFn == ParseTypesafeNumber_int || 
+			parseFn == ParseTypesafeNumber_long_long || parseFn == ParseIntVector || parseFn == ParseFloatVector )
+	{
+		return ovrParseKind::POD;
+	}
+	return ovrParseKind::UNKNOWN;
+}
+
 //=============================================================================================
 // ovrReflection
 //=============================================================================================
@@ -626,17 +700,86 @@ void ovrReflection::Shutdown()
 	Overloads.clear();
 }
 
+static uint64_t HashString( uint64_t const hash, char const * str )
+{
+	// the terminator keeps consecutive strings from running together
+	return str != nullptr ? FNV1a64( str, strlen( str ) + 1, hash ) : FNV1a64( "", 1, hash );
+}
+
+template< typename Type >
+static uint64_t HashValue( uint64_t const hash, Type const value )
+{
+	return FNV1a64( &value, sizeof( value ), hash );
+}
+
 void ovrReflection::AddTypeInfoList( ovrTypeInfo const * list )
 {
 	TypeInfoLists.push_back( list );
+
+	if ( TypeInfos.empty() )
+	{
+		TypeInfoHash = FNV1A64_OFFSET_BASIS;
+	}
+
+	uint64_t hash = TypeInfoHash;
+	for ( int i = 0; list[i].TypeName != nullptr; ++i )
+	{
+		ovrTypeInfo const & ti = list[i];
+		TypeInfos.push_back( &ti );
+
+		hash = HashString( hash, ti.TypeName );
+		hash = HashString( hash, ti.ParentTypeName );
+		hash = HashValue( hash, static_cast< uint64_t >( ti.Size ) );
+		hash = HashValue( hash, GetParseKind( ti.ParseFn ) );
+		hash = HashValue( hash, ti.ArrayType );
+		hash = HashValue( hash, ti.Abstract );
+		for ( int j = 0; ti.EnumInfos != nullptr && ti.EnumInfos[j].Name != nullptr; ++j )
+		{
+			hash = HashString( hash, ti.EnumInfos[j].Name );
+			hash = HashValue( hash, ti.EnumInfos[j].Value );
+		}
+		for ( int j = 0; ti.MemberInfo != nullptr && ti.MemberInfo[j].MemberName != nullptr; ++j )
+		{
+			ovrMemberInfo const & mi = ti.MemberInfo[j];
+			hash = HashString( hash, mi.MemberName );
+			hash = HashString( hash, mi.TypeName );
+			hash = HashValue( hash, mi.Operator );
+			hash = HashValue( hash, static_cast< int64_t >( mi.Offset ) );
+			hash = HashValue( hash, static_cast< uint64_t >( mi.ArraySize ) );
+		}
+		// terminate the type so that members can't be mistaken for the next type
+		hash = HashString( hash, nullptr );
+	}
+	TypeInfoHash = hash;
 }
 
-ovrMemberInfo const * ovrReflection::FindMemberReflectionInfoRecursive( ovrTypeInfo const * objectTypeInfo, const char * memberName )
+int ovrReflection::GetTypeInfoIndex( ovrTypeInfo const * typeInfo ) const
+{
+	for ( int i = 0; i < static_cast< int >( TypeInfos.size() ); ++i )
+	{
+		if ( TypeInfos[i] == typeInfo )
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+void ovrReflection::SetBinaryCachePath( char const * cachePath )
+{
+	BinaryCachePath = cachePath != nullptr ? cachePath : "";
+	if ( !BinaryCachePath.empty() && BinaryCachePath.back() != '/' )
+	{
+		BinaryCachePath += '/';
+	}
+}
+
+ovrMemberInfo const * ovrReflection::FindMemberReflectionInfoRecursive( ovrTypeInfo const * objectTypeInfo, ovrLexerToken const & memberName )
 {
 	ovrMemberInfo const * arrayOfMemberType = objectTypeInfo->MemberInfo;
 	for ( int i = 0; arrayOfMemberType[i].MemberName != nullptr; ++i )
 	{
-		if ( !OVR::OVR_strcmp( arrayOfMemberType[i].MemberName, memberName ) )
+		if ( memberName.Equals( arrayOfMemberType[i].MemberName ) )
 		{
 			return &arrayOfMemberType[i];
 		}
@@ -667,10 +810,10 @@ ovrMemberInfo const * ovrReflection::FindMemberReflectionInfo( ovrMemberInfo con
 	return nullptr;
 }
 
-ovrTypeInfo const * ovrReflection::FindTypeInfo( char const * typeName )
+ovrTypeInfo const * ovrReflection::FindTypeInfo( ovrLexerToken const & typeName )
 {
 	assert( TypeInfoLists.size() > 0 );
-	if ( typeName == nullptr || typeName[0] == '\0' )
+	if ( typeName.IsEmpty() )
 	{
 		return nullptr;
 	}
@@ -684,21 +827,21 @@ ovrTypeInfo const * ovrReflection::FindTypeInfo( char const * typeName )
 			return ti;
 		}
 	}
-	ALOG( "FindTypeInfo for '%s' could not be found! ERROR", typeName );
+	ALOG( "FindTypeInfo for '%.*s' could not be found! ERROR", typeName.GetPrintLength(), typeName.GetText() );
 	assert( false );
 	return nullptr;
 }
 
-ovrTypeInfo const * ovrReflection::StaticFindTypeInfo( ovrTypeInfo const * list, char const * typeName )
+ovrTypeInfo const * ovrReflection::StaticFindTypeInfo( ovrTypeInfo const * list, ovrLexerToken const & typeName )
 {
-	if ( typeName == nullptr || typeName[0] == '\0' )
+	if ( typeName.IsEmpty() )
 	{
 		return nullptr;
 	}
 
 	for ( int i = 0; list[i].TypeName != nullptr; ++i )
 	{
-		if ( !OVR::OVR_strcmp( list[i].TypeName, typeName ) )
+		if ( typeName.Equals( list[i].TypeName ) )
 		{
 			return &list[i];
 		}
@@ -22,6 +22,8 @@ struct ovrTypeInfo;
 struct ovrMemberInfo;
 class ovrLocale;
 class ovrReflection;
+class ovrReflectionBinaryWriter;
+class ovrReflectionOverload;
 
 //==============================================================================================
 // Parsing
@@ -63,6 +65,13 @@ ovrParseResult ParseFloatVector( ovrReflection & refl, ovrLocale const & locale,
 ovrParseResult ParseArray( ovrReflection & refl, ovrLocale const & locale, const char * name, ovrLexer & lex, ovrTypeInfo const * arrayTypeInfo, void * objPtr, size_t const arraySize );
 ovrParseResult ParseObject( ovrReflection & refl, ovrLocale const & locale, const char * name, ovrLexer & lex, ovrTypeInfo const * objectTypeInfo, void * objPtr, size_t const arraySize );
 
+// The parts of ParseString and ParseObject that must also run when loading compiled reflection data.
+void AssignLocalizedString( ovrLocale const & locale, ovrLexerToken const & token, std::string & out );
+void ApplyMemberOverloads( ovrReflection & refl, ovrTypeInfo const * objectTypeInfo, void * objPtr );
+// Also looks in pendingOverloads, after the ones already added to refl.
+void ApplyMemberOverloads( ovrReflection & refl, ovrTypeInfo const * objectTypeInfo, void * objPtr,
+		std::vector< ovrReflectionOverload * > const & pendingOverloads );
+
 //==============================================================================================
 // Reflection data types
 //==============================================================================================
@@ -72,6 +81,18 @@ typedef void * (*CreateFn_t)( void * placementBuffer );
 typedef void (*ResizeArrayFn_t)( void * objPtr, const int newSize );
 typedef void (*SetArrayElementFn_t)( void * objPtr, const int index, void * elementPtr );
 
+// What a ParseFn writes, so that its result can be stored in compiled reflection data.
+enum class ovrParseKind : char
+{
+	NONE,		// no ParseFn
+	POD,		// writes plain data to the first Size bytes
+	STRING,		// ParseString
+	ARRAY,		// ParseArray
+	UNKNOWN		// any other ParseFn, which cannot be compiled
+};
+
+ovrParseKind GetParseKind( ParseFn_t const parseFn );
+
 enum class ovrArrayType : char
 {
 	NONE,
@@ -180,23 +201,48 @@ public:
 	// Add an additional list of types. The list must be terminated by a a
 	void							AddTypeInfoList( ovrTypeInfo const * list );
 
-	ovrMemberInfo const *			FindMemberReflectionInfoRecursive( ovrTypeInfo const * objectTypeInfo, const char * memberName );
+	// names can be tokens straight from the lexer, or 0-terminated strings
+	ovrMemberInfo const *			FindMemberReflectionInfoRecursive( ovrTypeInfo const * objectTypeInfo, ovrLexerToken const & memberName );
 	ovrMemberInfo const *			FindMemberReflectionInfo( ovrMemberInfo const * arrayOfMemberType, const char * memberName );
-	ovrTypeInfo const *				FindTypeInfo( char const * typeName );
+	ovrTypeInfo const *				FindTypeInfo( ovrLexerToken const & typeName );
 
 	void							AddOverload( ovrReflectionOverload * o ) { Overloads.push_back( o ); }
 	ovrReflectionOverload const *	FindOverload( char const * scope ) const;
+	bool							HasOverloads() const { return !Overloads.empty(); }
+
+	// Types are numbered in the order they were added, so compiled data can refer to them by index.
+	int								GetNumTypeInfos() const { return static_cast< int >( TypeInfos.size() ); }
+	ovrTypeInfo const *				GetTypeInfo( int const index ) const { return TypeInfos[index]; }
+	int								GetTypeInfoIndex( ovrTypeInfo const * typeInfo ) const;
+	// Hash of the layout of every type, used to reject compiled data written by a different build.
+	uint64_t						GetTypeInfoHash() const { return TypeInfoHash; }
+
+	// While a writer is set, the Parse* functions record what they parse to it.
+	void							SetBinaryWriter( ovrReflectionBinaryWriter * writer ) { BinaryWriter = writer; }
+	ovrReflectionBinaryWriter *		GetBinaryWriter() const { return BinaryWriter; }
+
+	// If set, menus loaded from reflection data are compiled and cached in this folder.
+	void							SetBinaryCachePath( char const * cachePath );
+	char const *					GetBinaryCachePath() const { return BinaryCachePath.c_str(); }
 
 protected:
-	static ovrTypeInfo const *		StaticFindTypeInfo( ovrTypeInfo const * list, char const * typeName );
+	static ovrTypeInfo const *		StaticFindTypeInfo( ovrTypeInfo const * list, ovrLexerToken const & typeName );
 
 
 private:
 	std::vector< ovrTypeInfo const * >		TypeInfoLists;
+	std::vector< ovrTypeInfo const * >		TypeInfos;		// every type of every list, in order
 	std::vector< ovrReflectionOverload* >	Overloads;
+	uint64_t								TypeInfoHash;
+	ovrReflectionBinaryWriter *				BinaryWriter;
+	std::string								BinaryCachePath;
 
 	// can only be allocated and deleted by ovrReflection::Create and ovrReflection::Destroy
-	ovrReflection() { };	
+	ovrReflection() 
+		: TypeInfoHash( 0 )
+		, BinaryWriter( nullptr )
+	{
+	}
 	virtual	~ovrReflection() { }
 };
 	
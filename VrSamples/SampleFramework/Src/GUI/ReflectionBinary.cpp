@@ -0,0 +1,505 @@
+/************************************************************************************
+
+Filename    :   ReflectionBinary.cpp
+Content     :   Compiled (binary) form of reflection data.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include "ReflectionBinary.h"
+
+#include "Misc/Hash.h"
+
+#include <alloca.h>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+namespace OVRFW {
+
+static const uint32_t	REFLECTION_BINARY_MAGIC		= 0x4c46524f;	// "ORFL"
+static const uint32_t	REFLECTION_BINARY_VERSION	= 1;
+
+// ends a list of members or array elements in place of a type index
+static const uint16_t	END_OF_LIST					= 0xffff;
+
+enum ovrRecordTag
+{
+	RECORD_TAG_END,
+	RECORD_TAG_OVERLOAD,
+	RECORD_TAG_ARRAY
+};
+
+//==============================
+// HashReflectionSource
+// The source is hashed on every load, so this mixes 8 bytes at a time instead of doing FNV-1a
+// per byte, which took as long as loading the compiled data.
+uint64_t HashReflectionSource( std::vector< uint8_t > const & source )
+{
+	uint8_t const * p = source.data();
+	size_t const size = source.size();
+	uint64_t hash = FNV1A64_OFFSET_BASIS ^ size;
+	size_t i = 0;
+	for ( ; i + sizeof( uint64_t ) <= size; i += sizeof( uint64_t ) )
+	{
+		uint64_t word;
+		memcpy( &word, p + i, sizeof( word ) );
+		hash = ( hash ^ word ) * 0x9e3779b97f4a7c15ULL;
+		hash ^= hash >> 29;
+	}
+	for ( ; i < size; ++i )
+	{
+		hash = ( hash ^ p[i] ) * FNV1A64_PRIME;
+	}
+	return hash;
+}
+
+//==============================
+// ReflectionBinaryCacheFileName
+std::string ReflectionBinaryCacheFileName( ovrReflection const & refl, uint64_t const sourceHash, size_t const sourceSize )
+{
+	std::string cachePath = refl.GetBinaryCachePath();
+	if ( cachePath.empty() )
+	{
+		return cachePath;
+	}
+	char name[64];
+	snprintf( name, sizeof( name ), "refl_v%u_%016" PRIx64 "_%zu.bin", REFLECTION_BINARY_VERSION, sourceHash, sourceSize );
+	return cachePath + name;
+}
+
+//==============================================================================================
+// ovrReflectionBinaryWriter
+//==============================================================================================
+
+//==============================
+// ovrReflectionBinaryWriter::ovrReflectionBinaryWriter
+ovrReflectionBinaryWriter::ovrReflectionBinaryWriter( ovrReflection const & refl, uint64_t const sourceHash )
+	: Refl( refl )
+	, Failed( false )
+{
+	Buffer.reserve( 16 * 1024 );
+	Put( REFLECTION_BINARY_MAGIC );
+	Put( REFLECTION_BINARY_VERSION );
+	Put( refl.GetTypeInfoHash() );
+	Put( sourceHash );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::Put
+template< typename Type >
+void ovrReflectionBinaryWriter::Put( Type const value )
+{
+	PutBytes( &value, sizeof( value ) );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::PutBytes
+void ovrReflectionBinaryWriter::PutBytes( void const * data, size_t const size )
+{
+	uint8_t const * bytes = static_cast< uint8_t const * >( data );
+	Buffer.insert( Buffer.end(), bytes, bytes + size );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::PutString
+void ovrReflectionBinaryWriter::PutString( char const * str, size_t const length )
+{
+	Put( static_cast< uint32_t >( length ) );
+	PutBytes( str, length );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::PutType
+void ovrReflectionBinaryWriter::PutType( ovrTypeInfo const * typeInfo )
+{
+	const int index = Refl.GetTypeInfoIndex( typeInfo );
+	if ( index < 0 || index >= END_OF_LIST )
+	{
+		Failed = true;
+	}
+	Put( static_cast< uint16_t >( index ) );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteOverload
+void ovrReflectionBinaryWriter::WriteOverload( ovrReflectionOverload const & o )
+{
+	switch ( o.GetType() )
+	{
+		case ovrReflectionOverload::OVERLOAD_FLOAT_DEFAULT_VALUE:
+			Put( static_cast< uint8_t >( RECORD_TAG_OVERLOAD ) );
+			Put( static_cast< uint8_t >( o.GetType() ) );
+			PutString( o.GetScope(), strlen( o.GetScope() ) );
+			PutString( o.GetName(), strlen( o.GetName() ) );
+			Put( static_cast< ovrReflectionOverload_FloatDefaultValue const & >( o ).GetValue() );
+			break;
+		default:
+			Failed = true;
+			break;
+	}
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteArrayRecord
+void ovrReflectionBinaryWriter::WriteArrayRecord( ovrTypeInfo const * arrayTypeInfo )
+{
+	Put( static_cast< uint8_t >( RECORD_TAG_ARRAY ) );
+	PutType( arrayTypeInfo );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::BeginArray
+void ovrReflectionBinaryWriter::BeginArray( int const count, bool const resized )
+{
+	Put( static_cast< int32_t >( count ) );
+	Put( static_cast< uint8_t >( resized ) );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::BeginElement
+void ovrReflectionBinaryWriter::BeginElement( int const index, ovrTypeInfo const * elementTypeInfo )
+{
+	PutType( elementTypeInfo );
+	Put( static_cast< int32_t >( index ) );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::EndArray
+void ovrReflectionBinaryWriter::EndArray()
+{
+	Put( END_OF_LIST );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::BeginMember
+void ovrReflectionBinaryWriter::BeginMember( ovrMemberInfo const * memberInfo, ovrTypeInfo const * memberTypeInfo )
+{
+	PutType( memberTypeInfo );
+	Put( static_cast< uint32_t >( memberInfo->Offset ) );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::EndObject
+void ovrReflectionBinaryWriter::EndObject()
+{
+	Put( END_OF_LIST );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteValue
+void ovrReflectionBinaryWriter::WriteValue( ovrTypeInfo const * typeInfo, void const * valuePtr )
+{
+	switch ( GetParseKind( typeInfo->ParseFn ) )
+	{
+		case ovrParseKind::POD:
+			// the whole value, so that bytes the ParseFn didn't write are restored as they were
+			PutBytes( valuePtr, typeInfo->Size );
+			break;
+		case ovrParseKind::STRING:
+		case ovrParseKind::ARRAY:
+			// already recorded while parsing
+			break;
+		default:
+			Failed = true;
+			break;
+	}
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteString
+void ovrReflectionBinaryWriter::WriteString( ovrLexerToken const & token )
+{
+	PutString( token.GetText(), token.GetLength() );
+}
+
+//==============================
+// ovrReflectionBinaryWriter::Finish
+std::vector< uint8_t > const & ovrReflectionBinaryWriter::Finish()
+{
+	Put( static_cast< uint8_t >( RECORD_TAG_END ) );
+	return Buffer;
+}
+
+//==============================================================================================
+// ovrReflectionBinaryReader
+//==============================================================================================
+
+//==============================
+// ovrReflectionBinaryReader::ovrReflectionBinaryReader
+ovrReflectionBinaryReader::ovrReflectionBinaryReader( ovrReflection & refl, ovrLocale const & locale, std::vector< uint8_t > const & buffer )
+	: Refl( refl )
+	, Locale( locale )
+	, Cur( buffer.data() )
+	, End( buffer.data() + buffer.size() )
+{
+}
+
+//==============================
+// ovrReflectionBinaryReader::~ovrReflectionBinaryReader
+ovrReflectionBinaryReader::~ovrReflectionBinaryReader()
+{
+	for ( ovrReflectionOverload * o : PendingOverloads )
+	{
+		delete o;
+	}
+}
+
+//==============================
+// ovrReflectionBinaryReader::CommitOverloads
+void ovrReflectionBinaryReader::CommitOverloads()
+{
+	for ( ovrReflectionOverload * o : PendingOverloads )
+	{
+		Refl.AddOverload( o );
+	}
+	PendingOverloads.clear();
+}
+
+//==============================
+// ovrReflectionBinaryReader::Get
+template< typename Type >
+bool ovrReflectionBinaryReader::Get( Type & value )
+{
+	return GetBytes( &value, sizeof( value ) );
+}
+
+//==============================
+// ovrReflectionBinaryReader::GetBytes
+bool ovrReflectionBinaryReader::GetBytes( void * data, size_t const size )
+{
+	if ( static_cast< size_t >( End - Cur ) < size )
+	{
+		return false;
+	}
+	memcpy( data, Cur, size );
+	Cur += size;
+	return true;
+}
+
+//==============================
+// ovrReflectionBinaryReader::GetString
+// Returns a view of the string in the buffer.
+bool ovrReflectionBinaryReader::GetString( ovrLexerToken & str )
+{
+	uint32_t length;
+	if ( !Get( length ) || static_cast< size_t >( End - Cur ) < length )
+	{
+		return false;
+	}
+	str = ovrLexerToken( reinterpret_cast< char const * >( Cur ), length );
+	Cur += length;
+	return true;
+}
+
+//==============================
+// ovrReflectionBinaryReader::GetType
+bool ovrReflectionBinaryReader::GetType( ovrTypeInfo const * & typeInfo, bool & isEnd )
+{
+	uint16_t index;
+	if ( !Get( index ) )
+	{
+		return false;
+	}
+	isEnd = index == END_OF_LIST;
+	if ( isEnd )
+	{
+		typeInfo = nullptr;
+		return true;
+	}
+	if ( index >= Refl.GetNumTypeInfos() )
+	{
+		return false;
+	}
+	typeInfo = Refl.GetTypeInfo( index );
+	return true;
+}
+
+//==============================
+// ovrReflectionBinaryReader::ReadHeader
+bool ovrReflectionBinaryReader::ReadHeader( uint64_t const sourceHash )
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t typeInfoHash;
+	uint64_t fileSourceHash;
+	if ( !Get( magic ) || !Get( version ) || !Get( typeInfoHash ) || !Get( fileSourceHash ) )
+	{
+		return false;
+	}
+	return magic == REFLECTION_BINARY_MAGIC && version == REFLECTION_BINARY_VERSION &&
+			typeInfoHash == Refl.GetTypeInfoHash() && fileSourceHash == sourceHash;
+}
+
+//==============================
+// ovrReflectionBinaryReader::NextRecord
+ovrReflectionBinaryReader::ovrRecord ovrReflectionBinaryReader::NextRecord( ovrTypeInfo const * & arrayTypeInfo )
+{
+	arrayTypeInfo = nullptr;
+	for ( ; ; )
+	{
+		uint8_t tag;
+		if ( !Get( tag ) )
+		{
+			return RECORD_ERROR;
+		}
+		if ( tag == RECORD_TAG_END )
+		{
+			return RECORD_END;
+		}
+		if ( tag == RECORD_TAG_ARRAY )
+		{
+			bool isEnd;
+			if ( !GetType( arrayTypeInfo, isEnd ) || isEnd || GetParseKind( arrayTypeInfo->ParseFn ) != ovrParseKind::ARRAY )
+			{
+				return RECORD_ERROR;
+			}
+			return RECORD_ARRAY;
+		}
+		if ( tag != RECORD_TAG_OVERLOAD )
+		{
+			return RECORD_ERROR;
+		}
+
+		uint8_t type;
+		ovrLexerToken scope;
+		ovrLexerToken name;
+		float value;
+		if ( !Get( type ) || type != ovrReflectionOverload::OVERLOAD_FLOAT_DEFAULT_VALUE ||
+				!GetString( scope ) || !GetString( name ) || !Get( value ) )
+		{
+			return RECORD_ERROR;
+		}
+		PendingOverloads.push_back( new ovrReflectionOverload_FloatDefaultValue( scope.ToString().c_str(), name.ToString().c_str(), value ) );
+	}
+}
+
+//==============================
+// ovrReflectionBinaryReader::ReadArray
+// Follows the same steps as ParseArray.
+bool ovrReflectionBinaryReader::ReadArray( ovrTypeInfo const * arrayTypeInfo, void * arrayPtr )
+{
+	int32_t count;
+	uint8_t resized;
+	if ( !Get( count ) || !Get( resized ) || count < 0 )
+	{
+		return false;
+	}
+	if ( resized != 0 )
+	{
+		if ( count <= 0 || arrayTypeInfo->ResizeArrayFn == nullptr )
+		{
+			return false;
+		}
+		arrayTypeInfo->ResizeArrayFn( arrayPtr, count );
+	}
+
+	for ( ; ; )
+	{
+		ovrTypeInfo const * elementTypeInfo;
+		bool isEnd;
+		if ( !GetType( elementTypeInfo, isEnd ) )
+		{
+			return false;
+		}
+		if ( isEnd )
+		{
+			return true;
+		}
+
+		int32_t index;
+		if ( !Get( index ) || index < 0 || elementTypeInfo->CreateFn == nullptr || arrayTypeInfo->SetArrayElementFn == nullptr )
+		{
+			return false;
+		}
+		if ( index >= count )
+		{
+			// a count of 0 means the array grows as items are added
+			if ( count != 0 || arrayTypeInfo->ResizeArrayFn == nullptr )
+			{
+				return false;
+			}
+			arrayTypeInfo->ResizeArrayFn( arrayPtr, index + 1 );
+		}
+
+		void * placementBuffer = nullptr;
+		if ( arrayTypeInfo->ArrayType != ovrArrayType::OVR_POINTER && arrayTypeInfo->ArrayType != ovrArrayType::C_POINTER )
+		{
+			placementBuffer = alloca( elementTypeInfo->Size );
+		}
+		void * elementPtr = elementTypeInfo->CreateFn( placementBuffer );
+
+		const bool ok = elementTypeInfo->MemberInfo != nullptr ? ReadObject( elementTypeInfo, elementPtr ) : ReadValue( elementTypeInfo, elementPtr );
+
+		// stored even if it failed, so the caller frees it along with the rest of the array
+		arrayTypeInfo->SetArrayElementFn( arrayPtr, index, elementPtr );
+		if ( !ok )
+		{
+			return false;
+		}
+	}
+}
+
+//==============================
+// ovrReflectionBinaryReader::ReadObject
+// Follows the same steps as ParseObject.
+bool ovrReflectionBinaryReader::ReadObject( ovrTypeInfo const * objectTypeInfo, void * objPtr )
+{
+	ApplyMemberOverloads( Refl, objectTypeInfo, objPtr, PendingOverloads );
+
+	for ( ; ; )
+	{
+		ovrTypeInfo const * memberTypeInfo;
+		bool isEnd;
+		if ( !GetType( memberTypeInfo, isEnd ) )
+		{
+			return false;
+		}
+		if ( isEnd )
+		{
+			return true;
+		}
+
+		uint32_t offset;
+		if ( !Get( offset ) || offset >= objectTypeInfo->Size )
+		{
+			return false;
+		}
+		void * memberPtr = static_cast< uint8_t * >( objPtr ) + offset;
+
+		const bool ok = memberTypeInfo->ParseFn != nullptr ? ReadValue( memberTypeInfo, memberPtr ) : ReadObject( memberTypeInfo, memberPtr );
+		if ( !ok )
+		{
+			return false;
+		}
+	}
+}
+
+//==============================
+// ovrReflectionBinaryReader::ReadValue
+bool ovrReflectionBinaryReader::ReadValue( ovrTypeInfo const * typeInfo, void * valuePtr )
+{
+	switch ( GetParseKind( typeInfo->ParseFn ) )
+	{
+		case ovrParseKind::POD:
+			return GetBytes( valuePtr, typeInfo->Size );
+		case ovrParseKind::STRING:
+		{
+			ovrLexerToken token;
+			if ( !GetString( token ) )
+			{
+				return false;
+			}
+			AssignLocalizedString( Locale, token, *static_cast< std::string * >( valuePtr ) );
+			return true;
+		}
+		case ovrParseKind::ARRAY:
+			return ReadArray( typeInfo, valuePtr );
+		default:
+			return false;
+	}
+}
+
+}	// namespace OVRFW
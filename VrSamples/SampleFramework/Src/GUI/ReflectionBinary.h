@@ -0,0 +1,137 @@
+/************************************************************************************
+
+Filename    :   ReflectionBinary.h
+Content     :   Compiled (binary) form of reflection data.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include "Reflection.h"
+
+namespace OVRFW {
+
+//==============================================================================================
+// Compiled reflection data
+//
+// A compiled file is a recording of a text parse. Every type is stored as an index into the
+// ovrReflection type list and every member as its offset, so loading it needs no lexing and no
+// name look-ups. Values are stored as the bytes their ParseFn wrote, except that strings keep
+// their token so that "@string/" keys are still localized for the current locale when loaded.
+//
+// Files are only valid for the ovrReflection::GetTypeInfoHash() and the source text they were
+// compiled from. Both are checked by the header, and if either differs the text must be parsed.
+//==============================================================================================
+
+// Hash of the source text, which identifies the text a compiled file was made from.
+uint64_t		HashReflectionSource( std::vector< uint8_t > const & source );
+
+// Returns the cache file name for source text, or an empty string if refl has no cache path.
+std::string		ReflectionBinaryCacheFileName( ovrReflection const & refl, uint64_t const sourceHash, size_t const sourceSize );
+
+//==============================================================
+// ovrReflectionBinaryWriter
+//
+// Set with ovrReflection::SetBinaryWriter while parsing. The Parse* functions
+// call the Begin* / End* / Write* methods as they go; the caller only writes
+// the top-level records.
+//==============================================================
+class ovrReflectionBinaryWriter
+{
+public:
+	ovrReflectionBinaryWriter( ovrReflection const & refl, uint64_t const sourceHash );
+
+	// top-level records
+	void		WriteOverload( ovrReflectionOverload const & o );
+	void		WriteArrayRecord( ovrTypeInfo const * arrayTypeInfo );	// must be followed by ParseArray
+
+	// recorded by the Parse* functions
+	void		BeginArray( int const count, bool const resized );
+	void		BeginElement( int const index, ovrTypeInfo const * elementTypeInfo );
+	void		EndArray();
+	void		BeginMember( ovrMemberInfo const * memberInfo, ovrTypeInfo const * memberTypeInfo );
+	void		EndObject();
+	void		WriteValue( ovrTypeInfo const * typeInfo, void const * valuePtr );
+	void		WriteString( ovrLexerToken const & token );
+
+	// true if something was parsed that can't be compiled
+	bool		HasFailed() const { return Failed; }
+
+	// terminates the data and returns it
+	std::vector< uint8_t > const &	Finish();
+
+private:
+	ovrReflection const &	Refl;
+	std::vector< uint8_t >	Buffer;
+	bool					Failed;
+
+	template< typename Type >
+	void		Put( Type const value );
+	void		PutBytes( void const * data, size_t const size );
+	void		PutString( char const * str, size_t const length );
+	void		PutType( ovrTypeInfo const * typeInfo );
+};
+
+//==============================================================
+// ovrReflectionBinaryReader
+//
+// Loads compiled reflection data in a single pass, creating and filling in
+// objects exactly as ParseArray / ParseObject would have.
+//==============================================================
+class ovrReflectionBinaryReader
+{
+public:
+	enum ovrRecord
+	{
+		RECORD_ARRAY,	// an array follows, call ReadArray
+		RECORD_END,		// no more records
+		RECORD_ERROR
+	};
+
+	ovrReflectionBinaryReader( ovrReflection & refl, ovrLocale const & locale, std::vector< uint8_t > const & buffer );
+	// Frees any overloads that were not committed.
+	~ovrReflectionBinaryReader();
+
+	// returns false if the data was compiled from other source text or with other reflection data
+	bool		ReadHeader( uint64_t const sourceHash );
+
+	// Reads any overloads that precede the next array and returns the array's type in arrayTypeInfo.
+	// The overloads apply to the objects read after them, but are only added to the ovrReflection
+	// object by CommitOverloads, so a load that fails part way, and is then parsed from the source
+	// text instead, doesn't add them twice.
+	ovrRecord	NextRecord( ovrTypeInfo const * & arrayTypeInfo );
+
+	// If it fails, the element being read is still stored in the array, so it is freed with the array.
+	bool		ReadArray( ovrTypeInfo const * arrayTypeInfo, void * arrayPtr );
+
+	// Adds the overloads read so far to the ovrReflection object. Call once the whole file has loaded.
+	void		CommitOverloads();
+
+private:
+	ovrReflection &			Refl;
+	ovrLocale const &		Locale;
+	uint8_t const *			Cur;
+	uint8_t const *			End;
+	std::vector< ovrReflectionOverload * >	PendingOverloads;
+
+	// not copyable
+	ovrReflectionBinaryReader( ovrReflectionBinaryReader const & ) = delete;
+	ovrReflectionBinaryReader &	operator=( ovrReflectionBinaryReader const & ) = delete;
+
+	template< typename Type >
+	bool		Get( Type & value );
+	bool		GetBytes( void * data, size_t const size );
+	bool		GetString( ovrLexerToken & str );
+	bool		GetType( ovrTypeInfo const * & typeInfo, bool & isEnd );
+
+	bool		ReadObject( ovrTypeInfo const * objectTypeInfo, void * objPtr );
+	bool		ReadValue( ovrTypeInfo const * typeInfo, void * valuePtr );
+};
+
+}	// namespace OVRFW
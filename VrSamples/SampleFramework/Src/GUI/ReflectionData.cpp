@@ -35,35 +35,39 @@ namespace OVRFW {
 ovrEnumInfo HorizontalJustification_Enums[] = {
 	{ "HORIZONTAL_LEFT",	0 },
 	{ "HORIZONTAL_CENTER",	1 },
-	{ "HORIZONTAL_RIGHT",	2 }
+	{ "HORIZONTAL_RIGHT",	2 },
+	{ }
 };
-OVR_VERIFY_ARRAY_SIZE( HorizontalJustification_Enums, 3 );
+OVR_VERIFY_ARRAY_SIZE( HorizontalJustification_Enums, 4 );
 
 ovrEnumInfo VerticalJustification_Enums[] =
 {
 	{ "VERTICAL_BASELINE",				0 },
 	{ "VERTICAL_CENTER",				1 },
 	{ "VERTICAL_CENTER_FIXEDHEIGHT",	2 },
-	{ "VERTICAL_TOP",					3 }
+	{ "VERTICAL_TOP",					3 },
+	{ }
 };
-OVR_VERIFY_ARRAY_SIZE( VerticalJustification_Enums, 4 );
+OVR_VERIFY_ARRAY_SIZE( VerticalJustification_Enums, 5 );
 
 ovrEnumInfo eContentFlags_Enums[] =
 {
 	{ "CONTENT_NONE",   0 },
 	{ "CONTENT_SOLID",	1 },
 	{ "CONTENT_ALL",	0x7fffffff },
+	{ }
 };
-OVR_VERIFY_ARRAY_SIZE( eContentFlags_Enums, 3 );
+OVR_VERIFY_ARRAY_SIZE( eContentFlags_Enums, 4 );
 
 ovrEnumInfo VRMenuObjectType_Enums[] =
 {
 	{ "VRMENU_CONTAINER",	0 },
 	{ "VRMENU_STATIC",		1 },
 	{ "VRMENU_BUTTON",		2 },
-	{ "VRMENU_MAX",			3 }
+	{ "VRMENU_MAX",			3 },
+	{ }
 };
-OVR_VERIFY_ARRAY_SIZE( VRMenuObjectType_Enums, VRMENU_MAX + 1 );
+OVR_VERIFY_ARRAY_SIZE( VRMenuObjectType_Enums, VRMENU_MAX + 2 );
 
 ovrEnumInfo VRMenuObjectFlag_Enums[] =
 {
@@ -82,16 +86,18 @@ ovrEnumInfo VRMenuObjectFlag_Enums[] =
 	{ "VRMENUOBJECT_RENDER_HIERARCHY_ORDER",	12 },
 	{ "VRMENUOBJECT_FLAG_BILLBOARD",			13 },
 	{ "VRMENUOBJECT_DONT_MOD_PARENT_COLOR",		14 },
-	{ "VRMENUOBJECT_INSTANCE_TEXT",				15 }
+	{ "VRMENUOBJECT_INSTANCE_TEXT",				15 },
+	{ }
 };
-OVR_VERIFY_ARRAY_SIZE( VRMenuObjectFlag_Enums, VRMENUOBJECT_MAX );
+OVR_VERIFY_ARRAY_SIZE( VRMenuObjectFlag_Enums, VRMENUOBJECT_MAX + 1 );
 
 ovrEnumInfo VRMenuObjectInitFlag_Enums[] =
 {
 	{ "VRMENUOBJECT_INIT_ALIGN_TO_VIEW", 0 },
-	{ "VRMENUOBJECT_INIT_FORCE_POSITION", 1 }
+	{ "VRMENUOBJECT_INIT_FORCE_POSITION", 1 },
+	{ }
 };
-OVR_VERIFY_ARRAY_SIZE( VRMenuObjectInitFlag_Enums, 2 );
+OVR_VERIFY_ARRAY_SIZE( VRMenuObjectInitFlag_Enums, 3 );
 
 ovrEnumInfo SurfaceTextureType_Enums[] =
 {
@@ -101,13 +107,15 @@ ovrEnumInfo SurfaceTextureType_Enums[] =
 	{ "SURFACE_TEXTURE_COLOR_RAMP",				3 },
 	{ "SURFACE_TEXTURE_COLOR_RAMP_TARGET",		4 },
 	{ "SURFACE_TEXTURE_ALPHA_MASK",				5 },
-	{ "SURFACE_TEXTURE_MAX",					6 }
+	{ "SURFACE_TEXTURE_MAX",					6 },
+	{ }
 };
-OVR_VERIFY_ARRAY_SIZE( SurfaceTextureType_Enums, SURFACE_TEXTURE_MAX + 1 );
+OVR_VERIFY_ARRAY_SIZE( SurfaceTextureType_Enums, SURFACE_TEXTURE_MAX + 2 );
 
 ovrEnumInfo VRMenuId_Enums[] =
 {
-	{ "INVALID_MENU_ID", INT_MIN }
+	{ "INVALID_MENU_ID", INT_MIN },
+	{ }
 };
 
 ovrEnumInfo VRMenuEventType_Enums[] =
@@ -135,24 +143,27 @@ ovrEnumInfo VRMenuEventType_Enums[] =
 	{ "VRMENU_EVENT_UPDATE_OBJECT", 		20 },
 	{ "VRMENU_EVENT_SWIPE_COMPLETE",		21 },
 	{ "VRMENU_EVENT_ITEM_ACTION_COMPLETE",	22 },	
-	{ "VRMENU_EVENT_MAX",					23 }
+	{ "VRMENU_EVENT_MAX",					23 },
+	{ }
 };
-OVR_VERIFY_ARRAY_SIZE( VRMenuEventType_Enums, VRMENU_EVENT_MAX + 1 );
+OVR_VERIFY_ARRAY_SIZE( VRMenuEventType_Enums, VRMENU_EVENT_MAX + 2 );
 
 ovrEnumInfo AnimState_Enums[] =
 {
 	{ "ANIMSTATE_PAUSED",	0 },
-	{ "ANIMSTATE_PLAYING",	1 }
+	{ "ANIMSTATE_PLAYING",	1 },
+	{ }
 };
-OVR_VERIFY_ARRAY_SIZE( AnimState_Enums, OvrAnimComponent::ANIMSTATE_MAX );
+OVR_VERIFY_ARRAY_SIZE( AnimState_Enums, OvrAnimComponent::ANIMSTATE_MAX + 1 );
 
 ovrEnumInfo EventDispatchType_Enums[] =
 {
 	{ "EVENT_DISPATCH_TARGET",		0 },
 	{ "EVENT_DISPATCH_FOCUS",		1 },
-	{ "EVENT_DISPATCH_BROADCAST",	2 }
+	{ "EVENT_DISPATCH_BROADCAST",	2 },
+	{ }
 };
-OVR_VERIFY_ARRAY_SIZE( EventDispatchType_Enums, EVENT_DISPATCH_MAX );
+OVR_VERIFY_ARRAY_SIZE( EventDispatchType_Enums, EVENT_DISPATCH_MAX + 1 );
 
 template< typename T >
 T * CreateObject( void * placementBuffer )
@@ -0,0 +1,471 @@
+/************************************************************************************
+
+Filename    :   ThumbnailCache.cpp
+Content     :   Persistent cache of compressed thumbnails packed into texture pages.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include "ThumbnailCache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+
+#include "Render/Egl.h"
+#include "Render/TextureTranscode.h"
+#include "Misc/Log.h"
+
+namespace OVRFW {
+
+static const uint32_t	INDEX_MAGIC		= 0x31435454;	// "TTC1"
+static const uint32_t	INDEX_VERSION	= 1;
+static const int		BLOCK_SIZE		= 16;			// bytes per 4x4 ETC2 RGBA block
+static const int		MAX_PAGE_SIZE	= 2048;			// page texture width and height
+
+struct ovrIndexHeader
+{
+	uint32_t	Magic;
+	uint32_t	Version;
+	uint32_t	ThumbWidth;
+	uint32_t	ThumbHeight;
+	uint32_t	TilesPerRow;
+	uint32_t	TilesPerColumn;
+};
+
+// followed by PathLength bytes of path
+struct ovrIndexRecord
+{
+	int64_t		ModTime;
+	int64_t		FileSize;
+	int32_t		TileIndex;
+	uint32_t	PathLength;
+};
+
+//==============================
+// GetSourceStat
+static bool GetSourceStat( char const * sourcePath, int64_t & modTime, int64_t & fileSize )
+{
+	struct stat st;
+	if ( stat( sourcePath, &st ) != 0 )
+	{
+		return false;
+	}
+	modTime = static_cast< int64_t >( st.st_mtime );
+	fileSize = static_cast< int64_t >( st.st_size );
+	return true;
+}
+
+//==============================
+// ovrThumbnailCache::ovrThumbnailCache
+ovrThumbnailCache::ovrThumbnailCache()
+	: ThumbWidth( 0 )
+	, ThumbHeight( 0 )
+	, TileWidth( 0 )
+	, TileHeight( 0 )
+	, TilesPerRow( 0 )
+	, TilesPerColumn( 0 )
+	, TilesPerPage( 1 )
+	, MaxTiles( 0 )
+	, NumTiles( 0 )
+	, IndexEnd( 0 )
+{
+}
+
+//==============================
+// ovrThumbnailCache::~ovrThumbnailCache
+ovrThumbnailCache::~ovrThumbnailCache()
+{
+	Close();
+}
+
+//==============================
+// ovrThumbnailCache::Open
+bool ovrThumbnailCache::Open( char const * pathPrefix, int const thumbWidth, int const thumbHeight, int const maxPages )
+{
+	Close();
+
+	if ( pathPrefix == nullptr || pathPrefix[0] == '\0' || thumbWidth <= 0 || thumbHeight <= 0 || maxPages <= 0 )
+	{
+		return false;
+	}
+
+	std::lock_guard< std::mutex > lk( Mutex );
+
+	PathPrefix = pathPrefix;
+	ThumbWidth = thumbWidth;
+	ThumbHeight = thumbHeight;
+	TileWidth = ( thumbWidth + 3 ) & ~3;
+	TileHeight = ( thumbHeight + 3 ) & ~3;
+	TilesPerRow = std::max( 1, MAX_PAGE_SIZE / TileWidth );
+	TilesPerColumn = std::max( 1, MAX_PAGE_SIZE / TileHeight );
+	TilesPerPage = TilesPerRow * TilesPerColumn;
+	MaxTiles = TilesPerPage * maxPages;
+
+	if ( !ReadIndex() && !ResetIndex() )
+	{
+		ALOGW( "ovrThumbnailCache: failed to create '%s'", IndexFileName().c_str() );
+		PathPrefix.clear();
+		return false;
+	}
+	ALOG( "ovrThumbnailCache: %d cached thumbnails, %d tiles used of %d", static_cast< int >( Entries.size() ), NumTiles, MaxTiles );
+	return true;
+}
+
+//==============================
+// ovrThumbnailCache::Close
+void ovrThumbnailCache::Close()
+{
+	for ( ovrPage & page : Pages )
+	{
+		DeleteTexture( page.Texture );
+	}
+	Pages.clear();
+
+	std::lock_guard< std::mutex > lk( Mutex );
+	Entries.clear();
+	NumTiles = 0;
+	IndexEnd = 0;
+	PathPrefix.clear();
+}
+
+//==============================
+// ovrThumbnailCache::GetTileSize
+size_t ovrThumbnailCache::GetTileSize() const
+{
+	return static_cast< size_t >( TileWidth / 4 ) * ( TileHeight / 4 ) * BLOCK_SIZE;
+}
+
+//==============================
+// ovrThumbnailCache::IndexFileName
+std::string ovrThumbnailCache::IndexFileName() const
+{
+	return PathPrefix + "index.bin";
+}
+
+//==============================
+// ovrThumbnailCache::PageFileName
+std::string ovrThumbnailCache::PageFileName( int const page ) const
+{
+	char name[32];
+	snprintf( name, sizeof( name ), "page%03d.bin", page );
+	return PathPrefix + name;
+}
+
+//==============================
+// ovrThumbnailCache::ReadIndex
+// Returns false if there is no index or it was made for other tiles. Anything after
+// the last complete record, such as a record whose write was interrupted, is cut
+// off so that new records are appended right after the good ones.
+bool ovrThumbnailCache::ReadIndex()
+{
+	FILE * f = fopen( IndexFileName().c_str(), "rb" );
+	if ( f == nullptr )
+	{
+		return false;
+	}
+
+	ovrIndexHeader header;
+	if ( fread( &header, sizeof( header ), 1, f ) != 1 ||
+			header.Magic != INDEX_MAGIC || header.Version != INDEX_VERSION ||
+			header.ThumbWidth != static_cast< uint32_t >( ThumbWidth ) ||
+			header.ThumbHeight != static_cast< uint32_t >( ThumbHeight ) ||
+			header.TilesPerRow != static_cast< uint32_t >( TilesPerRow ) ||
+			header.TilesPerColumn != static_cast< uint32_t >( TilesPerColumn ) )
+	{
+		fclose( f );
+		return false;
+	}
+
+	IndexEnd = sizeof( header );
+	std::string path;
+	ovrIndexRecord record;
+	while ( fread( &record, sizeof( record ), 1, f ) == 1 )
+	{
+		if ( record.TileIndex < 0 || record.TileIndex >= MaxTiles || record.PathLength == 0 || record.PathLength > 4096 )
+		{
+			break;
+		}
+		path.resize( record.PathLength );
+		if ( fread( &path[0], 1, record.PathLength, f ) != record.PathLength )
+		{
+			break;
+		}
+		// a later record for the same path replaces the earlier one
+		ovrEntry & entry = Entries[path];
+		entry.ModTime = record.ModTime;
+		entry.FileSize = record.FileSize;
+		entry.TileIndex = record.TileIndex;
+		NumTiles = std::max( NumTiles, record.TileIndex + 1 );
+		IndexEnd += sizeof( record ) + record.PathLength;
+	}
+	const bool atEnd = fseek( f, 0, SEEK_END ) == 0 && ftell( f ) == IndexEnd;
+	fclose( f );
+
+	if ( !atEnd && truncate( IndexFileName().c_str(), IndexEnd ) != 0 )
+	{
+		// appending after the bad bytes would lose every later record
+		Entries.clear();
+		NumTiles = 0;
+		return false;
+	}
+	return true;
+}
+
+//==============================
+// ovrThumbnailCache::ResetIndex
+bool ovrThumbnailCache::ResetIndex()
+{
+	Entries.clear();
+	NumTiles = 0;
+
+	FILE * f = fopen( IndexFileName().c_str(), "wb" );
+	if ( f == nullptr )
+	{
+		return false;
+	}
+	ovrIndexHeader header;
+	header.Magic = INDEX_MAGIC;
+	header.Version = INDEX_VERSION;
+	header.ThumbWidth = static_cast< uint32_t >( ThumbWidth );
+	header.ThumbHeight = static_cast< uint32_t >( ThumbHeight );
+	header.TilesPerRow = static_cast< uint32_t >( TilesPerRow );
+	header.TilesPerColumn = static_cast< uint32_t >( TilesPerColumn );
+	const bool ok = fwrite( &header, sizeof( header ), 1, f ) == 1;
+	IndexEnd = sizeof( header );
+	return fclose( f ) == 0 && ok;
+}
+
+//==============================
+// ovrThumbnailCache::AccessTile
+// The page file has the layout of the page texture, so each block row of a tile is a
+// separate run of the file.
+bool ovrThumbnailCache::AccessTile( int const tileIndex, uint8_t * tile, bool const write ) const
+{
+	const int page = tileIndex / TilesPerPage;
+	const int slot = tileIndex % TilesPerPage;
+	const int tileBlocksX = TileWidth / 4;
+	const int tileBlocksY = TileHeight / 4;
+	const int pageBlocksX = tileBlocksX * TilesPerRow;
+	const size_t rowSize = static_cast< size_t >( tileBlocksX ) * BLOCK_SIZE;
+
+	FILE * f = fopen( PageFileName( page ).c_str(), write ? "r+b" : "rb" );
+	if ( f == nullptr )
+	{
+		return false;
+	}
+
+	bool ok = true;
+	const long firstBlockY = static_cast< long >( ( slot / TilesPerRow ) * tileBlocksY );
+	const long firstBlockX = static_cast< long >( ( slot % TilesPerRow ) * tileBlocksX );
+	for ( int y = 0; y < tileBlocksY && ok; y++ )
+	{
+		const long offset = ( ( firstBlockY + y ) * pageBlocksX + firstBlockX ) * BLOCK_SIZE;
+		ok = fseek( f, offset, SEEK_SET ) == 0;
+		if ( ok )
+		{
+			uint8_t * row = tile + y * rowSize;
+			ok = ( write ? fwrite( row, 1, rowSize, f ) : fread( row, 1, rowSize, f ) ) == rowSize;
+		}
+	}
+	return fclose( f ) == 0 && ok;
+}
+
+//==============================
+// ovrThumbnailCache::EncodeTile
+void ovrThumbnailCache::EncodeTile( uint8_t const * rgba, std::vector< uint8_t > & tile ) const
+{
+	tile.resize( GetTileSize() );
+	uint8_t * out = tile.data();
+	uint8_t block[16 * 4];
+	for ( int by = 0; by < TileHeight; by += 4 )
+	{
+		for ( int bx = 0; bx < TileWidth; bx += 4 )
+		{
+			// the padding past the thumbnail repeats its edge
+			for ( int y = 0; y < 4; y++ )
+			{
+				const int sy = std::min( by + y, ThumbHeight - 1 );
+				for ( int x = 0; x < 4; x++ )
+				{
+					const int sx = std::min( bx + x, ThumbWidth - 1 );
+					memcpy( &block[( y * 4 + x ) * 4], &rgba[( static_cast< size_t >( sy ) * ThumbWidth + sx ) * 4], 4 );
+				}
+			}
+			EncodeEACAlphaBlock( block, out );
+			EncodeETC2Block( block, out + 8 );
+			out += BLOCK_SIZE;
+		}
+	}
+}
+
+//==============================
+// ovrThumbnailCache::FindTile
+bool ovrThumbnailCache::FindTile( char const * sourcePath, int & tileIndex, std::vector< uint8_t > & tile )
+{
+	int64_t modTime;
+	int64_t fileSize;
+	if ( !IsOpen() || !GetSourceStat( sourcePath, modTime, fileSize ) )
+	{
+		return false;
+	}
+
+	{
+		std::lock_guard< std::mutex > lk( Mutex );
+		auto it = Entries.find( sourcePath );
+		if ( it == Entries.end() || it->second.ModTime != modTime || it->second.FileSize != fileSize )
+		{
+			return false;
+		}
+		tileIndex = it->second.TileIndex;
+	}
+
+	tile.resize( GetTileSize() );
+	return AccessTile( tileIndex, tile.data(), false );
+}
+
+//==============================
+// ovrThumbnailCache::AddTile
+bool ovrThumbnailCache::AddTile( char const * sourcePath, std::vector< uint8_t > const & tile, int & tileIndex )
+{
+	int64_t modTime;
+	int64_t fileSize;
+	if ( !IsOpen() || tile.size() != GetTileSize() || !GetSourceStat( sourcePath, modTime, fileSize ) )
+	{
+		return false;
+	}
+
+	{
+		std::lock_guard< std::mutex > lk( Mutex );
+		if ( NumTiles >= MaxTiles )
+		{
+			return false;
+		}
+		tileIndex = NumTiles++;
+		if ( tileIndex % TilesPerPage == 0 )
+		{
+			// a new page, truncate whatever an earlier cache left there
+			FILE * f = fopen( PageFileName( tileIndex / TilesPerPage ).c_str(), "wb" );
+			if ( f == nullptr )
+			{
+				NumTiles--;
+				return false;
+			}
+			fclose( f );
+		}
+	}
+
+	// the tile is written before the index refers to it
+	if ( !AccessTile( tileIndex, const_cast< uint8_t * >( tile.data() ), true ) )
+	{
+		ALOGW( "ovrThumbnailCache: failed to write tile %d for '%s'", tileIndex, sourcePath );
+		return false;
+	}
+
+	std::lock_guard< std::mutex > lk( Mutex );
+	FILE * f = fopen( IndexFileName().c_str(), "ab" );
+	if ( f == nullptr )
+	{
+		return false;
+	}
+	ovrIndexRecord record;
+	record.ModTime = modTime;
+	record.FileSize = fileSize;
+	record.TileIndex = tileIndex;
+	record.PathLength = static_cast< uint32_t >( strlen( sourcePath ) );
+	bool ok = fwrite( &record, sizeof( record ), 1, f ) == 1 &&
+			fwrite( sourcePath, 1, record.PathLength, f ) == record.PathLength;
+	ok = fclose( f ) == 0 && ok;
+	if ( ok )
+	{
+		ovrEntry & entry = Entries[sourcePath];
+		entry.ModTime = modTime;
+		entry.FileSize = fileSize;
+		entry.TileIndex = tileIndex;
+		IndexEnd += sizeof( record ) + record.PathLength;
+	}
+	else
+	{
+		// drop whatever part of the record was written, so the next one follows a complete record
+		truncate( IndexFileName().c_str(), IndexEnd );
+	}
+	return ok;
+}
+
+//==============================
+// ovrThumbnailCache::AcquireTile
+GlTexture ovrThumbnailCache::AcquireTile( int const tileIndex, std::vector< uint8_t > const & tile, OVR::Vector4f & cropUV )
+{
+	if ( tileIndex < 0 || tileIndex >= MaxTiles || tile.size() != GetTileSize() )
+	{
+		return GlTexture();
+	}
+
+	const int pageIndex = tileIndex / TilesPerPage;
+	const int slot = tileIndex % TilesPerPage;
+	const int pageWidth = TileWidth * TilesPerRow;
+	const int pageHeight = TileHeight * TilesPerColumn;
+	const int x = ( slot % TilesPerRow ) * TileWidth;
+	const int y = ( slot / TilesPerRow ) * TileHeight;
+
+	if ( pageIndex >= static_cast< int >( Pages.size() ) )
+	{
+		Pages.resize( pageIndex + 1 );
+	}
+	ovrPage & page = Pages[pageIndex];
+	if ( !page.Texture.IsValid() )
+	{
+		// Single level, so tiles can be uploaded one at a time. Thumbnails are drawn
+		// at about one texel per pixel, so they do without mips.
+		GLuint texId;
+		glGenTextures( 1, &texId );
+		glBindTexture( GL_TEXTURE_2D, texId );
+		glTexStorage2D( GL_TEXTURE_2D, 1, GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC, pageWidth, pageHeight );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+		page.Texture = GlTexture( texId, GL_TEXTURE_2D, pageWidth, pageHeight );
+	}
+	else
+	{
+		glBindTexture( GL_TEXTURE_2D, page.Texture.texture );
+	}
+	glCompressedTexSubImage2D( GL_TEXTURE_2D, 0, x, y, TileWidth, TileHeight,
+			GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC, static_cast< GLsizei >( tile.size() ), tile.data() );
+	glBindTexture( GL_TEXTURE_2D, 0 );
+	page.RefCount++;
+
+	// Inset by half a texel so bilinear filtering never reaches the neighboring tiles.
+	// CropUV's y runs bottom to top, and the first row of the tile is its top.
+	const float u0 = ( x + 0.5f ) / pageWidth;
+	const float u1 = ( x + ThumbWidth - 0.5f ) / pageWidth;
+	const float v0 = ( y + 0.5f ) / pageHeight;
+	const float v1 = ( y + ThumbHeight - 0.5f ) / pageHeight;
+	cropUV = OVR::Vector4f( u0, 1.0f - v1, u1, 1.0f - v0 );
+	return page.Texture;
+}
+
+//==============================
+// ovrThumbnailCache::ReleaseTile
+void ovrThumbnailCache::ReleaseTile( int const tileIndex )
+{
+	const int pageIndex = tileIndex / TilesPerPage;
+	if ( tileIndex < 0 || pageIndex >= static_cast< int >( Pages.size() ) )
+	{
+		return;
+	}
+	ovrPage & page = Pages[pageIndex];
+	assert( page.RefCount > 0 );
+	if ( --page.RefCount == 0 )
+	{
+		DeleteTexture( page.Texture );
+	}
+}
+
+}	// namespace OVRFW
@@ -0,0 +1,121 @@
+/************************************************************************************
+
+Filename    :   ThumbnailCache.h
+Content     :   Persistent cache of compressed thumbnails packed into texture pages.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+#include "OVR_Math.h"
+#include "Render/GlTexture.h"
+
+namespace OVRFW {
+
+//==============================================================
+// ovrThumbnailCache
+//
+// Thumbnails are stored as fixed-size GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC tiles
+// in page files, each laid out exactly like a page texture so a tile is a block
+// aligned rectangle of it. An index file maps each source image's path, modification
+// time and size to its tile, so a thumbnail is decoded and compressed once and later
+// loads only read its tile.
+//
+// At runtime each page that has a visible thumbnail is one texture, and panels
+// sample their tile with a crop UV, so a grid of panels renders with as many
+// texture binds as there are pages in view instead of one per panel.
+//
+// The index is an append-only log. A changed source image gets a new tile and the
+// old one is left unused until the cache is discarded, which happens when it is
+// opened with another tile size. Once maxPages are full, AddTile fails.
+//==============================================================
+class ovrThumbnailCache
+{
+public:
+						ovrThumbnailCache();
+						~ovrThumbnailCache();
+
+	// Opens the cache, creating it if needed. Files are named by appending to pathPrefix.
+	// Main thread only, before any thread looks up tiles.
+	bool				Open( char const * pathPrefix, int const thumbWidth, int const thumbHeight, int const maxPages );
+	// Frees all page textures. Main thread only, after all threads are done with the cache.
+	void				Close();
+	bool				IsOpen() const { return !PathPrefix.empty(); }
+
+	// Size of a tile's block data.
+	size_t				GetTileSize() const;
+
+	// The methods below are thread safe.
+
+	// Compresses a thumbWidth x thumbHeight RGBA image to a tile.
+	void				EncodeTile( uint8_t const * rgba, std::vector< uint8_t > & tile ) const;
+	// Returns the tile index and reads the tile if the source file is cached and has not changed.
+	bool				FindTile( char const * sourcePath, int & tileIndex, std::vector< uint8_t > & tile );
+	// Writes the tile to a free slot and records it in the index.
+	bool				AddTile( char const * sourcePath, std::vector< uint8_t > const & tile, int & tileIndex );
+
+	// The methods below are NOT thread safe, and should only be called by the main thread.
+
+	// Uploads a tile to its page texture, creating the texture if needed, and adds a
+	// reference to the page. Returns the page texture and the tile's crop UV in the
+	// form VRMenuSurface::CropUV expects.
+	GlTexture			AcquireTile( int const tileIndex, std::vector< uint8_t > const & tile, OVR::Vector4f & cropUV );
+	// Releases a reference from AcquireTile. The page texture is freed when no tile in it is used.
+	void				ReleaseTile( int const tileIndex );
+
+	int					GetPage( int const tileIndex ) const { return tileIndex / TilesPerPage; }
+
+private:
+	struct ovrEntry
+	{
+		int64_t		ModTime;
+		int64_t		FileSize;
+		int			TileIndex;
+	};
+
+	struct ovrPage
+	{
+		ovrPage() : RefCount( 0 ) {}
+
+		GlTexture	Texture;
+		int			RefCount;
+	};
+
+	std::string			PathPrefix;
+	int					ThumbWidth;
+	int					ThumbHeight;
+	int					TileWidth;			// ThumbWidth rounded up to whole blocks
+	int					TileHeight;
+	int					TilesPerRow;		// in a page
+	int					TilesPerColumn;
+	int					TilesPerPage;
+	int					MaxTiles;
+
+	std::mutex			Mutex;				// guards Entries, NumTiles and the index file
+	std::unordered_map< std::string, ovrEntry >	Entries;
+	int					NumTiles;
+	long				IndexEnd;			// size of the index file up to the last complete record
+
+	std::vector< ovrPage >	Pages;			// main thread only
+
+	// not copyable
+						ovrThumbnailCache( ovrThumbnailCache const & ) = delete;
+	ovrThumbnailCache &	operator=( ovrThumbnailCache const & ) = delete;
+
+	std::string			IndexFileName() const;
+	std::string			PageFileName( int const page ) const;
+	bool				ReadIndex();
+	bool				ResetIndex();
+	// Reads or writes a tile's block rows in its page file.
+	bool				AccessTile( int const tileIndex, uint8_t * tile, bool const write ) const;
+};
+
+}	// namespace OVRFW
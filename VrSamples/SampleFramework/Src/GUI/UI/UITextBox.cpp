@@ -129,7 +129,11 @@ void UITextBox::UpdateText()
 	VRMenuFontParms fontParms = object->GetFontParms();
 	float width = ( GetDimensions().x * DEFAULT_TEXEL_SCALE ) - ( 2.0f * Border.x );
 	std::string cutText = Text + Cursor; //always add space for the caret even if we aren't going to show it
-	float extraOffset = GuiSys.GetDefaultFont().GetLastFitChars( cutText, width, fontParms.Scale );
+	// only the characters that changed since the last update are measured
+	TextLayout.SetFont( GuiSys.GetDefaultFont(), 0.0f, fontParms.Scale );
+	TextLayout.SetText( cutText.c_str() );
+	float extraOffset;
+	cutText.erase( 0, TextLayout.GetLastFitOffset( width, extraOffset ) );
 	if ( !ShowCursor )
 	{
 		cutText.erase( cutText.length() - 1 );
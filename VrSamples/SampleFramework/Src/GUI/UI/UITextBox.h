@@ -78,6 +78,7 @@ private:
 	UITextBoxComponent *				TextBoxComponent { nullptr };
 
 	std::string							Text;
+	ovrWordWrapper						TextLayout;		// Text and the cursor, measured for UpdateText
 	UITexture							Background;
 	OVR::Vector2f							Border { 0.005f, 0.002f }; //5mm border by default on sides, 2mm on top and bottom
 	float								TextOffset { 0 };
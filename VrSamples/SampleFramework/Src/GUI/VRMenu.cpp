@@ -23,9 +23,11 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #include "VRMenuEventHandler.h"
 #include "GuiSys.h"
 #include "Reflection.h"
+#include "ReflectionBinary.h"
 
 #include "OVR_FileSys.h"
 #include "Misc/Log.h"
+#include "Misc/FileUtils.h"
 
 using OVR::Matrix4f;
 using OVR::Vector2f;
@@ -323,8 +325,8 @@ void VRMenu::Frame( OvrGuiSys & guiSys, ovrApplFrameIn const & vrFrame, Matrix4f
 {
 	// OVR_PERF_TIMER( VRMenu_Frame );
 
-	std::vector< VRMenuEvent > events;
-	events.reserve( 1024 );
+	std::vector< VRMenuEvent > & events = FrameEvents;
+	events.clear();
 	// copy any pending events
 	for ( const auto & pendingEvent : PendingEvents )
 	{
@@ -749,6 +751,8 @@ void VRMenu::SetSelected( OvrGuiSys & guiSys, VRMenuId_t const itemId, bool cons
 
 //==============================
 // VRMenu::InitFromReflectionData
+// If the reflection object has a binary cache path, each file is compiled the first time it is
+// parsed and later loads read the compiled file instead. The text is still read to validate it.
 bool VRMenu::InitFromReflectionData( OvrGuiSys & guiSys, ovrFileSys & fileSys, ovrReflection & refl,
 	ovrLocale const & locale, char const * fileNames[], float const menuDistance, VRMenuFlags_t const & flags )
 {
@@ -763,6 +767,18 @@ bool VRMenu::InitFromReflectionData( OvrGuiSys & guiSys, ovrFileSys & fileSys, o
 			return false;
 		}
 
+		uint64_t const sourceHash = HashReflectionSource( parmBuffer );
+		std::string const cacheFileName = ReflectionBinaryCacheFileName( refl, sourceHash, parmBuffer.size() );
+		if ( !cacheFileName.empty() )
+		{
+			std::vector< uint8_t > binary;
+			if ( ReadWholeFile( cacheFileName.c_str(), binary ) && 
+					VRMenuObject::LoadItemParms( refl, locale, binary, sourceHash, itemParms ) )
+			{
+				continue;
+			}
+		}
+
 		// Add a null terminator
 		parmBuffer.push_back( '\0' );
 
@@ -770,13 +786,28 @@ bool VRMenu::InitFromReflectionData( OvrGuiSys & guiSys, ovrFileSys & fileSys, o
 ///		ALOG( "Loaded reflection file:\n==============\n%s\n=================\n", &parmBuffer[0] );
 #endif
 
+		ovrReflectionBinaryWriter writer( refl, sourceHash );
+		if ( !cacheFileName.empty() )
+		{
+			refl.SetBinaryWriter( &writer );
+		}
+
 		ovrParseResult parseResult = VRMenuObject::ParseItemParms( refl, locale, fileNames[i], parmBuffer, itemParms );
+		refl.SetBinaryWriter( nullptr );
 		if ( !parseResult )
 		{
 			DeletePointerArray( itemParms );
 			ALOG( "%s", parseResult.GetErrorText() );
 			return false;
 		}
+
+		if ( !cacheFileName.empty() )
+		{
+			if ( writer.HasFailed() || !WriteFileAtomically( cacheFileName.c_str(), writer.Finish() ) )
+			{
+				ALOGW( "Failed to compile reflection file '%s' to '%s'.", fileNames[i], cacheFileName.c_str() );
+			}
+		}
 	}
 
 	InitWithItems( guiSys, menuDistance, flags, itemParms );
@@ -173,6 +173,7 @@ private:
 
 	VRMenuEventHandler *	EventHandler;
 	std::vector< VRMenuEvent >	PendingEvents;		// events pending since the last frame
+	std::vector< VRMenuEvent >	FrameEvents;		// events for the current frame, kept to avoid reallocating each frame
 
 	std::string                Name;				// name of the menu
 
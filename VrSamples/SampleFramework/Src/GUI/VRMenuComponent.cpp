@@ -42,6 +42,7 @@ eMsgStatus VRMenuComponent::OnEvent( OvrGuiSys & guiSys, ovrApplFrameIn const &
 	if ( event.EventType == VRMENU_EVENT_INIT )
 	{
 		EventFlags &= ~VRMenuEventFlags_t( VRMENU_EVENT_INIT );
+		VRMenuObject::InvalidateSubtreeEventFlags();
 	}
 
 	return status;
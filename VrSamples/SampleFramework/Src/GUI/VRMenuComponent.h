@@ -72,9 +72,9 @@ public:
 	virtual void			SetEnabled( const bool /*enabled*/ ) { assert( false ); }
 	
 protected:	
-	void					RemoveEventFlags( VRMenuEventFlags_t const & flags ) { EventFlags &=  ~flags; }
-	void					AddEventFlags( VRMenuEventFlags_t const & flags ) { EventFlags |= flags; }
-	void					ClearEventFlags() { EventFlags &= ~EventFlags; }
+	void					RemoveEventFlags( VRMenuEventFlags_t const & flags ) { EventFlags &=  ~flags; VRMenuObject::InvalidateSubtreeEventFlags(); }
+	void					AddEventFlags( VRMenuEventFlags_t const & flags ) { EventFlags |= flags; VRMenuObject::InvalidateSubtreeEventFlags(); }
+	void					ClearEventFlags() { EventFlags &= ~EventFlags; VRMenuObject::InvalidateSubtreeEventFlags(); }
 
 private:
     virtual eMsgStatus      OnEvent_Impl( OvrGuiSys & guiSys, ovrApplFrameIn const & vrFrame,
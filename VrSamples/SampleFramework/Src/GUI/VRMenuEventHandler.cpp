@@ -30,9 +30,21 @@ using OVR::Posef;
 
 namespace OVRFW {
 
+int VRMenuEventHandler::DispatchCount = 0;
+
+//==============================
+// SubtreeHandlesEvent
+// Returns true if any component on the object or its descendants subscribes to the event type.
+static bool SubtreeHandlesEvent( OvrGuiSys & guiSys, VRMenuObject const * obj, eVRMenuEventType const eventType )
+{
+	return ( obj->GetSubtreeEventFlags( guiSys.GetVRMenuMgr() ) & VRMenuEventFlags_t( eventType ).GetValue() ) != 0;
+}
+
 //==============================
 // VRMenuEventHandler::VRMenuEventHandler
 VRMenuEventHandler::VRMenuEventHandler() 
+	: HasHitTest( false )
+	, LastHitTestGeneration( 0 )
 {
 }
 
@@ -65,12 +77,28 @@ void VRMenuEventHandler::Frame( OvrGuiSys & guiSys, ovrApplFrameIn const & vrFra
 	const Vector3f viewFwd( GetViewMatrixForward( viewMatrix ) );
 #endif
 
-	HitTestResult result;
-	menuHandle_t hitHandle = root->HitTest( guiSys, menuPose, viewPos, viewFwd, ContentFlags_t( CONTENT_SOLID ), result );
-	result.RayStart = viewPos;
-	result.RayDir = viewFwd;
+	// The hit, and so the focus, can only change if the ray or the menu moved, or something in a
+	// menu changed since the last hit test. Otherwise the last result still holds.
+	bool const hitTestChanged = !HasHitTest
+			|| viewPos != LastViewPos || viewFwd != LastViewFwd
+			|| !( menuPose.Translation == LastMenuPose.Translation && menuPose.Rotation == LastMenuPose.Rotation )
+			|| VRMenuObject::GetHitTestGeneration() != LastHitTestGeneration;
+	if ( hitTestChanged )
+	{
+		LastHitResult = HitTestResult();
+		root->HitTest( guiSys, menuPose, viewPos, viewFwd, ContentFlags_t( CONTENT_SOLID ), LastHitResult );
+		LastHitResult.RayStart = viewPos;
+		LastHitResult.RayDir = viewFwd;
+
+		HasHitTest = true;
+		LastViewPos = viewPos;
+		LastViewFwd = viewFwd;
+		LastMenuPose = menuPose;
+		LastHitTestGeneration = VRMenuObject::GetHitTestGeneration();
+	}
+	HitTestResult const & result = LastHitResult;
+	menuHandle_t const hitHandle = result.HitHandle;
 
-	VRMenuObject * hit = hitHandle.IsValid() ? guiSys.GetVRMenuMgr().ToObject( hitHandle ) : NULL;
 /*
 	if ( hit != NULL )
 	{
@@ -80,6 +108,7 @@ void VRMenuEventHandler::Frame( OvrGuiSys & guiSys, ovrApplFrameIn const & vrFra
 	bool focusChanged = ( hitHandle != FocusedHandle );
 	if ( focusChanged )
 	{
+		VRMenuObject * hit = hitHandle.IsValid() ? guiSys.GetVRMenuMgr().ToObject( hitHandle ) : NULL;
 		// focus changed
 		VRMenuObject * oldFocus = guiSys.GetVRMenuMgr().ToObject( FocusedHandle );
 		if ( oldFocus != NULL )
@@ -126,8 +155,8 @@ void VRMenuEventHandler::Frame( OvrGuiSys & guiSys, ovrApplFrameIn const & vrFra
 	}
 */
 
-	bool touchPressed = ( vrFrame.AllTouches | ovrTouch_A ) != 0;
-	bool touchReleased = !touchPressed && ( ( vrFrame.LastFrameAllButtons | ovrTouch_A ) != 0 ); 
+	bool touchPressed = ( vrFrame.AllTouches & ovrTouch_A ) != 0;
+	bool touchReleased = !touchPressed && ( ( vrFrame.LastFrameAllButtons & ovrTouch_A ) != 0 ); 
 	bool touchDown = ( vrFrame.AllTouches ) != 0;
 	bool ignoreTouchRelease = false; /// ( vrFrame.Input.buttonState & BUTTON_TOUCH_WAS_SWIPE ) != 0;
 
@@ -199,8 +228,9 @@ void VRMenuEventHandler::Frame( OvrGuiSys & guiSys, ovrApplFrameIn const & vrFra
 		events.push_back( event );
 	}
 
+	// post the frame event to the root, unless nothing in the menu wants it
+	if ( SubtreeHandlesEvent( guiSys, root, VRMENU_EVENT_FRAME_UPDATE ) )
 	{
-		// always post the frame event to the root
 		VRMenuEvent event( VRMENU_EVENT_FRAME_UPDATE, EVENT_DISPATCH_BROADCAST, menuHandle_t(), Vector3f( 0.0f ), result, "" );
 		events.push_back( event );
 	}
@@ -315,6 +345,11 @@ static void FindTargetPath( OvrGuiSys & guiSys, menuHandle_t const rootHandle,
 void VRMenuEventHandler::HandleEvents( OvrGuiSys & guiSys, ovrApplFrameIn const & vrFrame,
 		menuHandle_t const rootHandle, std::vector< VRMenuEvent > const & events ) const
 {
+	if ( events.empty() )
+	{
+		return;
+	}
+
 	VRMenuObject * root = guiSys.GetVRMenuMgr().ToObject( rootHandle );
 	if ( root == NULL )
 	{
@@ -370,6 +405,7 @@ bool VRMenuEventHandler::DispatchToComponents( OvrGuiSys & guiSys, ovrApplFrameI
 	{
 		if ( menuComponent->HandlesEvent( VRMenuEventFlags_t( event.EventType ) ) )
 		{
+			DispatchCount++;
 			LogEventType( event, "DispatchEvent: to '%s'", receiver->GetText().c_str() );
 
 			if ( menuComponent->OnEvent( guiSys, vrFrame, receiver, event ) == MSG_STATUS_CONSUMED )
@@ -419,6 +455,12 @@ bool VRMenuEventHandler::BroadcastEvent( OvrGuiSys & guiSys, ovrApplFrameIn cons
 {
 	/// assert_WITH_TAG( receiver != NULL, "VrMenu" );
 
+	// skip whole subtrees where no component subscribes to this event type
+	if ( !SubtreeHandlesEvent( guiSys, receiver, event.EventType ) )
+	{
+		return false;
+	}
+
 	// allow parent components to handle first
 	if ( DispatchToComponents( guiSys, vrFrame, event, receiver ) )
 	{
@@ -44,9 +44,23 @@ public:
 
 	menuHandle_t	GetFocusedHandle() const { return FocusedHandle; }
 
+	// instrumentation: number of events delivered to components by all handlers since the last reset
+	static int		GetDispatchCount() { return DispatchCount; }
+	static void		ResetDispatchCount() { DispatchCount = 0; }
+
 private:
 	menuHandle_t	FocusedHandle;
 
+	// the last hit test, reused while the ray, the menu pose and the menu objects are unchanged
+	bool			HasHitTest;
+	OVR::Vector3f	LastViewPos;
+	OVR::Vector3f	LastViewFwd;
+	OVR::Posef		LastMenuPose;
+	std::uint32_t	LastHitTestGeneration;
+	HitTestResult	LastHitResult;
+
+	static int		DispatchCount;
+
 	ovrSoundLimiter	GazeOverSoundLimiter;
 	ovrSoundLimiter	DownSoundLimiter;
 	ovrSoundLimiter	UpSoundLimiter;
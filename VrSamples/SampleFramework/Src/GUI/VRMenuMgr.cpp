@@ -282,26 +282,229 @@ static bool HandleComponentsAreValid( int const index, std::uint32_t const id )
 	return true;
 }
 
+//==============================================================
+// ovrMenuObjectPool
+// Slot map for menu objects. Objects are constructed in place in fixed-size chunks so that
+// they are packed together in memory and never move once created. Each slot records the id
+// of the object it currently holds, which acts as a generation count: a handle is only valid
+// if its id matches the slot's id, so stale handles are rejected without touching the object.
+// Free slots are kept in an intrusive free list and live objects are also tracked in a dense
+// array so the whole set can be walked without visiting empty slots.
+class ovrMenuObjectPool
+{
+public:
+	static int const	CHUNK_SIZE = 64;
+
+	ovrMenuObjectPool()
+		: FreeHead( -1 )
+	{
+	}
+
+	~ovrMenuObjectPool()
+	{
+		// Objects that are still live are not destructed here. Their destructors delete their components,
+		// which owners outside the menu system (e.g. UIButton) may still reference after the menu manager
+		// is destroyed, so they are reported and leaked along with their chunks, as they always were.
+		if ( !Live.empty() )
+		{
+			ALOGW( "ovrMenuObjectPool: leaking %i menu objects that were not freed before shutdown", static_cast< int >( Live.size() ) );
+			return;
+		}
+		for ( int i = 0; i < static_cast< int >( Chunks.size() ); ++i )
+		{
+			delete Chunks[i];
+		}
+		Chunks.clear();
+	}
+
+	// Reserves a slot and returns its index. The object must be constructed with Construct().
+	int Alloc()
+	{
+		if ( FreeHead >= 0 )
+		{
+			int const index = FreeHead;
+			FreeHead = Slots[index].NextFree;
+			Slots[index].NextFree = -1;
+			return index;
+		}
+		int const index = static_cast< int >( Slots.size() );
+		if ( index / CHUNK_SIZE >= static_cast< int >( Chunks.size() ) )
+		{
+			Chunks.push_back( new ovrChunk );
+		}
+		Slots.push_back( ovrSlot() );
+		return index;
+	}
+
+	// Constructs an object in a slot returned by Alloc().
+	VRMenuObject * Construct( int const index, std::uint32_t const id, VRMenuObjectParms const & parms,
+			menuHandle_t const handle )
+	{
+		ovrSlot & slot = Slots[index];
+		assert( slot.Object == NULL );
+		void * mem = Chunks[index / CHUNK_SIZE]->Storage[index % CHUNK_SIZE];
+		slot.Object = new ( mem ) VRMenuObject( parms, handle );
+		slot.Id = id;
+		slot.LiveIndex = static_cast< int >( Live.size() );
+		Live.push_back( slot.Object );
+		return slot.Object;
+	}
+
+	// Destroys the object in a slot and returns the slot to the free list.
+	void Free( int const index )
+	{
+		ovrSlot & slot = Slots[index];
+		assert( slot.Object != NULL );
+
+		// swap the last live object into this object's place
+		VRMenuObject * last = Live.back();
+		Live[slot.LiveIndex] = last;
+		int lastIndex;
+		std::uint32_t lastId;
+		DecomposeHandle( last->GetHandle(), lastIndex, lastId );
+		Slots[lastIndex].LiveIndex = slot.LiveIndex;
+		Live.pop_back();
+
+		slot.Object->~VRMenuObject();
+		slot.Object = NULL;
+		slot.Id = INVALID_MENU_OBJECT_ID;
+		slot.LiveIndex = -1;
+		slot.NextFree = FreeHead;
+		FreeHead = index;
+	}
+
+	// Returns the object in the slot if the slot is occupied, regardless of the id.
+	VRMenuObject * GetSlotObject( int const index ) const
+	{
+		if ( index < 0 || index >= static_cast< int >( Slots.size() ) )
+		{
+			return NULL;
+		}
+		return Slots[index].Object;
+	}
+
+	int						GetNumSlots() const { return static_cast< int >( Slots.size() ); }
+	std::uint32_t			GetSlotId( int const index ) const { return Slots[index].Id; }
+
+	// dense iteration over all live objects
+	int						GetNumLive() const { return static_cast< int >( Live.size() ); }
+	VRMenuObject *			GetLive( int const i ) const { return Live[i]; }
+
+private:
+	struct ovrSlot
+	{
+		ovrSlot()
+			: Object( NULL )
+			, Id( INVALID_MENU_OBJECT_ID )
+			, LiveIndex( -1 )
+			, NextFree( -1 )
+		{
+		}
+
+		VRMenuObject *	Object;		// object constructed in this slot's chunk storage, or NULL if free
+		std::uint32_t	Id;			// id of the object in the slot, checked against the handle id
+		int				LiveIndex;	// index of the object in the Live array
+		int				NextFree;	// next slot in the free list
+	};
+
+	struct ovrChunk
+	{
+		alignas( VRMenuObject ) unsigned char	Storage[CHUNK_SIZE][sizeof( VRMenuObject )];
+	};
+
+	std::vector< ovrSlot >			Slots;		// per-slot bookkeeping, indexed by the handle index
+	std::vector< ovrChunk* >		Chunks;		// object storage, CHUNK_SIZE objects per chunk
+	std::vector< VRMenuObject* >	Live;		// all live objects, packed
+	int								FreeHead;	// first free slot, or -1
+};
+
 //==============================================================
 // SurfSort
 class SurfSort
 {
 public:
-	int64_t		Key;
+	std::uint64_t	Key;
 
 	bool operator < ( SurfSort const & other ) const
 	{
-		return Key - other.Key > 0;	// inverted because we want to render furthest-to-closest
+		return Key > other.Key;	// inverted because we want to render furthest-to-closest
 	}
 };
 
+// Below this many submitted surfaces std::sort is faster than the radix sort, whose fixed cost
+// of building and walking its histograms only pays off for large UIs (measured crossover ~2.7k).
+static int const RADIX_SORT_MIN_SURFACES = 3072;
+
+//==============================
+// RadixSortSurfaces
+// Stable LSD radix sort of the surface keys, 8 bits per pass. Keys are sorted in descending
+// order because we want to render furthest-to-closest. The histograms for all passes are built
+// with a single walk over the keys and any pass where every key has the same digit is skipped,
+// which for a typical frame removes most of the passes over the submission index bits.
+// scratch is resized to match keys and the result is always left in keys.
+static void RadixSortSurfaces( std::vector< SurfSort > & keys, std::vector< SurfSort > & scratch )
+{
+	int const RADIX_BITS = 8;
+	int const RADIX_SIZE = 1 << RADIX_BITS;
+	int const NUM_PASSES = 64 / RADIX_BITS;
+
+	int const count = static_cast< int >( keys.size() );
+	if ( count < 2 )
+	{
+		return;
+	}
+	scratch.resize( keys.size() );
+
+	int histograms[NUM_PASSES][RADIX_SIZE];
+	memset( histograms, 0, sizeof( histograms ) );
+	for ( int i = 0; i < count; ++i )
+	{
+		std::uint64_t const key = keys[i].Key;
+		for ( int pass = 0; pass < NUM_PASSES; ++pass )
+		{
+			histograms[pass][( key >> ( pass * RADIX_BITS ) ) & ( RADIX_SIZE - 1 )]++;
+		}
+	}
+
+	SurfSort * src = keys.data();
+	SurfSort * dst = scratch.data();
+	for ( int pass = 0; pass < NUM_PASSES; ++pass )
+	{
+		int * histogram = histograms[pass];
+		int const shift = pass * RADIX_BITS;
+		if ( histogram[( src[0].Key >> shift ) & ( RADIX_SIZE - 1 )] == count )
+		{
+			continue;	// every key has the same digit, this pass would not change the order
+		}
+
+		// convert counts to output offsets, largest digit first for a descending sort
+		int offset = 0;
+		for ( int digit = RADIX_SIZE - 1; digit >= 0; --digit )
+		{
+			int const digitCount = histogram[digit];
+			histogram[digit] = offset;
+			offset += digitCount;
+		}
+
+		for ( int i = 0; i < count; ++i )
+		{
+			int const digit = static_cast< int >( ( src[i].Key >> shift ) & ( RADIX_SIZE - 1 ) );
+			dst[histogram[digit]++] = src[i];
+		}
+		std::swap( src, dst );
+	}
+
+	if ( src != keys.data() )
+	{
+		memcpy( keys.data(), src, count * sizeof( SurfSort ) );
+	}
+}
+
 //==============================================================
 // VRMenuMgrLocal
 class VRMenuMgrLocal : public OvrVRMenuMgr
 {
 public:
-	static int const	MAX_SUBMITTED	= 256;
-
 								VRMenuMgrLocal( OvrGuiSys & guiSys );
 	virtual						~VRMenuMgrLocal();
 
@@ -347,28 +550,28 @@ private:
 	void						AddComponentToDeletionList( menuHandle_t const ownerHandle, VRMenuComponent * component );
 	void						ExecutePendingComponentDeletions();
 
-	void						CondenseList();
 	void						SubmitForRenderingRecursive( OvrGuiSys & guiSys, Matrix4f const & centerViewMatrix,
 										VRMenuRenderFlags_t const & flags, VRMenuObject const * obj,
 										Posef const & parentModelPose, Vector4f const & parentColor,
 										Vector3f const & parentScale, Bounds3f & cullBounds,
-                                        SubmittedMenuObject * submitted, int const maxIndices, int & curIndex,
+										std::vector< SubmittedMenuObject > & submitted, int & curIndex,
 										int const distanceIndex ) const;
+	static SubmittedMenuObject &	AllocSubmitted( std::vector< SubmittedMenuObject > & submitted, int & curIndex );
 
 	//--------------------------------------------------------------
 	// private members
 	//--------------------------------------------------------------
 	OvrGuiSys &				GuiSys;			// reference to the GUI sys that owns this menu manager
 	std::uint32_t					CurrentId;		// ever-incrementing object ID (well... up to 4 billion or so :)
-	std::vector< VRMenuObject* >	ObjectList;		// list of all menu objects
-	std::vector< int >			FreeList;		// list of free slots in the array
+	ovrMenuObjectPool			Objects;		// storage for all menu objects
 	
 	std::vector< ovrComponentList >	PendingDeletions;	// list of components (and owning objects) that are pending deletion
 
 	bool					Initialized;	// true if Init has been called
 
-	SubmittedMenuObject		Submitted[MAX_SUBMITTED];	// all objects that have been submitted for rendering on the current frame
+	std::vector< SubmittedMenuObject >	Submitted;	// all objects that have been submitted for rendering on the current frame, entries are reused across frames
 	std::vector< SurfSort >	SortKeys;					// sort key consisting of distance from view and submission index
+	std::vector< SurfSort >	SortScratch;				// scratch buffer for radix sorting SortKeys
 	int						NumSubmitted;				// number of currently submitted menu objects
 	mutable int				NumToRender;				// number of submitted objects to render
 
@@ -651,43 +854,15 @@ menuHandle_t VRMenuMgrLocal::CreateObject( VRMenuObjectParms const & parms )
 	}
 
 	// create the handle first so we can enforce setting it be requiring it to be passed to the constructor
-	int index = -1;
-	if ( FreeList.size() > 0 )
-	{
-		index = FreeList.back();
-		FreeList.pop_back();
-	}
-	else
-	{
-		index = static_cast< int >( ObjectList.size() );
-	}
+	int const index = Objects.Alloc();
 
 	std::uint32_t id = ++CurrentId;
 	menuHandle_t handle = ComposeHandle( index, id );
 	//ALOG( "VRMenuMgrLocal::CreateObject - handle is %llu", handle.Get() );
 
-	VRMenuObject * obj = new VRMenuObject( parms, handle );
-	if ( obj == NULL )
-	{
-		ALOGW( "VRMenuMgrLocal::CreateObject - failed to allocate menu object!" );
-		assert( obj != NULL );	// this would be bad -- but we're likely just going to explode elsewhere
-		return menuHandle_t();
-	}
-
+	VRMenuObject * obj = Objects.Construct( index, id, parms, handle );
 	obj->Init( GuiSys, parms );
 
-	if ( index == static_cast< int >( ObjectList.size() ) )
-	{
-		// we have to grow the array
-		ObjectList.push_back( obj );
-	}
-	else
-	{
-		// insert in existing slot
-		assert( ObjectList[index] == NULL );
-		ObjectList[index ] = obj;
-	}
-
 	return handle;
 }
 
@@ -704,13 +879,13 @@ void VRMenuMgrLocal::FreeObject( menuHandle_t const handle )
 	{
 		return;
 	}
-	if ( ObjectList[index] == NULL )
+	VRMenuObject * obj = Objects.GetSlotObject( index );
+	if ( obj == NULL || Objects.GetSlotId( index ) != id )
 	{
 		// already freed
 		return;
 	}
 
-	VRMenuObject * obj = ObjectList[index];
 	// remove this object from its parent's child list
 	if ( obj->GetParentHandle().IsValid() )
 	{
@@ -724,44 +899,8 @@ void VRMenuMgrLocal::FreeObject( menuHandle_t const handle )
     // free all of this object's children
     obj->FreeChildren( *this );
 
-	delete obj;
-
-	// empty the slot
-	ObjectList[index] = NULL;
-	// add the index to the free list
-	FreeList.push_back( index );
-
-	CondenseList();
-}
-
-//==================================
-// VRMenuMgrLocal::CondenseList
-// keeps the free list from growing too large when items are removed
-void VRMenuMgrLocal::CondenseList()
-{
-	// we can only condense the array if we have a significant number of items at the end of the array buffer
-	// that are empty (because we cannot move an existing object around without changing its handle, too, which
-	// would invalidate any existing references to it).
-	// This is the difference between the current size and the array capacity.
-	int const MIN_FREE = 64;	// very arbitray number
-	if ( ObjectList.capacity() - ObjectList.size() < MIN_FREE )
-	{
-		return;
-	}
-
-	// shrink to current size
-	ObjectList.resize( ObjectList.size() );
-
-	// create a new free list of just indices < the new size
-	std::vector< int > newFreeList;
-	for ( int i = 0; i < static_cast< int >( FreeList.size() ); ++i )
-	{
-		if ( FreeList[i] <= static_cast< int >( ObjectList.size() ) )
-		{
-			newFreeList.push_back( FreeList[i] );
-		}
-	}
-	FreeList = newFreeList;
+	// destroy the object and add the slot to the free list
+	Objects.Free( index );
 }
 
 //==================================
@@ -791,18 +930,18 @@ VRMenuObject * VRMenuMgrLocal::ToObject( menuHandle_t const handle ) const
 		ALOGW( "VRMenuMgrLocal::ToObject - invalid handle." );
 		return NULL;
 	}
-	if ( index >= static_cast< int >( ObjectList.size() ) )
+	if ( index >= Objects.GetNumSlots() )
 	{
 		ALOGW( "VRMenuMgrLocal::ToObject - index out of range." );
 		return NULL;
 	}
-	VRMenuObject * object = ObjectList[index];
+	VRMenuObject * object = Objects.GetSlotObject( index );
 	if ( object == NULL )
 	{
 		ALOGW( "VRMenuMgrLocal::ToObject - slot empty." );
 		return NULL;	// this can happen if someone is holding onto the handle of an object that's been freed
 	}
-	if ( object->GetHandle() != handle )
+	if ( Objects.GetSlotId( index ) != id )
 	{
 		// if the handle of the object in the slot does not match, then the object the handle refers to was deleted
 		// and a new object is in the slot
@@ -830,17 +969,8 @@ static void LogBounds( const char * name, char const * prefix, Bounds3f const &
 void VRMenuMgrLocal::SubmitForRenderingRecursive( OvrGuiSys & guiSys, Matrix4f const & centerViewMatrix,
 		VRMenuRenderFlags_t const & flags, VRMenuObject const * obj, Posef const & parentModelPose,
 		Vector4f const & parentColor, Vector3f const & parentScale, Bounds3f & cullBounds,
-		SubmittedMenuObject * submitted, int const maxIndices, int & curIndex, int const distanceIndex ) const
+		std::vector< SubmittedMenuObject > & submitted, int & curIndex, int const distanceIndex ) const
 {
-	if ( curIndex >= maxIndices )
-	{
-		// If this happens we're probably not correctly clearing the submitted surfaces each frame
-		// OR we've got a LOT of surfaces.
-		ALOG( "maxIndices = %i, curIndex = %i", maxIndices, curIndex );
-		/// assert_WITH_TAG( curIndex < maxIndices, "VrMenu" );
-		return;
-	}
-
 	// check if this object is hidden
 	VRMenuObjectFlags_t const oFlags = obj->GetFlags();
 	if ( oFlags & VRMENUOBJECT_DONT_RENDER )
@@ -915,9 +1045,10 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive( OvrGuiSys & guiSys, Matrix4f c
 				VRMenuSurface const & surf = surfaces[i];
 				if ( surf.IsRenderable() )
 				{
-					SubmittedMenuObject & sub = submitted[curIndex];
+					int const subIndex = curIndex;
+					SubmittedMenuObject & sub = AllocSubmitted( submitted, curIndex );
 					sub.SurfaceIndex = i;
-					sub.DistanceIndex = distanceIndex >= 0 ? distanceIndex : curIndex;
+					sub.DistanceIndex = distanceIndex >= 0 ? distanceIndex : subIndex;
 					sub.Pose = itemPose;
 					sub.Scale = scale;
 					sub.Flags = rFlags;
@@ -934,7 +1065,6 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive( OvrGuiSys & guiSys, Matrix4f c
 					sub.SurfaceName = surf.GetName();
 #endif
 					sub.LocalBounds = cullBounds;
-					curIndex++;
 				}
 			}
 			/// OVR_PERF_TIMER_STOP( SubmitForRenderingRecursive_submit );
@@ -982,15 +1112,16 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive( OvrGuiSys & guiSys, Matrix4f c
 				// the text surface will be added to the surface list in BuildDrawSurface
 				if ( curIndex - submissionIndex == 0 )
 				{
-					SubmittedMenuObject & sub = submitted[curIndex];
+					int const subIndex = curIndex;
+					SubmittedMenuObject & sub = AllocSubmitted( submitted, curIndex );
 					sub.SurfaceIndex = -1;
+					sub.DistanceIndex = distanceIndex >= 0 ? distanceIndex : subIndex;
 					sub.Pose = itemPose;
 					sub.Scale = scale;
 					sub.Flags = rFlags;
 					sub.Handle = obj->GetHandle();
 					sub.Color = parentColor;
 					sub.LocalBounds = cullBounds;
-					curIndex++;
 				}
 			}
 			else
@@ -1043,7 +1174,7 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive( OvrGuiSys & guiSys, Matrix4f c
 
             Bounds3f childCullBounds;
 		    SubmitForRenderingRecursive( guiSys, centerViewMatrix, flags, child, curModelPose,
-                    curColor, scale, childCullBounds, submitted, maxIndices, curIndex, di );
+                    curColor, scale, childCullBounds, submitted, curIndex, di );
 
 		    Posef pose = child->GetLocalPose();
 		    pose.Translation = pose.Translation * scale;
@@ -1119,6 +1250,21 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive( OvrGuiSys & guiSys, Matrix4f c
 	}
 }
 
+//==============================
+// VRMenuMgrLocal::AllocSubmitted
+// Returns the next entry in the submission arena, growing the arena if needed. Entries
+// are reset because they are reused from previous frames.
+SubmittedMenuObject & VRMenuMgrLocal::AllocSubmitted( std::vector< SubmittedMenuObject > & submitted, int & curIndex )
+{
+	if ( curIndex >= static_cast< int >( submitted.size() ) )
+	{
+		submitted.resize( submitted.empty() ? 256 : submitted.size() * 2 );
+	}
+	SubmittedMenuObject & sub = submitted[curIndex++];
+	sub = SubmittedMenuObject();
+	return sub;
+}
+
 //==============================
 // VRMenuMgrLocal::SubmitForRendering
 // Submits the specified menu object and it's children
@@ -1126,11 +1272,6 @@ void VRMenuMgrLocal::SubmitForRendering( OvrGuiSys & guiSys, Matrix4f const & ce
 		menuHandle_t const handle, Posef const & worldPose, VRMenuRenderFlags_t const & flags )
 {
 	//ALOG( "VRMenuMgrLocal::SubmitForRendering" );
-	if ( NumSubmitted >= MAX_SUBMITTED )
-	{
-		ALOGW( "Too many menu objects submitted!" );
-		return;
-	}
 	VRMenuObject * obj = static_cast< VRMenuObject* >( ToObject( handle ) );
 	if ( obj == NULL )
 	{
@@ -1139,7 +1280,7 @@ void VRMenuMgrLocal::SubmitForRendering( OvrGuiSys & guiSys, Matrix4f const & ce
 
     Bounds3f cullBounds;
 	SubmitForRenderingRecursive( guiSys, centerViewMatrix, flags, obj, worldPose, Vector4f( 1.0f ),
-			Vector3f( 1.0f ), cullBounds, Submitted, MAX_SUBMITTED, NumSubmitted, -1 );
+			Vector3f( 1.0f ), cullBounds, Submitted, NumSubmitted, -1 );
 
 	/// OVR_PERF_REPORT( SubmitForRenderingRecursive_submit );
 	/// OVR_PERF_REPORT( SubmitForRenderingRecursive_DrawText3D );
@@ -1171,11 +1312,19 @@ void VRMenuMgrLocal::Finish( Matrix4f const & viewMatrix )
 		// allowing a group of objects to sort against all other object's based on a single distance. Objects uising the
 		// same DistanceIndex will then be sorted against each other based only on their submission index.
 		float const distSq = ( Submitted[Submitted[i].DistanceIndex].Pose.Translation - viewPos ).LengthSq();
-		int64_t sortKey = *reinterpret_cast< unsigned const* >( &distSq );
-		SortKeys[i].Key = ( sortKey << 32ULL ) | ( NumSubmitted - i );	// invert i because we want items submitted sooner to be considered "further away"
+		std::uint64_t sortKey = *reinterpret_cast< unsigned const* >( &distSq );
+		SortKeys[i].Key = ( sortKey << 32ULL ) | static_cast< std::uint32_t >( NumSubmitted - i );	// invert i because we want items submitted sooner to be considered "further away"
 	}
 
-	std::sort( SortKeys.begin(), SortKeys.end() );
+	// keys are unique because they include the submission index, so both sorts give the same order
+	if ( NumSubmitted < RADIX_SORT_MIN_SURFACES )
+	{
+		std::sort( SortKeys.begin(), SortKeys.end() );
+	}
+	else
+	{
+		RadixSortSurfaces( SortKeys, SortScratch );
+	}
 
 	NumToRender = NumSubmitted;
 	NumSubmitted = 0;
@@ -1251,7 +1400,7 @@ void VRMenuMgrLocal::AppendSurfaceList( Matrix4f const & centerViewMatrix, std::
 
 	if ( ShowStats )
 	{
-		ALOG( "VRMenuMgr: submitted %i surfaces", NumToRender );
+		ALOG( "VRMenuMgr: submitted %i surfaces, %i live objects", NumToRender, Objects.GetNumLive() );
 	}
 }
 
@@ -30,6 +30,7 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #include "VRMenuComponent.h"
 #include "ui_default.h"	// embedded default UI texture (loaded as a placeholder when something doesn't load)
 #include "Reflection.h"
+#include "ReflectionBinary.h"
 
 using OVR::Matrix4f;
 using OVR::Vector2f;
@@ -76,6 +77,9 @@ namespace OVRFW {
 float const	VRMenuObject::TEXELS_PER_METER		= 500.0f;
 float const	VRMenuObject::DEFAULT_TEXEL_SCALE	= 1.0f / TEXELS_PER_METER;
 
+std::uint32_t VRMenuObject::SubtreeEventFlagsGeneration = 0;
+std::uint32_t VRMenuObject::HitTestGeneration = 0;
+
 const float VRMenuSurface::Z_BOUNDS = 0.05f;
 
 //======================================================================================
@@ -976,7 +980,9 @@ VRMenuObject::VRMenuObject( VRMenuObjectParms const & parms,
 	MinsBoundsExpand( 0.0f ),
 	MaxsBoundsExpand( 0.0f ),
 	TextMetrics(),
-	TextSurface( nullptr )
+	TextSurface( nullptr ),
+	SubtreeEventFlags( 0 ),
+	SubtreeEventFlagsCacheGen( SubtreeEventFlagsGeneration - 1 )
 {
 	CullBounds.Clear();
 }
@@ -1061,6 +1067,8 @@ void VRMenuObject::FreeChildren( OvrVRMenuMgr & menuMgr )
 		menuMgr.FreeObject( Children[i] );
 	}
 	Children.resize( 0 );
+	InvalidateSubtreeEventFlags();
+	InvalidateHitTests();
 	// NOTE! bounds will be incorrect now until submitted for rendering
 }
 
@@ -1103,6 +1111,8 @@ void VRMenuObject::AddChild( OvrVRMenuMgr & menuMgr, menuHandle_t const handle )
 	{
 		child->SetParentHandle( this->Handle );
 	}
+	InvalidateSubtreeEventFlags();
+	InvalidateHitTests();
     // NOTE: bounds will be incorrect until submitted for rendering
 }
 
@@ -1115,6 +1125,8 @@ void VRMenuObject::RemoveChild( OvrVRMenuMgr & menuMgr, menuHandle_t const handl
 		if ( Children[i] == handle )
 		{
 			Children.erase( Children.cbegin() + i );
+			InvalidateSubtreeEventFlags();
+			InvalidateHitTests();
 			return;
 		}
 	}
@@ -1130,6 +1142,8 @@ void VRMenuObject::FreeChild( OvrVRMenuMgr & menuMgr, menuHandle_t const handle
 		if ( childHandle == handle )
 		{
 			Children.erase( Children.cbegin() + i );
+			InvalidateSubtreeEventFlags();
+			InvalidateHitTests();
 			menuMgr.FreeObject( childHandle );
 			return;
 		}
@@ -1664,6 +1678,7 @@ void VRMenuObject::AddComponent( VRMenuComponent * component )
 		return;
 	}
 	Components.push_back( component );
+	InvalidateSubtreeEventFlags();
 }
 
 //==============================
@@ -1702,6 +1717,7 @@ void VRMenuObject::FreeComponents( ovrComponentList & list )
 
 		delete component;
 	}
+	InvalidateSubtreeEventFlags();
 }
 
 //==============================
@@ -1718,6 +1734,34 @@ int VRMenuObject::GetComponentIndex( VRMenuComponent * component ) const
 	return -1;
 }
 
+//==============================
+// VRMenuObject::GetSubtreeEventFlags
+std::uint64_t VRMenuObject::GetSubtreeEventFlags( OvrVRMenuMgr const & menuMgr ) const
+{
+	if ( SubtreeEventFlagsCacheGen == SubtreeEventFlagsGeneration )
+	{
+		return SubtreeEventFlags;
+	}
+
+	std::uint64_t flags = 0;
+	for ( VRMenuComponent const * component : Components )
+	{
+		flags |= component->GetEventFlags().GetValue();
+	}
+	for ( menuHandle_t const & childHandle : Children )
+	{
+		VRMenuObject const * child = menuMgr.ToObject( childHandle );
+		if ( child != NULL )
+		{
+			flags |= child->GetSubtreeEventFlags( menuMgr );
+		}
+	}
+
+	SubtreeEventFlags = flags;
+	SubtreeEventFlagsCacheGen = SubtreeEventFlagsGeneration;
+	return flags;
+}
+
 //==============================
 // VRMenuObject::GetComponentById
 VRMenuComponent * VRMenuObject::GetComponentById_Impl( int const id, const char * name ) const
@@ -1805,6 +1849,7 @@ void VRMenuObject::SetVisible( bool visible )
 	{
 		Flags |= VRMenuObjectFlags_t( VRMENUOBJECT_DONT_RENDER );
 	}
+	InvalidateHitTests();
 }
 
 //==============================
@@ -2078,6 +2123,32 @@ void VRMenuObject::SetSurfaceBorder( int const surfaceIndex, Vector4f const & bo
 	Surfaces[ surfaceIndex ].SetBorder( border );
 }
 
+//==============================
+// VRMenuObject::GetSurfaceCropUV
+Vector4f const & VRMenuObject::GetSurfaceCropUV( int const surfaceIndex )
+{
+	if ( surfaceIndex < 0 || surfaceIndex >= static_cast< int >( Surfaces.size() ) )
+	{
+		/// assert_WITH_TAG( surfaceIndex >= 0 && surfaceIndex < static_cast< int >( Surfaces.size() ), "VrMenu" );
+		return Vector4f::ZERO;
+	}
+
+	return Surfaces[ surfaceIndex ].GetCropUV();
+}
+
+//==============================
+// VRMenuObject::SetSurfaceCropUV
+void VRMenuObject::SetSurfaceCropUV( int const surfaceIndex, Vector4f const & cropUV )
+{
+	if ( surfaceIndex < 0 || surfaceIndex >= static_cast< int >( Surfaces.size() ) )
+	{
+		/// assert_WITH_TAG( surfaceIndex >= 0 && surfaceIndex < static_cast< int >( Surfaces.size() ), "VrMenu" );
+		return;
+	}
+
+	Surfaces[ surfaceIndex ].SetCropUV( cropUV );
+}
+
 
 //==============================
 // VRMenuObject::SetLocalBoundsExpand
@@ -2085,6 +2156,7 @@ void VRMenuObject::SetLocalBoundsExpand( Vector3f const mins, Vector3f const & m
 {
 	MinsBoundsExpand = mins;
 	MaxsBoundsExpand = maxs;
+	InvalidateHitTests();
 }
 
 //==============================
@@ -2096,6 +2168,7 @@ void VRMenuObject::SetCollisionPrimitive( OvrCollisionPrimitive * c )
 		delete CollisionPrimitive;
 	}
 	CollisionPrimitive = c;
+	InvalidateHitTests();
 }
 
 //==============================
@@ -2206,6 +2279,7 @@ void VRMenuObject::SetText( char const * text )
 {
 	Text = text;
 	TextDirty = true;
+	InvalidateHitTests();
 }
 
 //==============================
@@ -2397,7 +2471,12 @@ ovrParseResult VRMenuObject::ParseItemParms( ovrReflection & refl, ovrLocale con
 						return ovrParseResult( res, "Expected ')'." );
 					}
 
-					refl.AddOverload( new ovrReflectionOverload_FloatDefaultValue( scope.c_str(), name.c_str(), value ) );
+					ovrReflectionOverload * o = new ovrReflectionOverload_FloatDefaultValue( scope.c_str(), name.c_str(), value );
+					if ( refl.GetBinaryWriter() != nullptr )
+					{
+						refl.GetBinaryWriter()->WriteOverload( *o );
+					}
+					refl.AddOverload( o );
 				}
 			}
 			else
@@ -2412,6 +2491,10 @@ ovrParseResult VRMenuObject::ParseItemParms( ovrReflection & refl, ovrLocale con
 			ovrTypeInfo const * typeInfo = refl.FindTypeInfo( "std::vector< VRMenuObjectParms* >" );
 			if ( typeInfo != nullptr )
 			{
+				if ( refl.GetBinaryWriter() != nullptr )
+				{
+					refl.GetBinaryWriter()->WriteArrayRecord( typeInfo );
+				}
 				ovrParseResult parseRes = ParseArray( refl, locale, fileName, lex, typeInfo, &parms, 0 );
 				if ( !parseRes )
 				{
@@ -2443,5 +2526,41 @@ ovrParseResult VRMenuObject::ParseItemParms( ovrReflection & refl, ovrLocale con
 	return ovrParseResult();
 }
 
+//==============================
+// VRMenuObject::LoadItemParms
+bool VRMenuObject::LoadItemParms( ovrReflection & refl, ovrLocale const & locale, std::vector< uint8_t > const & binary,
+		uint64_t const sourceHash, std::vector<VRMenuObjectParms const *> & itemParms )
+{
+	ovrReflectionBinaryReader reader( refl, locale, binary );
+	if ( !reader.ReadHeader( sourceHash ) )
+	{
+		return false;
+	}
+
+	std::vector< VRMenuObjectParms const * > parms;
+	ovrTypeInfo const * typeInfo = refl.FindTypeInfo( "std::vector< VRMenuObjectParms* >" );
+	for ( ; ; )
+	{
+		ovrTypeInfo const * arrayTypeInfo;
+		ovrReflectionBinaryReader::ovrRecord const record = reader.NextRecord( arrayTypeInfo );
+		if ( record == ovrReflectionBinaryReader::RECORD_END )
+		{
+			break;
+		}
+		std::vector< VRMenuObjectParms const * > arrayParms;
+		if ( record != ovrReflectionBinaryReader::RECORD_ARRAY || arrayTypeInfo != typeInfo || !reader.ReadArray( typeInfo, &arrayParms ) )
+		{
+			DeletePointerArray( arrayParms );
+			DeletePointerArray( parms );
+			return false;
+		}
+		parms.insert( parms.cend(), arrayParms.cbegin(), arrayParms.cend() );
+	}
+
+	reader.CommitOverloads();
+	itemParms.insert( itemParms.cend(), parms.cbegin(), parms.cend() );
+	return true;
+}
+
 
 } // namespace OVR
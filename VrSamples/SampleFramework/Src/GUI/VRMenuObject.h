@@ -786,6 +786,9 @@ public:
 	OVR::Vector4f const &			GetBorder() const { return Border; }
 	void							SetBorder( OVR::Vector4f const & a ) { Border = a; }	// requires call to CreateFromSurfaceParms or RegenerateSurfaceGeometry() to take effect
 
+	OVR::Vector4f const &			GetCropUV() const { return CropUV; }
+	void							SetCropUV( OVR::Vector4f const & uvs ) { CropUV = uvs; }	// requires call to CreateFromSurfaceParms or RegenerateSurfaceGeometry() to take effect
+
 	OVR::Vector4f const &			GetClipUVs() const { return ClipUVs; }
 	void							SetClipUVs( OVR::Vector4f const & uvs ) { ClipUVs = uvs; }
 
@@ -894,6 +897,7 @@ class VRMenuObject
 public:
 	friend class VRMenuMgr;
 	friend class VRMenuMgrLocal;
+	friend class ovrMenuObjectPool;
 
 	class ovrRecursionFunctor
 	{
@@ -946,6 +950,17 @@ public:
 
 	std::vector< VRMenuComponent* > const & GetComponentList() const { return Components; }
 
+	// Returns the union of the event flags (as VRMenuEventFlags_t bits) of the components on this
+	// object and all of its descendants. Cached until the hierarchy or any component's event flags change.
+	std::uint64_t		GetSubtreeEventFlags( OvrVRMenuMgr const & menuMgr ) const;
+	// Must be called whenever menu hierarchies or component event flags change.
+	static void			InvalidateSubtreeEventFlags() { SubtreeEventFlagsGeneration++; }
+
+	// Changes whenever anything that can change the result of HitTest changes, so a hit test with
+	// an unchanged ray only needs to be repeated when this differs from the last one.
+	static std::uint32_t	GetHitTestGeneration() { return HitTestGeneration; }
+	static void			InvalidateHitTests() { HitTestGeneration++; }
+
 	VRMenuComponent *	GetComponentById_Impl( int const typeId, const char * name ) const;
 	VRMenuComponent *	GetComponentByTypeName_Impl( const char * typeName ) const;
 
@@ -979,9 +994,9 @@ public:
 	void				SetParentHandle( menuHandle_t const h ) { ParentHandle = h; }
 
 	VRMenuObjectFlags_t const &	GetFlags() const { return Flags; }
-	void				SetFlags( VRMenuObjectFlags_t const & flags ) { Flags = flags; }
-	void				AddFlags( VRMenuObjectFlags_t const & flags ) { Flags |= flags; }
-	void				RemoveFlags( VRMenuObjectFlags_t const & flags ) { Flags &= ~flags; }
+	void				SetFlags( VRMenuObjectFlags_t const & flags ) { Flags = flags; InvalidateHitTests(); }
+	void				AddFlags( VRMenuObjectFlags_t const & flags ) { Flags |= flags; InvalidateHitTests(); }
+	void				RemoveFlags( VRMenuObjectFlags_t const & flags ) { Flags &= ~flags; InvalidateHitTests(); }
 
 	void				ModifyFlags( bool const add, VRMenuObjectFlags_t const & flags )
 	{
@@ -1007,28 +1022,28 @@ public:
 	menuHandle_t		GetChildHandleForIndex( int const index ) const { return Children[index]; }
 
 	OVR::Posef const &	GetLocalPose() const { return LocalPose; }
-	void				SetLocalPose( OVR::Posef const & pose ) { LocalPose = pose; }
+	void				SetLocalPose( OVR::Posef const & pose ) { LocalPose = pose; InvalidateHitTests(); }
 	OVR::Vector3f const &	GetLocalPosition() const { return LocalPose.Translation; }
-	void				SetLocalPosition( OVR::Vector3f const & pos ) { LocalPose.Translation = pos; }
+	void				SetLocalPosition( OVR::Vector3f const & pos ) { LocalPose.Translation = pos; InvalidateHitTests(); }
 	OVR::Quatf const &	GetLocalRotation() const { return LocalPose.Rotation; }
-	void				SetLocalRotation( OVR::Quatf const & rot ) { LocalPose.Rotation = rot; }
+	void				SetLocalRotation( OVR::Quatf const & rot ) { LocalPose.Rotation = rot; InvalidateHitTests(); }
 	OVR::Vector3f       GetLocalScale() const;
-	void				SetLocalScale( OVR::Vector3f const & scale ) { LocalScale = scale; }
+	void				SetLocalScale( OVR::Vector3f const & scale ) { LocalScale = scale; InvalidateHitTests(); }
 
     OVR::Posef const &  GetHilightPose() const { return HilightPose; }
     void                SetHilightPose( OVR::Posef const & pose ) { HilightPose = pose; }
     float               GetHilightScale() const { return HilightScale; }
-    void                SetHilightScale( float const s ) { HilightScale = s; }
+    void                SetHilightScale( float const s ) { HilightScale = s; InvalidateHitTests(); }
 
-    void                SetTextLocalPose( OVR::Posef const & pose ) { TextLocalPose = pose; }
+    void                SetTextLocalPose( OVR::Posef const & pose ) { TextLocalPose = pose; InvalidateHitTests(); }
     OVR::Posef const &  GetTextLocalPose() const { return TextLocalPose; }
-    void                SetTextLocalPosition( OVR::Vector3f const & pos ) { TextLocalPose.Translation = pos; }
+    void                SetTextLocalPosition( OVR::Vector3f const & pos ) { TextLocalPose.Translation = pos; InvalidateHitTests(); }
     OVR::Vector3f const &    GetTextLocalPosition() const { return TextLocalPose.Translation; }
-    void                SetTextLocalRotation( OVR::Quatf const & rot ) { TextLocalPose.Rotation = rot; }
+    void                SetTextLocalRotation( OVR::Quatf const & rot ) { TextLocalPose.Rotation = rot; InvalidateHitTests(); }
     OVR::Quatf const &  GetTextLocalRotation() const { return TextLocalPose.Rotation; }
     OVR::Vector3f       GetTextLocalScale() const;
 	float				GetWrapScale() const { return WrapScale; }
-    void                SetTextLocalScale( OVR::Vector3f const & scale ) { TextLocalScale = scale; }
+    void                SetTextLocalScale( OVR::Vector3f const & scale ) { TextLocalScale = scale; InvalidateHitTests(); }
 
 	void				SetLocalBoundsExpand( OVR::Vector3f const mins, OVR::Vector3f const & maxs );
 
@@ -1037,7 +1052,15 @@ public:
 	OVR::Bounds3f		CalcLocalBoundsForText( BitmapFont const & font, std::string & text ) const;
 
 	OVR::Bounds3f const &	GetCullBounds() const { return CullBounds; }
-	void				SetCullBounds( OVR::Bounds3f const & bounds ) const { CullBounds = bounds; }
+	void				SetCullBounds( OVR::Bounds3f const & bounds ) const
+	{
+		// set on every submit, but only a change in the bounds can change a hit test
+		if ( bounds.b[0] != CullBounds.b[0] || bounds.b[1] != CullBounds.b[1] )
+		{
+			CullBounds = bounds;
+			InvalidateHitTests();
+		}
+	}
 
 	OVR::Vector2f const &	GetColorTableOffset() const;
 	void				SetColorTableOffset( OVR::Vector2f const & ofs );
@@ -1099,6 +1122,9 @@ public:
 	OVR::Vector4f const &	GetSurfaceBorder( int const surfaceIndex );
 	void				SetSurfaceBorder( int const surfaceIndex, OVR::Vector4f const & border );
 
+	OVR::Vector4f const &	GetSurfaceCropUV( int const surfaceIndex );
+	void				SetSurfaceCropUV( int const surfaceIndex, OVR::Vector4f const & cropUV );
+
 	//--------------------------------------------------------------
 	// collision
 	//--------------------------------------------------------------
@@ -1107,7 +1133,7 @@ public:
 	OvrCollisionPrimitive const *	GetCollisionPrimitive() const { return CollisionPrimitive; }
 
 	ContentFlags_t		GetContents() const { return Contents; }
-	void				SetContents( ContentFlags_t const c ) { Contents = c; }
+	void				SetContents( ContentFlags_t const c ) { Contents = c; InvalidateHitTests(); }
 
 	//--------------------------------------------------------------
 	// surfaces (non-virtual)
@@ -1149,6 +1175,10 @@ public:
 	//--------------------------------------------------------------
 	static ovrParseResult			ParseItemParms( ovrReflection & refl, ovrLocale const & locale, char const * fileName, 
 											std::vector< uint8_t > const & buffer, std::vector<VRMenuObjectParms const *> & itemParms );
+	// Loads the items recorded by ParseItemParms when it was called with a binary writer set. Returns 
+	// false if the compiled data doesn't match the source or the reflection data, and adds no items.
+	static bool						LoadItemParms( ovrReflection & refl, ovrLocale const & locale, std::vector< uint8_t > const & binary, 
+											uint64_t const sourceHash, std::vector<VRMenuObjectParms const *> & itemParms );
 
 private:
 	eVRMenuObjectType			Type;			// type of this object
@@ -1197,6 +1227,11 @@ private:
 
 	mutable ovrTextSurface	*	TextSurface;
 
+	mutable std::uint64_t		SubtreeEventFlags;			// cached result of GetSubtreeEventFlags()
+	mutable std::uint32_t		SubtreeEventFlagsCacheGen;	// generation SubtreeEventFlags was computed for
+	static std::uint32_t		SubtreeEventFlagsGeneration;	// incremented on any change that affects SubtreeEventFlags
+	static std::uint32_t		HitTestGeneration;				// incremented on any change that can affect HitTest
+
 private:
 	// only VRMenuMgrLocal static methods can construct and destruct a menu object.
 	VRMenuObject( VRMenuObjectParms const & parms, menuHandle_t const handle );
@@ -0,0 +1,422 @@
+/************************************************************************************
+
+Filename    :   JobSystem.cpp
+Content     :   Work-stealing job system shared by the framework
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <stdio.h>
+#if defined( __linux__ )
+#include <pthread.h>
+#endif
+
+namespace OVRFW
+{
+
+//==============================================================
+// ovrJob
+class ovrJob
+{
+public:
+	ovrJob( ovrJobPriority const priority, ovrJobSystem::ovrJobFunction && function )
+		: Priority( priority )
+		, Function( std::move( function ) )
+		, NumDependencies( 1 )
+		, Done( false )
+	{
+	}
+
+	ovrJobPriority const			Priority;
+	ovrJobSystem::ovrJobFunction	Function;
+	// Starts at 1 so the job can't be queued while its dependencies are still being added.
+	std::atomic< int >				NumDependencies;
+	std::atomic< bool >				Done;
+
+	// jobs to queue once this one is done, guarded by Mutex
+	std::mutex						Mutex;
+	std::vector< std::shared_ptr< ovrJob > >	Dependents;
+};
+
+// the worker running on this thread, if any
+static thread_local void *	CurrentWorker = nullptr;
+
+//==============================
+// ovrJobHandle::IsDone
+bool ovrJobHandle::IsDone() const
+{
+	return Job == nullptr || Job->Done.load( std::memory_order_acquire );
+}
+
+//==============================
+// ovrJobSystem::ovrJobSystem
+ovrJobSystem::ovrJobSystem( int const numWorkers )
+	: NumIdleWorkers( 0 )
+	, NumWaiting( 0 )
+	, ShuttingDown( false )
+{
+	for ( int i = 0; i < JOB_PRIORITY_MAX; i++ )
+	{
+		NumQueued[i].store( 0, std::memory_order_relaxed );
+	}
+
+	int count = numWorkers;
+	if ( count <= 0 )
+	{
+		count = std::max( 1, static_cast< int >( std::thread::hardware_concurrency() ) - 1 );
+	}
+
+	// all workers must exist before any of them starts stealing
+	Workers.reserve( count );
+	for ( int i = 0; i < count; i++ )
+	{
+		std::unique_ptr< ovrWorker > worker( new ovrWorker() );
+		worker->System = this;
+		worker->Index = i;
+		Workers.push_back( std::move( worker ) );
+	}
+	for ( auto & worker : Workers )
+	{
+		worker->Thread = std::thread( &ovrJobSystem::WorkerThread, this, worker.get() );
+	}
+}
+
+//==============================
+// ovrJobSystem::~ovrJobSystem
+ovrJobSystem::~ovrJobSystem()
+{
+	{
+		std::lock_guard< std::mutex > lk( SleepMutex );
+		ShuttingDown.store( true );
+		WorkAvailable.notify_all();
+		JobFinished.notify_all();
+	}
+	for ( auto & worker : Workers )
+	{
+		worker->Thread.join();
+	}
+
+	// Discard anything that never ran. Jobs still waiting on a dependency are not in any queue,
+	// only in the Dependents of a discarded job, so those are followed as well.
+	std::vector< ovrJobPtr > discarded;
+	for ( int p = 0; p < JOB_PRIORITY_MAX; p++ )
+	{
+		discarded.insert( discarded.end(), SubmitQueues[p].Jobs.begin(), SubmitQueues[p].Jobs.end() );
+		SubmitQueues[p].Jobs.clear();
+		for ( auto & worker : Workers )
+		{
+			discarded.insert( discarded.end(), worker->Queues[p].Jobs.begin(), worker->Queues[p].Jobs.end() );
+			worker->Queues[p].Jobs.clear();
+		}
+	}
+	while ( !discarded.empty() )
+	{
+		ovrJobPtr job = std::move( discarded.back() );
+		discarded.pop_back();
+
+		std::vector< ovrJobPtr > dependents;
+		{
+			std::lock_guard< std::mutex > lk( job->Mutex );
+			// a job with several discarded dependencies is reached once for each
+			if ( job->Done.load( std::memory_order_relaxed ) )
+			{
+				continue;
+			}
+			job->Function = nullptr;
+			job->Done.store( true, std::memory_order_release );
+			dependents.swap( job->Dependents );
+		}
+		discarded.insert( discarded.end(), dependents.begin(), dependents.end() );
+	}
+}
+
+//==============================
+// ovrJobSystem::GetShared
+ovrJobSystem & ovrJobSystem::GetShared()
+{
+	static ovrJobSystem shared( 0 );
+	return shared;
+}
+
+//==============================
+// ovrJobSystem::Submit
+ovrJobHandle ovrJobSystem::Submit( ovrJobPriority const priority, ovrJobFunction function )
+{
+	return Submit( priority, std::move( function ), nullptr, 0 );
+}
+
+//==============================
+// ovrJobSystem::Submit
+ovrJobHandle ovrJobSystem::Submit( ovrJobPriority const priority, ovrJobFunction function,
+		std::initializer_list< ovrJobHandle > dependencies )
+{
+	return Submit( priority, std::move( function ), dependencies.begin(), static_cast< int >( dependencies.size() ) );
+}
+
+//==============================
+// ovrJobSystem::Submit
+ovrJobHandle ovrJobSystem::Submit( ovrJobPriority const priority, ovrJobFunction function,
+		ovrJobHandle const * dependencies, int const numDependencies )
+{
+	assert( priority >= 0 && priority < JOB_PRIORITY_MAX );
+	ovrJobPtr job = std::make_shared< ovrJob >( priority, std::move( function ) );
+
+	for ( int i = 0; i < numDependencies; i++ )
+	{
+		ovrJob * dependency = dependencies[i].Job.get();
+		if ( dependency == nullptr )
+		{
+			continue;
+		}
+		std::lock_guard< std::mutex > lk( dependency->Mutex );
+		if ( !dependency->Done.load( std::memory_order_relaxed ) )
+		{
+			job->NumDependencies.fetch_add( 1, std::memory_order_relaxed );
+			dependency->Dependents.push_back( job );
+		}
+	}
+
+	// drop the reference that kept the job from being queued
+	if ( job->NumDependencies.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+	{
+		Enqueue( job );
+	}
+	return ovrJobHandle( job );
+}
+
+//==============================
+// ovrJobSystem::Wait
+void ovrJobSystem::Wait( ovrJobHandle const & handle )
+{
+	ovrJob * const job = handle.Job.get();
+	if ( job == nullptr )
+	{
+		return;
+	}
+
+	ovrWorker * self = GetCurrentWorker();
+	int const maxPriority = job->Priority;
+	while ( !job->Done.load( std::memory_order_acquire ) )
+	{
+		ovrJobPtr other = FindJob( self, maxPriority );
+		if ( other != nullptr )
+		{
+			Execute( other );
+			continue;
+		}
+
+		// Nothing to help with, so sleep until some job finishes or more work is queued.
+		std::unique_lock< std::mutex > lk( SleepMutex );
+		NumWaiting.fetch_add( 1, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		JobFinished.wait( lk, [this, job, maxPriority]()
+			{
+				return job->Done.load( std::memory_order_acquire ) || HasQueuedJobs( maxPriority ) ||
+						ShuttingDown.load( std::memory_order_relaxed );
+			} );
+		NumWaiting.fetch_sub( 1, std::memory_order_relaxed );
+		if ( ShuttingDown.load( std::memory_order_relaxed ) )
+		{
+			return;
+		}
+	}
+}
+
+//==============================
+// ovrJobSystem::Wait
+void ovrJobSystem::Wait( ovrJobHandle const * handles, int const numHandles )
+{
+	for ( int i = 0; i < numHandles; i++ )
+	{
+		Wait( handles[i] );
+	}
+}
+
+//==============================
+// ovrJobSystem::GetCurrentWorker
+ovrJobSystem::ovrWorker * ovrJobSystem::GetCurrentWorker() const
+{
+	ovrWorker * worker = static_cast< ovrWorker * >( CurrentWorker );
+	return worker != nullptr && worker->System == this ? worker : nullptr;
+}
+
+//==============================
+// ovrJobSystem::HasQueuedJobs
+bool ovrJobSystem::HasQueuedJobs( int const maxPriority ) const
+{
+	for ( int p = 0; p <= maxPriority; p++ )
+	{
+		if ( NumQueued[p].load( std::memory_order_relaxed ) > 0 )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//==============================
+// ovrJobSystem::Enqueue
+void ovrJobSystem::Enqueue( ovrJobPtr const & job )
+{
+	int const p = job->Priority;
+	ovrWorker * self = GetCurrentWorker();
+	ovrJobQueue & queue = self != nullptr ? self->Queues[p] : SubmitQueues[p];
+	{
+		std::lock_guard< std::mutex > lk( queue.Mutex );
+		queue.Jobs.push_back( job );
+		NumQueued[p].fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	// Pairs with the fences before sleeping: either the sleeper sees the job
+	// in NumQueued, or this sees the sleeper.
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	bool const wakeWorker = NumIdleWorkers.load( std::memory_order_relaxed ) > 0;
+	bool const wakeWaiting = NumWaiting.load( std::memory_order_relaxed ) > 0;
+	if ( wakeWorker || wakeWaiting )
+	{
+		std::lock_guard< std::mutex > lk( SleepMutex );
+		if ( wakeWorker )
+		{
+			WorkAvailable.notify_one();
+		}
+		if ( wakeWaiting )
+		{
+			JobFinished.notify_all();
+		}
+	}
+}
+
+//==============================
+// ovrJobSystem::FindJob
+ovrJobSystem::ovrJobPtr ovrJobSystem::FindJob( ovrWorker * self, int const maxPriority )
+{
+	int const numWorkers = static_cast< int >( Workers.size() );
+	for ( int p = 0; p <= maxPriority; p++ )
+	{
+		if ( NumQueued[p].load( std::memory_order_relaxed ) <= 0 )
+		{
+			continue;
+		}
+
+		// newest first from our own deque, since its data is most likely still in cache
+		if ( self != nullptr )
+		{
+			ovrJobQueue & queue = self->Queues[p];
+			std::lock_guard< std::mutex > lk( queue.Mutex );
+			if ( !queue.Jobs.empty() )
+			{
+				ovrJobPtr job = std::move( queue.Jobs.back() );
+				queue.Jobs.pop_back();
+				NumQueued[p].fetch_sub( 1, std::memory_order_relaxed );
+				return job;
+			}
+		}
+
+		// oldest first from everywhere else
+		int const first = self != nullptr ? self->Index + 1 : 0;
+		for ( int i = -1; i < numWorkers; i++ )
+		{
+			ovrJobQueue * queue;
+			if ( i < 0 )
+			{
+				queue = &SubmitQueues[p];
+			}
+			else
+			{
+				ovrWorker * victim = Workers[( first + i ) % numWorkers].get();
+				if ( victim == self )
+				{
+					continue;
+				}
+				queue = &victim->Queues[p];
+			}
+			std::lock_guard< std::mutex > lk( queue->Mutex );
+			if ( !queue->Jobs.empty() )
+			{
+				ovrJobPtr job = std::move( queue->Jobs.front() );
+				queue->Jobs.pop_front();
+				NumQueued[p].fetch_sub( 1, std::memory_order_relaxed );
+				return job;
+			}
+		}
+	}
+	return nullptr;
+}
+
+//==============================
+// ovrJobSystem::Execute
+void ovrJobSystem::Execute( ovrJobPtr const & job )
+{
+	job->Function();
+	// release anything the function captured now rather than when the last handle goes away
+	job->Function = nullptr;
+
+	std::vector< ovrJobPtr > dependents;
+	{
+		std::lock_guard< std::mutex > lk( job->Mutex );
+		job->Done.store( true, std::memory_order_release );
+		dependents.swap( job->Dependents );
+	}
+	for ( auto & dependent : dependents )
+	{
+		if ( dependent->NumDependencies.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+		{
+			Enqueue( dependent );
+		}
+	}
+
+	WakeWaiting();
+}
+
+//==============================
+// ovrJobSystem::WakeWaiting
+void ovrJobSystem::WakeWaiting()
+{
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	if ( NumWaiting.load( std::memory_order_relaxed ) > 0 )
+	{
+		std::lock_guard< std::mutex > lk( SleepMutex );
+		JobFinished.notify_all();
+	}
+}
+
+//==============================
+// ovrJobSystem::WorkerThread
+void ovrJobSystem::WorkerThread( ovrWorker * self )
+{
+	CurrentWorker = self;
+#if defined( __linux__ )
+	char name[16];
+	snprintf( name, sizeof( name ), "OVR::Job%d", self->Index );
+	pthread_setname_np( pthread_self(), name );
+#endif
+
+	while ( !ShuttingDown.load( std::memory_order_relaxed ) )
+	{
+		ovrJobPtr job = FindJob( self, JOB_PRIORITY_MAX - 1 );
+		if ( job != nullptr )
+		{
+			Execute( job );
+			continue;
+		}
+
+		std::unique_lock< std::mutex > lk( SleepMutex );
+		NumIdleWorkers.fetch_add( 1, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		WorkAvailable.wait( lk, [this]()
+			{
+				return HasQueuedJobs( JOB_PRIORITY_MAX - 1 ) || ShuttingDown.load( std::memory_order_relaxed );
+			} );
+		NumIdleWorkers.fetch_sub( 1, std::memory_order_relaxed );
+	}
+
+	CurrentWorker = nullptr;
+}
+
+}	// namespace OVRFW
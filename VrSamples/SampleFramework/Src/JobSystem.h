@@ -0,0 +1,146 @@
+/************************************************************************************
+
+Filename    :   JobSystem.h
+Content     :   Work-stealing job system shared by the framework
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+
+namespace OVRFW
+{
+
+enum ovrJobPriority
+{
+	JOB_PRIORITY_FRAME,			// needed by the current frame, always run before background jobs
+	JOB_PRIORITY_BACKGROUND,	// loading, decoding and anything else that may take several frames
+	JOB_PRIORITY_MAX
+};
+
+class ovrJob;
+
+//==============================================================
+// ovrJobHandle
+//
+// Refers to a submitted job. Handles are cheap to copy and keep the job's
+// bookkeeping alive, so a handle can be tested or waited on at any time,
+// even long after the job has finished.
+//==============================================================
+class ovrJobHandle
+{
+public:
+	ovrJobHandle() {}
+
+	bool	IsValid() const { return Job != nullptr; }
+	// An invalid handle counts as done.
+	bool	IsDone() const;
+	void	Reset() { Job.reset(); }
+
+private:
+	friend class ovrJobSystem;
+
+	explicit ovrJobHandle( std::shared_ptr< ovrJob > const & job ) : Job( job ) {}
+
+	std::shared_ptr< ovrJob >	Job;
+};
+
+//==============================================================
+// ovrJobSystem
+//
+// A fixed set of worker threads, each with its own deque of jobs per priority.
+// A worker pushes and pops jobs it submits at the back of its own deque, and
+// when that is empty takes jobs from the front of the shared queue for other
+// threads and then steals from the front of other workers' deques. Frame
+// jobs are always looked for everywhere before any background job is.
+//
+// A job can depend on other jobs, and is only queued once all of them have
+// finished. Wait() runs other queued jobs while the job it waits on is not
+// done, so a job can wait on the jobs it submits without tying up a worker.
+// To avoid delaying frame work, a thread waiting on a frame job only helps
+// with other frame jobs, so frame jobs should not depend on background jobs.
+//
+// Jobs are not cancelled. A job that needs to stop early should check a flag
+// of its own.
+//==============================================================
+class ovrJobSystem
+{
+public:
+	typedef std::function< void() >	ovrJobFunction;
+
+	// Creates numWorkers threads. 0 uses one per core, less one for the render thread.
+	explicit		ovrJobSystem( int const numWorkers );
+	// Waits for running jobs to finish. Jobs that have not started are discarded
+	// and their handles report them as done.
+					~ovrJobSystem();
+
+	// The job system the framework's own loaders use, created on first use.
+	static ovrJobSystem &	GetShared();
+
+	// Thread safe, callable by any thread, including from inside a job.
+	ovrJobHandle	Submit( ovrJobPriority const priority, ovrJobFunction function );
+	// The job runs after all dependencies have finished. Invalid handles are ignored.
+	ovrJobHandle	Submit( ovrJobPriority const priority, ovrJobFunction function,
+							ovrJobHandle const * dependencies, int const numDependencies );
+	ovrJobHandle	Submit( ovrJobPriority const priority, ovrJobFunction function,
+							std::initializer_list< ovrJobHandle > dependencies );
+
+	// Returns once the job is done, running other jobs in the meantime.
+	void			Wait( ovrJobHandle const & handle );
+	void			Wait( ovrJobHandle const * handles, int const numHandles );
+
+	int				GetNumWorkers() const { return static_cast< int >( Workers.size() ); }
+
+private:
+	typedef std::shared_ptr< ovrJob >	ovrJobPtr;
+
+	struct ovrJobQueue
+	{
+		std::mutex					Mutex;
+		std::deque< ovrJobPtr >		Jobs;
+	};
+
+	struct ovrWorker
+	{
+		ovrJobSystem *	System;
+		int				Index;
+		ovrJobQueue		Queues[JOB_PRIORITY_MAX];
+		std::thread		Thread;
+	};
+
+	std::vector< std::unique_ptr< ovrWorker > >	Workers;
+	ovrJobQueue				SubmitQueues[JOB_PRIORITY_MAX];	// jobs submitted by threads that aren't workers
+	std::atomic< int >		NumQueued[JOB_PRIORITY_MAX];
+
+	std::mutex				SleepMutex;
+	std::condition_variable	WorkAvailable;	// idle workers sleep on this
+	std::condition_variable	JobFinished;	// threads in Wait() sleep on this
+	std::atomic< int >		NumIdleWorkers;
+	std::atomic< int >		NumWaiting;
+	std::atomic< bool >		ShuttingDown;
+
+	// not copyable
+					ovrJobSystem( ovrJobSystem const & ) = delete;
+	ovrJobSystem &	operator=( ovrJobSystem const & ) = delete;
+
+	ovrWorker *		GetCurrentWorker() const;
+	bool			HasQueuedJobs( int const maxPriority ) const;
+	void			Enqueue( ovrJobPtr const & job );
+	ovrJobPtr		FindJob( ovrWorker * self, int const maxPriority );
+	void			Execute( ovrJobPtr const & job );
+	void			WakeWaiting();
+	void			WorkerThread( ovrWorker * self );
+};
+
+}	// namespace OVRFW
@@ -18,13 +18,19 @@ of patent rights can be found in the PATENTS file in the same directory.
 #include <sys/stat.h>
 
 #include <vector>
-#include <unordered_map>
+#include <algorithm>
+#include <mutex>
+#include <cinttypes>
+#include <cstdio>
 
 #include "Misc/Log.h"
+#include "Misc/FileUtils.h"
+#include "Misc/Hash.h"
 
 #include "tinyxml2.h"
 #include "OVR_JSON.h"
 #include "OVR_FileSys.h"
+#include "OVR_MappedFile.h"
 #include "OVR_UTF8Util.h"
 
 namespace OVRFW {
@@ -32,6 +38,279 @@ namespace OVRFW {
 char const *	ovrLocale::LOCALIZED_KEY_PREFIX = "@string/";
 size_t const	ovrLocale::LOCALIZED_KEY_PREFIX_LEN = OVR::OVR_strlen( LOCALIZED_KEY_PREFIX );
 
+//==============================================================
+// ovrCompiledStringTable
+//
+// A string table written by ovrLocale::CompileAndroidFormatXMLBuffer:
+//
+//   ovrHeader
+//   ovrEntry[NumStrings]	sorted by key bytes, as std::string compares them
+//   string pool			every key and value, each 0-terminated
+//
+// Entry offsets are relative to the start of the pool. The file is mapped and
+// searched in place.
+class ovrCompiledStringTable
+{
+public:
+	static const uint32_t	MAGIC = 0x534c564f;	// "OVLS"
+	static const uint32_t	VERSION = 1;
+
+	struct ovrHeader
+	{
+		uint32_t	Magic;
+		uint32_t	Version;
+		uint32_t	NumStrings;
+		uint32_t	PoolOffset;
+		uint32_t	PoolSize;
+	};
+
+	struct ovrEntry
+	{
+		uint32_t	KeyOffset;
+		uint32_t	KeyLength;
+		uint32_t	ValueOffset;
+		uint32_t	ValueLength;
+	};
+
+	ovrCompiledStringTable()
+		: Entries( nullptr )
+		, NumStrings( 0 )
+		, Pool( nullptr )
+		, PoolSize( 0 )
+	{
+	}
+
+	bool			Open( char const * fileName );
+
+	// key does not need to be 0-terminated
+	bool			Find( char const * key, size_t const keyLength, char const * & value, size_t & valueLength ) const;
+
+	int				GetNumStrings() const { return static_cast< int >( NumStrings ); }
+
+private:
+	MappedFile			File;
+	MappedView			View;
+	ovrEntry const *	Entries;
+	uint32_t			NumStrings;
+	char const *		Pool;
+	uint32_t			PoolSize;
+};
+
+//==============================
+// ovrCompiledStringTable::Open
+bool ovrCompiledStringTable::Open( char const * fileName )
+{
+	if ( !File.OpenRead( fileName ) || !View.Open( &File ) )
+	{
+		return false;
+	}
+	uint8_t const * data = View.MapView();
+	size_t const length = File.GetLength();
+	if ( data == nullptr || length < sizeof( ovrHeader ) )
+	{
+		return false;
+	}
+
+	ovrHeader header;
+	memcpy( &header, data, sizeof( header ) );
+	if ( header.Magic != MAGIC || header.Version != VERSION ||
+			header.PoolOffset != sizeof( ovrHeader ) + static_cast< uint64_t >( header.NumStrings ) * sizeof( ovrEntry ) ||
+			static_cast< uint64_t >( header.PoolOffset ) + header.PoolSize > length )
+	{
+		ALOG( "ERROR: '%s' is not a compiled string table!", fileName );
+		return false;
+	}
+
+	Entries = reinterpret_cast< ovrEntry const * >( data + sizeof( ovrHeader ) );
+	NumStrings = header.NumStrings;
+	Pool = reinterpret_cast< char const * >( data + header.PoolOffset );
+	PoolSize = header.PoolSize;
+	return true;
+}
+
+//==============================
+// ovrCompiledStringTable::Find
+bool ovrCompiledStringTable::Find( char const * key, size_t const keyLength, char const * & value, size_t & valueLength ) const
+{
+	uint32_t lo = 0;
+	uint32_t hi = NumStrings;
+	while ( lo < hi )
+	{
+		uint32_t const mid = lo + ( hi - lo ) / 2;
+		ovrEntry const & e = Entries[mid];
+		if ( static_cast< uint64_t >( e.KeyOffset ) + e.KeyLength >= PoolSize )
+		{
+			return false;	// corrupt table
+		}
+
+		size_t const n = std::min( keyLength, static_cast< size_t >( e.KeyLength ) );
+		int cmp = memcmp( key, Pool + e.KeyOffset, n );
+		if ( cmp == 0 )
+		{
+			cmp = keyLength < e.KeyLength ? -1 : ( keyLength > e.KeyLength ? 1 : 0 );
+		}
+
+		if ( cmp < 0 )
+		{
+			hi = mid;
+		}
+		else if ( cmp > 0 )
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			if ( static_cast< uint64_t >( e.ValueOffset ) + e.ValueLength >= PoolSize )
+			{
+				return false;
+			}
+			value = Pool + e.ValueOffset;
+			valueLength = e.ValueLength;
+			return true;
+		}
+	}
+	return false;
+}
+
+//==============================================================
+// ovrStringIndex
+//
+// An open-addressed hash of strings to the order they were added in. Unlike
+// std::unordered_map< std::string, int >, keys are found from a pointer and
+// a length, so a look-up never has to build a std::string.
+class ovrStringIndex
+{
+public:
+	// returns the index of the key, or -1 if it was never added
+	int		Find( char const * key, size_t const keyLength ) const;
+	// returns the index of the key, adding it if it wasn't found
+	int		Add( char const * key, size_t const keyLength, bool & added );
+
+	int		GetNumKeys() const { return static_cast< int >( Keys.size() ); }
+	void	Clear();
+
+private:
+	struct ovrSlot
+	{
+		uint32_t	Hash;
+		int			Index;	// -1 if the slot is empty
+	};
+
+	std::vector< std::string >	Keys;
+	std::vector< ovrSlot >		Slots;	// power-of-2 size, never more than half full
+
+	static uint32_t	Hash( char const * key, size_t const keyLength );
+	void			Grow();
+};
+
+//==============================
+// ovrStringIndex::Hash
+uint32_t ovrStringIndex::Hash( char const * key, size_t const keyLength )
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	for ( size_t i = 0; i < keyLength; ++i )
+	{
+		hash = ( hash ^ static_cast< uint8_t >( key[i] ) ) * 16777619u;
+	}
+	return hash;
+}
+
+//==============================
+// ovrStringIndex::Find
+int ovrStringIndex::Find( char const * key, size_t const keyLength ) const
+{
+	if ( Slots.empty() )
+	{
+		return -1;
+	}
+	uint32_t const hash = Hash( key, keyLength );
+	size_t const mask = Slots.size() - 1;
+	for ( size_t i = hash & mask; ; i = ( i + 1 ) & mask )
+	{
+		ovrSlot const & slot = Slots[i];
+		if ( slot.Index < 0 )
+		{
+			return -1;
+		}
+		if ( slot.Hash == hash )
+		{
+			std::string const & k = Keys[slot.Index];
+			if ( k.size() == keyLength && memcmp( k.data(), key, keyLength ) == 0 )
+			{
+				return slot.Index;
+			}
+		}
+	}
+}
+
+//==============================
+// ovrStringIndex::Add
+int ovrStringIndex::Add( char const * key, size_t const keyLength, bool & added )
+{
+	int const found = Find( key, keyLength );
+	if ( found >= 0 )
+	{
+		added = false;
+		return found;
+	}
+
+	if ( ( Keys.size() + 1 ) * 2 > Slots.size() )
+	{
+		Grow();
+	}
+
+	int const index = static_cast< int >( Keys.size() );
+	Keys.emplace_back( key, keyLength );
+
+	uint32_t const hash = Hash( key, keyLength );
+	size_t const mask = Slots.size() - 1;
+	size_t i = hash & mask;
+	while ( Slots[i].Index >= 0 )
+	{
+		i = ( i + 1 ) & mask;
+	}
+	Slots[i].Hash = hash;
+	Slots[i].Index = index;
+
+	added = true;
+	return index;
+}
+
+//==============================
+// ovrStringIndex::Grow
+void ovrStringIndex::Grow()
+{
+	std::vector< ovrSlot > oldSlots;
+	oldSlots.swap( Slots );
+
+	ovrSlot const empty = { 0, -1 };
+	Slots.assign( oldSlots.empty() ? 16 : oldSlots.size() * 2, empty );
+
+	size_t const mask = Slots.size() - 1;
+	for ( ovrSlot const & slot : oldSlots )
+	{
+		if ( slot.Index < 0 )
+		{
+			continue;
+		}
+		size_t i = slot.Hash & mask;
+		while ( Slots[i].Index >= 0 )
+		{
+			i = ( i + 1 ) & mask;
+		}
+		Slots[i] = slot;
+	}
+}
+
+//==============================
+// ovrStringIndex::Clear
+void ovrStringIndex::Clear()
+{
+	Keys.clear();
+	Slots.clear();
+}
+
 //==============================================================
 // ovrLocaleInternal
 class ovrLocaleInternal : public ovrLocale
@@ -58,6 +337,10 @@ public:
 
 	virtual bool			AddStringsFromAndroidFormatXMLBuffer( char const * name, char const * buffer, size_t const size );
 
+	virtual bool			LoadCompiledStringsFile( char const * fileName );
+
+	virtual void			SetCompiledStringsCachePath( char const * cachePath );
+
 	virtual bool			GetLocalizedString( char const * key, char const * defaultStr, std::string & out ) const;
 
 	virtual void			ReplaceLocalizedText( char const * inText, char * out, size_t const outSize ) const;
@@ -69,10 +352,23 @@ private:
 	std::string								Name;			// user-specified locale name
 	std::string								LanguageCode;	// system-specific locale name
 	std::vector< std::string >				Strings;
-	std::unordered_map< std::string, int >	StringHash;
+	ovrStringIndex							StringIndex;	// index into Strings for each key
+	std::vector< ovrCompiledStringTable * >	CompiledTables;
+	std::string								CompiledStringsCachePath;
+
+	// ReplaceLocalizedText expands each distinct text once and then only copies it. Labels
+	// are refreshed with the same text over and over, but text that embeds changing values
+	// could grow the cache without bound, so it is flushed when it gets too large.
+	static const int						MAX_CACHED_TEXTS = 1024;
+	mutable std::mutex						TextCacheMutex;
+	mutable ovrStringIndex					TextCacheIndex;	// index into TextCache for each input text
+	mutable std::vector< std::string >		TextCache;
 
 private:
 	bool					GetStringJNI( char const * key, char const * defaultOut, std::string & out ) const;
+	void					AddStrings( char const * name, std::vector< std::pair< std::string, std::string > > const & strings );
+	void					ExpandLocalizedText( char const * inText, char const * firstKey, std::string & out ) const;
+	void					FlushTextCache();
 };
 
 char const *	ovrLocaleInternal::LOCALIZED_KEY_PREFIX = "@string/";
@@ -92,6 +388,11 @@ ovrLocaleInternal::ovrLocaleInternal( JNIEnv & jni_, jobject activity_, char con
 // ovrLocaleInternal::~ovrLocaleInternal
 ovrLocaleInternal::~ovrLocaleInternal()
 {
+	for ( ovrCompiledStringTable * table : CompiledTables )
+	{
+		delete table;
+	}
+	CompiledTables.clear();
 }
 
 //==============================
@@ -120,8 +421,10 @@ static void GetValueFromNode( std::string & v, tinyxml2::XMLNode const * node )
 }
 
 //==============================
-// ovrLocaleInternal::AddStringsFromAndroidFormatXMLBuffer
-bool ovrLocaleInternal::AddStringsFromAndroidFormatXMLBuffer( char const * name, char const * buffer, size_t const size )
+// ParseAndroidFormatXMLBuffer
+// Returns each string's key and decoded value, in file order.
+static bool ParseAndroidFormatXMLBuffer( char const * name, char const * buffer, size_t const size, 
+		std::vector< std::pair< std::string, std::string > > & strings )
 {
 	tinyxml2::XMLDocument doc;
 	tinyxml2::XMLError error = doc.Parse( buffer, size );
@@ -216,18 +519,124 @@ bool ovrLocaleInternal::AddStringsFromAndroidFormatXMLBuffer( char const * name,
 		}
 		//ALOG( "Name: '%s' = '%s'\n", key.c_str(), value.c_str() );
 
-		if ( StringHash.find( key ) == StringHash.end() )
+		strings.emplace_back( std::move( key ), std::move( decodedValue ) );
+	}
+
+	return true;
+}
+
+//==============================
+// ovrLocaleInternal::AddStrings
+void ovrLocaleInternal::AddStrings( char const * name, std::vector< std::pair< std::string, std::string > > const & strings )
+{
+	for ( auto const & s : strings )
+	{
+		bool added;
+		StringIndex.Add( s.first.c_str(), s.first.size(), added );
+		if ( added )
 		{
-			StringHash[key] = static_cast< int >( Strings.size() );
-			Strings.push_back( decodedValue );
+			Strings.push_back( s.second );
 		}
 	}
+	FlushTextCache();
 
 	ALOG( "Added %i strings from '%s'", static_cast< int >( Strings.size() ), name );
+}
 
+//==============================
+// ovrLocaleInternal::AddStringsFromAndroidFormatXMLBuffer
+bool ovrLocaleInternal::AddStringsFromAndroidFormatXMLBuffer( char const * name, char const * buffer, size_t const size )
+{
+	std::vector< std::pair< std::string, std::string > > strings;
+	if ( !ParseAndroidFormatXMLBuffer( name, buffer, size, strings ) )
+	{
+		return false;
+	}
+	AddStrings( name, strings );
 	return true;
 }
 
+//==============================
+// ovrLocaleInternal::LoadCompiledStringsFile
+bool ovrLocaleInternal::LoadCompiledStringsFile( char const * fileName )
+{
+	ovrCompiledStringTable * table = new ovrCompiledStringTable();
+	if ( !table->Open( fileName ) )
+	{
+		delete table;
+		return false;
+	}
+	CompiledTables.push_back( table );
+	FlushTextCache();
+
+	ALOG( "Mapped %i strings from '%s'", table->GetNumStrings(), fileName );
+	return true;
+}
+
+//==============================
+// ovrLocaleInternal::SetCompiledStringsCachePath
+void ovrLocaleInternal::SetCompiledStringsCachePath( char const * cachePath )
+{
+	CompiledStringsCachePath = cachePath != nullptr ? cachePath : "";
+	if ( !CompiledStringsCachePath.empty() && CompiledStringsCachePath.back() != '/' )
+	{
+		CompiledStringsCachePath += '/';
+	}
+}
+
+//==============================
+// CompileStrings
+static void CompileStrings( std::vector< std::pair< std::string, std::string > > const & strings, std::vector< uint8_t > & out )
+{
+	// sort by key, keeping the first of any duplicate keys like ovrLocaleInternal::AddStrings does
+	std::vector< int > order( strings.size() );
+	for ( int i = 0; i < static_cast< int >( order.size() ); ++i )
+	{
+		order[i] = i;
+	}
+	std::stable_sort( order.begin(), order.end(), [&strings]( int const a, int const b ) 
+	{
+		return strings[a].first < strings[b].first;
+	} );
+	order.erase( std::unique( order.begin(), order.end(), [&strings]( int const a, int const b )
+	{
+		return strings[a].first == strings[b].first;
+	} ), order.end() );
+
+	std::vector< ovrCompiledStringTable::ovrEntry > entries( order.size() );
+	std::vector< uint8_t > pool;
+	auto AddToPool = [&pool]( std::string const & s, uint32_t & offset, uint32_t & length )
+	{
+		offset = static_cast< uint32_t >( pool.size() );
+		length = static_cast< uint32_t >( s.size() );
+		pool.insert( pool.end(), s.c_str(), s.c_str() + s.size() + 1 );
+	};
+	for ( size_t i = 0; i < order.size(); ++i )
+	{
+		auto const & s = strings[order[i]];
+		AddToPool( s.first, entries[i].KeyOffset, entries[i].KeyLength );
+		AddToPool( s.second, entries[i].ValueOffset, entries[i].ValueLength );
+	}
+
+	ovrCompiledStringTable::ovrHeader header;
+	header.Magic = ovrCompiledStringTable::MAGIC;
+	header.Version = ovrCompiledStringTable::VERSION;
+	header.NumStrings = static_cast< uint32_t >( entries.size() );
+	header.PoolOffset = static_cast< uint32_t >( sizeof( header ) + entries.size() * sizeof( ovrCompiledStringTable::ovrEntry ) );
+	header.PoolSize = static_cast< uint32_t >( pool.size() );
+
+	out.resize( header.PoolOffset + pool.size() );
+	memcpy( out.data(), &header, sizeof( header ) );
+	if ( !entries.empty() )
+	{
+		memcpy( out.data() + sizeof( header ), entries.data(), entries.size() * sizeof( ovrCompiledStringTable::ovrEntry ) );
+	}
+	if ( !pool.empty() )
+	{
+		memcpy( out.data() + header.PoolOffset, pool.data(), pool.size() );
+	}
+}
+
 //==============================
 // ovrLocaleInternal::LoadStringsFromAndroidFormatXMLFile
 bool ovrLocaleInternal::LoadStringsFromAndroidFormatXMLFile( ovrFileSys & fileSys, char const * fileName )
@@ -237,7 +646,37 @@ bool ovrLocaleInternal::LoadStringsFromAndroidFormatXMLFile( ovrFileSys & fileSy
 	{
 		return false;
 	}
-	return AddStringsFromAndroidFormatXMLBuffer( fileName, reinterpret_cast< char const * > ( static_cast< uint8_t const * >( buffer.data() ) ), buffer.size() );
+	char const * xml = reinterpret_cast< char const * > ( static_cast< uint8_t const * >( buffer.data() ) );
+	if ( CompiledStringsCachePath.empty() )
+	{
+		return AddStringsFromAndroidFormatXMLBuffer( fileName, xml, buffer.size() );
+	}
+
+	// FNV-1a of the XML, so edits to the strings never pick up a stale table
+	uint64_t const hash = FNV1a64( buffer.data(), buffer.size() );
+	char name[64];
+	snprintf( name, sizeof( name ), "strings_v%u_%016" PRIx64 "_%zu.bin", ovrCompiledStringTable::VERSION, hash, buffer.size() );
+	std::string const cacheFileName = CompiledStringsCachePath + name;
+	if ( LoadCompiledStringsFile( cacheFileName.c_str() ) )
+	{
+		return true;
+	}
+
+	std::vector< std::pair< std::string, std::string > > strings;
+	if ( !ParseAndroidFormatXMLBuffer( fileName, xml, buffer.size(), strings ) )
+	{
+		return false;
+	}
+	std::vector< uint8_t > compiled;
+	CompileStrings( strings, compiled );
+	if ( WriteFileAtomically( cacheFileName.c_str(), compiled ) && LoadCompiledStringsFile( cacheFileName.c_str() ) )
+	{
+		return true;
+	}
+
+	ALOGW( "Failed to compile '%s' to '%s'.", fileName, cacheFileName.c_str() );
+	AddStrings( fileName, strings );
+	return true;
 }
 
 //==============================
@@ -419,16 +858,27 @@ bool ovrLocaleInternal::GetLocalizedString( char const * key, char const * defau
 		return false;
 	}
 
-	if ( strstr( key, LOCALIZED_KEY_PREFIX ) == key )
+	if ( strncmp( key, LOCALIZED_KEY_PREFIX, LOCALIZED_KEY_PREFIX_LEN ) == 0 )
 	{
-		if ( Strings.size() > 0 )
+		char const * realKey = key + LOCALIZED_KEY_PREFIX_LEN;
+		size_t const realKeyLength = strlen( realKey );
+		int const index = StringIndex.Find( realKey, realKeyLength );
+		if ( index >= 0 )
+		{
+			out = Strings[index];
+			return true;
+		}
+		if ( !CompiledTables.empty() )
 		{
-			std::string realKey( key + LOCALIZED_KEY_PREFIX_LEN );
-			auto it = StringHash.find( realKey );
-			if ( it != StringHash.end() )
+			for ( ovrCompiledStringTable const * table : CompiledTables )
 			{
-				out = Strings[ it->second ];
-				return true;
+				char const * value;
+				size_t valueLength;
+				if ( table->Find( realKey, realKeyLength, value, valueLength ) )
+				{
+					out.assign( value, valueLength );
+					return true;
+				}
 			}
 		}
 	}
@@ -444,41 +894,18 @@ bool ovrLocaleInternal::GetLocalizedString( char const * key, char const * defau
 }
 
 //==============================
-// ovrLocaleInternal::ReplaceLocalizedText
-void ovrLocaleInternal::ReplaceLocalizedText( char const * inText, char * out, size_t const outSize ) const
+// ovrLocaleInternal::ExpandLocalizedText
+void ovrLocaleInternal::ExpandLocalizedText( char const * inText, char const * firstKey, std::string & out ) const
 {
-	char const * cur = strstr( inText, LOCALIZED_KEY_PREFIX );
-	if ( cur == nullptr )
-	{
-		OVR::OVR_strcpy( out, outSize, inText );
-		return;
-	}
-
 	const size_t MAX_AT_STRING_LEN = 256;
-	size_t outOfs = 0;
 	char const * last = inText;
+	char const * cur = firstKey;
 
-	auto CopyChars = [] ( char * out, size_t outSize, size_t & outOfs, char const * src, size_t const count )
-	{
-		size_t remaining = outSize - outOfs - 1;
-		size_t copyCount = count > remaining ? remaining : count;
-		memcpy( &out[outOfs], src, copyCount );
-		outOfs += copyCount;
-		if ( count > remaining )
-		{
-			out[outOfs] = '\0';
-			return false;
-		}
-		return true;
-	};
-
+	out.clear();
 	while( cur != nullptr )
 	{
 		// copy from the last to the current
-		if ( !CopyChars( out, outSize, outOfs, last, cur - last ) )
-		{
-			return;
-		}
+		out.append( last, cur - last );
 
 		// scan ahead to find white space terminating the "@string/"
 		size_t ofs = 0;
@@ -501,25 +928,52 @@ void ovrLocaleInternal::ReplaceLocalizedText( char const * inText, char * out, s
 		// get the localized text
 		std::string localized;
 		GetLocalizedString( atString, atString, localized );
-
-		// copy localized text into the output buffer
-		if ( !CopyChars( out, outSize, outOfs, localized.c_str(), OVR::OVR_strlen( localized.c_str() ) ) )
-		{
-			return;
-		}
+		out += localized.c_str();
 
 		cur = strstr( cur, LOCALIZED_KEY_PREFIX );
-		if ( cur == nullptr )
+	}
+	// copy any remainder
+	out += last;
+}
+
+//==============================
+// ovrLocaleInternal::FlushTextCache
+void ovrLocaleInternal::FlushTextCache()
+{
+	std::lock_guard< std::mutex > lock( TextCacheMutex );
+	TextCacheIndex.Clear();
+	TextCache.clear();
+}
+
+//==============================
+// ovrLocaleInternal::ReplaceLocalizedText
+void ovrLocaleInternal::ReplaceLocalizedText( char const * inText, char * out, size_t const outSize ) const
+{
+	char const * cur = strstr( inText, LOCALIZED_KEY_PREFIX );
+	if ( cur == nullptr )
+	{
+		OVR::OVR_strcpy( out, outSize, inText );
+		return;
+	}
+
+	std::lock_guard< std::mutex > lock( TextCacheMutex );
+
+	size_t const inLength = strlen( inText );
+	int index = TextCacheIndex.Find( inText, inLength );
+	if ( index < 0 )
+	{
+		if ( TextCacheIndex.GetNumKeys() >= MAX_CACHED_TEXTS )
 		{
-			// copy any remainder
-			for ( size_t i = 0; last[i] != '\0' && outOfs < outSize - 1; ++i )
-			{
-				out[outOfs++] = last[i];
-			}
-			out[outOfs] = '\0';
-			break;
+			TextCacheIndex.Clear();
+			TextCache.clear();
 		}
+		bool added;
+		index = TextCacheIndex.Add( inText, inLength, added );
+		TextCache.emplace_back();
+		ExpandLocalizedText( inText, cur, TextCache[index] );
 	}
+
+	OVR::OVR_strcpy( out, outSize, TextCache[index].c_str() );
 }
 
 
@@ -594,6 +1048,19 @@ ovrLocale * ovrLocale::Create( JNIEnv & jni_, jobject activity_, char const * na
 	return localePtr;
 }
 
+//==============================
+// ovrLocale::CompileAndroidFormatXMLBuffer
+bool ovrLocale::CompileAndroidFormatXMLBuffer( char const * name, char const * buffer, size_t const size, std::vector< uint8_t > & out )
+{
+	std::vector< std::pair< std::string, std::string > > strings;
+	if ( !ParseAndroidFormatXMLBuffer( name, buffer, size, strings ) )
+	{
+		return false;
+	}
+	CompileStrings( strings, out );
+	return true;
+}
+
 //==============================
 // ovrLocale::Destroy
 void ovrLocale::Destroy( ovrLocale * & localePtr )
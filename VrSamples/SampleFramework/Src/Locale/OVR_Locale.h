@@ -16,6 +16,7 @@ of patent rights can be found in the PATENTS file in the same directory.
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 #include "VrApi_Types.h"
 #include "JniUtils.h"
@@ -54,6 +55,11 @@ public:
 	static std::string		ToString( char const * fmt, float const f );
 	static std::string		ToString( char const * fmt, int const i );
 
+	// Converts an Android-format XML string file to a compiled string table: a key table sorted for
+	// binary search and a pool of 0-terminated strings, in a single file that can be memory-mapped.
+	static bool				CompileAndroidFormatXMLBuffer( char const * name, char const * buffer, size_t const size, 
+									std::vector< uint8_t > & out );
+
 	//----------------------------------------------------------
 	// public virtual interface methods
 	//----------------------------------------------------------
@@ -72,6 +78,15 @@ public:
 	// been loaded. The name is only an identifier used for error reporting.
 	virtual bool			AddStringsFromAndroidFormatXMLBuffer( char const * name, char const * buffer, size_t const size ) = 0;
 
+	// Memory-maps a file written by CompileAndroidFormatXMLBuffer. Its strings are looked up in place
+	// and are never copied to the heap. Strings added from XML buffers are searched first, then compiled
+	// tables in the order they were loaded.
+	virtual bool			LoadCompiledStringsFile( char const * fileName ) = 0;
+
+	// If set, LoadStringsFromAndroidFormatXMLFile compiles each XML file into this folder the first time
+	// it is loaded, and maps the compiled table instead of parsing the XML after that.
+	virtual void			SetCompiledStringsCachePath( char const * cachePath ) = 0;
+
 	// returns the localized string associated with the passed key. Returns false if the
 	// key was not found. If the key was not found, out will be set to the defaultStr.
 	virtual bool			GetLocalizedString( char const * key, char const * defaultStr, std::string & out ) const = 0;
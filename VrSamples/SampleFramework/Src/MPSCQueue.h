@@ -0,0 +1,302 @@
+/************************************************************************************
+
+Filename    :   MPSCQueue.h
+Content     :   Typed, bounded, lock-free multiple-producer single-consumer queue
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+namespace OVRFW
+{
+
+//==============================================================
+// ovrMPSCQueue
+//
+// A bounded ring of typed items that any number of threads can push to
+// and a single thread pops from. Each slot holds a sequence number that
+// tells a producer when the slot is free and the consumer when the item
+// in it has been written, so neither side takes a lock and items are
+// moved in and out instead of being copied to the heap.
+//
+// Producers claim slots by incrementing Tail with a CAS, and only the
+// consumer writes Head. The two are kept on separate cache lines so that
+// producers don't invalidate the consumer's line on every push.
+//
+// The blocking waits are optional. A mutex and condition variable are only
+// touched when a thread is actually waiting, so a queue that is only polled
+// never locks.
+//
+// The capacity is rounded up to a power of two.
+//==============================================================
+template< typename Type >
+class ovrMPSCQueue
+{
+public:
+	explicit		ovrMPSCQueue( size_t const minCapacity );
+					~ovrMPSCQueue();
+
+	// Thread safe, callable by any thread.
+	// Returns false if the queue is full or has been shut down.
+	bool			TryPush( Type const & item ) { return Emplace( item ); }
+	bool			TryPush( Type && item ) { return Emplace( std::move( item ) ); }
+	// Waits while the queue is full. Returns false if the queue has been shut down.
+	bool			Push( Type const & item ) { return PushWait( item ); }
+	bool			Push( Type && item ) { return PushWait( std::move( item ) ); }
+
+	// Wakes all waiting threads and makes all further pushes fail.
+	void			Shutdown();
+	bool			IsShutdown() const { return ShutDown.load( std::memory_order_acquire ); }
+
+	size_t			GetCapacity() const { return Mask + 1; }
+	// Only exact when no other thread is pushing or popping.
+	size_t			GetSizeApprox() const;
+
+	// The methods below are NOT thread safe, and should only be called by
+	// the consumer thread.
+
+	// Returns false if there is no item.
+	bool			TryPop( Type & item );
+	bool			IsEmpty() const;
+	// Returns true as soon as there is an item, or false if the queue was
+	// shut down or the timeout expired. A negative timeout waits forever.
+	bool			WaitForItem( int const timeoutMilliseconds = -1 );
+
+private:
+	static const size_t CACHE_LINE_SIZE = 64;
+
+	struct ovrSlot
+	{
+		std::atomic< size_t >	Sequence;
+		typename std::aligned_storage< sizeof( Type ), alignof( Type ) >::type	Storage;
+	};
+
+	// Padded rather than alignas'd, since operator new does not honor over-alignment before C++17.
+	ovrSlot *				Slots;
+	size_t					Mask;
+	uint8_t					Pad0[CACHE_LINE_SIZE];
+	std::atomic< size_t >	Tail;	// next slot to claim, written by producers
+	uint8_t					Pad1[CACHE_LINE_SIZE - sizeof( std::atomic< size_t > )];
+	std::atomic< size_t >	Head;	// next slot to pop, written by the consumer
+	uint8_t					Pad2[CACHE_LINE_SIZE - sizeof( std::atomic< size_t > )];
+
+	std::atomic< bool >		ShutDown;
+	std::atomic< bool >		ConsumerWaiting;
+	std::atomic< int >		ProducersWaiting;
+	std::mutex				WaitMutex;
+	std::condition_variable	ItemPushed;
+	std::condition_variable	ItemPopped;
+
+	// not copyable
+					ovrMPSCQueue( ovrMPSCQueue const & ) = delete;
+	ovrMPSCQueue &	operator=( ovrMPSCQueue const & ) = delete;
+
+	template< typename Arg >
+	bool			Emplace( Arg && item );
+	template< typename Arg >
+	bool			PushWait( Arg && item );
+	bool			IsFull() const;
+};
+
+template< typename Type >
+ovrMPSCQueue< Type >::ovrMPSCQueue( size_t const minCapacity )
+	: Slots( nullptr )
+	, Mask( 0 )
+	, Tail( 0 )
+	, Head( 0 )
+	, ShutDown( false )
+	, ConsumerWaiting( false )
+	, ProducersWaiting( 0 )
+{
+	assert( minCapacity > 0 );
+	size_t capacity = 2;
+	while ( capacity < minCapacity )
+	{
+		capacity <<= 1;
+	}
+	Mask = capacity - 1;
+	Slots = new ovrSlot[capacity];
+	for ( size_t i = 0; i < capacity; i++ )
+	{
+		Slots[i].Sequence.store( i, std::memory_order_relaxed );
+	}
+}
+
+template< typename Type >
+ovrMPSCQueue< Type >::~ovrMPSCQueue()
+{
+	for ( size_t pos = Head.load( std::memory_order_relaxed ); Slots[pos & Mask].Sequence.load( std::memory_order_relaxed ) == pos + 1; pos++ )
+	{
+		reinterpret_cast< Type * >( &Slots[pos & Mask].Storage )->~Type();
+	}
+	delete[] Slots;
+}
+
+template< typename Type >
+template< typename Arg >
+bool ovrMPSCQueue< Type >::Emplace( Arg && item )
+{
+	if ( ShutDown.load( std::memory_order_relaxed ) )
+	{
+		return false;
+	}
+
+	ovrSlot * slot;
+	size_t pos = Tail.load( std::memory_order_relaxed );
+	for ( ; ; )
+	{
+		slot = &Slots[pos & Mask];
+		size_t const seq = slot->Sequence.load( std::memory_order_acquire );
+		ptrdiff_t const diff = static_cast< ptrdiff_t >( seq - pos );
+		if ( diff == 0 )
+		{
+			// the slot is free for this position, try to claim it
+			if ( Tail.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+			{
+				break;
+			}
+		}
+		else if ( diff < 0 )
+		{
+			// the item a lap behind has not been popped yet
+			return false;
+		}
+		else
+		{
+			// another producer claimed it first
+			pos = Tail.load( std::memory_order_relaxed );
+		}
+	}
+
+	new ( &slot->Storage ) Type( std::forward< Arg >( item ) );
+	slot->Sequence.store( pos + 1, std::memory_order_release );
+
+	// Pairs with the fence in WaitForItem: either the consumer sees the item
+	// before it sleeps, or this sees that it is waiting.
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	if ( ConsumerWaiting.load( std::memory_order_relaxed ) )
+	{
+		std::lock_guard< std::mutex > lk( WaitMutex );
+		ItemPushed.notify_one();
+	}
+	return true;
+}
+
+template< typename Type >
+template< typename Arg >
+bool ovrMPSCQueue< Type >::PushWait( Arg && item )
+{
+	for ( ; ; )
+	{
+		// Emplace only moves from item when it succeeds
+		if ( Emplace( std::forward< Arg >( item ) ) )
+		{
+			return true;
+		}
+		std::unique_lock< std::mutex > lk( WaitMutex );
+		ProducersWaiting.fetch_add( 1, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		ItemPopped.wait( lk, [this]() { return !IsFull() || IsShutdown(); } );
+		ProducersWaiting.fetch_sub( 1, std::memory_order_relaxed );
+		if ( IsShutdown() )
+		{
+			return false;
+		}
+	}
+}
+
+template< typename Type >
+bool ovrMPSCQueue< Type >::TryPop( Type & item )
+{
+	size_t const pos = Head.load( std::memory_order_relaxed );
+	ovrSlot & slot = Slots[pos & Mask];
+	if ( slot.Sequence.load( std::memory_order_acquire ) != pos + 1 )
+	{
+		return false;
+	}
+
+	Type * stored = reinterpret_cast< Type * >( &slot.Storage );
+	item = std::move( *stored );
+	stored->~Type();
+	slot.Sequence.store( pos + Mask + 1, std::memory_order_release );
+	Head.store( pos + 1, std::memory_order_release );
+
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	if ( ProducersWaiting.load( std::memory_order_relaxed ) > 0 )
+	{
+		std::lock_guard< std::mutex > lk( WaitMutex );
+		ItemPopped.notify_all();
+	}
+	return true;
+}
+
+template< typename Type >
+bool ovrMPSCQueue< Type >::IsEmpty() const
+{
+	size_t const pos = Head.load( std::memory_order_relaxed );
+	return Slots[pos & Mask].Sequence.load( std::memory_order_acquire ) != pos + 1;
+}
+
+template< typename Type >
+bool ovrMPSCQueue< Type >::IsFull() const
+{
+	size_t const pos = Tail.load( std::memory_order_relaxed );
+	return static_cast< ptrdiff_t >( Slots[pos & Mask].Sequence.load( std::memory_order_acquire ) - pos ) < 0;
+}
+
+template< typename Type >
+size_t ovrMPSCQueue< Type >::GetSizeApprox() const
+{
+	size_t const head = Head.load( std::memory_order_acquire );
+	size_t const tail = Tail.load( std::memory_order_acquire );
+	ptrdiff_t const size = static_cast< ptrdiff_t >( tail - head );
+	return size < 0 ? 0 : static_cast< size_t >( size );
+}
+
+template< typename Type >
+bool ovrMPSCQueue< Type >::WaitForItem( int const timeoutMilliseconds )
+{
+	if ( !IsEmpty() )
+	{
+		return true;
+	}
+
+	std::unique_lock< std::mutex > lk( WaitMutex );
+	ConsumerWaiting.store( true, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	auto ready = [this]() { return !IsEmpty() || IsShutdown(); };
+	if ( timeoutMilliseconds < 0 )
+	{
+		ItemPushed.wait( lk, ready );
+	}
+	else
+	{
+		ItemPushed.wait_for( lk, std::chrono::milliseconds( timeoutMilliseconds ), ready );
+	}
+	ConsumerWaiting.store( false, std::memory_order_relaxed );
+	return !IsEmpty();
+}
+
+template< typename Type >
+void ovrMPSCQueue< Type >::Shutdown()
+{
+	ShutDown.store( true, std::memory_order_release );
+	std::lock_guard< std::mutex > lk( WaitMutex );
+	ItemPushed.notify_all();
+	ItemPopped.notify_all();
+}
+
+}	// namespace OVRFW
@@ -23,21 +23,12 @@ namespace OVRFW
 
 bool ovrMessageQueue::debug = false;
 
-ovrMessageQueue::ovrMessageQueue( int maxMessages_ ) :
-	shutdown( false ),
-	maxMessages( maxMessages_ ),
-	messages( new message_t[ maxMessages_ ] ),
-	head( 0 ),
-	tail( 0 ),
-	synced( false )
+ovrMessageQueue::ovrMessageQueue( int maxMessages ) :
+	messages( maxMessages ),
+	synced( false ),
+	processedCount( 0 )
 {
 	assert( maxMessages > 0 );
-
-	for ( int i = 0; i < maxMessages; i++ )
-	{
-		messages[i].string = NULL;
-		messages[i].synced = false;
-	}
 }
 
 ovrMessageQueue::~ovrMessageQueue()
@@ -57,9 +48,6 @@ ovrMessageQueue::~ovrMessageQueue()
 		free( (void *)msg );
 	}
 
-	// Free the queue itself.
-	delete[] messages;
-
 #if defined( OVR_BUILD_DEBUG )
 	ALOG( "%p:~ovrMessageQueue: destroying ... DONE", this );
 #endif
@@ -68,19 +56,17 @@ ovrMessageQueue::~ovrMessageQueue()
 void ovrMessageQueue::Shutdown()
 {
 	ALOG( "%p:ovrMessageQueue shutdown", this );
-	shutdown = true;
 
 	if ( debug )
 	{
 		ALOG( "%p:Shutdown() : notifying on processed", this );
 	}
-	processed.notify_all();
-
-	if ( debug )
 	{
-		ALOG( "%p:Shutdown() : notifying on posted", this );
+		std::lock_guard< std::mutex > lk( sync_mutex );
+		// makes further posts fail before waking a sender
+		messages.Shutdown();
+		processed.notify_all();
 	}
-	posted.notify_all();
 }
 
 // Thread safe, callable by any thread.
@@ -90,7 +76,7 @@ void ovrMessageQueue::Shutdown()
 // buffer overflows.
 bool ovrMessageQueue::PostMessage( const char * msg, bool sync, bool abortIfFull )
 {
-	if ( shutdown )
+	if ( messages.IsShutdown() )
 	{
 		ALOG( "%p:PostMessage( %s ) to shutdown queue", this, msg );
 		return false;
@@ -100,51 +86,51 @@ bool ovrMessageQueue::PostMessage( const char * msg, bool sync, bool abortIfFull
 		ALOG( "%p:PostMessage( %s )", this, msg );
 	}
 
-	// mutex lock scope
+	message_t message;
+	message.string = OVR::OVR_strdup( msg );
+	message.synced = sync;
+
+	// A synced post holds sync_mutex until it waits, so the message can't be
+	// processed before the sender starts waiting for it.
+	std::unique_lock< std::mutex > lk( sync_mutex, std::defer_lock );
+	int startCount = 0;
+	if ( sync )
 	{
-		std::unique_lock< std::mutex > lk( message_mutex );
-		if ( tail - head >= maxMessages )
+		lk.lock();
+		startCount = processedCount;
+	}
+
+	if ( !messages.TryPush( message ) )
+	{
+		free( (void *)message.string );
+		if ( messages.IsShutdown() )
 		{
-			if ( abortIfFull )
-			{
-				ALOG( "ovrMessageQueue overflow" );
-				for ( int i = head; i < tail; i++ )
-				{
-					ALOG( "%s", messages[i % maxMessages].string );
-				}
-				ALOGE_FAIL( "Message buffer overflowed" );
-			}
+			ALOG( "%p:PostMessage( %s ) to shutdown queue", this, msg );
 			return false;
 		}
-		const int index = tail % maxMessages;
-		messages[index].string = OVR::OVR_strdup( msg );
-		messages[index].synced = sync;
-		tail++;
-
-		if ( debug )
+		if ( abortIfFull )
 		{
-			ALOG( "%p:PostMessage( '%s' ) : notifying on posted", this, msg );
+			ALOG( "ovrMessageQueue overflow: %i messages posting %s", static_cast< int >( messages.GetCapacity() ), msg );
+			ALOGE_FAIL( "Message buffer overflowed" );
 		}
+		return false;
+	}
 
-		posted.notify_all();
-
+	if ( sync )
+	{
 		if ( debug )
 		{
 			ALOG( "%p:PostMessage( '%s' ) : sleep waiting on processed", this, msg );
 		}
 
-		// wait scope
-		if ( sync )
+		processed.wait( lk, [this, startCount]() { return processedCount != startCount || messages.IsShutdown(); } );
+
+		if ( debug )
 		{
-			processed.wait( lk );
+			ALOG( "%p:PostMessage( '%s' ) : awoke after waiting on processed", this, msg );
 		}
 	}
 
-	if ( debug )
-	{
-		ALOG( "%p:PostMessage( '%s' ) : awoke after waiting on processed", this, msg );
-	}
-
 	return true;
 }
 
@@ -214,26 +200,18 @@ const char * ovrMessageQueue::GetNextMessage()
 {
 	NotifyMessageProcessed();
 
+	message_t message;
+	if ( !messages.TryPop( message ) )
 	{
-		std::unique_lock< std::mutex > lk( message_mutex );
-		if ( tail > head )
-		{
-			const int index = head % maxMessages;
-			const char * msg = messages[index].string;
-			synced = messages[index].synced;
-			messages[index].string = NULL;
-			messages[index].synced = false;
-			head++;
-
-			if ( debug )
-			{
-				ALOG( "%p:GetNextMessage() : %s", this, msg );
-			}
-			return msg;
-		}
+		return nullptr;
 	}
+	synced = message.synced;
 
-	return nullptr;
+	if ( debug )
+	{
+		ALOG( "%p:GetNextMessage() : %s", this, message.string );
+	}
+	return message.string;
 }
 
 // Returns immediately if there is already a message in the queue.
@@ -241,33 +219,17 @@ void ovrMessageQueue::SleepUntilMessage()
 {
 	NotifyMessageProcessed();
 
-	// Guard
+	if ( debug )
 	{
-		std::unique_lock< std::mutex > lk( message_mutex );
-		if ( tail > head )
-		{
-			if ( debug )
-			{
-				ALOG( "%p:SleepUntilMessage() : tail > head", this );
-			}
-			return;
-		}
-
-		if ( debug )
-		{
-			ALOG( "%p:SleepUntilMessage() : sleep waiting on posted", this );
-		}
-
-		// Wait
-		posted.wait( lk );
+		ALOG( "%p:SleepUntilMessage() : sleep waiting on posted", this );
 	}
 
+	messages.WaitForItem();
 
 	if ( debug )
 	{
 		ALOG( "%p:SleepUntilMessage() : awoke after waiting on posted", this );
 	}
-
 }
 
 void ovrMessageQueue::NotifyMessageProcessed()
@@ -279,6 +241,8 @@ void ovrMessageQueue::NotifyMessageProcessed()
 		{
 			ALOG( "%p:NotifyMessageProcessed() : notifying on processed", this );
 		}
+		std::lock_guard< std::mutex > lk( sync_mutex );
+		processedCount++;
 		processed.notify_all();
 	}
 }
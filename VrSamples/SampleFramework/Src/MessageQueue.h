@@ -15,10 +15,14 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #include <condition_variable>
 #include <atomic>
 
+#include "MPSCQueue.h"
+
 namespace OVRFW
 {
 
 // This is a multiple-producer, single-consumer message queue.
+// Messages are strings that are copied on post. For anything sent often,
+// ovrMPSCQueue with a message struct avoids the copy and the parse.
 
 class ovrMessageQueue
 {
@@ -51,8 +55,9 @@ public:
 	void			SendString( const char * msg );
 	void			SendPrintf( const char * fmt, ... );
 
-	// Returns the number slots available for new messages.
-	int				SpaceAvailable() const { return maxMessages - ( tail - head ); }
+	// Returns the number slots available for new messages. The queue holds at
+	// least maxMessages, rounded up to a power of two.
+	int				SpaceAvailable() const { return static_cast< int >( messages.GetCapacity() - messages.GetSizeApprox() ); }
 
 	// The other methods are NOT thread safe, and should only be
 	// called by the thread that owns the ovrMessageQueue.
@@ -74,9 +79,6 @@ private:
 	// If set true, print all message sends and gets to the log
 	static bool		debug;
 
-	bool			shutdown;
-	int 			maxMessages;
-
 	struct message_t
 	{
 		const char *	string;
@@ -85,16 +87,14 @@ private:
 
 	// All messages will be allocated with strdup, and returned to
 	// the caller on GetNextMessage().
-	message_t * 	messages;
+	ovrMPSCQueue< message_t >	messages;
 
-	// PostMessage() fills in messages[tail%maxMessages], then increments tail
-	// If tail > head, GetNextMessage() will fetch messages[head%maxMessages],
-	// then increment head.
-	volatile int			head;
-	volatile int			tail;
+	// Set when a synced message is returned by GetNextMessage(), and
+	// cleared when the sender is woken. processedCount is guarded by
+	// sync_mutex and only changes when a synced message was processed.
 	std::atomic<bool>		synced;
-	std::mutex				message_mutex;
-	std::condition_variable	posted;
+	int						processedCount;
+	std::mutex				sync_mutex;
 	std::condition_variable	processed;
 
 	bool PostMessage( const char * msg, bool sync, bool abortIfFull );
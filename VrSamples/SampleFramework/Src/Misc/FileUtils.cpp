@@ -0,0 +1,108 @@
+/************************************************************************************
+
+Filename    :   FileUtils.cpp
+Content     :   Whole-file reads and atomic writes for local cache files.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include "FileUtils.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <string>
+
+namespace OVRFW {
+
+//==============================
+// ReadWholeFile
+bool ReadWholeFile( char const * fileName, std::vector< uint8_t > & buffer )
+{
+	buffer.clear();
+
+	int const fd = open( fileName, O_RDONLY | O_CLOEXEC );
+	if ( fd < 0 )
+	{
+		return false;
+	}
+
+	struct stat st;
+	bool ok = fstat( fd, &st ) == 0 && st.st_size > 0;
+	if ( ok )
+	{
+		buffer.resize( static_cast< size_t >( st.st_size ) );
+		size_t done = 0;
+		while ( done < buffer.size() )
+		{
+			ssize_t const numRead = read( fd, buffer.data() + done, buffer.size() - done );
+			if ( numRead < 0 && errno == EINTR )
+			{
+				continue;
+			}
+			if ( numRead <= 0 )
+			{
+				break;
+			}
+			done += static_cast< size_t >( numRead );
+		}
+		ok = done == buffer.size();
+	}
+	close( fd );
+
+	if ( !ok )
+	{
+		buffer.clear();
+	}
+	return ok;
+}
+
+//==============================
+// WriteFileAtomically
+bool WriteFileAtomically( char const * fileName, void const * data, size_t const size )
+{
+	static std::atomic< uint32_t > tempCount( 0 );
+	char suffix[48];
+	snprintf( suffix, sizeof( suffix ), ".%d.%u.tmp", static_cast< int >( getpid() ), tempCount++ );
+	std::string const tempName = std::string( fileName ) + suffix;
+
+	int const fd = open( tempName.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0660 );
+	if ( fd < 0 )
+	{
+		return false;
+	}
+
+	uint8_t const * bytes = static_cast< uint8_t const * >( data );
+	size_t done = 0;
+	while ( done < size )
+	{
+		ssize_t const numWritten = write( fd, bytes + done, size - done );
+		if ( numWritten < 0 && errno == EINTR )
+		{
+			continue;
+		}
+		if ( numWritten <= 0 )
+		{
+			break;
+		}
+		done += static_cast< size_t >( numWritten );
+	}
+
+	// sync before the rename, so a crash can't leave the new name on an unwritten file
+	bool ok = done == size;
+	ok = fsync( fd ) == 0 && ok;
+	ok = close( fd ) == 0 && ok;
+	if ( !ok || rename( tempName.c_str(), fileName ) != 0 )
+	{
+		unlink( tempName.c_str() );
+		return false;
+	}
+	return true;
+}
+
+}	// namespace OVRFW
@@ -0,0 +1,33 @@
+/************************************************************************************
+
+Filename    :   FileUtils.h
+Content     :   Whole-file reads and atomic writes for local cache files.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace OVRFW {
+
+// Reads a whole local file. Returns false with an empty buffer if the file is missing,
+// empty or can't be read.
+bool	ReadWholeFile( char const * fileName, std::vector< uint8_t > & buffer );
+
+// Writes to a temporary file, syncs it and renames it over fileName, so a reader sees
+// either the old file or the whole new one, even if the write is interrupted. The
+// temporary name is unique, so threads or processes writing the same file at once
+// don't write into each other's temporary file.
+bool	WriteFileAtomically( char const * fileName, void const * data, size_t const size );
+
+inline bool WriteFileAtomically( char const * fileName, std::vector< uint8_t > const & buffer )
+{
+	return WriteFileAtomically( fileName, buffer.data(), buffer.size() );
+}
+
+}	// namespace OVRFW
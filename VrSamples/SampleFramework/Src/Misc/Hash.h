@@ -0,0 +1,43 @@
+/************************************************************************************
+
+Filename    :   Hash.h
+Content     :   FNV-1a hashing of byte strings.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace OVRFW {
+
+static const uint64_t FNV1A64_OFFSET_BASIS	= 14695981039346656037ULL;
+static const uint64_t FNV1A64_PRIME			= 1099511628211ULL;
+
+// 64-bit FNV-1a. Pass the result of an earlier call as hash to continue hashing after it.
+inline uint64_t FNV1a64( void const * data, size_t const len, uint64_t hash = FNV1A64_OFFSET_BASIS )
+{
+	uint8_t const * bytes = static_cast< uint8_t const * >( data );
+	for ( size_t i = 0; i < len; i++ )
+	{
+		hash = ( hash ^ bytes[i] ) * FNV1A64_PRIME;
+	}
+	return hash;
+}
+
+// FNV1a64 of the string with ASCII letters lowercased, for keys that ignore case.
+inline uint64_t FNV1a64Lower( char const * str, size_t const len, uint64_t hash = FNV1A64_OFFSET_BASIS )
+{
+	for ( size_t i = 0; i < len; i++ )
+	{
+		char const c = str[i];
+		uint8_t const lower = static_cast< uint8_t >( ( c >= 'A' && c <= 'Z' ) ? c - 'A' + 'a' : c );
+		hash = ( hash ^ lower ) * FNV1A64_PRIME;
+	}
+	return hash;
+}
+
+}	// namespace OVRFW
@@ -459,13 +459,29 @@ ModelFile * LoadModelFileFromApplicationPackage( const char * nameInZip,
 
 ModelFile * LoadModelFile( ovrFileSys & fileSys, const char * uri, const ModelGlPrograms & programs, const MaterialParms & materialParms )
 {
+	ovrStream * stream = fileSys.OpenStream( uri, OVR_STREAM_MODE_READ );
+	if ( stream == nullptr )
+	{
+		ALOGW( "Failed to load model uri '%s'", uri );
+		return nullptr;
+	}
+
+	// Local files are mapped, so stored geometry is uploaded straight from the page cache.
+	MappedFile file;
+	MappedView view;
 	std::vector< uint8_t > buffer;
-	if ( !fileSys.ReadFile( uri, buffer ) )
+	const bool mapped = stream->MapFile( file, view );
+	const bool loaded = mapped || stream->ReadFile( uri, buffer );
+	fileSys.CloseStream( stream );
+	if ( !loaded )
 	{
 		ALOGW( "Failed to load model uri '%s'", uri );
 		return nullptr;
 	}
-	ModelFile * scene = LoadModelFileFromMemory( uri, buffer.data(), static_cast<int>( buffer.size() ), programs, materialParms );
+
+	const uint8_t * data = mapped ? view.GetFront() : buffer.data();
+	const int dataLength = static_cast<int>( mapped ? file.GetLength() : buffer.size() );
+	ModelFile * scene = LoadModelFileFromMemory( uri, data, dataLength, programs, materialParms );
 	return scene;
 }
 
@@ -42,6 +42,23 @@ void ReadModelArray( std::vector< _type_ > & out, const char * string, const Bin
 	}
 }
 
+// Points span at the array in the binary file when it can be used in place, otherwise
+// reads it into storage and points span there.
+template< typename _type_ >
+void ReadModelSpan( GeometrySpan< _type_ > & span, std::vector< _type_ > & storage, const char * string, const BinaryReader & bin, const int numElements )
+{
+	if ( string != nullptr && string[0] != '\0' && numElements > 0 )
+	{
+		if ( bin.ReadSpan( span.Data, numElements ) )
+		{
+			span.Count = numElements;
+			return;
+		}
+		ReadModelArray( storage, string, bin, numElements );
+		span = GeometrySpan< _type_ >( storage );
+	}
+}
+
 bool LoadModelFile_OvrScene_Json( ModelFile & modelFile,
 	const char * modelsJson, const int modelsJsonLength,
 	const char * modelsBin, const int modelsBinLength,
@@ -49,7 +66,6 @@ bool LoadModelFile_OvrScene_Json( ModelFile & modelFile,
 	ModelGeo * outModelGeo )
 {
 	ALOG( "parsing %s", modelFile.FileName.c_str() );
-	OVR_UNUSED( modelsJsonLength );
 
 	const BinaryReader bin( ( const std::uint8_t * )modelsBin, modelsBinLength );
 
@@ -59,9 +75,10 @@ bool LoadModelFile_OvrScene_Json( ModelFile & modelFile,
 		return false;
 	}
 
+	// an uncompressed entry points into the zip file, so it is not null-terminated
 	const char * error = nullptr;
-	auto json = OVR::JSON::Parse( modelsJson, &error );
-	if ( json == nullptr )
+	OVR::JsonDocument json;
+	if ( !json.Parse( modelsJson, static_cast< size_t >( modelsJsonLength ), &error ) )
 	{
 		ALOGW( "LoadModelFile_OvrScene_Json: Error loading %s : %s", modelFile.FileName.c_str(), error );
 		return false;
@@ -311,7 +328,8 @@ bool LoadModelFile_OvrScene_Json( ModelFile & modelFile,
 						// Vertices
 						//
 
-						VertexAttribs attribs;
+						VertexAttribs attribs;		// attributes that can't be used in place in the binary file
+						VertexAttribSpans spans;
 
 						const OVR::JsonReader vertices( surface.GetChildByName( "vertices" ) );
 						if ( vertices.IsObject() )
@@ -319,22 +337,19 @@ bool LoadModelFile_OvrScene_Json( ModelFile & modelFile,
 							const int vertexCount = std::min<int>( vertices.GetChildInt32ByName( "vertexCount" ), GlGeometry::GetMaxGeometryVertices() );
 							// ALOG( "%5d vertices", vertexCount );
 
-							ReadModelArray( attribs.position, vertices.GetChildStringByName( "position" ).c_str(), bin, vertexCount );
-							ReadModelArray( attribs.normal, vertices.GetChildStringByName( "normal" ).c_str(), bin, vertexCount );
-							ReadModelArray( attribs.tangent, vertices.GetChildStringByName( "tangent" ).c_str(), bin, vertexCount );
-							ReadModelArray( attribs.binormal, vertices.GetChildStringByName( "binormal" ).c_str(), bin, vertexCount );
-							ReadModelArray( attribs.color, vertices.GetChildStringByName( "color" ).c_str(), bin, vertexCount );
-							ReadModelArray( attribs.uv0, vertices.GetChildStringByName( "uv0" ).c_str(), bin, vertexCount );
-							ReadModelArray( attribs.uv1, vertices.GetChildStringByName( "uv1" ).c_str(), bin, vertexCount );
-							ReadModelArray( attribs.jointIndices, vertices.GetChildStringByName( "jointIndices" ).c_str(), bin, vertexCount );
-							ReadModelArray( attribs.jointWeights, vertices.GetChildStringByName( "jointWeights" ).c_str(), bin, vertexCount );
+							ReadModelSpan( spans.position, attribs.position, vertices.GetChildStringByName( "position" ).c_str(), bin, vertexCount );
+							ReadModelSpan( spans.normal, attribs.normal, vertices.GetChildStringByName( "normal" ).c_str(), bin, vertexCount );
+							ReadModelSpan( spans.tangent, attribs.tangent, vertices.GetChildStringByName( "tangent" ).c_str(), bin, vertexCount );
+							ReadModelSpan( spans.binormal, attribs.binormal, vertices.GetChildStringByName( "binormal" ).c_str(), bin, vertexCount );
+							ReadModelSpan( spans.color, attribs.color, vertices.GetChildStringByName( "color" ).c_str(), bin, vertexCount );
+							ReadModelSpan( spans.uv0, attribs.uv0, vertices.GetChildStringByName( "uv0" ).c_str(), bin, vertexCount );
+							ReadModelSpan( spans.uv1, attribs.uv1, vertices.GetChildStringByName( "uv1" ).c_str(), bin, vertexCount );
+							ReadModelSpan( spans.jointIndices, attribs.jointIndices, vertices.GetChildStringByName( "jointIndices" ).c_str(), bin, vertexCount );
+							ReadModelSpan( spans.jointWeights, attribs.jointWeights, vertices.GetChildStringByName( "jointWeights" ).c_str(), bin, vertexCount );
 
 							if ( outModelGeo != nullptr )
 							{
-								for ( int i = 0; i < static_cast< int >( attribs.position.size() ); ++i )
-								{
-									( *outModelGeo ).positions.push_back( attribs.position[i] );
-								}
+								( *outModelGeo ).positions.insert( ( *outModelGeo ).positions.end(), spans.position.Data, spans.position.Data + spans.position.Count );
 							}
 						}
 
@@ -343,6 +358,7 @@ bool LoadModelFile_OvrScene_Json( ModelFile & modelFile,
 						//
 
 						std::vector< TriangleIndex > indices;
+						GeometrySpan< TriangleIndex > indexSpan;
 
 						const OVR::JsonReader triangles( surface.GetChildByName( "triangles" ) );
 						if ( triangles.IsObject() )
@@ -350,14 +366,14 @@ bool LoadModelFile_OvrScene_Json( ModelFile & modelFile,
 							const int indexCount = std::min<int>( triangles.GetChildInt32ByName( "indexCount" ), GlGeometry::GetMaxGeometryIndices() );
 							// ALOG( "%5d indices", indexCount );
 
-							ReadModelArray( indices, triangles.GetChildStringByName( "indices" ).c_str(), bin, indexCount );
+							ReadModelSpan( indexSpan, indices, triangles.GetChildStringByName( "indices" ).c_str(), bin, indexCount );
 						}
 
 						if ( outModelGeo != nullptr )
 						{
-							for ( int i = 0; i < static_cast< int >( indices.size() ); ++i )
+							for ( int i = 0; i < indexSpan.Count; ++i )
 							{
-								( *outModelGeo ).indices.push_back( indices[i] + indexOffset );
+								( *outModelGeo ).indices.push_back( indexSpan.Data[i] + indexOffset );
 							}
 						}
 
@@ -365,7 +381,7 @@ bool LoadModelFile_OvrScene_Json( ModelFile & modelFile,
 						// Setup geometry, textures and render programs now that the vertex attributes are known.
 						//
 
-						modelSurface.surfaceDef.geo.Create( attribs, indices );
+						modelSurface.surfaceDef.geo.Create( spans, indexSpan );
 
 						const char * materialTypeString = "opaque";
 						OVR_UNUSED( materialTypeString );	// we'll get warnings if the LOGV's compile out
@@ -397,8 +413,8 @@ bool LoadModelFile_OvrScene_Json( ModelFile & modelFile,
 							materialTypeString = "additive";
 						}
 
-						const bool skinned = ( attribs.jointIndices.size() == attribs.position.size() &&
-							attribs.jointWeights.size() == attribs.position.size() );
+						const bool skinned = ( spans.jointIndices.Count == spans.position.Count &&
+							spans.jointWeights.Count == spans.position.Count );
 
 						if ( diffuseTextureIndex >= 0 && diffuseTextureIndex < static_cast< int >( glTextures.size() ) )
 						{
@@ -482,7 +498,7 @@ bool LoadModelFile_OvrScene_Json( ModelFile & modelFile,
 								}
 							}
 						}
-						else if ( attribs.color.size() > 0 )
+						else if ( spans.color.Count > 0 )
 						{
 							// vertex color material
 							if ( skinned )
@@ -221,8 +221,8 @@ bool LoadModelFile_glTF_Json( ModelFile & modelFile, const char * modelsJson,
 	bool loaded = true;
 
 	const char * error = nullptr;
-	auto json = OVR::JSON::Parse( modelsJson, &error );
-	if ( json == nullptr )
+	OVR::JsonDocument json;
+	if ( !json.Parse( modelsJson, &error ) )
 	{
 		ALOGW( "LoadModelFile_glTF_Json: Error loading %s : %s", modelFile.FileName.c_str(), error );
 		loaded = false;
@@ -1687,8 +1687,8 @@ bool LoadModelFile_glTF_OvrScene( ModelFile * modelFilePtr, unzFile zfp, const c
 	bool loaded = true;
 
 	const char * error = nullptr;
-	auto json = OVR::JSON::Parse( gltfJson, &error );
-	if ( json == nullptr )
+	OVR::JsonDocument json;
+	if ( !json.Parse( gltfJson, gltfJsonLength, &error ) )
 	{
 		ALOGW( "LoadModelFile_glTF_OvrScene: Error loading %s : %s", modelFilePtr->FileName.c_str(), error );
 		loaded = false;
@@ -1947,17 +1947,17 @@ ModelFile * LoadModelFile_glB( const char * fileName,
 			loaded = false;
 		}
 
-		std::shared_ptr<OVR::JSON> json = nullptr;
+		OVR::JsonDocument json;
 		const char * gltfJson = nullptr;
 		if ( loaded )
 		{
 			const char * error = nullptr;
 			gltfJson = &fileData[fileDataIndex];
-			json = OVR::JSON::Parse( gltfJson, &error );
+			const bool parsed = chunkLength <= fileDataRemainingLength && json.Parse( gltfJson, chunkLength, &error );
 			fileDataIndex += chunkLength;
 			fileDataRemainingLength -= chunkLength;
 
-			if ( json == nullptr )
+			if ( !parsed )
 			{
 				ALOGW( "LoadModelFile_glB: Error Parsing JSON %s : %s", modelFilePtr->FileName.c_str(), error );
 				loaded = false;
@@ -0,0 +1,137 @@
+/************************************************************************************
+
+Filename    :   OVR_AsyncFileReader.cpp
+Content     :   Reads whole files on a small pool of I/O threads.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include "OVR_AsyncFileReader.h"
+
+#include "Misc/Log.h"
+
+namespace OVRFW {
+
+//==============================
+// ovrAsyncFileReader::ovrAsyncFileReader
+ovrAsyncFileReader::ovrAsyncFileReader( ovrFileSys & fileSys, int const numThreads )
+	: FileSys( fileSys )
+	, NumThreads( numThreads > 0 ? numThreads : 1 )
+	, ShuttingDown( false )
+{
+}
+
+//==============================
+// ovrAsyncFileReader::~ovrAsyncFileReader
+ovrAsyncFileReader::~ovrAsyncFileReader()
+{
+	Shutdown();
+}
+
+//==============================
+// ovrAsyncFileReader::ReadFile
+void ovrAsyncFileReader::ReadFile( char const * uri, ovrJobPriority const priority, ovrFileSys::ovrReadFileCallback callback )
+{
+	{
+		std::lock_guard< std::mutex > lock( Mutex );
+		if ( !ShuttingDown )
+		{
+			if ( Jobs == nullptr )
+			{
+				Jobs.reset( new ovrJobSystem( NumThreads ) );
+			}
+
+			auto it = Reads.find( uri );
+			if ( it != Reads.end() )
+			{
+				std::shared_ptr< ovrRead > const & read = it->second;
+				read->Callbacks.push_back( std::move( callback ) );
+				if ( priority < read->Priority && !read->Started.load() )
+				{
+					SubmitRead( read, priority );
+				}
+				return;
+			}
+
+			std::shared_ptr< ovrRead > read = std::make_shared< ovrRead >( uri, priority );
+			read->Callbacks.push_back( std::move( callback ) );
+			Reads[read->Uri] = read;
+			SubmitRead( read, priority );
+			return;
+		}
+	}
+
+	ALOG( "ovrAsyncFileReader::ReadFile: '%s' requested after shutdown", uri );
+	std::vector< uint8_t > empty;
+	callback( uri, false, empty );
+}
+
+//==============================
+// ovrAsyncFileReader::SubmitRead
+void ovrAsyncFileReader::SubmitRead( std::shared_ptr< ovrRead > const & read, ovrJobPriority const priority )
+{
+	read->Priority = priority;
+	read->Jobs.push_back( Jobs->Submit( priority, [this, read]() { ReadJob( read ); } ) );
+}
+
+//==============================
+// ovrAsyncFileReader::ReadJob
+void ovrAsyncFileReader::ReadJob( std::shared_ptr< ovrRead > const & read )
+{
+	if ( read->Started.exchange( true ) )
+	{
+		return;	// already done by a job submitted at another priority
+	}
+
+	std::vector< uint8_t > buffer;
+	bool const success = FileSys.ReadFile( read->Uri.c_str(), buffer );
+
+	// requests that arrive from here on start a new read
+	std::vector< ovrFileSys::ovrReadFileCallback > callbacks;
+	{
+		std::lock_guard< std::mutex > lock( Mutex );
+		callbacks.swap( read->Callbacks );
+		Reads.erase( read->Uri );
+	}
+
+	// each callback gets a buffer of its own, the last one gets the original
+	for ( size_t i = 0; i + 1 < callbacks.size(); ++i )
+	{
+		std::vector< uint8_t > copy( buffer );
+		callbacks[i]( read->Uri.c_str(), success, copy );
+	}
+	if ( !callbacks.empty() )
+	{
+		callbacks.back()( read->Uri.c_str(), success, buffer );
+	}
+}
+
+//==============================
+// ovrAsyncFileReader::Shutdown
+void ovrAsyncFileReader::Shutdown()
+{
+	std::vector< ovrJobHandle > pending;
+	{
+		std::lock_guard< std::mutex > lock( Mutex );
+		if ( ShuttingDown )
+		{
+			return;
+		}
+		ShuttingDown = true;
+		for ( auto const & it : Reads )
+		{
+			pending.insert( pending.end(), it.second->Jobs.begin(), it.second->Jobs.end() );
+		}
+	}
+
+	// no new reads are queued from here on, and no one else touches Jobs
+	if ( Jobs != nullptr )
+	{
+		Jobs->Wait( pending.data(), static_cast< int >( pending.size() ) );
+		Jobs.reset();
+	}
+}
+
+}	// namespace OVRFW
@@ -0,0 +1,82 @@
+/************************************************************************************
+
+Filename    :   OVR_AsyncFileReader.h
+Content     :   Reads whole files on a small pool of I/O threads.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "OVR_FileSys.h"
+#include "JobSystem.h"
+
+namespace OVRFW {
+
+//==============================================================
+// ovrAsyncFileReader
+//
+// Runs ovrFileSys::ReadFile on a job system of its own with a few workers, so
+// blocking reads neither stall the caller nor tie up the workers of the shared
+// job system that decode what was read, and the number of reads in flight is
+// bounded. Since reads go through ReadFile, every scheme the file system knows
+// is covered, though reads from an apk are serialized by the package code.
+//
+// A read of a uri that is already queued or being read is not issued again; its
+// callback is added to the pending read. If the new request has a higher priority
+// than a read that has not started, the read is queued again at that priority and
+// whichever job runs first does it.
+//==============================================================
+class ovrAsyncFileReader
+{
+public:
+	// numThreads is the most reads that can be in flight at once.
+							ovrAsyncFileReader( ovrFileSys & fileSys, int const numThreads );
+	// Calls Shutdown if it wasn't called.
+							~ovrAsyncFileReader();
+
+	// Thread safe, and callable from a read callback. After Shutdown the callback is called
+	// right away, on the calling thread, with success = false.
+	void					ReadFile( char const * uri, ovrJobPriority const priority, ovrFileSys::ovrReadFileCallback callback );
+
+	// Finishes all reads that were requested, including running their callbacks, and stops the threads.
+	// Must not be called from a read callback.
+	void					Shutdown();
+
+private:
+	struct ovrRead
+	{
+		ovrRead( char const * uri, ovrJobPriority const priority ) : Uri( uri ), Priority( priority ), Started( false ) {}
+
+		std::string				Uri;
+		ovrJobPriority			Priority;	// highest priority a job for this read was submitted at
+		std::atomic< bool >		Started;	// set by the first job to run, later jobs do nothing
+		std::vector< ovrFileSys::ovrReadFileCallback >	Callbacks;
+		std::vector< ovrJobHandle >	Jobs;
+	};
+
+	ovrFileSys &			FileSys;
+	int const				NumThreads;
+
+	std::mutex				Mutex;		// guards everything below
+	std::unique_ptr< ovrJobSystem >	Jobs;	// created on the first read
+	std::unordered_map< std::string, std::shared_ptr< ovrRead > >	Reads;	// queued or being read, by uri
+	bool					ShuttingDown;
+
+	// not copyable
+							ovrAsyncFileReader( ovrAsyncFileReader const & ) = delete;
+	ovrAsyncFileReader &	operator=( ovrAsyncFileReader const & ) = delete;
+
+	void					SubmitRead( std::shared_ptr< ovrRead > const & read, ovrJobPriority const priority );
+	void					ReadJob( std::shared_ptr< ovrRead > const & read );
+};
+
+}	// namespace OVRFW
@@ -18,62 +18,49 @@ namespace OVRFW
 
 BinaryReader::~BinaryReader()
 {
-	if ( Allocated && nullptr != Data )
-	{
-		delete [] Data;
-	}
+	View.Close();
+	File.Close();
 }
 
 BinaryReader::BinaryReader( const char * path, const char ** perror ) :
 	Data( NULL ),
 	Size( 0 ),
-	Offset( 0 ),
-	Allocated( true )
+	Offset( 0 )
 {
-	std::ifstream is;
-	is.open( path, std::ios::binary | std::ios::in );
-	if ( !is.is_open() )
+	if ( !File.OpenRead( path, true ) )
 	{
 		if ( perror != NULL )
 		{
 			*perror = "Failed to open file.";
 		}
+		File.Close();
 		return;
 	}
 
-	// get size
-    is.seekg( 0, is.end );
-    Size = static_cast< int >( is.tellg() );
-    is.seekg( 0, is.beg );	
-
-    // allocate buffer
-	Data = (uint8_t*) new uint8_t[ ( Size + 1 ) ];
-	if ( nullptr != Data )
+	if ( File.GetLength() > 0x7FFFFFFF )
 	{
-		static_assert( 
-			sizeof(char) == sizeof(uint8_t), 
-			"allocation size of char and uint8_t mismatch - BinaryReader will fail" );
-
-		// read all file
-		is.read( (char *)Data, Size );
-		if ( !is )
+		if ( perror != NULL )
 		{
-			if ( perror != NULL )
-			{
-				*perror = "Failed to read file.";
-			}
+			*perror = "File is too large.";
 		}
+		File.Close();
+		return;
 	}
-	else
+
+	// map the whole file so the view starts at the first byte
+	if ( !View.Open( &File ) || View.MapView() == NULL )
 	{
 		if ( perror != NULL )
 		{
-			*perror = "Failed to allocate backing buffer.";
+			*perror = "Failed to map file.";
 		}
+		View.Close();
+		File.Close();
+		return;
 	}
 
-	// close
-	is.close();
+	Data = View.GetFront();
+	Size = static_cast< int32_t >( File.GetLength() );
 }
 
 std::vector<uint8_t> MemBufferFile( const char * fileName )
@@ -12,10 +12,15 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #pragma once
 
 #include "OVR_Types.h"
+#include "OVR_MappedFile.h"
 #include <vector>
 
 /*
 	This is a simple helper class to read binary data next to a JSON file.
+
+	A reader opened on a path maps the file instead of reading it, and ReadSpan
+	returns arrays in place, so they are paged in from the page cache as they
+	are used instead of being copied to the heap.
 */
 
 namespace OVRFW
@@ -27,10 +32,10 @@ public:
 	BinaryReader( const uint8_t * binData, const int binSize ) :
 		Data( binData ),
 		Size( binSize ),
-		Offset( 0 ),
-		Allocated( false ) {}
+		Offset( 0 ) {}
 	~BinaryReader();
 
+	// Maps the file read-only. The reader is empty if the file can't be mapped.
 	BinaryReader( const char * path, const char ** perror );
 
 	uint32_t ReadUInt32() const
@@ -59,6 +64,24 @@ public:
 		return true;
 	}
 
+	// Points out at the next numElements in place. The data stays valid as long as the memory
+	// the reader was created on, or the reader itself when it mapped a file. Returns false
+	// without consuming anything if there is not enough data or it is not aligned for the type,
+	// in which case ReadArray can still copy it out.
+	template< typename _type_ >
+	bool ReadSpan( const _type_ * & out, const int numElements ) const
+	{
+		const int bytes = numElements * sizeof( _type_ );
+		if ( Data == NULL || bytes > Size - Offset ||
+			( reinterpret_cast< uintptr_t >( Data + Offset ) % alignof( _type_ ) ) != 0 )
+		{
+			return false;
+		}
+		out = reinterpret_cast< const _type_ * >( Data + Offset );
+		Offset += bytes;
+		return true;
+	}
+
 	bool IsAtEnd() const
 	{
 		return ( Offset == Size );
@@ -68,7 +91,12 @@ private:
 	const uint8_t *	Data;
 	int32_t			Size;
 	mutable int32_t	Offset;
-	bool			Allocated;
+	MappedFile		File;	// only used when created on a path
+	MappedView		View;
+
+	// not copyable
+	BinaryReader( const BinaryReader & ) = delete;
+	BinaryReader & operator=( const BinaryReader & ) = delete;
 };
 
 std::vector<uint8_t> MemBufferFile( const char * fileName );
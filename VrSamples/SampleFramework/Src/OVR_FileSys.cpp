@@ -12,11 +12,16 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #include "OVR_FileSys.h"
 
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <cctype>	// for isdigit, isalpha
 
 #include "Misc/Log.h"
+#include "Misc/Hash.h"
 
 #include "OVR_Stream_Impl.h"
+#include "OVR_AsyncFileReader.h"
 #include "OVR_UTF8Util.h"
 #include "OVR_Uri.h"
 
@@ -146,27 +151,51 @@ public:
 	virtual ovrStream *		OpenStream( char const * uri, ovrStreamMode const mode );
 	virtual void			CloseStream( ovrStream * & stream );
 	virtual bool			ReadFile( char const * uri, std::vector< uint8_t > & outBuffer );
+	virtual void			ReadFileAsync( char const * uri, ovrJobPriority const priority, ovrReadFileCallback callback );
 	virtual bool			FileExists( char const * uri );
 	virtual bool			GetLocalPathForURI( char const * uri, std::string &outputPath );
 
 	virtual void			Shutdown();
 
 private:
+	struct ovrCachedUri
+	{
+		std::string			Uri;
+		ovrParsedUri		Parsed;
+	};
+
 	std::vector< ovrUriScheme* >	Schemes;
+	std::unordered_map< std::string, int >	SchemeIndices;	// by folded scheme name
 	JavaVM *				Jvm{ nullptr };
 	jobject					ActivityObject{ 0 };
+	ovrAsyncFileReader		AsyncReader;
+
+	std::mutex				ApkHostMutex;	// so two threads don't both add a host for the same package
+	mutable std::mutex		UriCacheMutex;
+	mutable std::unordered_map< uint64_t, std::shared_ptr< ovrCachedUri const > >	UriCache;	// by hash of the uri
 
 private:
+	void					AddScheme( ovrUriScheme * scheme );
 	int						FindSchemeIndexForName( char const * schemeName ) const;
 	ovrUriScheme *			FindSchemeForName( char const * name ) const;
+	// Returns the parse of uri, parsing it only the first time it is seen.
+	std::shared_ptr< ovrCachedUri const >	ParseUri( char const * uri ) const;
 };
 
 
 #define PUI_PACKAGE_NAME "com.oculus.systemactivities"
 
+// Flash storage keeps several requests in flight, but more threads than this only add contention.
+static const int MAX_ASYNC_READS = 4;
+
+// Scenes open a few thousand distinct uris at most, so past this the cache is just emptied.
+static const size_t MAX_CACHED_URIS = 8192;
+
 //==============================
 // ovrFileSysLocal::ovrFileSysLocal
-ovrFileSysLocal::ovrFileSysLocal( ovrJava const & javaContext ) : Jvm( javaContext.Vm )
+ovrFileSysLocal::ovrFileSysLocal( ovrJava const & javaContext )
+	: Jvm( javaContext.Vm )
+	, AsyncReader( *this, MAX_ASYNC_READS )
 {
 	// always do unit tests on startup to assure nothing has been broken
 	ovrUri::DoUnitTest();
@@ -245,7 +274,7 @@ ovrFileSysLocal::ovrFileSysLocal( ovrJava const & javaContext ) : Jvm( javaConte
 	}
 
 	ALOG( "ovrFileSysLocal - apk scheme OpenHost done uri '%s'", curPackageUri );
-	Schemes.push_back( scheme );
+	AddScheme( scheme );
 
 	ovrUriScheme_File * file_scheme = new ovrUriScheme_File( "file" );
 	if ( !file_scheme->OpenHost( "localhost", "" ) )
@@ -254,7 +283,7 @@ ovrFileSysLocal::ovrFileSysLocal( ovrJava const & javaContext ) : Jvm( javaConte
 		assert( false );
 	}
 	ALOG( "ovrFileSysLocal - file scheme OpenHost done uri '%s'", "" );
-	Schemes.push_back( file_scheme );
+	AddScheme( file_scheme );
 
 	ALOG( "ovrFileSysLocal - done " );
 }
@@ -274,12 +303,10 @@ ovrFileSysLocal::~ovrFileSysLocal()
 ovrStream *	ovrFileSysLocal::OpenStream( char const * uri, ovrStreamMode const mode )
 {
 	// parse the Uri to find the scheme
-	char scheme[OVR_MAX_SCHEME_LEN];
-	char host[OVR_MAX_HOST_NAME_LEN];
-	char path[OVR_MAX_PATH_LEN];
-	int port = 0;
-	ovrUri::ParseUri( uri, scheme, sizeof( scheme ), nullptr, 0, nullptr, 0, host, sizeof( host ), 
-			port, path, sizeof( path ), nullptr, 0, nullptr, 0 );
+	std::shared_ptr< ovrCachedUri const > cached = ParseUri( uri );
+	ovrParsedUri const & parsedUri = cached->Parsed;
+	char const * scheme = parsedUri.Scheme.c_str();
+	char const * host = parsedUri.Host.c_str();
 
 	// ALOG( "Uri='%s' scheme='%s' host='%s'", uri, scheme, host );
 
@@ -298,6 +325,7 @@ ovrStream *	ovrFileSysLocal::OpenStream( char const * uri, ovrStreamMode const m
 	// If apk scheme, need to check if this is a package we haven't seen before, and add a host if so.
 	if ( OVR::OVR_stricmp( scheme, "apk" ) == 0 )
 	{
+		std::lock_guard< std::mutex > lock( ApkHostMutex );
 		if ( !uriScheme->HostExists( host ) )
 		{
 			TempJniEnv env{ Jvm };
@@ -320,7 +348,7 @@ ovrStream *	ovrFileSysLocal::OpenStream( char const * uri, ovrStreamMode const m
 		assert( stream != nullptr );
 		return nullptr;
 	}
-	if ( !stream->Open( uri, mode ) )
+	if ( !stream->Open( uri, parsedUri, mode ) )
 	{
 		// ALOG( "Uri='%s' stream->Open failed!", uri );
 		delete stream;
@@ -355,6 +383,13 @@ bool ovrFileSysLocal::ReadFile( char const * uri, std::vector< uint8_t > & outBu
 	return success;
 }
 
+//==============================
+// ovrFileSysLocal::ReadFileAsync
+void ovrFileSysLocal::ReadFileAsync( char const * uri, ovrJobPriority const priority, ovrReadFileCallback callback )
+{
+	AsyncReader.ReadFile( uri, priority, std::move( callback ) );
+}
+
 //==============================
 // ovrFileSysLocal::FileExists
 bool ovrFileSysLocal::FileExists( char const * uri )
@@ -373,14 +408,9 @@ bool ovrFileSysLocal::FileExists( char const * uri )
 bool ovrFileSysLocal::GetLocalPathForURI( char const * uri, std::string &outputPath )
 {
 	// parse the Uri to find the scheme
-	char scheme[OVR_MAX_SCHEME_LEN];
-	char host[OVR_MAX_HOST_NAME_LEN];
-	char path[OVR_MAX_PATH_LEN];
-	int port = 0;
-	ovrUri::ParseUri( uri, scheme, sizeof( scheme ), nullptr, 0, nullptr, 0, host, sizeof( host ), 
-			port, path, sizeof( path ), nullptr, 0, nullptr, 0 );
+	std::shared_ptr< ovrCachedUri const > cached = ParseUri( uri );
 
-	ovrUriScheme * uriScheme = FindSchemeForName( scheme );
+	ovrUriScheme * uriScheme = FindSchemeForName( cached->Parsed.Scheme.c_str() );
 	if ( uriScheme == nullptr )
 	{
 		ALOG( "GetLocalPathForURI: Uri '%s' missing scheme!", uri );
@@ -401,18 +431,20 @@ bool ovrFileSysLocal::GetLocalPathForURI( char const * uri, std::string &outputP
 	return result;	
 }
 
+//==============================
+// ovrFileSysLocal::AddScheme
+void ovrFileSysLocal::AddScheme( ovrUriScheme * scheme )
+{
+	SchemeIndices[FoldUriName( scheme->GetSchemeName() )] = static_cast< int >( Schemes.size() );
+	Schemes.push_back( scheme );
+}
+
 //==============================
 // ovrFileSysLocal::FindSchemeIndexForName
 int ovrFileSysLocal::FindSchemeIndexForName( char const * schemeName ) const
 {
-	for ( int i = 0; i < static_cast< const int >( Schemes.size() ); ++i )
-	{
-		if ( OVR::OVR_stricmp( Schemes[i]->GetSchemeName(), schemeName ) == 0 )
-		{
-			return i;
-		}
-	}
-	return -1;
+	auto it = SchemeIndices.find( FoldUriName( schemeName ) );
+	return it != SchemeIndices.end() ? it->second : -1;
 }
 
 //==============================
@@ -423,10 +455,43 @@ ovrUriScheme * ovrFileSysLocal::FindSchemeForName( char const * name ) const
 	return index < 0 ? nullptr : Schemes[index];
 }
 
+//==============================
+// ovrFileSysLocal::ParseUri
+std::shared_ptr< ovrFileSysLocal::ovrCachedUri const > ovrFileSysLocal::ParseUri( char const * uri ) const
+{
+	// hashed in place, so a lookup doesn't have to copy the uri into a key
+	uint64_t const hash = FNV1a64( uri, strlen( uri ) );
+
+	{
+		std::lock_guard< std::mutex > lock( UriCacheMutex );
+		auto it = UriCache.find( hash );
+		if ( it != UriCache.end() && OVR::OVR_strcmp( it->second->Uri.c_str(), uri ) == 0 )
+		{
+			return it->second;
+		}
+	}
+
+	std::shared_ptr< ovrCachedUri > cached = std::make_shared< ovrCachedUri >();
+	cached->Uri = uri;
+	ovrUri::ParseUri( uri, cached->Parsed );
+
+	std::lock_guard< std::mutex > lock( UriCacheMutex );
+	if ( UriCache.size() >= MAX_CACHED_URIS )
+	{
+		UriCache.clear();
+	}
+	// on a hash collision the newer uri replaces the older one
+	UriCache[hash] = cached;
+	return cached;
+}
+
 //==============================
 // ovrFileSysLocal::Shutdown
 void ovrFileSysLocal::Shutdown()
 {
+	// reads in flight still need the schemes
+	AsyncReader.Shutdown();
+
 	for ( int i = 0; i < static_cast< const int >( Schemes.size() ); ++i )
 	{
 		Schemes[i]->Shutdown();
@@ -434,6 +499,10 @@ void ovrFileSysLocal::Shutdown()
 		Schemes[i] = nullptr;
 	}
 	Schemes.clear();
+	SchemeIndices.clear();
+
+	std::lock_guard< std::mutex > lock( UriCacheMutex );
+	UriCache.clear();
 }
 
 //==============================================================================================
@@ -14,7 +14,9 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #include "OVR_Stream.h"
 #include "OVR_BitFlags.h"
 #include "OVR_Std.h"
+#include "JobSystem.h"	// ovrJobPriority
 
+#include <functional>
 #include <vector>
 #include <sys/stat.h>
 
@@ -86,6 +88,14 @@ public:
 
 	virtual bool			ReadFile( char const * uri, std::vector< uint8_t > & outBuffer ) = 0;
 
+	// Called on an I/O thread when an asynchronous read finishes. The buffer holds the whole
+	// file and belongs to the callback, which may swap it out.
+	typedef std::function< void( char const * uri, bool const success, std::vector< uint8_t > & buffer ) > ovrReadFileCallback;
+
+	// Queues a read of the whole file and returns right away. Frame priority reads are done
+	// before background ones. Requests for a uri that is already being read share that read.
+	virtual void			ReadFileAsync( char const * uri, ovrJobPriority const priority, ovrReadFileCallback callback ) = 0;
+
 	virtual bool			FileExists( char const * uri ) = 0;
 	// Gets the local path for the specified URI. File must exist. Returns false if path is not accessible directly by the file system.
 	virtual bool			GetLocalPathForURI( char const * uri, std::string &outputPath ) = 0;
@@ -18,11 +18,59 @@ of patent rights can be found in the PATENTS file in the same directory.
 #include "OVR_Std.h"
 #include "OVR_UTF8Util.h"
 #include <cstdlib> // for strto* functions
+#include <climits>
 #include <errno.h>
+#include <limits>
 #include <utility>
 
 namespace OVRFW {
 
+//==============================
+// ovrLexerToken::ovrLexerToken
+ovrLexerToken::ovrLexerToken( char const * text )
+	: Text( text != nullptr ? text : "" )
+	, Length( text != nullptr ? OVR::OVR_strlen( text ) : 0 )
+{
+}
+
+//==============================
+// ovrLexerToken::Equals
+bool ovrLexerToken::Equals( char const * str ) const
+{
+	// strncmp stops at a null byte in str, so str[Length] is only read if str is at least Length long
+	return OVR::OVR_strncmp( Text, str, Length ) == 0 && str[Length] == '\0';
+}
+
+//==============================
+// ovrLexerToken::Find
+ptrdiff_t ovrLexerToken::Find( char const * str ) const
+{
+	size_t const len = OVR::OVR_strlen( str );
+	for ( size_t i = 0; i + len <= Length; ++i )
+	{
+		if ( memcmp( Text + i, str, len ) == 0 )
+		{
+			return static_cast< ptrdiff_t >( i );
+		}
+	}
+	return -1;
+}
+
+//==============================
+// ovrLexerToken::CopyTo
+bool ovrLexerToken::CopyTo( char * buffer, size_t const bufferSize ) const
+{
+	if ( buffer == nullptr || bufferSize == 0 )
+	{
+		assert( buffer != nullptr && bufferSize > 0 );
+		return false;
+	}
+	size_t const len = Length < bufferSize - 1 ? Length : bufferSize - 1;
+	memcpy( buffer, Text, len );
+	buffer[len] = '\0';
+	return len == Length;
+}
+
 //==============================
 // ovrLexer::ovrLexer
 ovrLexer::ovrLexer( const char * source, const size_t sourceLength, char const * punctuation )
@@ -31,18 +79,9 @@ ovrLexer::ovrLexer( const char * source, const size_t sourceLength, char const *
 	, p( Source )
 	, Error( LEX_RESULT_OK )
 	, Punctuation( NULL )
+	, HasMultiBytePunctuation( false )
 {
-	size_t len = punctuation == NULL ? 0 :OVR::OVR_strlen( punctuation );
-	if ( len == 0 )
-	{
-		Punctuation = new char[16];
-		Punctuation[0] = '\0';
-	}
-	else
-	{
-		Punctuation = new char[len + 1];
-		OVR::OVR_strcpy( Punctuation, len + 1, punctuation );
-	}
+	InitPunctuation( punctuation );
 }
 
 //==============================
@@ -69,6 +108,7 @@ ovrLexer::ovrLexer( std::vector< uint8_t > const & source, char const * punctuat
 //==============================
 // ovrLexer::ovrLexer
 ovrLexer::ovrLexer( const ovrLexer & other )
+	: Punctuation( NULL )
 {
 	operator=( other );
 }
@@ -76,6 +116,7 @@ ovrLexer::ovrLexer( const ovrLexer & other )
 //==============================
 // ovrLexer::ovrLexer
 ovrLexer::ovrLexer( ovrLexer && other )
+	: Punctuation( NULL )
 {
 	operator=( std::move(other) );
 }
@@ -85,7 +126,7 @@ ovrLexer::ovrLexer( ovrLexer && other )
 ovrLexer::~ovrLexer()
 {
 	assert( Error == LEX_RESULT_OK || Error == LEX_RESULT_EOF );
-	delete Punctuation;
+	delete [] Punctuation;
 	Punctuation = NULL;
 }
 
@@ -104,17 +145,8 @@ ovrLexer & ovrLexer::operator=( const ovrLexer & other )
 	p = other.p;
 	Error = other.Error;
 	
-	size_t len = other.Punctuation == NULL ? 0 : OVR::OVR_strlen( other.Punctuation );
-	if ( len == 0 )
-	{
-		Punctuation = new char[16];
-		Punctuation[0] = '\0';
-	}
-	else
-	{
-		Punctuation = new char[len + 1];
-		OVR::OVR_strcpy( Punctuation, len + 1, other.Punctuation );
-	}
+	delete [] Punctuation;
+	InitPunctuation( other.Punctuation );
 
 	return *this;
 }
@@ -133,7 +165,11 @@ ovrLexer & ovrLexer::operator=( ovrLexer && other )
 	SourceLength = other.SourceLength;
 	p = other.p;
 	Error = other.Error;
+	delete [] Punctuation;
 	Punctuation = other.Punctuation;
+	HasMultiBytePunctuation = other.HasMultiBytePunctuation;
+	memcpy( CharClasses, other.CharClasses, sizeof( CharClasses ) );
+	Scratch = std::move( other.Scratch );
 
 	other.Source = nullptr;
 	other.SourceLength = 0;
@@ -143,6 +179,52 @@ ovrLexer & ovrLexer::operator=( ovrLexer && other )
 	return *this;
 }
 
+//==============================
+// ovrLexer::InitPunctuation
+// Copies the punctuation string and builds the table of character classes, so that
+// single-byte punctuation is a table lookup instead of a scan of the punctuation string.
+void ovrLexer::InitPunctuation( char const * punctuation )
+{
+	size_t len = punctuation == NULL ? 0 : OVR::OVR_strlen( punctuation );
+	if ( len == 0 )
+	{
+		Punctuation = new char[16];
+		Punctuation[0] = '\0';
+	}
+	else
+	{
+		Punctuation = new char[len + 1];
+		OVR::OVR_strcpy( Punctuation, len + 1, punctuation );
+	}
+
+	memset( CharClasses, 0, sizeof( CharClasses ) );
+	CharClasses[static_cast< uint8_t >( ' ' )] = CHAR_WHITESPACE;
+	CharClasses[static_cast< uint8_t >( '\t' )] = CHAR_WHITESPACE;
+	CharClasses[static_cast< uint8_t >( '\r' )] = CHAR_WHITESPACE;
+	CharClasses[static_cast< uint8_t >( '\n' )] = CHAR_WHITESPACE;
+	CharClasses[static_cast< uint8_t >( '\"' )] = CHAR_QUOTE;
+	CharClasses[static_cast< uint8_t >( '\\' )] = CHAR_BACKSLASH;
+	CharClasses[0] = CHAR_END;
+	for ( int i = 0x80; i < 256; ++i )
+	{
+		CharClasses[i] = CHAR_MULTIBYTE;
+	}
+
+	HasMultiBytePunctuation = false;
+	const char * cur = Punctuation;
+	for ( uint32_t ch = UTF8Util::DecodeNextChar( &cur ); ch != '\0'; ch = UTF8Util::DecodeNextChar( &cur ) )
+	{
+		if ( ch < 0x80 )
+		{
+			CharClasses[ch] |= CHAR_PUNCTUATION;
+		}
+		else
+		{
+			HasMultiBytePunctuation = true;
+		}
+	}
+}
+
 //==============================
 // ovrLexer::FindChar
 bool ovrLexer::FindChar( char const * buffer, uint32_t const ch )
@@ -182,22 +264,18 @@ bool ovrLexer::IsQuote( uint32_t const ch )
 // ovrLexer::SkipWhitespace
 ovrLexer::ovrResult ovrLexer::SkipWhitespace( char const * & p, char const * source, size_t const sourceLength )
 {
-	const char * cur = p; // copy p because we only want to advance if it is whitespace
-	uint32_t ch;
 	for ( ; ; )
 	{
 		if ( p >= source + sourceLength )
 		{
 			return LEX_RESULT_EOF;
 		}
-		
-		ch = UTF8Util::DecodeNextChar( &cur );
-		
-		if ( ch == '\0' || !IsWhitespace( ch ) )
+		// whitespace characters are all single-byte, so there's no need to decode
+		if ( !IsWhitespace( static_cast< uint8_t >( *p ) ) )
 		{
 			return LEX_RESULT_OK;
 		}
-		p = cur;
+		p++;
 	}
 }
 
@@ -219,25 +297,14 @@ bool ovrLexer::IsPunctuation( char const * punctuation, uint32_t const ch )
 }
 
 //==============================
-// ovrLexer::CopyResult
-void ovrLexer::CopyResult( char const * buffer, char * token, size_t const maxTokenSize )
+// ovrLexer::IsPunctuation
+bool ovrLexer::IsPunctuation( uint32_t const ch ) const
 {
-	// NOTE: if any multi-byte characters are ever treated as quotes, this code must change
-	if ( IsQuote( *buffer ) )
+	if ( ch < 0x80 )
 	{
-		size_t len = UTF8Util::GetLength( buffer );
-		const uint32_t lastChar = UTF8Util::GetCharAt( len - 1, buffer );
-		if ( IsQuote( lastChar ) )
-		{
-			// The first char and last char are single-byte quotes, we can now just step past the first and not copy the last. 
-			char const * start = buffer + 1;
-			len = OVR::OVR_strlen( start );	// We do not care about UTF length here since we know the quotes are a single bytes
-			OVR::OVR_strncpy( token, maxTokenSize, start, len - 1 );
-			return;
-		}
+		return ( CharClasses[ch] & CHAR_PUNCTUATION ) != 0;
 	}
-
-	OVR::OVR_strcpy( token, maxTokenSize, buffer );
+	return HasMultiBytePunctuation && IsPunctuation( Punctuation, ch );
 }
 
 //==============================
@@ -280,25 +347,6 @@ ovrLexer::ovrResult ovrLexer::SkipToEndOfLine()
 	return LEX_RESULT_OK;
 }
 
-//==============================
-// ovrLexer::EmitCodePoint
-// helper function to ensure we never emit a character beyond the end of the buffer and that if we
-// try to we always 0-terminate at the end of the buffer.
-void ovrLexer::EmitCodePoint( uint32_t const ch, char * buffer, ptrdiff_t & bufferOfs, size_t const bufferSize, 
-		char * token, size_t const maxTokenSize ) const
-{
-	if ( static_cast< size_t >( bufferOfs ) < bufferSize )
-	{
-		UTF8Util::EncodeChar( buffer, &bufferOfs, ch );
-	}
-	else
-	{
-		// not enough room to emit, so stuff a null character at the end
-		bufferOfs = bufferSize - 1;
-		UTF8Util::EncodeChar( buffer, &bufferOfs, '\0' );
-	}
-}
-
 //==============================
 // ovrLexer::TranslateEscapeCode
 uint32_t ovrLexer::TranslateEscapeCode( uint32_t const inCh ) 
@@ -315,39 +363,116 @@ uint32_t ovrLexer::TranslateEscapeCode( uint32_t const inCh )
 }
 
 //==============================
-// ovrLexer::NextToken
-ovrLexer::ovrResult ovrLexer::NextToken( char * token, size_t const maxTokenSize )
+// ovrLexer::ScanToken
+// Reads the next token as a view of the source buffer. The token is only copied into
+// Scratch once something inside it (an escape code, a quote or a comment) means its text
+// is no longer a contiguous run of the source. maxTokenSize limits the length of the token
+// the same way the size of a caller's buffer does, including room for a null terminator.
+ovrLexer::ovrResult ovrLexer::ScanToken( ovrLexerToken & token, size_t const maxTokenSize )
 {
-	if ( token == NULL || maxTokenSize <= 0 )
-	{
-		assert( token != NULL && maxTokenSize > 0 );
-		return LEX_RESULT_ERROR;
-	}
-
-	token[0] = '\0';
-
-	size_t const BUFF_SIZE = 8192;
-	char buffer[BUFF_SIZE];
+	token = ovrLexerToken();
 
 	SkipWhitespace( p, Source, SourceLength );
 
+	char const * const sourceEnd = Source + SourceLength;
 	bool inQuotes = false;
 	bool inComment = false;
-	bool isPunc = false;
-	
-	char const * lastp = p;
+	bool inScratch = false;
+	char const * tokenStart = nullptr;
+	size_t tokenLength = 0;
 
-	ptrdiff_t bufferOfs = 0;
+	auto moveToScratch = [&]()
+	{
+		Scratch.assign( tokenStart, tokenStart + tokenLength );
+		inScratch = true;
+	};
+
+	// emits source characters that are copied to the token unchanged
+	auto emitSource = [&]( char const * src, size_t const len )
+	{
+		if ( !inScratch )
+		{
+			if ( tokenLength == 0 )
+			{
+				tokenStart = src;
+				tokenLength = len;
+				return;
+			}
+			if ( tokenStart + tokenLength == src )
+			{
+				tokenLength += len;
+				return;
+			}
+			moveToScratch();
+		}
+		Scratch.insert( Scratch.end(), src, src + len );
+		tokenLength += len;
+	};
+
+	// emits the character read from [src, p)
+	auto emitChar = [&]( uint32_t const ch, char const * src )
+	{
+		// escape codes, and invalid or overlong UTF-8 which decodes to U+FFFD, don't encode
+		// back to the bytes they were read from
+		int const encodeSize = UTF8Util::GetEncodeCharSize( ch );
+		if ( p - src == encodeSize && ch != 0xFFFD )
+		{
+			emitSource( src, encodeSize );
+			return;
+		}
+		if ( !inScratch )
+		{
+			moveToScratch();
+		}
+		char encoded[8];
+		intptr_t encodedSize = 0;
+		UTF8Util::EncodeChar( encoded, &encodedSize, ch );
+		Scratch.insert( Scratch.end(), encoded, encoded + encodedSize );
+		tokenLength += encodedSize;
+	};
+
+	ovrResult result = LEX_RESULT_OK;
 	for ( ; ; )
 	{
-		if ( p > Source + SourceLength )
+		if ( p > sourceEnd )
 		{
-			EmitCodePoint( '\0', buffer, bufferOfs, BUFF_SIZE, token, maxTokenSize );
-			CopyResult( buffer, token, maxTokenSize );
-			return LEX_RESULT_EOF;
+			result = LEX_RESULT_EOF;
+			break;
 		}
 
-		lastp = p;
+		// runs of single-byte characters that need no special handling are consumed without decoding
+		if ( inComment )
+		{
+			while ( p <= sourceEnd && *p != '*' && ( CharClasses[static_cast< uint8_t >( *p )] & ( CHAR_END | CHAR_MULTIBYTE ) ) == 0 )
+			{
+				p++;
+			}
+			if ( p > sourceEnd )
+			{
+				continue;
+			}
+		}
+		else
+		{
+			uint8_t const stopClasses = inQuotes ? ( CHAR_QUOTE | CHAR_BACKSLASH | CHAR_END | CHAR_MULTIBYTE )
+					: ( CHAR_WHITESPACE | CHAR_PUNCTUATION | CHAR_QUOTE | CHAR_END | CHAR_MULTIBYTE );
+			// each character must leave room for itself and a null terminator
+			size_t const room = maxTokenSize > tokenLength + 2 ? maxTokenSize - tokenLength - 2 : 0;
+			char const * run = p;
+			while ( run <= sourceEnd && static_cast< size_t >( run - p ) < room 
+					&& ( CharClasses[static_cast< uint8_t >( *run )] & stopClasses ) == 0 )
+			{
+				run++;
+			}
+			if ( run > p )
+			{
+				emitSource( p, run - p );
+				p = run;
+				continue;
+			}
+		}
+
+		char const * lastp = p;
 		uint32_t ch = UTF8Util::DecodeNextChar( &p );
 
 		// exit if we just read whitespace or a null byte
@@ -356,7 +481,6 @@ ovrLexer::ovrResult ovrLexer::NextToken( char * token, size_t const maxTokenSize
 			break;
 		}
 
-		isPunc = IsPunctuation( Punctuation, ch );
 		if ( inComment )
 		{
 			if ( ch == '*' && PeekNextChar() == '/' )
@@ -379,7 +503,7 @@ ovrLexer::ovrResult ovrLexer::NextToken( char * token, size_t const maxTokenSize
 			}
 			UTF8Util::DecodeNextChar( &p );	// consume the escape code
 		}
-		else if ( !inQuotes && !inComment && isPunc )
+		else if ( !inQuotes && IsPunctuation( ch ) )
 		{
 			if ( ch == '/' && PeekNextChar() == '*' )
 			{
@@ -394,7 +518,7 @@ ovrLexer::ovrResult ovrLexer::NextToken( char * token, size_t const maxTokenSize
 				if ( res != LEX_RESULT_OK ) { return res; }
 				continue;
 			}
-			else if ( bufferOfs > 0 )
+			else if ( tokenLength > 0 )
 			{
 				// we're already in a token, undo the read of the punctuation and exit
 				p = lastp;
@@ -403,7 +527,7 @@ ovrLexer::ovrResult ovrLexer::NextToken( char * token, size_t const maxTokenSize
 			else
 			{
 				// if this is the first character of a token, just emit the punctuation
-				EmitCodePoint( ch, buffer, bufferOfs, BUFF_SIZE, token, maxTokenSize );
+				emitChar( ch, lastp );
 				break;
 			}
 		}
@@ -418,21 +542,68 @@ ovrLexer::ovrResult ovrLexer::NextToken( char * token, size_t const maxTokenSize
 			continue;
 		}
 
-		int encodeSize = UTF8Util::GetEncodeCharSize( ch );
-		if ( static_cast< size_t >( bufferOfs + encodeSize ) >= BUFF_SIZE - 1 || static_cast< size_t >( bufferOfs + encodeSize + 1 ) >= maxTokenSize )
+		size_t const encodeSize = UTF8Util::GetEncodeCharSize( ch );
+		if ( tokenLength + encodeSize + 1 >= maxTokenSize )
 		{
 			// truncation
-			UTF8Util::EncodeChar( buffer, &bufferOfs, '\0' );
-			CopyResult( buffer, token, maxTokenSize );
-			return LEX_RESULT_ERROR;
+			result = LEX_RESULT_ERROR;
+			break;
 		}
-		UTF8Util::EncodeChar( buffer, &bufferOfs, ch );
+		emitChar( ch, lastp );
 	}
 
-	// always emit a null byte
-	EmitCodePoint( '\0', buffer, bufferOfs, BUFF_SIZE, token, maxTokenSize );
-	CopyResult( buffer, token, maxTokenSize );
-	return LEX_RESULT_OK;
+	char const * text = inScratch ? Scratch.data() : tokenStart;
+	if ( tokenLength == 0 )
+	{
+		return result;
+	}
+
+	// NOTE: if any multi-byte characters are ever treated as quotes, this code must change
+	// A token can only still start with a quote here if it was escaped (or the quote is also
+	// punctuation). If it also ends with one, both are stripped.
+	if ( IsQuote( text[0] ) && IsQuote( text[tokenLength - 1] ) )
+	{
+		token = ovrLexerToken( text + 1, tokenLength >= 2 ? tokenLength - 2 : 0 );
+	}
+	else
+	{
+		token = ovrLexerToken( text, tokenLength );
+	}
+	return result;
+}
+
+//==============================
+// ovrLexer::NextToken
+ovrLexer::ovrResult ovrLexer::NextToken( char * token, size_t const maxTokenSize )
+{
+	if ( token == NULL || maxTokenSize <= 0 )
+	{
+		assert( token != NULL && maxTokenSize > 0 );
+		return LEX_RESULT_ERROR;
+	}
+
+	// this interface has always been limited by an 8KB buffer, in addition to the caller's buffer
+	size_t const BUFF_SIZE = 8192;
+
+	ovrLexerToken view;
+	ovrResult const res = ScanToken( view, maxTokenSize < BUFF_SIZE ? maxTokenSize : BUFF_SIZE );
+	view.CopyTo( token, maxTokenSize );
+	return res;
+}
+
+//==============================
+// ovrLexer::NextToken
+ovrLexer::ovrResult ovrLexer::NextToken( ovrLexerToken & token )
+{
+	return ScanToken( token, std::numeric_limits< size_t >::max() );
+}
+
+//==============================
+// ovrLexer::NextNumericToken
+ovrLexer::ovrResult ovrLexer::NextNumericToken( ovrLexerToken & token )
+{
+	// numbers have always been read into a 128 byte buffer, so keep failing the same way on longer tokens
+	return ScanToken( token, MAX_NUMERIC_TOKEN_SIZE );
 }
 
 //==============================
@@ -452,18 +623,157 @@ ovrLexer::ovrResult ovrLexer::PeekToken( char * token, size_t const maxTokenSize
 	return res;
 }
 
+//==============================
+// ovrLexer::PeekToken
+ovrLexer::ovrResult ovrLexer::PeekToken( ovrLexerToken & token )
+{
+	// save state
+	ovrResult error = Error;
+	const char * tp = p;
+	
+	ovrResult res = NextToken( token );
+	
+	// restore state
+	Error = error;
+	p = tp;
+
+	return res;
+}
+
+//==============================
+// IsDecimalDigit
+static inline bool IsDecimalDigit( char const c )
+{
+	return c >= '0' && c <= '9';
+}
+
+//==============================
+// ParseDecimalInteger
+// Parses a token that is only an optional sign followed by at most 19 decimal digits, which
+// always fits in 64 bits. Anything else returns false so that the caller can fall back to
+// the C library and keep its exact behavior for whitespace, trailing characters, etc.
+static bool ParseDecimalInteger( ovrLexerToken const & token, bool & negative, unsigned long long & magnitude )
+{
+	char const * cur = token.GetText();
+	char const * const end = cur + token.GetLength();
+
+	negative = false;
+	if ( cur < end && ( *cur == '-' || *cur == '+' ) )
+	{
+		negative = *cur == '-';
+		cur++;
+	}
+	if ( cur == end || end - cur > 19 )
+	{
+		return false;
+	}
+
+	magnitude = 0;
+	for ( ; cur < end; ++cur )
+	{
+		if ( !IsDecimalDigit( *cur ) )
+		{
+			return false;
+		}
+		magnitude = magnitude * 10 + static_cast< unsigned >( *cur - '0' );
+	}
+	return true;
+}
+
+//==============================
+// ParseDecimalFloat
+// Parses the longest prefix of the token of the form [+-]digits[.digits][(e|E)[+-]digits]
+// into a mantissa and a power of 10. Returns a pointer past the parsed characters, or
+// nullptr if the token doesn't start with a number or it has too many digits to be exact.
+static char const * ParseDecimalFloat( ovrLexerToken const & token, bool & negative, unsigned long long & mantissa, int & exponent )
+{
+	char const * cur = token.GetText();
+	char const * const end = cur + token.GetLength();
+
+	negative = false;
+	if ( cur < end && ( *cur == '-' || *cur == '+' ) )
+	{
+		negative = *cur == '-';
+		cur++;
+	}
+
+	mantissa = 0;
+	exponent = 0;
+	int numDigits = 0;
+	for ( ; cur < end && IsDecimalDigit( *cur ); ++cur, ++numDigits )
+	{
+		mantissa = mantissa * 10 + static_cast< unsigned >( *cur - '0' );
+	}
+	if ( cur < end && *cur == '.' )
+	{
+		for ( ++cur; cur < end && IsDecimalDigit( *cur ); ++cur, ++numDigits )
+		{
+			mantissa = mantissa * 10 + static_cast< unsigned >( *cur - '0' );
+			exponent--;
+		}
+	}
+	if ( numDigits == 0 || numDigits > 19 )
+	{
+		return nullptr;
+	}
+
+	if ( cur < end && ( *cur == 'e' || *cur == 'E' ) )
+	{
+		char const * e = cur + 1;
+		bool negativeExponent = false;
+		if ( e < end && ( *e == '-' || *e == '+' ) )
+		{
+			negativeExponent = *e == '-';
+			e++;
+		}
+		if ( e < end && IsDecimalDigit( *e ) )
+		{
+			int value = 0;
+			for ( ; e < end && IsDecimalDigit( *e ); ++e )
+			{
+				if ( value > 9999 )
+				{
+					return nullptr;
+				}
+				value = value * 10 + ( *e - '0' );
+			}
+			exponent += negativeExponent ? -value : value;
+			cur = e;
+		}
+	}
+	return cur;
+}
+
 //==============================
 // ovrLexer::ParseInt
 ovrLexer::ovrResult ovrLexer::ParseInt( int & value, int const defaultVal )
 {
-	char token[128];
-	ovrResult r = NextToken( token, sizeof( token ) );
+	ovrLexerToken view;
+	ovrResult r = NextNumericToken( view );
 	if ( r != LEX_RESULT_OK )
 	{
 		value = defaultVal;
 		return r;
 	}
 
+	// the value was always parsed as a long before, so range check against a long
+	bool negative;
+	unsigned long long magnitude;
+	if ( ParseDecimalInteger( view, negative, magnitude ) )
+	{
+		if ( magnitude > ( negative ? static_cast< unsigned long long >( LONG_MAX ) + 1 : LONG_MAX ) )
+		{
+			value = defaultVal;
+			return LEX_RESULT_VALUE_OUT_OF_RANGE;
+		}
+		long const l = negative ? -static_cast< long >( magnitude - 1 ) - 1 : static_cast< long >( magnitude );
+		value = static_cast< int >( l );
+		return LEX_RESULT_OK;
+	}
+
+	char token[MAX_NUMERIC_TOKEN_SIZE];
+	view.CopyTo( token, sizeof( token ) );
+
 	errno = 0;
 	char * endptr = nullptr;
 	value = strtol( token, &endptr, 10 );
@@ -503,14 +813,30 @@ ovrLexer::ovrResult ovrLexer::ParseInt( int & value, int const defaultVal )
 // ovrLexer::ParseUnsignedInt
 ovrLexer::ovrResult ovrLexer::ParseUnsignedInt( unsigned int & value, unsigned int const defaultVal )
 {
-	char token[128];
-	ovrResult r = NextToken( token, sizeof( token ) );
+	ovrLexerToken view;
+	ovrResult r = NextNumericToken( view );
 	if ( r != LEX_RESULT_OK )
 	{
 		value = defaultVal;
 		return r;
 	}
 
+	// negative values are left to strtoul, which negates them as unsigned
+	bool negative;
+	unsigned long long magnitude;
+	if ( ParseDecimalInteger( view, negative, magnitude ) && !negative )
+	{
+		if ( magnitude > ULONG_MAX )
+		{
+			value = defaultVal;
+			return LEX_RESULT_VALUE_OUT_OF_RANGE;
+		}
+		value = static_cast< unsigned int >( static_cast< unsigned long >( magnitude ) );
+		return LEX_RESULT_OK;
+	}
+
+	char token[MAX_NUMERIC_TOKEN_SIZE];
+	view.CopyTo( token, sizeof( token ) );
 	errno = 0;
 	char * endptr = nullptr;
 	value = strtoul( token, &endptr, 10 );
@@ -550,14 +876,29 @@ ovrLexer::ovrResult ovrLexer::ParseUnsignedInt( unsigned int & value, unsigned i
 // ovrLexer::ParseLongLong
 ovrLexer::ovrResult	ovrLexer::ParseLongLong( long long & value, long long const defaultVal )
 {
-	char token[128];
-	ovrResult r = NextToken( token, sizeof( token ) );
+	ovrLexerToken view;
+	ovrResult r = NextNumericToken( view );
 	if ( r != LEX_RESULT_OK )
 	{
 		value = defaultVal;
 		return r;
 	}
 
+	bool negative;
+	unsigned long long magnitude;
+	if ( ParseDecimalInteger( view, negative, magnitude ) )
+	{
+		if ( magnitude > ( negative ? static_cast< unsigned long long >( LLONG_MAX ) + 1 : LLONG_MAX ) )
+		{
+			value = defaultVal;
+			return LEX_RESULT_VALUE_OUT_OF_RANGE;
+		}
+		value = negative ? -static_cast< long long >( magnitude - 1 ) - 1 : static_cast< long long >( magnitude );
+		return LEX_RESULT_OK;
+	}
+
+	char token[MAX_NUMERIC_TOKEN_SIZE];
+	view.CopyTo( token, sizeof( token ) );
 	errno = 0;
 	char * endptr = nullptr;
 	value = strtoll( token, &endptr, 10 );
@@ -597,14 +938,25 @@ ovrLexer::ovrResult	ovrLexer::ParseLongLong( long long & value, long long const
 // ovrLexer::ParseUnsignedLongLong
 ovrLexer::ovrResult	ovrLexer::ParseUnsignedLongLong( unsigned long long & value, unsigned long long const defaultVal )
 {
-	char token[128];
-	ovrResult r = NextToken( token, sizeof( token ) );
+	ovrLexerToken view;
+	ovrResult r = NextNumericToken( view );
 	if ( r != LEX_RESULT_OK )
 	{
 		value = defaultVal;
 		return r;
 	}
 
+	// negative values are left to strtoull, which negates them as unsigned
+	bool negative;
+	unsigned long long magnitude;
+	if ( ParseDecimalInteger( view, negative, magnitude ) && !negative )
+	{
+		value = magnitude;
+		return LEX_RESULT_OK;
+	}
+
+	char token[MAX_NUMERIC_TOKEN_SIZE];
+	view.CopyTo( token, sizeof( token ) );
 	errno = 0;
 	char * endptr = nullptr;
 	value = strtoull( token, &endptr, 10 );
@@ -644,14 +996,33 @@ ovrLexer::ovrResult	ovrLexer::ParseUnsignedLongLong( unsigned long long & value,
 // ovrLexer::ParseFloat
 ovrLexer::ovrResult ovrLexer::ParseFloat( float & value, float const defaultVal )
 {
-	char token[128];
-	ovrResult r = NextToken( token, sizeof(token) );
+	ovrLexerToken view;
+	ovrResult r = NextNumericToken( view );
 	if ( r != LEX_RESULT_OK )
 	{
 		value = defaultVal;
 		return r;
 	}
 
+	// Any integer up to 2^24 and any power of 10 up to 10^10 is exact as a float, so a single
+	// multiply or divide gives the same correctly rounded result as strtof.
+	static float const powersOf10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+	char const * const end = view.GetText() + view.GetLength();
+	bool negative;
+	unsigned long long mantissa;
+	int exponent;
+	char const * parsed = ParseDecimalFloat( view, negative, mantissa, exponent );
+	if ( parsed != nullptr && ( parsed == end || *parsed == 'f' ) 
+			&& mantissa <= ( 1ULL << 24 ) && exponent >= -10 && exponent <= 10 )
+	{
+		float const f = static_cast< float >( mantissa );
+		float const v = exponent < 0 ? f / powersOf10[-exponent] : f * powersOf10[exponent];
+		value = negative ? -v : v;
+		return LEX_RESULT_OK;
+	}
+
+	char token[MAX_NUMERIC_TOKEN_SIZE];
+	view.CopyTo( token, sizeof( token ) );
 	errno = 0;
 	char * endptr = nullptr;
 	value = strtof( token, &endptr );
@@ -691,14 +1062,35 @@ ovrLexer::ovrResult ovrLexer::ParseFloat( float & value, float const defaultVal
 // ovrLexer::ParseDouble
 ovrLexer::ovrResult ovrLexer::ParseDouble( double & value, double const defaultVal )
 {
-	char token[128];
-	ovrResult r = NextToken( token, sizeof(token) );
+	ovrLexerToken view;
+	ovrResult r = NextNumericToken( view );
 	if ( r != LEX_RESULT_OK )
 	{
 		value = defaultVal;
 		return r;
 	}
 
+	// same as ParseFloat, for integers up to 2^53 and powers of 10 up to 10^22
+	static double const powersOf10[] = 
+	{
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	char const * const end = view.GetText() + view.GetLength();
+	bool negative;
+	unsigned long long mantissa;
+	int exponent;
+	char const * parsed = ParseDecimalFloat( view, negative, mantissa, exponent );
+	if ( parsed == end && mantissa <= ( 1ULL << 53 ) && exponent >= -22 && exponent <= 22 )
+	{
+		double const d = static_cast< double >( mantissa );
+		double const v = exponent < 0 ? d / powersOf10[-exponent] : d * powersOf10[exponent];
+		value = negative ? -v : v;
+		return LEX_RESULT_OK;
+	}
+
+	char token[MAX_NUMERIC_TOKEN_SIZE];
+	view.CopyTo( token, sizeof( token ) );
 	errno = 0;
 	char * endptr = nullptr;
 	value = strtod( token, &endptr );
@@ -809,6 +1201,45 @@ ovrLexer::ovrResult ovrLexer::ExpectPunctuation( char const * punc, char * token
 	return LEX_RESULT_UNEXPECTED_TOKEN;
 }
 
+//==============================
+// ovrLexer::ExpectToken
+ovrLexer::ovrResult ovrLexer::ExpectToken( char const * expectedToken, ovrLexerToken & token )
+{
+	ovrResult res = NextToken( token );
+	if ( res != LEX_RESULT_OK )
+	{
+		return res;
+	}
+
+	if ( !token.Equals( expectedToken ) )
+	{
+		return LEX_RESULT_UNEXPECTED_TOKEN;
+	}
+	return LEX_RESULT_OK;
+}
+
+//==============================
+// ovrLexer::ExpectPunctuation
+ovrLexer::ovrResult ovrLexer::ExpectPunctuation( char const * punc, ovrLexerToken & token )
+{
+	ovrResult res = NextToken( token );
+	if ( res != LEX_RESULT_OK )
+	{
+		return res;
+	}
+	if ( token.GetLength() == 1 )
+	{
+		for ( char const * c = punc; *c != '\0'; ++c )
+		{
+			if ( token.IsChar( *c ) )
+			{
+				return LEX_RESULT_OK;
+			}
+		}
+	}
+	return LEX_RESULT_UNEXPECTED_TOKEN;
+}
+
 #if 0	// enable for unit tests at static initialization time
 
 #include "OVR_LogUtils.h"
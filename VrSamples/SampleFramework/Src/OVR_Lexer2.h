@@ -15,10 +15,57 @@ of patent rights can be found in the PATENTS file in the same directory.
 #pragma once
 
 #include <stdint.h>
+#include <stddef.h>
+#include <string>
 #include <vector>
 
 namespace OVRFW {
 
+//==============================================================
+// ovrLexerToken
+//
+// A view of a token's text, which is NOT 0-terminated. Most tokens
+// point straight into the lexer's source buffer. Tokens that had to be
+// rewritten (escape codes, or quotes and comments in the middle of a
+// token) point into a scratch buffer owned by the lexer instead. In
+// either case a token should only be considered valid until the next
+// token is read from the same lexer.
+//==============================================================
+class ovrLexerToken
+{
+public:
+	ovrLexerToken()
+		: Text( "" )
+		, Length( 0 )
+	{
+	}
+	ovrLexerToken( char const * text, size_t const length )
+		: Text( text )
+		, Length( length )
+	{
+	}
+	// intentionally implicit so that 0-terminated strings can be passed where a token is expected
+	ovrLexerToken( char const * text );
+
+	char const *	GetText() const { return Text; }
+	size_t			GetLength() const { return Length; }
+	// for printing with "%.*s"
+	int				GetPrintLength() const { return static_cast< int >( Length ); }
+	bool			IsEmpty() const { return Length == 0; }
+
+	bool			Equals( char const * str ) const;
+	bool			IsChar( char const ch ) const { return Length == 1 && Text[0] == ch; }
+	// returns the offset of the first occurrence of str in the token, or -1
+	ptrdiff_t		Find( char const * str ) const;
+	// copies the token as a 0-terminated string, returns false if it had to be truncated
+	bool			CopyTo( char * buffer, size_t const bufferSize ) const;
+	std::string		ToString() const { return std::string( Text, Length ); }
+
+private:
+	char const *	Text;
+	size_t			Length;
+};
+
 //==============================================================
 // ovrLexer
 //
@@ -33,6 +80,11 @@ namespace OVRFW {
 //
 // If the / and * characters are passed as punctuation, then the lexer
 // will also treat // and /* */ as C-style comments.
+//
+// The ovrLexerToken overloads return views into the source buffer
+// instead of copying each token, and are not limited in token length.
+// The Parse* functions parse plain decimal numbers directly from the
+// view and only fall back to the C library for anything else.
 //==============================================================
 class ovrLexer 
 {
@@ -66,6 +118,11 @@ public:
 	ovrResult	ExpectToken( char const * expectedToken, char * token, size_t const maxTokenSize );
 	ovrResult	ExpectPunctuation( char const * punc, char * token, size_t const maxTokenSize );
 
+	ovrResult	NextToken( ovrLexerToken & token );
+	ovrResult	PeekToken( ovrLexerToken & token );
+	ovrResult	ExpectToken( char const * expectedToken, ovrLexerToken & token );
+	ovrResult	ExpectPunctuation( char const * punc, ovrLexerToken & token );
+
 	ovrResult	ParseInt( int & value, int const defaultVal );
 	ovrResult	ParseUnsignedInt( unsigned int & value, unsigned int const defaultVal );
 	ovrResult	ParseLongLong( long long & value, long long const defaultVal );
@@ -78,26 +135,43 @@ public:
 	ovrResult	GetError() const { return Error; }
 
 private:
+	// per-byte character classes used to scan runs of characters without decoding them
+	enum ovrCharClass
+	{
+		CHAR_WHITESPACE		= 1 << 0,
+		CHAR_PUNCTUATION	= 1 << 1,
+		CHAR_QUOTE			= 1 << 2,
+		CHAR_BACKSLASH		= 1 << 3,
+		CHAR_END			= 1 << 4,	// '\0'
+		CHAR_MULTIBYTE		= 1 << 5	// any byte of a multi-byte UTF-8 sequence
+	};
+
+	static const size_t	MAX_NUMERIC_TOKEN_SIZE = 128;
+
 	static	bool		FindChar( char const * buffer, uint32_t const ch );
 	static	bool		IsWhitespace( uint32_t const ch );
 	static	bool		IsQuote( uint32_t const ch );
 	static	ovrResult	SkipWhitespace( char const * & p, char const * source, size_t const sourceLength );
 	static	bool		IsPunctuation( char const * punctuation, uint32_t const ch );
-	static	void		CopyResult( char const * buffer, char * token, size_t const maxTokenSize );
 	static	uint32_t	TranslateEscapeCode( uint32_t const inCh );
 	
+	void			InitPunctuation( char const * punctuation );
+	bool			IsPunctuation( uint32_t const ch ) const;
+	ovrResult		ScanToken( ovrLexerToken & token, size_t const maxTokenSize );
+	ovrResult		NextNumericToken( ovrLexerToken & token );
+
 	uint32_t 		PeekNextChar();
 	ovrResult 		SkipToEndOfLine();
 
-	void			EmitCodePoint( uint32_t const ch, char * buffer, ptrdiff_t & bufferOfs, size_t const bufferSize, 
-							char * token, size_t const maxTokenSize ) const;
-
 private:
 	const char *	Source;
 	size_t			SourceLength;	
 	const char *	p;	// pointer to current position
 	ovrResult		Error;	
 	char *			Punctuation;	// UTF-8 string holding characters to lex as punctuation (may be empty)
+	bool			HasMultiBytePunctuation;	// true if Punctuation holds any non-ASCII characters
+	uint8_t			CharClasses[256];	// ovrCharClass flags for each byte value
+	std::vector< char >	Scratch;	// backing store for tokens that are not a view of the source
 };
 
 } // namespace OVRFW
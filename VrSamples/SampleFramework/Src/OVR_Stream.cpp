@@ -13,12 +13,20 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #include "Misc/Log.h"
 
 #include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#include <algorithm>
 
 #include "PackageFiles.h"
 #include "OVR_Uri.h"
 #include "OVR_UTF8Util.h"
 #include "OVR_FileSys.h"
 #include "OVR_Stream_Impl.h"
+#include "OVR_MappedFile.h"
 
 #include "OVR_Std.h"
 
@@ -263,6 +271,15 @@ ovrStream::~ovrStream()
 //==============================
 // ovrStream::Open
 bool ovrStream::Open( char const * uri, ovrStreamMode const mode )
+{
+	ovrParsedUri parsedUri;
+	ovrUri::ParseUri( uri, parsedUri );
+	return Open( uri, parsedUri, mode );
+}
+
+//==============================
+// ovrStream::Open
+bool ovrStream::Open( char const * uri, ovrParsedUri const & parsedUri, ovrStreamMode const mode )
 {
 	if ( IsOpen() )
 	{
@@ -271,7 +288,7 @@ bool ovrStream::Open( char const * uri, ovrStreamMode const mode )
 		return false;
 	}
 
-	bool success = Open_Internal( uri, mode );	
+	bool success = Open_Internal( uri, parsedUri, mode );
 	if ( success )
 	{
 		Uri = uri;
@@ -298,25 +315,75 @@ bool ovrStream::GetLocalPathFromUri( const char *uri, std::string &outputPath )
 }
 
 //==============================
-// ovrStream::Read
-bool ovrStream::Read( std::vector< uint8_t > & outBuffer, size_t const bytesToRead, size_t & outBytesRead ) 
+// ovrStream::CheckMode
+bool ovrStream::CheckMode( ovrStreamMode const mode, char const * func ) const
 {
 	if ( !IsOpen() )
 	{
-		ALOG( "ovrStream::Read: stream is not open!" );
+		ALOG( "ovrStream::%s: stream is not open!", func );
 		assert( IsOpen() );
 		return false;
 	}
 
-	if ( Mode != OVR_STREAM_MODE_READ )
+	if ( Mode != mode )
+	{
+		ALOG( "ovrStream::%s: stream is not open for %s!", func, mode == OVR_STREAM_MODE_READ ? "reading" : "writing" );
+		assert( Mode == mode );
+		return false;
+	}
+	return true;
+}
+
+//==============================
+// ovrStream::Read
+bool ovrStream::Read( std::vector< uint8_t > & outBuffer, size_t const bytesToRead, size_t & outBytesRead ) 
+{
+	size_t const bytesThatFit = std::min( bytesToRead, outBuffer.size() );
+	bool const success = Read( outBuffer.data(), bytesThatFit, outBytesRead );
+	return success && bytesThatFit == bytesToRead;
+}
+
+//==============================
+// ovrStream::Read
+bool ovrStream::Read( void * outBuffer, size_t const bytesToRead, size_t & outBytesRead )
+{
+	outBytesRead = 0;
+	if ( !CheckMode( OVR_STREAM_MODE_READ, "Read" ) )
 	{
-		ALOG( "ovrStream::Read: stream is not open for reading!" );
-		assert( Mode == OVR_STREAM_MODE_READ );
 		return false;
 	}
 	return Read_Internal( outBuffer, bytesToRead, outBytesRead );
 }
 
+//==============================
+// ovrStream::ReadV
+bool ovrStream::ReadV( ovrStreamBuffer const * buffers, int const numBuffers, size_t & outBytesRead )
+{
+	outBytesRead = 0;
+	if ( !CheckMode( OVR_STREAM_MODE_READ, "ReadV" ) )
+	{
+		return false;
+	}
+	return ReadV_Internal( buffers, numBuffers, outBytesRead );
+}
+
+//==============================
+// ovrStream::ReadV_Internal
+bool ovrStream::ReadV_Internal( ovrStreamBuffer const * buffers, int const numBuffers, size_t & outBytesRead )
+{
+	for ( int i = 0; i < numBuffers; ++i )
+	{
+		size_t bytesRead = 0;
+		bool const success = Read_Internal( buffers[i].Data, buffers[i].Size, bytesRead );
+		outBytesRead += bytesRead;
+		if ( !success )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 //==============================
 // ovrStream::ReadFile
 bool ovrStream::ReadFile( char const * uri, std::vector< uint8_t > & outBuffer )
@@ -327,20 +394,22 @@ bool ovrStream::ReadFile( char const * uri, std::vector< uint8_t > & outBuffer )
 }
 
 //==============================
-// ovrStream::Write
-bool ovrStream::Write( void const * inBuffer, size_t const bytesToWrite )
+// ovrStream::MapFile
+bool ovrStream::MapFile( MappedFile & outFile, MappedView & outView )
 {
-	if ( !IsOpen() )
+	if ( !CheckMode( OVR_STREAM_MODE_READ, "MapFile" ) )
 	{
-		ALOG( "ovrStream::Read: stream is not open!" );
-		assert( IsOpen() );
 		return false;
 	}
+	return MapFile_Internal( outFile, outView );
+}
 
-	if ( Mode != OVR_STREAM_MODE_WRITE )
+//==============================
+// ovrStream::Write
+bool ovrStream::Write( void const * inBuffer, size_t const bytesToWrite )
+{
+	if ( !CheckMode( OVR_STREAM_MODE_WRITE, "Write" ) )
 	{
-		ALOG( "ovrStream::Read: stream is not open for writing!" );
-		assert( Mode == OVR_STREAM_MODE_WRITE );
 		return false;
 	}
 	return Write_Internal( inBuffer, bytesToWrite );
@@ -360,6 +429,13 @@ size_t ovrStream::Length() const
 	return Length_Internal();
 }
 
+//==============================
+// ovrStream::AtEnd
+bool ovrStream::AtEnd() const
+{
+	return AtEnd_Internal();
+}
+
 //==============================
 // ovrStream::GetUri
 char const * ovrStream::GetUri() const 
@@ -402,10 +478,11 @@ bool ovrUriScheme_File::HostExists_Internal( char const * hostName ) const {
 // ovrUriScheme_File::OpenHost_Internal
 bool ovrUriScheme_File::OpenHost_Internal( char const * hostName, char const * uriSource )
 {
-	int index = FindHostIndexByHostName( hostName );
-	if ( index >= 0 )
+	std::lock_guard< std::mutex > lock( HostMutex );
+	std::string const key = FoldUriName( hostName );
+	if ( HostIndices.find( key ) != HostIndices.end() )
 	{
-		assert( index < 0 );	// host already exists
+		assert( false );	// host already exists
 		return false;
 	}
 	// TODO: Add AllocHost() / AllocHost_Internal() to ovrUriScheme? Requires an ovrUriHost base class, though...
@@ -416,6 +493,7 @@ bool ovrUriScheme_File::OpenHost_Internal( char const * hostName, char const * u
 	{
 		return false;
 	}
+	HostIndices[key] = static_cast< int >( Hosts.size() );
 	Hosts.push_back( host );
 	return true;
 }
@@ -442,20 +520,13 @@ void ovrUriScheme_File::Shutdown_Internal()
 // ovrUriScheme_File::FindHostIndexByHostName
 int ovrUriScheme_File::FindHostIndexByHostName( char const * hostName ) const
 {
-	if ( ( hostName == NULL || hostName[0] == '\0' ) && Hosts.size() > 0 )
-	{
-		return 0;
-	}
-
-	for ( int i = 0; i < static_cast< int >( Hosts.size() ); ++i )
+	std::lock_guard< std::mutex > lock( HostMutex );
+	if ( hostName == NULL || hostName[0] == '\0' )
 	{
-		assert( Hosts[i] != NULL );
-		if ( OVR::OVR_strcmp( Hosts[i]->GetHostName(), hostName ) == 0 )
-		{
-			return i;
-		}
+		return Hosts.size() > 0 ? 0 : -1;
 	}
-	return -1;
+	auto it = HostIndices.find( FoldUriName( hostName ) );
+	return it != HostIndices.end() ? it->second : -1;
 }
 
 //==============================
@@ -467,6 +538,8 @@ ovrUriScheme_File::ovrFileHost * ovrUriScheme_File::FindHostByHostName( char con
 	{
 		return NULL;
 	}
+	// hosts are only ever added, so the pointer stays valid once the lock is released
+	std::lock_guard< std::mutex > lock( HostMutex );
 	return Hosts[index];
 }
 
@@ -502,6 +575,18 @@ void ovrUriScheme_File::ovrFileHost::Close()
 void ovrUriScheme_File::ovrFileHost::AddSourceUri( char const * sourceUri )
 {
 	SourceUris.push_back( std::string( sourceUri ) );
+
+	// convert the source uri into a system path once, rather than on every open
+	char basePath[ovrFileSys::OVR_MAX_PATH_LEN];
+	int port;
+	if ( !ovrUri::ParseUri( sourceUri, NULL, 0, NULL, 0, NULL, 0, NULL, 0, 
+			port, basePath, sizeof( basePath ), NULL, 0, NULL, 0 ) )
+	{
+		ALOG( "ovrFileHost::AddSourceUri: invalid source uri '%s'", sourceUri );
+		assert( false );
+		basePath[0] = '\0';
+	}
+	BasePaths.push_back( std::string( SafePathFromUriPath( basePath ) ) );
 }
 
 //==============================================================================================
@@ -512,7 +597,8 @@ void ovrUriScheme_File::ovrFileHost::AddSourceUri( char const * sourceUri )
 // ovrStream_File::ovrStream_File
 ovrStream_File::ovrStream_File( ovrUriScheme const & scheme )
 	: ovrStream( scheme )
-	, F( NULL )
+	, Fd( -1 )
+	, HitEnd( false )
 {
 }
 
@@ -565,21 +651,9 @@ bool ovrStream_File::GetLocalPathFromUri_Internal( const char *uri, std::string
 	int i = host->GetNumSourceUris() - 1;
 	if ( i >= 0 )
 	{
-		// find the host's base path
-		char const * sourceUri = host->GetSourceUri( i );
-		assert( sourceUri != NULL );
 		// in this case, the URI path should ALWAYS have a leading slash!
 		assert( uriPath[0] == '/' );
-		// convert the source uri into a system path
-		char basePath[ovrFileSys::OVR_MAX_PATH_LEN];
-		if ( !ovrUri::ParseUri( sourceUri, NULL, 0, NULL, 0, NULL, 0, NULL, 0, 
-				port, basePath, sizeof( basePath ), NULL, 0, NULL, 0 ) )
-		{
-			ALOG( "ovrStream_File::GetLocalPathFromUri_Internal: invalid source uri '%s'", sourceUri );
-			assert( false );
-			return false;
-		}
-		AppendUriPath( SafePathFromUriPath( basePath ), uriPath, fullPath, sizeof( fullPath ) );
+		AppendUriPath( host->GetBasePath( i ), uriPath, fullPath, sizeof( fullPath ) );
 		outputPath = fullPath;
 		return true;
 	}
@@ -589,49 +663,31 @@ bool ovrStream_File::GetLocalPathFromUri_Internal( const char *uri, std::string
 
 //==============================
 // ovrStream_File::Open_Internal
-bool ovrStream_File::Open_Internal( char const * uri, ovrStreamMode const mode ) 
+bool ovrStream_File::Open_Internal( char const * uri, ovrParsedUri const & parsedUri, ovrStreamMode const mode ) 
 {
-	if ( F != NULL )
+	if ( Fd >= 0 )
 	{
-		assert( F == NULL );
+		assert( Fd < 0 );
 		ALOG( "Attempted to open file '%s' with an already open file handle.", uri );
 		return false;
 	}
-	char const * fmode = NULL;
-	switch( mode )
+	if ( mode != OVR_STREAM_MODE_READ && mode != OVR_STREAM_MODE_WRITE )
 	{
-		case OVR_STREAM_MODE_READ:
-			fmode = "rb";
-			break;
-		case OVR_STREAM_MODE_WRITE:
-			fmode = "wb";
-			break;
-		default:
-			assert( false );
-			return false;
-	}
-	if ( fmode == NULL )
-	{
-		assert( fmode != NULL );
+		assert( false );
 		return false;
 	}
 
 	// require a fully-qualified Uri for now?
-	char schemeName[128];
-	char hostName[128];
-	int port;
-	char uriPath[ovrFileSys::OVR_MAX_SCHEME_LEN];
-	if ( !ovrUri::ParseUri( uri, schemeName, sizeof( schemeName ), NULL, 0, NULL, 0, hostName, sizeof( hostName ), 
-			port, uriPath, sizeof( uriPath ), NULL, 0, NULL, 0 ) )
+	if ( !parsedUri.Valid )
 	{
 		ALOG( "ovrStream_File::Open_Internal: invalid uri '%s'", uri );
 		assert( false );
 		return false;
 	}
-	size_t uriPathLen = UTF8Util::GetLength( uriPath );
-	if ( uriPathLen < 1 )
+	char const * uriPath = parsedUri.Path.c_str();
+	if ( uriPath[0] == '\0' )
 	{
-		assert( uriPathLen > 0 );
+		assert( uriPath[0] != '\0' );
 		return false;
 	}
 	// on Windows, the URI path may have a /C:/ pattern, in which case we must skip over the leading slash
@@ -640,8 +696,7 @@ bool ovrStream_File::Open_Internal( char const * uri, ovrStreamMode const mode )
 	if ( UriPathStartsWithDriveLetter( uriPath ) )
 	{
 		OVR::OVR_sprintf( fullPath, sizeof( fullPath ), "%s", SafePathFromUriPath( uriPath ) );
-		F = fopen( fullPath, fmode );
-		if ( F != NULL )
+		if ( OpenPath( fullPath, mode ) )
 		{
 			Uri = uri;
 			return true;
@@ -649,7 +704,7 @@ bool ovrStream_File::Open_Internal( char const * uri, ovrStreamMode const mode )
 		return false;
 	}
 
-	ovrUriScheme_File::ovrFileHost * host = GetFileScheme().FindHostByHostName( hostName );
+	ovrUriScheme_File::ovrFileHost * host = GetFileScheme().FindHostByHostName( parsedUri.Host.c_str() );
 	if ( host == NULL )
 	{
 		assert( host != NULL );
@@ -659,24 +714,10 @@ bool ovrStream_File::Open_Internal( char const * uri, ovrStreamMode const mode )
 	// open the file in the first host path where it exists
 	for ( int i = host->GetNumSourceUris() - 1; i >= 0; --i )
 	{
-		// find the host's base path
-		char const * sourceUri = host->GetSourceUri( i );
-		assert( sourceUri != NULL );
 		// in this case, the URI path should ALWAYS have a leading slash!
 		assert( uriPath[0] == '/' );
-		// convert the source uri into a system path
-		char basePath[ovrFileSys::OVR_MAX_PATH_LEN];
-		if ( !ovrUri::ParseUri( sourceUri, NULL, 0, NULL, 0, NULL, 0, NULL, 0, 
-				port, basePath, sizeof( basePath ), NULL, 0, NULL, 0 ) )
-		{
-			ALOG( "ovrStream_File::Open_Internal: invalid source uri '%s'", sourceUri );
-			assert( false );
-			return false;
-		}
-		AppendUriPath( SafePathFromUriPath( basePath ), uriPath, fullPath, sizeof( fullPath ) );
-		//OVR_sprintf( fullPath, sizeof( fullPath ), "%s%s", ovrPathUtils::SafePathFromUriPath( basePath ), uriPath );
-		F = fopen( fullPath, fmode );
-		if ( F != NULL )
+		AppendUriPath( host->GetBasePath( i ), uriPath, fullPath, sizeof( fullPath ) );
+		if ( OpenPath( fullPath, mode ) )
 		{
 			Uri = uri;
 			return true;
@@ -685,51 +726,182 @@ bool ovrStream_File::Open_Internal( char const * uri, ovrStreamMode const mode )
 	return false;
 }
 
+//==============================
+// ovrStream_File::OpenPath
+bool ovrStream_File::OpenPath( char const * fullPath, ovrStreamMode const mode )
+{
+	if ( mode == OVR_STREAM_MODE_READ )
+	{
+		Fd = open( fullPath, O_RDONLY | O_CLOEXEC );
+	}
+	else
+	{
+		Fd = open( fullPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666 );
+	}
+	if ( Fd < 0 )
+	{
+		return false;
+	}
+#if defined( POSIX_FADV_SEQUENTIAL )
+	if ( mode == OVR_STREAM_MODE_READ )
+	{
+		// nearly every read is a whole file front to back, so let the kernel read ahead further
+		posix_fadvise( Fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+	}
+#endif
+	HitEnd = false;
+	Path = fullPath;
+	return true;
+}
+
 //==============================
 // ovrStream_File::Close_Internal
 void	ovrStream_File::Close_Internal() 
 {
-	if ( F != NULL )
+	if ( Fd >= 0 )
 	{
-		fclose( F );
-		F = NULL;
+		close( Fd );
+		Fd = -1;
 	}
 }
 
 //==============================
 // ovrStream_File::Read_Internal
-bool ovrStream_File::Read_Internal( std::vector< uint8_t > & outBuffer, size_t const bytesToRead, size_t & outBytesRead )
+bool ovrStream_File::Read_Internal( void * outBuffer, size_t const bytesToRead, size_t & outBytesRead )
 {
-	size_t numRead;
-	numRead = fread( outBuffer.data(), bytesToRead, 1, F );
-	outBytesRead = numRead * bytesToRead;
-	if ( numRead != 1 )
+	// read until the request is filled, since a read may return fewer bytes than asked for
+	uint8_t * out = static_cast< uint8_t * >( outBuffer );
+	outBytesRead = 0;
+	while ( outBytesRead < bytesToRead )
 	{
-		ALOG( "Tried to read %zu bytes from file '%s', but only read %zu bytes.", bytesToRead, Uri.c_str(), outBytesRead );
-		return false;
+		ssize_t const numRead = read( Fd, out + outBytesRead, bytesToRead - outBytesRead );
+		if ( numRead < 0 && errno == EINTR )
+		{
+			continue;
+		}
+		if ( numRead <= 0 )
+		{
+			HitEnd = ( numRead == 0 );
+			ALOG( "Tried to read %zu bytes from file '%s', but only read %zu bytes.", bytesToRead, Uri.c_str(), outBytesRead );
+			return false;
+		}
+		outBytesRead += static_cast< size_t >( numRead );
+	}
+	// an empty read fails, as it did with fread
+	return bytesToRead > 0;
+}
+
+//==============================
+// ovrStream_File::ReadV_Internal
+bool ovrStream_File::ReadV_Internal( ovrStreamBuffer const * buffers, int const numBuffers, size_t & outBytesRead )
+{
+	static const int MAX_IOVECS = 16;
+	size_t bytesToRead = 0;
+	for ( int i = 0; i < numBuffers; ++i )
+	{
+		bytesToRead += buffers[i].Size;
+	}
+
+	int cur = 0;			// first buffer that is not full
+	size_t curFilled = 0;	// bytes already read into buffers[cur]
+	for ( ;; )
+	{
+		while ( cur < numBuffers && curFilled == buffers[cur].Size )
+		{
+			cur++;
+			curFilled = 0;
+		}
+		if ( cur >= numBuffers )
+		{
+			return true;
+		}
+
+		// gather the next few non-empty buffers, starting after the part of buffers[cur] that is filled
+		iovec iov[MAX_IOVECS];
+		int numIov = 0;
+		for ( int i = cur; i < numBuffers && numIov < MAX_IOVECS; ++i )
+		{
+			size_t const skip = ( i == cur ) ? curFilled : 0;
+			if ( buffers[i].Size > skip )
+			{
+				iov[numIov].iov_base = static_cast< uint8_t * >( buffers[i].Data ) + skip;
+				iov[numIov].iov_len = buffers[i].Size - skip;
+				numIov++;
+			}
+		}
+
+		ssize_t const numRead = readv( Fd, iov, numIov );
+		if ( numRead < 0 && errno == EINTR )
+		{
+			continue;
+		}
+		if ( numRead <= 0 )
+		{
+			HitEnd = ( numRead == 0 );
+			ALOG( "Tried to read %zu bytes from file '%s', but only read %zu bytes.", bytesToRead, Uri.c_str(), outBytesRead );
+			return false;
+		}
+		outBytesRead += static_cast< size_t >( numRead );
+
+		// advance past the buffers that were filled
+		size_t remaining = static_cast< size_t >( numRead );
+		while ( remaining > 0 )
+		{
+			size_t const space = buffers[cur].Size - curFilled;
+			if ( remaining < space )
+			{
+				curFilled += remaining;
+				break;
+			}
+			remaining -= space;
+			cur++;
+			curFilled = 0;
+		}
 	}
-	return true;
 }
 
 //==============================
 // ovrStream_File::ReadFile_Internal
 bool ovrStream_File::ReadFile_Internal( std::vector< uint8_t > & outBuffer )
 {
-	std::vector< uint8_t > buffer( Length() );
-	outBuffer = buffer;
+	// read straight into the caller's buffer
+	outBuffer.resize( Length() );
 	size_t bytesRead = 0;
-	return Read_Internal( outBuffer, outBuffer.size(), bytesRead );
+	return Read_Internal( outBuffer.data(), outBuffer.size(), bytesRead );
+}
+
+//==============================
+// ovrStream_File::MapFile_Internal
+bool ovrStream_File::MapFile_Internal( MappedFile & outFile, MappedView & outView )
+{
+	if ( !outFile.OpenRead( Path.c_str(), true ) || !outView.Open( &outFile ) || outView.MapView() == NULL )
+	{
+		outView.Close();
+		outFile.Close();
+		return false;
+	}
+	return true;
 }
 
 //==============================
 // ovrStream_File::Write_Internal
 bool ovrStream_File::Write_Internal( void const * inBuffer, size_t const bytesToWrite )
 {
-	size_t recsWritten = fwrite( inBuffer, bytesToWrite, 1, F );
-	if ( recsWritten != 1 )
+	uint8_t const * in = static_cast< uint8_t const * >( inBuffer );
+	size_t written = 0;
+	while ( written < bytesToWrite )
 	{
-		ALOG( "Failed to write %zu bytes to file '%s'", bytesToWrite, Uri.c_str() );
-		return false;
+		ssize_t const numWritten = write( Fd, in + written, bytesToWrite - written );
+		if ( numWritten < 0 && errno == EINTR )
+		{
+			continue;
+		}
+		if ( numWritten <= 0 )
+		{
+			ALOG( "Failed to write %zu bytes to file '%s'", bytesToWrite, Uri.c_str() );
+			return false;
+		}
+		written += static_cast< size_t >( numWritten );
 	}
 	return true;
 }
@@ -738,29 +910,27 @@ bool ovrStream_File::Write_Internal( void const * inBuffer, size_t const bytesTo
 // ovrStream_File::Tell_Internal
 size_t	ovrStream_File::Tell_Internal() const
 {
-	return ftell( F );
+	off_t const ofs = lseek( Fd, 0, SEEK_CUR );
+	return ofs < 0 ? 0 : static_cast< size_t >( ofs );
 }
 
 //==============================
 // ovrStream_File::Length_Internal
 size_t	ovrStream_File::Length_Internal() const 
 {
-	// remember the current offset
-	size_t curOfs = ftell( F );
-	// seek to the end
-	fseek( F, 0, SEEK_END );
-	// get the position at the end
-	size_t len = ftell( F );
-	// seek back to the original offset
-	fseek( F, curOfs, SEEK_SET );
-	return len;
+	struct stat st;
+	if ( fstat( Fd, &st ) != 0 )
+	{
+		return 0;
+	}
+	return static_cast< size_t >( st.st_size );
 }
 
 //==============================
 // ovrStream_File::AtEnd_Internal
 bool ovrStream_File::AtEnd_Internal() const
 {
-	return feof( F ) != 0;
+	return HitEnd;
 }
 
 //==============================================================================================
@@ -797,10 +967,11 @@ bool ovrUriScheme_Apk::HostExists_Internal( char const * hostName ) const {
 // ovrUriScheme_Apk::OpenHost_Internal
 bool ovrUriScheme_Apk::OpenHost_Internal( char const * hostName, char const * sourceUri )
 {
-	int index = FindHostIndexByHostName( hostName );
-	if ( index >= 0 )
+	std::lock_guard< std::mutex > lock( HostMutex );
+	std::string const key = FoldUriName( hostName );
+	if ( HostIndices.find( key ) != HostIndices.end() )
 	{
-		assert( index < 0 );	// host already exists
+		assert( false );	// host already exists
 		return false;
 	}
 	ovrApkHost * host = new ovrApkHost( hostName, sourceUri );
@@ -810,6 +981,7 @@ bool ovrUriScheme_Apk::OpenHost_Internal( char const * hostName, char const * so
 	{
 		return false;
 	}
+	HostIndices[key] = static_cast< int >( Hosts.size() );
 	Hosts.push_back( host );
 	return true;
 }
@@ -830,20 +1002,13 @@ void ovrUriScheme_Apk::CloseHost_Internal( char const * hostName )
 // ovrUriScheme_Apk::FindHostIndexByHostName
 int ovrUriScheme_Apk::FindHostIndexByHostName( char const * hostName ) const
 {
-	if ( ( hostName == NULL || hostName[0] == '\0' ) && Hosts.size() > 0 )
+	std::lock_guard< std::mutex > lock( HostMutex );
+	if ( hostName == NULL || hostName[0] == '\0' )
 	{
-		return 0;
+		return Hosts.size() > 0 ? 0 : -1;
 	}
-
-	for ( int i = 0; i < static_cast< int >( Hosts.size() ); ++i )
-	{
-		assert( Hosts[i] != NULL );
-		if ( OVR::OVR_strcmp( Hosts[i]->GetHostName(), hostName ) == 0 )
-		{
-			return i;
-		}
-	}
-	return -1;
+	auto it = HostIndices.find( FoldUriName( hostName ) );
+	return it != HostIndices.end() ? it->second : -1;
 }
 
 //==============================
@@ -855,6 +1020,8 @@ ovrUriScheme_Apk::ovrApkHost * ovrUriScheme_Apk::FindHostByHostName( char const
 	{
 		return NULL;
 	}
+	// hosts are only added until shutdown, so the pointer stays valid once the lock is released
+	std::lock_guard< std::mutex > lock( HostMutex );
 	return Hosts[index];
 }
 
@@ -921,6 +1088,7 @@ void ovrUriScheme_Apk::ovrApkHost::Close()
 void ovrUriScheme_Apk::Shutdown_Internal() 
 {
 	// close all hosts
+	std::lock_guard< std::mutex > lock( HostMutex );
 	for ( int i = 0; i < static_cast< int >( Hosts.size() ); ++i )
 	{
 		Hosts[i]->Close();
@@ -928,6 +1096,7 @@ void ovrUriScheme_Apk::Shutdown_Internal()
 		Hosts[i] = NULL;
 	}
 	Hosts.clear();
+	HostIndices.clear();
 }
 
 
@@ -959,7 +1128,7 @@ bool ovrStream_Apk::GetLocalPathFromUri_Internal( const char *uri, std::string &
 
 //==============================
 // ovrStream_Apk::Open_Internal
-bool ovrStream_Apk::Open_Internal( char const * uri, ovrStreamMode const mode )
+bool ovrStream_Apk::Open_Internal( char const * uri, ovrParsedUri const & parsedUri, ovrStreamMode const mode )
 {
 	if ( IsOpen )
 	{
@@ -975,27 +1144,29 @@ bool ovrStream_Apk::Open_Internal( char const * uri, ovrStreamMode const mode )
 		return false;
 	}
 
-	char hostName[ovrFileSys::OVR_MAX_HOST_NAME_LEN];
-	int port;
-	char path[ovrFileSys::OVR_MAX_SCHEME_LEN];
-	if ( !ovrUri::ParseUri( uri, NULL, 0, NULL, 0, NULL, 0, hostName, sizeof( hostName ), 
-			port, path, sizeof( path ), NULL, 0, NULL, 0 ) )
+	if ( !parsedUri.Valid )
 	{
 		ALOG( "ovrStream_Apk::Open_Internal: invalid Uri '%s'", uri );
 		return false;
 	}
 
 	// get the zip file for this host
-	void * zipFile = GetApkScheme().GetZipFileForHostName( hostName );
+	void * zipFile = GetApkScheme().GetZipFileForHostName( parsedUri.Host.c_str() );
 	if ( zipFile == NULL )
 	{
-		ALOG( "ovrStream_Apk::Open_Internal: no zip file for uri '%s', host '%s'", uri, hostName );
+		ALOG( "ovrStream_Apk::Open_Internal: no zip file for uri '%s', host '%s'", uri, parsedUri.Host.c_str() );
 		return false;
 	}
 
 	// inside of zip files, the leading slash will cause the file to not be found, so skip it
+	char const * path = parsedUri.Path.c_str();
 	char const * pathStart = ( path[0] == '/' ) ? path + 1 : path;
 	IsOpen = ovr_OtherPackageFileExists( zipFile, pathStart );
+	if ( IsOpen )
+	{
+		HostName = parsedUri.Host;
+		Path = pathStart;
+	}
 	return IsOpen;
 }
 
@@ -1008,7 +1179,7 @@ void ovrStream_Apk::Close_Internal()
 
 //==============================
 // ovrStream_Apk::Read_Internal
-bool ovrStream_Apk::Read_Internal( std::vector< uint8_t > & outBuffer, size_t const bytesToRead, size_t & outBytesRead )
+bool ovrStream_Apk::Read_Internal( void * outBuffer, size_t const bytesToRead, size_t & outBytesRead )
 {
 	assert( false );	// TODO: cannot read partial files from an apk yet
 	return false;
@@ -1018,22 +1189,10 @@ bool ovrStream_Apk::Read_Internal( std::vector< uint8_t > & outBuffer, size_t co
 // ovrStream_Apk::ReadFile_Internal
 bool ovrStream_Apk::ReadFile_Internal( std::vector< uint8_t > & outBuffer )
 {
-	char hostName[ovrFileSys::OVR_MAX_HOST_NAME_LEN];
-	int port;
-	char path[ovrFileSys::OVR_MAX_SCHEME_LEN];
-	if ( !ovrUri::ParseUri( GetUri(), NULL, 0, NULL, 0, NULL, 0, hostName, sizeof( hostName ), 
-				port, path, sizeof( path ), NULL, 0, NULL, 0 ) )
-	{
-		ALOG( "ovrStream_Apk::ReadFile_Internal: invalid Uri '%s'", GetUri() );
-		return false;
-	}
-
-	void * zipFile = GetApkScheme().GetZipFileForHostName( hostName );
-
-	// inside of zip files, the leading slash will cause the file to not be found, so skip it
-	char const * pathStart = ( path[0] == '/' ) ? path + 1 : path;
+	// the host and path were parsed when the stream was opened
+	void * zipFile = GetApkScheme().GetZipFileForHostName( HostName.c_str() );
 
-	return ovr_ReadFileFromOtherApplicationPackage( zipFile, pathStart, outBuffer );
+	return ovr_ReadFileFromOtherApplicationPackage( zipFile, Path.c_str(), outBuffer );
 }
 
 //==============================
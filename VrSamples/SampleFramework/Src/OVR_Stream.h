@@ -24,6 +24,16 @@ enum ovrStreamMode
 };
 
 class ovrUriScheme;
+struct ovrParsedUri;
+class MappedFile;
+class MappedView;
+
+// One of the buffers filled by ovrStream::ReadV.
+struct ovrStreamBuffer
+{
+	void *	Data;
+	size_t	Size;
+};
 
 //==============================================================
 // ovrStream
@@ -39,6 +49,8 @@ public:
 
 	// Opens a stream for the specified Uri.
 	bool				Open( char const * Uri, ovrStreamMode const mode );
+	// Opens a stream for a Uri that the caller has already parsed.
+	bool				Open( char const * Uri, ovrParsedUri const & parsedUri, ovrStreamMode const mode );
 
 	// Closes the currently open stream.
 	void				Close();
@@ -52,10 +64,24 @@ public:
 	// - If the number of bytes in the file is less than the number requested, the buffer is filled with the
 	//   remaining bytes and false is returned.
 	bool				Read( std::vector< uint8_t > & outBuffer, size_t const bytesToRead, size_t & outBytesRead );
+
+	// Reads the specified number of bytes from the stream into outBuffer, which must be at least that large.
+	// Returns false if fewer bytes were read, for instance at the end of the stream.
+	bool				Read( void * outBuffer, size_t const bytesToRead, size_t & outBytesRead );
+
+	// Fills each of the buffers in turn, with a single read where the stream supports it.
+	// outBytesRead is the total number of bytes read. Returns false if not all buffers were filled.
+	bool				ReadV( ovrStreamBuffer const * buffers, int const numBuffers, size_t & outBytesRead );
 	
 	// Allocates a buffer large enough to fit the stream resource and reads the stream into it.
 	bool				ReadFile( char const * uri, std::vector< uint8_t > & outBuffer );
 
+	// Maps the whole stream resource read-only, so that it can be used in place without a copy.
+	// The data stays valid until outView and outFile are closed, even after the stream is closed.
+	// Returns false if the stream can't be mapped, i.e. it is not a local file or is empty; use
+	// ReadFile in that case.
+	bool				MapFile( MappedFile & outFile, MappedView & outView );
+
 	// Writes the specified number of bytes to the stream.
 	// - If writing fails, false is returned.
 	bool				Write( void const * inBuffer, size_t const bytesToWrite );
@@ -76,6 +102,8 @@ public:
 protected:
 	ovrUriScheme const &	GetScheme() const { return Scheme; }
 
+	bool					CheckMode( ovrStreamMode const mode, char const * func ) const;
+
 private:
 	ovrUriScheme const &	Scheme;
 	std::string				Uri;
@@ -83,10 +111,13 @@ private:
 
 private:
 	virtual bool			GetLocalPathFromUri_Internal( const char *uri, std::string &outputPath ) = 0;
-	virtual bool			Open_Internal( char const * Uri, ovrStreamMode const mode ) = 0;
+	virtual bool			Open_Internal( char const * Uri, ovrParsedUri const & parsedUri, ovrStreamMode const mode ) = 0;
 	virtual void			Close_Internal() = 0;
-	virtual bool			Read_Internal( std::vector< uint8_t > & outBuffer, size_t const bytesToRead, size_t & outBytesRead ) = 0;
+	virtual bool			Read_Internal( void * outBuffer, size_t const bytesToRead, size_t & outBytesRead ) = 0;
+	// by default buffers are read one at a time
+	virtual bool			ReadV_Internal( ovrStreamBuffer const * buffers, int const numBuffers, size_t & outBytesRead );
 	virtual bool			ReadFile_Internal( std::vector< uint8_t > & outBuffer ) = 0;
+	virtual bool			MapFile_Internal( MappedFile & outFile, MappedView & outView ) { return false; }
 	virtual bool			Write_Internal( void const * inBuffer, size_t const bytesToWrite ) = 0;
 	virtual size_t			Tell_Internal() const = 0;
 	virtual size_t			Length_Internal() const = 0;
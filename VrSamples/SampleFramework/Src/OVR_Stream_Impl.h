@@ -15,13 +15,31 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 
 #include <vector>
 #include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #include "OVR_Types.h"
 #include "OVR_Stream.h"
+#include "OVR_Uri.h"
 //#include "OVR_FileSys.h"
 
 namespace OVRFW
 {
+// Scheme and host names are matched without regard to case, by hashing their lowercase form.
+inline std::string FoldUriName( char const * name )
+{
+	std::string folded( name != NULL ? name : "" );
+	for ( size_t i = 0; i < folded.size(); ++i )
+	{
+		if ( folded[i] >= 'A' && folded[i] <= 'Z' )
+		{
+			folded[i] = static_cast< char >( folded[i] - 'A' + 'a' );
+		}
+	}
+	return folded;
+}
+
 //==============================================================
 // ovrUriScheme
 //
@@ -80,7 +98,7 @@ public:
 
 		ovrFileHost( char const * hostName, char const * sourceUri ) : HostName( hostName )
 		{
-			SourceUris.push_back( std::string( sourceUri ) );
+			AddSourceUri( sourceUri );
 		}
 
 		ovrFileHost( ovrFileHost & other ) : HostName( other.HostName ) {}
@@ -93,8 +111,10 @@ public:
 			{
 				this->HostName   = rhs.HostName;
 				this->SourceUris = rhs.SourceUris;
+				this->BasePaths	 = rhs.BasePaths;
 				rhs.HostName	 = "";
 				rhs.SourceUris.clear();
+				rhs.BasePaths.clear();
 			}
 			return *this;
 		}
@@ -110,6 +130,11 @@ public:
 		{
 			return SourceUris[index].c_str();
 		}
+		// the system path of a source uri, parsed when it was added
+		char const * GetBasePath( int const index ) const
+		{
+			return BasePaths[index].c_str();
+		}
 		int GetNumSourceUris() const
 		{
 			return static_cast<int>( SourceUris.size() );
@@ -119,6 +144,7 @@ public:
 	private:
 		std::string HostName;					// localhost or machine name on Windows
 		std::vector<std::string> SourceUris;	// all the base paths for files loaded through this host
+		std::vector<std::string> BasePaths;		// one per source uri
 	};
 
 	int FindHostIndexByHostName( char const * hostName ) const;
@@ -126,6 +152,8 @@ public:
 
 private:
 	std::vector<ovrFileHost *> Hosts;
+	std::unordered_map<std::string, int> HostIndices;	// by folded host name
+	mutable std::mutex HostMutex;						// guards Hosts and HostIndices, streams look hosts up on any thread
 
 private:
 	virtual ovrStream * AllocStream_Internal() const OVR_OVERRIDE;
@@ -207,6 +235,8 @@ private:
 	};
 
 	std::vector<ovrApkHost *> Hosts;
+	std::unordered_map<std::string, int> HostIndices;	// by folded host name
+	mutable std::mutex HostMutex;						// guards Hosts and HostIndices, streams look hosts up on any thread
 
 private:
 	virtual ovrStream * AllocStream_Internal() const OVR_OVERRIDE;
@@ -228,22 +258,26 @@ public:
 	virtual ~ovrStream_File();
 
 private:
-	FILE * F;
+	int Fd;
+	bool HitEnd;		  // a read stopped at the end of the file
 	std::string Uri;
+	std::string Path;	  // local path of the open file
 
 private:
 	virtual bool GetLocalPathFromUri_Internal( const char * uri, std::string & outputPath ) OVR_OVERRIDE;
-	virtual bool Open_Internal( char const * uri, ovrStreamMode const mode ) OVR_OVERRIDE;
+	virtual bool Open_Internal( char const * uri, ovrParsedUri const & parsedUri, ovrStreamMode const mode ) OVR_OVERRIDE;
 	virtual void Close_Internal() OVR_OVERRIDE;
-	virtual bool Read_Internal( std::vector<uint8_t> & outBuffer,
-								size_t const bytesToRead,
-								size_t & outBytesRead ) OVR_OVERRIDE;
+	virtual bool Read_Internal( void * outBuffer, size_t const bytesToRead, size_t & outBytesRead ) OVR_OVERRIDE;
+	virtual bool ReadV_Internal( ovrStreamBuffer const * buffers, int const numBuffers, size_t & outBytesRead ) OVR_OVERRIDE;
 	virtual bool ReadFile_Internal( std::vector<uint8_t> & outBuffer ) OVR_OVERRIDE;
+	virtual bool MapFile_Internal( MappedFile & outFile, MappedView & outView ) OVR_OVERRIDE;
 	virtual bool Write_Internal( void const * inBuffer, size_t const bytesToWrite ) OVR_OVERRIDE;
 	virtual size_t Tell_Internal() const OVR_OVERRIDE;
 	virtual size_t Length_Internal() const OVR_OVERRIDE;
 	virtual bool AtEnd_Internal() const OVR_OVERRIDE;
 
+	bool OpenPath( char const * fullPath, ovrStreamMode const mode );
+
 	ovrUriScheme_File const & GetFileScheme() const
 	{
 		return *static_cast<ovrUriScheme_File const *>( &GetScheme() );
@@ -260,15 +294,14 @@ public:
 
 private:
 	std::string HostName;
+	std::string Path;	// path of the open file inside the apk
 	bool IsOpen;
 
 private:
 	virtual bool GetLocalPathFromUri_Internal( const char * uri, std::string & outputPath ) OVR_OVERRIDE;
-	virtual bool Open_Internal( char const * uri, ovrStreamMode const mode ) OVR_OVERRIDE;
+	virtual bool Open_Internal( char const * uri, ovrParsedUri const & parsedUri, ovrStreamMode const mode ) OVR_OVERRIDE;
 	virtual void Close_Internal() OVR_OVERRIDE;
-	virtual bool Read_Internal( std::vector<uint8_t> & outBuffer,
-								size_t const bytesToRead,
-								size_t & outBytesRead ) OVR_OVERRIDE;
+	virtual bool Read_Internal( void * outBuffer, size_t const bytesToRead, size_t & outBytesRead ) OVR_OVERRIDE;
 	virtual bool ReadFile_Internal( std::vector<uint8_t> & outBuffer ) OVR_OVERRIDE;
 	virtual bool Write_Internal( void const * inBuffer, size_t const bytesToWrite ) OVR_OVERRIDE;
 	virtual size_t Tell_Internal() const OVR_OVERRIDE;
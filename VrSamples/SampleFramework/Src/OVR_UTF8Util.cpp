@@ -29,90 +29,389 @@ limitations under the License.
 
 #include "OVR_UTF8Util.h"
 
+#include <string.h>
+#include <assert.h>
+
+#if defined( __SSE2__ ) || defined( _M_X64 )
+#include <emmintrin.h>
+#define OVR_UTF8_SCAN_SSE2
+#elif defined( __ARM_NEON__ ) || defined( __ARM_NEON )
+#include <arm_neon.h>
+#define OVR_UTF8_SCAN_NEON
+#endif
+
 namespace OVRFW { namespace UTF8Util {
 
-intptr_t GetLength(const char* buf, intptr_t buflen)
+// *** Bulk scanning helpers.
+//
+// Blocks are loaded unaligned and only when all 16 bytes are inside the range, so nothing
+// past the end of the range is ever read.
+
+static const intptr_t BLOCK_SIZE = 16;
+
+#if defined( OVR_UTF8_SCAN_SSE2 )
+static const int MASK_BITS = 1;     // mask bits per byte
+
+// Bit mask of the bytes in the block at p that have the high bit set.
+static inline uint64_t NonASCIIMask(const char* p)
 {
-    const char* p = buf;
-    intptr_t length = 0;
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))));
+}
 
-    if (buflen != -1)
+// Widens the 16 ASCII bytes at p to UTF-32.
+static inline void WidenASCII(uint32_t* pbuff, const char* p)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pbuff + 0), _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pbuff + 4), _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pbuff + 8), _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pbuff + 12), _mm_unpackhi_epi16(hi, zero));
+}
+#elif defined( OVR_UTF8_SCAN_NEON )
+static const int MASK_BITS = 4;
+
+// NEON has no movemask; narrow each 0x00/0xFF byte lane of the sign test to a nibble.
+static inline uint64_t NonASCIIMask(const char* p)
+{
+    const uint8x16_t high = vcltq_s8(vld1q_s8(reinterpret_cast<const int8_t*>(p)), vdupq_n_s8(0));
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(high), 4)), 0);
+}
+
+static inline void WidenASCII(uint32_t* pbuff, const char* p)
+{
+    const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+    const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+    vst1q_u32(pbuff + 0, vmovl_u16(vget_low_u16(lo)));
+    vst1q_u32(pbuff + 4, vmovl_u16(vget_high_u16(lo)));
+    vst1q_u32(pbuff + 8, vmovl_u16(vget_low_u16(hi)));
+    vst1q_u32(pbuff + 12, vmovl_u16(vget_high_u16(hi)));
+}
+#else
+static const int MASK_BITS = 1;
+
+static inline uint64_t NonASCIIMask(const char* p)
+{
+    uint64_t mask = 0;
+    for (int i = 0; i < BLOCK_SIZE; i++)
+        mask |= static_cast<uint64_t>(static_cast<uint8_t>(p[i]) >> 7) << i;
+    return mask;
+}
+
+static inline void WidenASCII(uint32_t* pbuff, const char* p)
+{
+    for (int i = 0; i < BLOCK_SIZE; i++)
+        pbuff[i] = static_cast<uint8_t>(p[i]);
+}
+#endif
+
+// Number of ASCII bytes at the start of a block with a non-zero mask.
+static inline intptr_t LeadingASCII(uint64_t mask)
+{
+    return __builtin_ctzll(mask) / MASK_BITS;
+}
+
+// Decodes one character without reading at or past end. The result is the same as
+// DecodeNextChar_Advance0 gives if the range is followed by a 0.
+static inline uint32_t DecodeNextCharBounded(const char*& p, const char* end)
+{
+    // DecodeNextChar_Advance0 reads at most 6 bytes
+    if (end - p >= 6)
+        return DecodeNextChar_Advance0(&p);
+
+    char tail[8] = { 0 };
+    memcpy(tail, p, end - p);
+    const char* t = tail;
+    const uint32_t ch = DecodeNextChar_Advance0(&t);
+    p += t - tail;
+    return ch;
+}
+
+// Decodes a well-formed two or three byte sequence inline, which covers all of the BMP. Returns
+// false, without advancing, for anything DecodeNextCharBounded has to handle.
+static inline bool DecodeBMPChar(const char*& p, const char* end, uint32_t& ch)
+{
+    const uint8_t c = static_cast<uint8_t>(p[0]);
+    if ((c & 0xE0) == 0xC0 && end - p >= 2 && (p[1] & 0xC0) == 0x80)
     {
-        while (p - buf < buflen)
+        ch = ((c & 0x1F) << 6) | (p[1] & 0x3F);
+        if (ch < 0x80)
+            return false;   // overlong
+        p += 2;
+        return true;
+    }
+    if ((c & 0xF0) == 0xE0 && end - p >= 3 && (p[1] & 0xC0) == 0x80 && (p[2] & 0xC0) == 0x80)
+    {
+        ch = ((c & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+        if (ch < 0x800)
+            return false;   // overlong
+        p += 3;
+        return true;
+    }
+    return false;
+}
+
+// Advances p past up to maxChars characters before end and returns the number passed.
+// lastChar is set to the last character passed.
+static intptr_t SkipChars(const char*& p, const char* end, intptr_t maxChars, uint32_t& lastChar)
+{
+    intptr_t count = 0;
+    while (count < maxChars && p < end)
+    {
+        if (end - p >= BLOCK_SIZE && maxChars - count >= BLOCK_SIZE)
         {
-            // We should be able to have ASStrings with 0 in the middle.
-            UTF8Util::DecodeNextChar_Advance0(&p);
-            length++;
+            const uint64_t mask = NonASCIIMask(p);
+            if (mask == 0)
+            {
+                lastChar = static_cast<uint8_t>(p[BLOCK_SIZE - 1]);
+                p += BLOCK_SIZE;
+                count += BLOCK_SIZE;
+                continue;
+            }
+            const intptr_t ascii = LeadingASCII(mask);
+            if (ascii > 0)
+            {
+                lastChar = static_cast<uint8_t>(p[ascii - 1]);
+                p += ascii;
+                count += ascii;
+            }
         }
+        // decode up to the next ASCII byte before testing another block
+        do
+        {
+            if (!DecodeBMPChar(p, end, lastChar))
+                lastChar = DecodeNextCharBounded(p, end);
+            count++;
+        } while (count < maxChars && p < end && (*p & 0x80) != 0);
     }
-    else
+    return count;
+}
+
+intptr_t GetLength(const char* buf, intptr_t buflen)
+{
+    const char* p = buf;
+    uint32_t lastChar = 0;
+
+    if (buflen != -1)
     {
-        while (UTF8Util::DecodeNextChar_Advance0(&p))
-            length++;
+        // We should be able to have ASStrings with 0 in the middle.
+        return SkipChars(p, buf + buflen, INTPTR_MAX, lastChar);
     }
-    
-    return length;
+
+    // Before the terminator, a 0 can only come from a sequence the terminator cut off,
+    // which ends the string.
+    const intptr_t length = SkipChars(p, buf + strlen(buf), INTPTR_MAX, lastChar);
+    return (length > 0 && lastChar == 0) ? length - 1 : length;
 }
 
 uint32_t GetCharAt(intptr_t index, const char* putf8str, intptr_t length)
+{
+    const bool terminated = (length == -1);
+    if (terminated)
+        length = strlen(putf8str);
+
+    const char* buf = putf8str;
+    const char* end = putf8str + length;
+    uint32_t lastChar = 0;
+    const intptr_t skipped = SkipChars(buf, end, index, lastChar);
+    if (buf < end)
+        return DecodeNextCharBounded(buf, end);
+
+    if (terminated)
+    {
+        // We've hit the end of the string; don't go further.
+        assert(index == skipped);
+        (void)skipped;
+        return 0;
+    }
+
+    // Past the end of a string with a length, the last character is returned.
+    return lastChar;
+}
+
+intptr_t GetByteIndex(intptr_t index, const char *putf8str, intptr_t length)
 {
     const char* buf = putf8str;
-    uint32_t  c = 0;
+    uint32_t lastChar = 0;
 
     if (length != -1)
     {
-        while (buf - putf8str < length)
-        {           
-            c = UTF8Util::DecodeNextChar_Advance0(&buf);
-            if (index == 0)
-                return c;
-            index--;
-        }
+        SkipChars(buf, putf8str + length, index, lastChar);
+        return buf-putf8str;
+    }
 
-        return c;
+    const intptr_t len = strlen(putf8str);
+    const intptr_t skipped = SkipChars(buf, putf8str + len, index, lastChar);
+    if (skipped < index && (skipped == 0 || lastChar != 0))
+    {
+        // Decoding the terminator steps past it.
+        return len + 1;
     }
+    return buf-putf8str;
+}
 
-    do 
+ovrUTF8Index::ovrUTF8Index()
+    : Str("")
+    , ByteLength(0)
+    , NumChars(0)
+{
+}
+
+ovrUTF8Index::ovrUTF8Index(const char* putf8str, intptr_t length)
+    : Str("")
+    , ByteLength(0)
+    , NumChars(0)
+{
+    Build(putf8str, length);
+}
+
+void ovrUTF8Index::Build(const char* putf8str, intptr_t length)
+{
+    Str = putf8str;
+    ByteLength = (length == -1) ? static_cast<intptr_t>(strlen(putf8str)) : length;
+    NumChars = 0;
+    Checkpoints.clear();
+    Checkpoints.reserve(ByteLength / CHARS_PER_CHECKPOINT + 1);
+
+    const char* p = Str;
+    const char* end = Str + ByteLength;
+    uint32_t lastChar = 0;
+    while (p < end)
     {
-        c = UTF8Util::DecodeNextChar_Advance0(&buf);
-        index--;
+        Checkpoints.push_back(p - Str);
+        NumChars += SkipChars(p, end, CHARS_PER_CHECKPOINT, lastChar);
+    }
 
-        if (c == 0)
-        {
-            // We've hit the end of the string; don't go further.
-            assert(index == 0);
-            return c;
-        }
-    } while (index >= 0);
+    // match GetLength for a 0-terminated string that ends in a cut-off sequence
+    if (length == -1 && NumChars > 0 && lastChar == 0)
+        NumChars--;
+}
 
-    return c;
+intptr_t ovrUTF8Index::GetByteIndex(intptr_t index) const
+{
+    if (index < 0 || index >= NumChars)
+        return ByteLength;
+
+    const char* p = Str + Checkpoints[index / CHARS_PER_CHECKPOINT];
+    uint32_t lastChar = 0;
+    SkipChars(p, Str + ByteLength, index % CHARS_PER_CHECKPOINT, lastChar);
+    return p - Str;
 }
 
-intptr_t GetByteIndex(intptr_t index, const char *putf8str, intptr_t length)
+uint32_t ovrUTF8Index::GetCharAt(intptr_t index) const
 {
-    const char* buf = putf8str;
+    if (index < 0 || index >= NumChars)
+        return 0;
 
-    if (length != -1)
+    const char* p = Str + GetByteIndex(index);
+    return DecodeNextCharBounded(p, Str + ByteLength);
+}
+
+bool IsASCII(const char* putf8str, intptr_t length)
+{
+    const char* p = putf8str;
+    const char* end = putf8str + length;
+    for (; end - p >= BLOCK_SIZE; p += BLOCK_SIZE)
+    {
+        if (NonASCIIMask(p) != 0)
+            return false;
+    }
+    for (; p < end; p++)
     {
-        while ((buf - putf8str) < length && index > 0)
+        if ((*p & 0x80) != 0)
+            return false;
+    }
+    return true;
+}
+
+bool IsValid(const char* putf8str, intptr_t length)
+{
+    const char* p = putf8str;
+    const char* end = putf8str + length;
+    while (p < end)
+    {
+        if (end - p >= BLOCK_SIZE)
         {
-            UTF8Util::DecodeNextChar_Advance0(&buf);
-            index--;
+            const uint64_t mask = NonASCIIMask(p);
+            if (mask == 0)
+            {
+                p += BLOCK_SIZE;
+                continue;
+            }
+            p += LeadingASCII(mask);
         }
 
-        return buf-putf8str;
-    }
+        if ((*p & 0x80) == 0)
+        {
+            p++;
+            continue;
+        }
 
-    while (index > 0) 
-    {
-        uint32_t c = UTF8Util::DecodeNextChar_Advance0(&buf);
-        index--;
+        // check up to the next ASCII byte before testing another block
+        do
+        {
+            // the same sequences DecodeNextChar_Advance0 accepts
+            const char c = *p;
+            int extraBytes;
+            uint32_t minChar;
+            if ((c & 0xE0) == 0xC0)      { extraBytes = 1; minChar = 0x80; }
+            else if ((c & 0xF0) == 0xE0) { extraBytes = 2; minChar = 0x800; }
+            else if ((c & 0xF8) == 0xF0) { extraBytes = 3; minChar = 0x010000; }
+            else if ((c & 0xFC) == 0xF8) { extraBytes = 4; minChar = 0x0200000; }
+            else if ((c & 0xFE) == 0xFC) { extraBytes = 5; minChar = 0x04000000; }
+            else return false;
+
+            if (end - p <= extraBytes)
+                return false;   // cut off
+
+            uint32_t uc = c & (0x3F >> extraBytes);
+            for (int i = 1; i <= extraBytes; i++)
+            {
+                if ((p[i] & 0xC0) != 0x80)
+                    return false;
+                uc = (uc << 6) | (p[i] & 0x3F);
+            }
+            if (uc < minChar)
+                return false;   // overlong
 
-        if (c == 0)
-            return buf-putf8str;
-    };
+            p += extraBytes + 1;
+        } while (p < end && (*p & 0x80) != 0);
+    }
+    return true;
+}
 
-    return buf-putf8str;
+intptr_t DecodeUTF32(uint32_t* pbuff, const char* putf8str, intptr_t length)
+{
+    uint32_t* pbegin = pbuff;
+    const char* p = putf8str;
+    const char* end = putf8str + length;
+    while (p < end)
+    {
+        if (end - p >= BLOCK_SIZE)
+        {
+            const uint64_t mask = NonASCIIMask(p);
+            if (mask == 0)
+            {
+                WidenASCII(pbuff, p);
+                pbuff += BLOCK_SIZE;
+                p += BLOCK_SIZE;
+                continue;
+            }
+            for (intptr_t ascii = LeadingASCII(mask); ascii > 0; ascii--)
+                *pbuff++ = static_cast<uint8_t>(*p++);
+        }
+        // decode up to the next ASCII byte before testing another block
+        do
+        {
+            if (!DecodeBMPChar(p, end, *pbuff))
+                *pbuff = DecodeNextCharBounded(p, end);
+            pbuff++;
+        } while (p < end && (*p & 0x80) != 0);
+    }
+    return pbuff - pbegin;
 }
 
 int GetEncodeCharSize(uint32_t ucs_character)
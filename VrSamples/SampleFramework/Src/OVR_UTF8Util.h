@@ -27,11 +27,16 @@ limitations under the License.
 
 #include "VrApi_Types.h"
 #include <string>
+#include <vector>
 
 namespace OVRFW { 
 namespace UTF8Util {
 
 // *** UTF8 string length and indexing.
+//
+// These skip runs of ASCII 16 bytes at a time. When a length is specified, they never
+// read past it; a sequence cut off by the end of the range is treated as if the range
+// were followed by a 0.
 
 // Determines the length of UTF8 string in characters.
 // If source length is specified (in bytes), null 0 character is counted properly.
@@ -46,6 +51,51 @@ uint32_t GetCharAt(intptr_t index, const char* putf8str, intptr_t length = -1);
 intptr_t GetByteIndex(intptr_t index, const char* putf8str, intptr_t length = -1);
 
 
+// Caches the byte offset of every 16th character of a string, so that repeated random
+// access costs at most 16 characters of decoding instead of a scan from the start. The
+// string must not change or be freed while the index is used.
+class ovrUTF8Index
+{
+public:
+    ovrUTF8Index();
+    explicit ovrUTF8Index(const char* putf8str, intptr_t length = -1);
+
+    void     Build(const char* putf8str, intptr_t length = -1);
+
+    intptr_t GetLength() const { return NumChars; }
+    // Returns 0 if index is out of bounds.
+    uint32_t GetCharAt(intptr_t index) const;
+    // Returns the byte length of the string if index is out of bounds.
+    intptr_t GetByteIndex(intptr_t index) const;
+
+private:
+    static const intptr_t CHARS_PER_CHECKPOINT = 16;
+
+    const char*             Str;
+    intptr_t                ByteLength;
+    intptr_t                NumChars;
+    std::vector<intptr_t>   Checkpoints;    // byte offset of every CHARS_PER_CHECKPOINT'th character
+};
+
+
+// *** Bulk UTF8 routines.
+//
+// These work on a byte range of known length and test 16 bytes at a time, so runs of ASCII
+// are handled without decoding each character. They decode exactly as DecodeNextChar_Advance0
+// does, as if the range were followed by a 0.
+
+// Returns true if every byte in the range is 7-bit ASCII.
+bool     IsASCII(const char* putf8str, intptr_t length);
+
+// Returns true if decoding the range never produces U+FFFD for a malformed or overlong
+// sequence and never stops short at a truncated one.
+bool     IsValid(const char* putf8str, intptr_t length);
+
+// Decodes the range into a UTF-32 buffer, which must have room for GetLength( putf8str, length )
+// characters. Returns the number of characters written.
+intptr_t DecodeUTF32(uint32_t* pbuff, const char* putf8str, intptr_t length);
+
+
 // *** 16-bit Unicode string Encoding/Decoding routines.
 
 // Determines the number of bytes necessary to encode a string.
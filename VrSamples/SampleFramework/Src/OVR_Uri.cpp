@@ -120,6 +120,24 @@ bool ovrUri::ParseScheme( char const * uri, char * outScheme, size_t const outSc
 	return ParseUri( uri, outScheme, outSchemeSize, NULL, 0, NULL, 0, NULL, 0, port, NULL, 0, NULL, 0, NULL, 0 );
 }
 
+//==============================
+// ovrUri::ParseUri
+bool ovrUri::ParseUri( char const * uri, ovrParsedUri & outUri )
+{
+	// zeroed because a failed parse can stop without terminating a part
+	char scheme[MAX_URI_SIZE] = {};
+	char host[MAX_URI_SIZE] = {};
+	char path[MAX_URI_SIZE] = {};
+	int port = 0;
+	outUri.Valid = ParseUri( uri, scheme, sizeof( scheme ), NULL, 0, NULL, 0, host, sizeof( host ),
+			port, path, sizeof( path ), NULL, 0, NULL, 0 );
+	outUri.Scheme = scheme;
+	outUri.Host = host;
+	outUri.Path = path;
+	outUri.Port = port;
+	return outUri.Valid;
+}
+
 //==============================
 // EncodeCharToBuffer
 // only returns false if the buffer overflows -- NULL out pointers are just skipped
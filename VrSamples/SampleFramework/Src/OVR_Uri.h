@@ -12,9 +12,26 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 
 #include <stddef.h> // for size_t
 #include <stdint.h>
+#include <string>
 
 namespace OVRFW {
 
+//==============================================================
+// ovrParsedUri
+//
+// The parts of a Uri that the file system needs, so that a Uri can be parsed
+// once and the result passed along instead of every step parsing it again.
+struct ovrParsedUri
+{
+	ovrParsedUri() : Port( 0 ), Valid( false ) {}
+
+	std::string		Scheme;
+	std::string		Host;
+	std::string		Path;
+	int				Port;
+	bool			Valid;	// false if the Uri didn't parse, in which case the parts may be partial
+};
+
 //==============================================================
 // ovrUri
 //
@@ -79,6 +96,9 @@ public:
 	// only a scheme without a path.
 	static bool		ParseScheme( char const * uri, char * outScheme, size_t const outSchemeSize );
 
+	// Parses the scheme, host, port and path.
+	static bool		ParseUri( char const * uri, ovrParsedUri & outUri );
+
 	static bool		IsValidUri( char const * uri );
 
 	static void		DoUnitTest();
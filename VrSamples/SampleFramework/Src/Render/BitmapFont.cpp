@@ -19,6 +19,7 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #include <errno.h>
 #include <math.h>
 #include <sys/stat.h>
+#include <algorithm>
 
 #include "OVR_UTF8Util.h"
 #include "OVR_JSON.h"
@@ -1124,8 +1125,8 @@ bool FontInfoType::Load( ovrFileSys & fileSys, char const * uri )
 bool FontInfoType::LoadFromBuffer( void const * buffer, size_t const bufferSize )
 {
 	char const * errorMsg = NULL;
-	std::shared_ptr<OVR::JSON> jsonRoot = OVR::JSON::Parse( reinterpret_cast< char const * >( buffer ), &errorMsg );
-	if ( jsonRoot == NULL )
+	OVR::JsonDocument jsonRoot;
+	if ( !jsonRoot.Parse( reinterpret_cast< char const * >( buffer ), bufferSize, &errorMsg ) )
 	{
 		OVR_WARN( "OVR::JSON Error: %s", ( errorMsg != NULL ) ? errorMsg : "<NULL>" );
 		ALOG( "FontInfoType::LoadFromBuffer FAIL OVR::JSON ERROR = '%s' ", ( errorMsg != NULL ) ? errorMsg : "<NULL>" );
@@ -1635,6 +1636,29 @@ void BitmapFontLocal::GetGlyphMetrics( const uint32_t charCode, float &width,
     advanceY = glyph.AdvanceY;
 }
 
+//==============================
+// IsPostLineBreakChar
+// Returns true for characters after which a line can be broken.
+static bool IsPostLineBreakChar( uint32_t const ch )
+{
+	// array of characters after which we can add line breaks.
+	uint32_t const postLineBreakChars[] =
+	{
+		',', '.', ':', ';', '>', '!', '?', ')', ']', '-', '=', '+', '*', '\\', '/',
+		0x3002,	// Chinese 'full-stop
+		'\0' // list terminator
+	};
+
+	for ( int i = 0; postLineBreakChars[i] != 0; ++i )
+	{
+		if ( ch == postLineBreakChars[i] )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 //==============================
 // BitmapFontLocal::WordWrapText
 bool BitmapFontLocal::WordWrapText( std::string & inOutText, const float widthMeters, const float fontScale ) const
@@ -1661,26 +1685,6 @@ bool BitmapFontLocal::WordWrapText( std::string & inOutText, const float widthMe
 	// so it may grow larger than the original string.
 	// While determining the length of the string, find any characters that may potentially have a line
 	// break added after them and increase the string length by 1 for each.
-	auto IsPostLineBreakChar = [] ( uint32_t const ch )
-	{
-		// array of characters after which we can add line breaks.
-		uint32_t const postLineBreakChars[] =
-		{
-			',', '.', ':', ';', '>', '!', '?', ')', ']', '-', '=', '+', '*', '\\', '/',
-			0x3002,	// Chinese 'full-stop
-			'\0' // list terminator
-		};
-
-		for ( int i = 0; postLineBreakChars[i] != 0; ++i )
-		{
-			if ( ch == postLineBreakChars[i] )
-			{
-				return true;
-			}
-		}
-		return false;
-	};
-
 	size_t lengthInBytes = 0;
 	char const * cur = source;
 	for ( ; ; )
@@ -1898,9 +1902,11 @@ float BitmapFontLocal::GetFirstFitChars( std::string & inOutText, const float wi
 	float lineWidth = 0.0f;
 	int remainingLines = numLines;
 
+	// GetCharAt on the string itself would scan from the start for every character
+	UTF8Util::ovrUTF8Index const charIndex( inOutText.c_str() );
 	for ( int32_t pos = 0; pos < static_cast< int32_t >( inOutText.length() ); ++pos )
 	{
-		uint32_t charCode = UTF8Util::GetCharAt( pos, inOutText.c_str() );
+		uint32_t charCode = charIndex.GetCharAt( pos );
 		if ( charCode == '\n' )
 		{
 			remainingLines--;
@@ -1935,9 +1941,10 @@ float BitmapFontLocal::GetLastFitChars( std::string & inOutText, const float wid
 	float const xScale = FontInfo.ScaleFactorX * fontScale;
 	float lineWidth = 0.0f;
 
+	UTF8Util::ovrUTF8Index const charIndex( inOutText.c_str() );
 	for ( int32_t pos = static_cast< int32_t >( inOutText.length() ) - 1; pos >= 0; --pos )
 	{
-		uint32_t charCode = UTF8Util::GetCharAt( pos, inOutText.c_str() );
+		uint32_t charCode = charIndex.GetCharAt( pos );
 		FontGlyphType const & glyph = GlyphForCharCode( charCode );
 		lineWidth += glyph.AdvanceX * xScale;
 		if ( lineWidth > widthMeters )
@@ -2136,6 +2143,357 @@ void BitmapFontLocal::TruncateText( std::string & inOutText, int const maxLines
 
 }
 
+//==================================================================================================
+// ovrWordWrapper
+//==================================================================================================
+
+//==============================
+// ovrWordWrapper::ovrWordWrapper
+ovrWordWrapper::ovrWordWrapper()
+	: Font( nullptr )
+	, WidthMeters( 0.0f )
+	, FontScale( 1.0f )
+{
+}
+
+//==============================
+// ovrWordWrapper::SetFont
+void ovrWordWrapper::SetFont( BitmapFont const & font, float const widthMeters, float const fontScale )
+{
+	if ( Font == &font && WidthMeters == widthMeters && FontScale == fontScale )
+	{
+		return;
+	}
+	Font = &font;
+	WidthMeters = widthMeters;
+	FontScale = fontScale;
+
+	Glyphs.clear();
+	for ( size_t offset = 0; offset < Text.size(); )
+	{
+		ovrGlyph glyph;
+		MeasureGlyph( offset, glyph );
+		Glyphs.push_back( glyph );
+		offset += glyph.Size;
+	}
+
+	Lines.clear();
+	LineGlyphs.clear();
+	Reflow( 0, 0, 0, 0 );
+}
+
+//==============================
+// ovrWordWrapper::SetText
+void ovrWordWrapper::SetText( char const * text )
+{
+	size_t const length = strlen( text );
+	size_t const maxCommon = std::min( length, Text.size() );
+
+	size_t prefix = 0;
+	while ( prefix < maxCommon && Text[prefix] == text[prefix] )
+	{
+		prefix++;
+	}
+	if ( prefix == length && prefix == Text.size() )
+	{
+		return;
+	}
+	size_t suffix = 0;
+	while ( suffix < maxCommon - prefix && Text[Text.size() - 1 - suffix] == text[length - 1 - suffix] )
+	{
+		suffix++;
+	}
+
+	ReplaceText( prefix, Text.size() - prefix - suffix, text + prefix, length - prefix - suffix );
+}
+
+//==============================
+// ovrWordWrapper::ReplaceText
+void ovrWordWrapper::ReplaceText( size_t const byteOffset, size_t const numBytes, char const * text, size_t const textLength )
+{
+	size_t const offset = std::min( byteOffset, Text.size() );
+	size_t const count = std::min( numBytes, Text.size() - offset );
+	Text.replace( offset, count, text, textLength );
+	if ( Font == nullptr )
+	{
+		return;	// measured when the font is set
+	}
+
+	// An escape sequence can start up to a few bytes before the edit and be completed or broken
+	// by it, so measuring starts at a glyph a little before the edit.
+	size_t const MAX_ESCAPE_BYTES = 16;
+	size_t const measureFrom = offset > MAX_ESCAPE_BYTES ? offset - MAX_ESCAPE_BYTES : 0;
+	uint32_t firstGlyph = static_cast< uint32_t >( std::upper_bound( Glyphs.begin(), Glyphs.end(), measureFrom,
+			[]( size_t const o, ovrGlyph const & glyph ) { return o < glyph.Offset; } ) - Glyphs.begin() );
+	firstGlyph = firstGlyph > 0 ? firstGlyph - 1 : 0;
+
+	// Measure until a glyph starts on a byte after the edit where an old glyph also started. From
+	// there on the text is unchanged, so its glyphs are too.
+	ptrdiff_t const byteDelta = static_cast< ptrdiff_t >( textLength ) - static_cast< ptrdiff_t >( count );
+	size_t const editEnd = offset + textLength;
+	uint32_t oldGlyph = firstGlyph;
+	std::vector< ovrGlyph > newGlyphs;
+	size_t cur = firstGlyph < Glyphs.size() ? Glyphs[firstGlyph].Offset : 0;
+	for ( ; ; )
+	{
+		if ( cur >= editEnd )
+		{
+			while ( oldGlyph < Glyphs.size() && static_cast< ptrdiff_t >( Glyphs[oldGlyph].Offset ) + byteDelta < static_cast< ptrdiff_t >( cur ) )
+			{
+				oldGlyph++;
+			}
+			if ( oldGlyph < Glyphs.size() && static_cast< ptrdiff_t >( Glyphs[oldGlyph].Offset ) + byteDelta == static_cast< ptrdiff_t >( cur ) )
+			{
+				break;
+			}
+		}
+		if ( cur >= Text.size() )
+		{
+			oldGlyph = static_cast< uint32_t >( Glyphs.size() );
+			break;
+		}
+		ovrGlyph glyph;
+		MeasureGlyph( cur, glyph );
+		newGlyphs.push_back( glyph );
+		cur += glyph.Size;
+	}
+
+	for ( size_t i = oldGlyph; i < Glyphs.size(); ++i )
+	{
+		Glyphs[i].Offset = static_cast< uint32_t >( Glyphs[i].Offset + byteDelta );
+	}
+	Glyphs.erase( Glyphs.begin() + firstGlyph, Glyphs.begin() + oldGlyph );
+	Glyphs.insert( Glyphs.begin() + firstGlyph, newGlyphs.begin(), newGlyphs.end() );
+
+	Reflow( firstGlyph, oldGlyph, firstGlyph + static_cast< uint32_t >( newGlyphs.size() ), byteDelta );
+}
+
+//==============================
+// ovrWordWrapper::MeasureGlyph
+void ovrWordWrapper::MeasureGlyph( size_t const offset, ovrGlyph & glyph ) const
+{
+	char const * start = Text.c_str() + offset;
+	char const * p = start;
+
+	glyph.Offset = static_cast< uint32_t >( offset );
+	glyph.Advance = 0.0f;
+
+	uint32_t color;
+	uint32_t weight;
+	if ( CheckForFormatEscape( &p, color, weight ) )
+	{
+		glyph.Type = GLYPH_FORMAT;
+		glyph.Size = static_cast< uint8_t >( p - start );
+		return;
+	}
+
+	uint32_t charCode = UTF8Util::DecodeNextChar_Advance0( &p );
+	if ( charCode == '\\' && ( *p == 'n' || *p == 'r' ) )
+	{
+		p++;
+		glyph.Type = GLYPH_LINE_BREAK;
+	}
+	else if ( charCode == '\r' || charCode == '\n' )
+	{
+		glyph.Type = GLYPH_LINE_BREAK;
+	}
+	else
+	{
+		if ( charCode == '\t' )
+		{
+			charCode = ' ';
+		}
+		glyph.Type = charCode == ' ' ? GLYPH_SPACE : ( IsPostLineBreakChar( charCode ) ? GLYPH_POST_BREAK : GLYPH_NORMAL );
+		if ( charCode != '\0' )
+		{
+			float width;
+			float height;
+			float advanceX;
+			float advanceY;
+			Font->GetGlyphMetrics( charCode, width, height, advanceX, advanceY );
+			glyph.Advance = advanceX * Font->GetScaleFactor().x * FontScale;
+		}
+	}
+	glyph.Size = static_cast< uint8_t >( p - start );
+}
+
+//==============================
+// ovrWordWrapper::FlowLine
+// Lays out the line starting at firstGlyph and returns the first glyph of the next line. more is
+// set to false if this is the last line.
+uint32_t ovrWordWrapper::FlowLine( uint32_t const firstGlyph, ovrLine & line, bool & more ) const
+{
+	uint32_t const numGlyphs = static_cast< uint32_t >( Glyphs.size() );
+	if ( firstGlyph >= numGlyphs )
+	{
+		// empty line after a break at the end of the text
+		line.Start = line.End = Text.size();
+		line.Width = 0.0f;
+		more = false;
+		return numGlyphs;
+	}
+
+	double width = 0.0;
+	bool hasChars = false;
+	int64_t lastSpace = -1;
+	int64_t lastPostBreak = -1;
+	double widthAtSpace = 0.0;
+	double widthAtPostBreak = 0.0;
+
+	uint32_t end = numGlyphs;	// glyph the line ends before
+	uint32_t next = numGlyphs;	// first glyph of the next line
+	for ( uint32_t g = firstGlyph; g < numGlyphs; ++g )
+	{
+		ovrGlyph const & glyph = Glyphs[g];
+		if ( glyph.Type == GLYPH_LINE_BREAK )
+		{
+			end = g;
+			next = g + 1;
+			break;
+		}
+		if ( glyph.Type == GLYPH_FORMAT )
+		{
+			continue;
+		}
+		if ( glyph.Type == GLYPH_SPACE )
+		{
+			lastSpace = g;
+			widthAtSpace = width;
+		}
+
+		if ( WidthMeters > 0.0f && hasChars && width + glyph.Advance >= WidthMeters )
+		{
+			if ( glyph.Type == GLYPH_SPACE )
+			{
+				// the break replaces this space
+				end = g;
+				next = g + 1;
+			}
+			else if ( lastSpace >= 0 && lastSpace > lastPostBreak )
+			{
+				end = static_cast< uint32_t >( lastSpace );
+				next = end + 1;
+				width = widthAtSpace;
+			}
+			else if ( lastPostBreak >= 0 )
+			{
+				end = next = static_cast< uint32_t >( lastPostBreak + 1 );
+				width = widthAtPostBreak;
+			}
+			else
+			{
+				// no place to break, so break before this character
+				end = next = g;
+			}
+			break;
+		}
+
+		width += glyph.Advance;
+		hasChars = true;
+		if ( glyph.Type == GLYPH_POST_BREAK )
+		{
+			lastPostBreak = g;
+			widthAtPostBreak = width;
+		}
+	}
+
+	line.Start = Glyphs[firstGlyph].Offset;
+	line.End = end < numGlyphs ? Glyphs[end].Offset : Text.size();
+	line.Width = static_cast< float >( width );
+	// a line break at the very end starts one more, empty line
+	more = next < numGlyphs || end < numGlyphs;
+	return next;
+}
+
+//==============================
+// ovrWordWrapper::Reflow
+// Re-flows lines after the glyphs before oldEndGlyph, from firstGlyph on, were replaced by the
+// glyphs before newEndGlyph.
+void ovrWordWrapper::Reflow( uint32_t const firstGlyph, uint32_t const oldEndGlyph, uint32_t const newEndGlyph, ptrdiff_t const byteDelta )
+{
+	ptrdiff_t const glyphDelta = static_cast< ptrdiff_t >( newEndGlyph ) - static_cast< ptrdiff_t >( oldEndGlyph );
+
+	// Where the line before the edited one breaks depends on the glyph that overflowed it, which
+	// is on the edited line, so start from the line before.
+	size_t firstLine = std::upper_bound( LineGlyphs.begin(), LineGlyphs.end(), firstGlyph ) - LineGlyphs.begin();
+	firstLine = firstLine > 1 ? firstLine - 2 : 0;
+
+	// A line that starts on an unchanged glyph after the edit is laid out exactly as it was
+	// before, and so are all the lines after it.
+	size_t oldLine = std::lower_bound( LineGlyphs.begin() + firstLine, LineGlyphs.end(), oldEndGlyph ) - LineGlyphs.begin();
+	size_t resyncLine = Lines.size();
+
+	std::vector< ovrLine > newLines;
+	std::vector< uint32_t > newLineGlyphs;
+	uint32_t g = firstLine < LineGlyphs.size() ? LineGlyphs[firstLine] : 0;
+	bool more = !Glyphs.empty();
+	while ( more )
+	{
+		if ( g >= newEndGlyph )
+		{
+			while ( oldLine < Lines.size() && static_cast< ptrdiff_t >( LineGlyphs[oldLine] ) + glyphDelta < static_cast< ptrdiff_t >( g ) )
+			{
+				oldLine++;
+			}
+			if ( oldLine < Lines.size() && static_cast< ptrdiff_t >( LineGlyphs[oldLine] ) + glyphDelta == static_cast< ptrdiff_t >( g ) )
+			{
+				resyncLine = oldLine;
+				break;
+			}
+		}
+		ovrLine line;
+		newLineGlyphs.push_back( g );
+		g = FlowLine( g, line, more );
+		newLines.push_back( line );
+	}
+
+	for ( size_t i = resyncLine; i < Lines.size(); ++i )
+	{
+		LineGlyphs[i] = static_cast< uint32_t >( LineGlyphs[i] + glyphDelta );
+		Lines[i].Start += byteDelta;
+		Lines[i].End += byteDelta;
+	}
+	Lines.erase( Lines.begin() + firstLine, Lines.begin() + resyncLine );
+	Lines.insert( Lines.begin() + firstLine, newLines.begin(), newLines.end() );
+	LineGlyphs.erase( LineGlyphs.begin() + firstLine, LineGlyphs.begin() + resyncLine );
+	LineGlyphs.insert( LineGlyphs.begin() + firstLine, newLineGlyphs.begin(), newLineGlyphs.end() );
+}
+
+//==============================
+// ovrWordWrapper::GetWrappedText
+void ovrWordWrapper::GetWrappedText( std::string & out ) const
+{
+	out.clear();
+	out.reserve( Text.size() + Lines.size() );
+	for ( size_t i = 0; i < Lines.size(); ++i )
+	{
+		if ( i > 0 )
+		{
+			out += '\n';
+		}
+		out.append( Text, Lines[i].Start, Lines[i].End - Lines[i].Start );
+	}
+}
+
+//==============================
+// ovrWordWrapper::GetLastFitOffset
+size_t ovrWordWrapper::GetLastFitOffset( float const widthMeters, float & remainingWidth ) const
+{
+	float width = 0.0f;
+	for ( size_t g = Glyphs.size(); g-- > 0; )
+	{
+		width += Glyphs[g].Advance;
+		if ( width > widthMeters )
+		{
+			remainingWidth = widthMeters - ( width - Glyphs[g].Advance );
+			return g + 1 < Glyphs.size() ? Glyphs[g + 1].Offset : Text.size();
+		}
+	}
+	// the whole text fits
+	remainingWidth = 0.0f;
+	return 0;
+}
+
 //==================================================================================================
 // BitmapFontSurfaceLocal
 //==================================================================================================
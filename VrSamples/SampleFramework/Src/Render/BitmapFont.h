@@ -115,6 +115,88 @@ protected:
     virtual ~BitmapFont() { }
 };
 
+//==============================================================
+// ovrWordWrapper
+//
+// Word wraps text that is edited over and over, such as a text field or a
+// scrolling text panel. The advance and break type of each character are
+// measured once and kept, so an edit only measures the characters that
+// changed. Lines are re-flowed from the line before the edit until they
+// line up with the old lines again. Lines are returned as byte ranges of
+// the text instead of as copies.
+//
+// Breaks follow the same rules as BitmapFont::WordWrapText: a line is
+// broken at its last space, or after its last punctuation, before the
+// character that would make it reach the wrap width. If there is neither,
+// it is broken before that character. '\n', '\r' and the escapes "\\n" and
+// "\\r" always break. Unlike WordWrapText, each line is measured from its
+// own first character, and a line never exceeds the wrap width unless a
+// single character does.
+//==============================================================
+class ovrWordWrapper
+{
+public:
+	struct ovrLine
+	{
+		size_t	Start;	// byte offset of the first character of the line
+		size_t	End;	// byte offset past the last character, not counting the break
+		float	Width;	// in meters, including the font scale
+	};
+
+	ovrWordWrapper();
+
+	// Changing any of these re-measures all of the text. A widthMeters <= 0 only breaks lines at
+	// explicit line breaks.
+	void							SetFont( BitmapFont const & font, float const widthMeters, float const fontScale = 1.0f );
+
+	// Replaces the text. Only the bytes that differ from the current text are treated as edited.
+	void							SetText( char const * text );
+	// Replaces numBytes bytes at byteOffset with text.
+	void							ReplaceText( size_t const byteOffset, size_t const numBytes, char const * text, size_t const textLength );
+
+	std::string const &				GetText() const { return Text; }
+	std::vector< ovrLine > const &	GetLines() const { return Lines; }
+
+	// Copies the text with each line ended by a '\n', the form WordWrapText produces.
+	void							GetWrappedText( std::string & out ) const;
+
+	// Returns the byte offset of the longest tail of the text that fits in widthMeters, ignoring
+	// line breaks, and sets remainingWidth to the part of the next character that would have
+	// fit. Returns 0 and sets remainingWidth to 0 if the whole text fits. This is what
+	// BitmapFont::GetLastFitChars returns, without measuring the text again.
+	size_t							GetLastFitOffset( float const widthMeters, float & remainingWidth ) const;
+
+private:
+	enum ovrGlyphType
+	{
+		GLYPH_NORMAL,
+		GLYPH_SPACE,		// a line can be broken here, and the break replaces it
+		GLYPH_POST_BREAK,	// a line can be broken after this
+		GLYPH_LINE_BREAK,	// always breaks the line
+		GLYPH_FORMAT		// a color or weight escape, which has no width
+	};
+
+	struct ovrGlyph
+	{
+		uint32_t		Offset;		// byte offset in Text
+		float			Advance;	// in meters, including the font scale
+		uint8_t			Size;		// in bytes
+		uint8_t			Type;		// ovrGlyphType
+	};
+
+	BitmapFont const *		Font;
+	float					WidthMeters;
+	float					FontScale;
+	std::string				Text;
+	std::vector< ovrGlyph >	Glyphs;
+	std::vector< ovrLine >	Lines;
+	std::vector< uint32_t >	LineGlyphs;	// index of the first glyph of each line
+
+	void		MeasureGlyph( size_t const offset, ovrGlyph & glyph ) const;
+	uint32_t	FlowLine( uint32_t const firstGlyph, ovrLine & line, bool & more ) const;
+	void		Reflow( uint32_t const firstGlyph, uint32_t const oldEndGlyph, uint32_t const newEndGlyph, ptrdiff_t const byteDelta );
+};
+
 //==============================================================
 // BitmapFontSurface
 class BitmapFontSurface
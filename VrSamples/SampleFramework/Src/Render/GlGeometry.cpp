@@ -51,10 +51,42 @@ void PackVertexAttribute( std::vector< uint8_t > & packed, const std::vector< _a
 	}
 }
 
+template< typename _attrib_type_ >
+void UploadVertexAttribute( size_t & offset, const GeometrySpan< _attrib_type_ > & attrib,
+				const int glLocation, const int glType, const int glComponents )
+{
+	if ( attrib.Count > 0 )
+	{
+		const size_t size = attrib.Count * sizeof( attrib.Data[0] );
+
+		glBufferSubData( GL_ARRAY_BUFFER, offset, size, attrib.Data );
+
+		glEnableVertexAttribArray( glLocation );
+		glVertexAttribPointer( glLocation, glComponents, glType, false, sizeof( attrib.Data[0] ), (void *)( offset ) );
+
+		offset += size;
+	}
+	else
+	{
+		glDisableVertexAttribArray( glLocation );
+	}
+}
+
+template< typename _attrib_type_ >
+size_t VertexAttributeSize( const GeometrySpan< _attrib_type_ > & attrib )
+{
+	return ( attrib.Count > 0 ) ? attrib.Count * sizeof( attrib.Data[0] ) : 0;
+}
+
 void GlGeometry::Create( const VertexAttribs & attribs, const std::vector< TriangleIndex > & indices )
 {
-	vertexCount = attribs.position.size();
-	indexCount = indices.size();
+	Create( VertexAttribSpans( attribs ), GeometrySpan< TriangleIndex >( indices ) );
+}
+
+void GlGeometry::Create( const VertexAttribSpans & attribs, const GeometrySpan< TriangleIndex > & indices )
+{
+	vertexCount = attribs.position.Count;
+	indexCount = indices.Count;
 
 	glGenBuffers( 1, &vertexBuffer );
 	glGenBuffers( 1, &indexBuffer );
@@ -62,21 +94,32 @@ void GlGeometry::Create( const VertexAttribs & attribs, const std::vector< Trian
 	glBindVertexArray( vertexArrayObject );
 	glBindBuffer( GL_ARRAY_BUFFER, vertexBuffer );
 
-	std::vector< uint8_t > packed;
-	PackVertexAttribute( packed, attribs.position,		VERTEX_ATTRIBUTE_LOCATION_POSITION,			GL_FLOAT,	3 );
-	PackVertexAttribute( packed, attribs.normal,		VERTEX_ATTRIBUTE_LOCATION_NORMAL,			GL_FLOAT,	3 );
-	PackVertexAttribute( packed, attribs.tangent,		VERTEX_ATTRIBUTE_LOCATION_TANGENT,			GL_FLOAT,	3 );
-	PackVertexAttribute( packed, attribs.binormal,		VERTEX_ATTRIBUTE_LOCATION_BINORMAL,			GL_FLOAT,	3 );
-	PackVertexAttribute( packed, attribs.color,			VERTEX_ATTRIBUTE_LOCATION_COLOR,			GL_FLOAT,	4 );
-	PackVertexAttribute( packed, attribs.uv0,			VERTEX_ATTRIBUTE_LOCATION_UV0,				GL_FLOAT,	2 );
-	PackVertexAttribute( packed, attribs.uv1,			VERTEX_ATTRIBUTE_LOCATION_UV1,				GL_FLOAT,	2 );
-	PackVertexAttribute( packed, attribs.jointIndices,	VERTEX_ATTRIBUTE_LOCATION_JOINT_INDICES,	GL_INT,		4 );
-	PackVertexAttribute( packed, attribs.jointWeights,	VERTEX_ATTRIBUTE_LOCATION_JOINT_WEIGHTS,	GL_FLOAT,	4 );
-
-	glBufferData( GL_ARRAY_BUFFER, packed.size() * sizeof( packed[0] ), packed.data(), GL_STATIC_DRAW );
+	const size_t vertexBufferSize =
+		VertexAttributeSize( attribs.position ) +
+		VertexAttributeSize( attribs.normal ) +
+		VertexAttributeSize( attribs.tangent ) +
+		VertexAttributeSize( attribs.binormal ) +
+		VertexAttributeSize( attribs.color ) +
+		VertexAttributeSize( attribs.uv0 ) +
+		VertexAttributeSize( attribs.uv1 ) +
+		VertexAttributeSize( attribs.jointIndices ) +
+		VertexAttributeSize( attribs.jointWeights );
+
+	glBufferData( GL_ARRAY_BUFFER, vertexBufferSize, nullptr, GL_STATIC_DRAW );
+
+	size_t offset = 0;
+	UploadVertexAttribute( offset, attribs.position,		VERTEX_ATTRIBUTE_LOCATION_POSITION,			GL_FLOAT,	3 );
+	UploadVertexAttribute( offset, attribs.normal,			VERTEX_ATTRIBUTE_LOCATION_NORMAL,			GL_FLOAT,	3 );
+	UploadVertexAttribute( offset, attribs.tangent,			VERTEX_ATTRIBUTE_LOCATION_TANGENT,			GL_FLOAT,	3 );
+	UploadVertexAttribute( offset, attribs.binormal,		VERTEX_ATTRIBUTE_LOCATION_BINORMAL,			GL_FLOAT,	3 );
+	UploadVertexAttribute( offset, attribs.color,			VERTEX_ATTRIBUTE_LOCATION_COLOR,			GL_FLOAT,	4 );
+	UploadVertexAttribute( offset, attribs.uv0,				VERTEX_ATTRIBUTE_LOCATION_UV0,				GL_FLOAT,	2 );
+	UploadVertexAttribute( offset, attribs.uv1,				VERTEX_ATTRIBUTE_LOCATION_UV1,				GL_FLOAT,	2 );
+	UploadVertexAttribute( offset, attribs.jointIndices,	VERTEX_ATTRIBUTE_LOCATION_JOINT_INDICES,	GL_INT,		4 );
+	UploadVertexAttribute( offset, attribs.jointWeights,	VERTEX_ATTRIBUTE_LOCATION_JOINT_WEIGHTS,	GL_FLOAT,	4 );
 
 	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, indexBuffer );
-	glBufferData( GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof( indices[0] ), indices.data(), GL_STATIC_DRAW );
+	glBufferData( GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof( TriangleIndex ), indices.Data, GL_STATIC_DRAW );
 
 	glBindVertexArray( 0 );
 
@@ -93,7 +136,7 @@ void GlGeometry::Create( const VertexAttribs & attribs, const std::vector< Trian
 	localBounds.Clear();
 	for ( int i = 0; i < vertexCount; i++ )
 	{
-		localBounds.AddPoint( attribs.position[i] );
+		localBounds.AddPoint( attribs.position.Data[i] );
 	}
 }
 
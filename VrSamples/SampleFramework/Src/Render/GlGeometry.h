@@ -31,6 +31,45 @@ struct VertexAttribs
 	std::vector< OVR::Vector4f > jointWeights;
 };
 
+// An array of vertex attributes or indices held elsewhere, for instance in a mapped
+// model file, so it can be uploaded without first being copied into a vector.
+template< typename _type_ >
+struct GeometrySpan
+{
+	GeometrySpan() : Data( nullptr ), Count( 0 ) {}
+	GeometrySpan( const _type_ * data, const int count ) : Data( data ), Count( count ) {}
+	GeometrySpan( const std::vector< _type_ > & v ) : Data( v.data() ), Count( static_cast< int >( v.size() ) ) {}
+
+	const _type_ *	Data;
+	int				Count;
+};
+
+// VertexAttribs by reference. Attributes with a zero count are not used.
+struct VertexAttribSpans
+{
+	VertexAttribSpans() {}
+	explicit VertexAttribSpans( const VertexAttribs & attribs ) :
+		position( attribs.position ),
+		normal( attribs.normal ),
+		tangent( attribs.tangent ),
+		binormal( attribs.binormal ),
+		color( attribs.color ),
+		uv0( attribs.uv0 ),
+		uv1( attribs.uv1 ),
+		jointIndices( attribs.jointIndices ),
+		jointWeights( attribs.jointWeights ) {}
+
+	GeometrySpan< OVR::Vector3f > position;
+	GeometrySpan< OVR::Vector3f > normal;
+	GeometrySpan< OVR::Vector3f > tangent;
+	GeometrySpan< OVR::Vector3f > binormal;
+	GeometrySpan< OVR::Vector4f > color;
+	GeometrySpan< OVR::Vector2f > uv0;
+	GeometrySpan< OVR::Vector2f > uv1;
+	GeometrySpan< OVR::Vector4i > jointIndices;
+	GeometrySpan< OVR::Vector4f > jointWeights;
+};
+
 typedef uint16_t TriangleIndex;
 
 class GlGeometry
@@ -56,6 +95,9 @@ public:
 
 	// Create the VAO and vertex and index buffers from arrays of data.
 	void	Create( const VertexAttribs & attribs, const std::vector< TriangleIndex > & indices );
+	// Each attribute is uploaded straight from where it is, without packing the vertices
+	// into a temporary buffer first.
+	void	Create( const VertexAttribSpans & attribs, const GeometrySpan< TriangleIndex > & indices );
 	void	Update( const VertexAttribs & attribs, const bool updateBounds = true );
 
 	// Free the buffers and VAO, assuming that they are strictly for this geometry.
@@ -964,6 +964,12 @@ GlTexture LoadRGBATextureFromMemory( const uint8_t * texture, const int width, c
 	return CreateGlTexture( "memory-RGBA", Texture_RGBA, width, height, texture, dataSize, 1, useSrgbFormat, false );
 }
 
+GlTexture LoadRGBATextureMipsFromMemory( const uint8_t * levels, const size_t levelsSize, const int width, const int height,
+		const int numLevels, const bool useSrgbFormat )
+{
+	return CreateGlTexture( "memory-RGBA-mips", Texture_RGBA, width, height, levels, levelsSize, numLevels, useSrgbFormat, false );
+}
+
 GlTexture LoadRGBACubeTextureFromMemory( const uint8_t * texture, const int dim, const bool useSrgbFormat )
 {
 	const size_t dataSize = GetOvrTextureSize( Texture_RGBA, dim, dim ) * 6;
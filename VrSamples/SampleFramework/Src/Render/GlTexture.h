@@ -149,6 +149,9 @@ int	 ComputeFullMipChainNumLevels( const int width, const int height );
 
 // Allocates a GPU texture and uploads the raw data.
 GlTexture	LoadRGBATextureFromMemory( const uint8_t * texture, const int width, const int height, const bool useSrgbFormat );
+// Uploads a packed RGBA mip chain (largest level first, each level half the size of the previous).
+GlTexture	LoadRGBATextureMipsFromMemory( const uint8_t * levels, const size_t levelsSize, const int width, const int height,
+				const int numLevels, const bool useSrgbFormat );
 GlTexture	LoadRGBACubeTextureFromMemory( const uint8_t * texture, const int dim, const bool useSrgbFormat );
 GlTexture	LoadRGBTextureFromMemory( const uint8_t * texture, const int width, const int height, const bool useSrgbFormat );
 GlTexture	LoadRTextureFromMemory( const uint8_t * texture, const int width, const int height );
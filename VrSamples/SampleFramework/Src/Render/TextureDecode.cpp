@@ -0,0 +1,252 @@
+/************************************************************************************
+
+Filename    :   TextureDecode.cpp
+Content     :   GL-independent image decoding and mip generation.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include "TextureDecode.h"
+
+#include "stb_image.h"
+
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+
+namespace OVRFW {
+
+//==============================
+// IsDecodableImageFile
+bool IsDecodableImageFile( const char * fileName )
+{
+	if ( fileName == nullptr )
+	{
+		return false;
+	}
+	const char * ext = strrchr( fileName, '.' );
+	if ( ext == nullptr || strlen( ext ) != 4 )
+	{
+		return false;
+	}
+	char lower[5];
+	for ( int i = 0; i < 5; ++i )
+	{
+		lower[i] = static_cast< char >( tolower( static_cast< unsigned char >( ext[i] ) ) );
+	}
+
+	static const char * const extensions[] = { ".jpg", ".tga", ".png", ".bmp", ".psd", ".gif", ".hdr", ".pic" };
+	for ( const char * e : extensions )
+	{
+		if ( strcmp( lower, e ) == 0 )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//==============================
+// DecodeImageRGBA
+bool DecodeImageRGBA( const char * fileName, const uint8_t * buffer, const size_t bufferSize,
+		const bool alphaBorder, ovrDecodedImage & image )
+{
+	image = ovrDecodedImage();
+
+	if ( buffer == nullptr || bufferSize < 1 || !IsDecodableImageFile( fileName ) )
+	{
+		return false;
+	}
+
+	int width = 0;
+	int height = 0;
+	int comp = 0;
+	stbi_uc * pixels = stbi_load_from_memory( buffer, static_cast< int >( bufferSize ), &width, &height, &comp, 4 );
+	if ( pixels == nullptr )
+	{
+		return false;
+	}
+
+	image.Width = width;
+	image.Height = height;
+	image.NumLevels = 1;
+	image.Data.assign( pixels, pixels + static_cast< size_t >( width ) * height * 4 );
+	stbi_image_free( pixels );
+
+	if ( alphaBorder )
+	{
+		uint8_t * p = image.Data.data();
+		for ( int i = 0; i < width; i++ )
+		{
+			p[i * 4 + 3] = 0;
+			p[( ( height - 1 ) * width + i ) * 4 + 3] = 0;
+		}
+		for ( int i = 0; i < height; i++ )
+		{
+			p[i * width * 4 + 3] = 0;
+			p[( i * width + width - 1 ) * 4 + 3] = 0;
+		}
+	}
+	return true;
+}
+
+//==============================
+// MipLevelsForImageSize
+int MipLevelsForImageSize( int width, int height )
+{
+	int levels = 1;
+	while ( width > 1 || height > 1 )
+	{
+		levels++;
+		width >>= 1;
+		height >>= 1;
+	}
+	return levels;
+}
+
+//==============================
+// RGBAMipChainSize
+size_t RGBAMipChainSize( int width, int height, const int numLevels )
+{
+	size_t size = 0;
+	for ( int i = 0; i < numLevels; ++i )
+	{
+		size += static_cast< size_t >( width ) * height * 4;
+		width = width > 1 ? width >> 1 : 1;
+		height = height > 1 ? height >> 1 : 1;
+	}
+	return size;
+}
+
+//==============================
+// BuildBoxFilteredMips
+void BuildBoxFilteredMips( ovrDecodedImage & image )
+{
+	if ( image.NumLevels != 1 || image.Width <= 0 || image.Height <= 0 )
+	{
+		return;
+	}
+
+	const int numLevels = MipLevelsForImageSize( image.Width, image.Height );
+	image.Data.resize( RGBAMipChainSize( image.Width, image.Height, numLevels ) );
+
+	size_t srcOffset = 0;
+	int srcW = image.Width;
+	int srcH = image.Height;
+	for ( int level = 1; level < numLevels; ++level )
+	{
+		const int dstW = srcW > 1 ? srcW >> 1 : 1;
+		const int dstH = srcH > 1 ? srcH >> 1 : 1;
+		const size_t dstOffset = srcOffset + static_cast< size_t >( srcW ) * srcH * 4;
+
+		const uint8_t * src = image.Data.data() + srcOffset;
+		uint8_t * dst = image.Data.data() + dstOffset;
+
+		for ( int y = 0; y < dstH; ++y )
+		{
+			// clamp so 1-pixel wide or tall sources reuse the same row / column
+			const uint8_t * row0 = src + static_cast< size_t >( y * 2 ) * srcW * 4;
+			const uint8_t * row1 = src + static_cast< size_t >( y * 2 + 1 < srcH ? y * 2 + 1 : y * 2 ) * srcW * 4;
+			uint8_t * out = dst + static_cast< size_t >( y ) * dstW * 4;
+			for ( int x = 0; x < dstW; ++x )
+			{
+				const int x0 = x * 2 * 4;
+				const int x1 = ( x * 2 + 1 < srcW ? x * 2 + 1 : x * 2 ) * 4;
+				for ( int c = 0; c < 4; ++c )
+				{
+					const int sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+					out[x * 4 + c] = static_cast< uint8_t >( ( sum + 2 ) >> 2 );
+				}
+			}
+		}
+
+		srcOffset = dstOffset;
+		srcW = dstW;
+		srcH = dstH;
+	}
+	image.NumLevels = numLevels;
+}
+
+//==============================
+// BoxDownsampleRGBA
+void BoxDownsampleRGBA( uint8_t * image, const int width, const int height, const int factor )
+{
+	if ( image == nullptr || factor < 2 )
+	{
+		return;
+	}
+
+	const int dstW = width / factor;
+	const int dstH = height / factor;
+	const int count = factor * factor;
+	// Each box starts at or after the pixel it is written to, and all of it is read
+	// before that pixel is written, so the filter can run in place.
+	uint8_t * out = image;
+	for ( int y = 0; y < dstH; ++y )
+	{
+		const uint8_t * rows = image + static_cast< size_t >( y * factor ) * width * 4;
+		for ( int x = 0; x < dstW; ++x )
+		{
+			int sum[4] = { 0, 0, 0, 0 };
+			for ( int by = 0; by < factor; ++by )
+			{
+				const uint8_t * in = rows + ( static_cast< size_t >( by ) * width + x * factor ) * 4;
+				for ( int bx = 0; bx < factor; ++bx, in += 4 )
+				{
+					sum[0] += in[0];
+					sum[1] += in[1];
+					sum[2] += in[2];
+					sum[3] += in[3];
+				}
+			}
+			for ( int c = 0; c < 4; ++c )
+			{
+				out[c] = static_cast< uint8_t >( ( sum[c] + count / 2 ) / count );
+			}
+			out += 4;
+		}
+	}
+}
+
+//==============================
+// ResampleRGBA
+void ResampleRGBA( const uint8_t * src, const int srcWidth, const int srcHeight,
+		uint8_t * dst, const int dstWidth, const int dstHeight )
+{
+	if ( src == nullptr || dst == nullptr || srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0 )
+	{
+		return;
+	}
+
+	// 16.16 fixed point source coordinates of the destination pixel centers
+	const int stepX = static_cast< int >( ( static_cast< int64_t >( srcWidth ) << 16 ) / dstWidth );
+	const int stepY = static_cast< int >( ( static_cast< int64_t >( srcHeight ) << 16 ) / dstHeight );
+	int fy = stepY / 2 - 0x8000;
+	for ( int y = 0; y < dstHeight; ++y, fy += stepY )
+	{
+		const int cy = fy < 0 ? 0 : fy;
+		const int y0 = std::min( cy >> 16, srcHeight - 1 );
+		const int y1 = std::min( y0 + 1, srcHeight - 1 );
+		const int wy = ( cy >> 8 ) & 0xFF;
+		const uint8_t * row0 = src + static_cast< size_t >( y0 ) * srcWidth * 4;
+		const uint8_t * row1 = src + static_cast< size_t >( y1 ) * srcWidth * 4;
+		int fx = stepX / 2 - 0x8000;
+		for ( int x = 0; x < dstWidth; ++x, fx += stepX )
+		{
+			const int cx = fx < 0 ? 0 : fx;
+			const int x0 = std::min( cx >> 16, srcWidth - 1 );
+			const int x1 = std::min( x0 + 1, srcWidth - 1 );
+			const int wx = ( cx >> 8 ) & 0xFF;
+			for ( int c = 0; c < 4; ++c )
+			{
+				const int top = row0[x0 * 4 + c] * ( 256 - wx ) + row0[x1 * 4 + c] * wx;
+				const int bottom = row1[x0 * 4 + c] * ( 256 - wx ) + row1[x1 * 4 + c] * wx;
+				*dst++ = static_cast< uint8_t >( ( top * ( 256 - wy ) + bottom * wy + 32768 ) >> 16 );
+			}
+		}
+	}
+}
+
+} // namespace OVRFW
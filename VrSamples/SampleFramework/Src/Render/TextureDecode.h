@@ -0,0 +1,70 @@
+/************************************************************************************
+
+Filename    :   TextureDecode.h
+Content     :   GL-independent image decoding and mip generation.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Nothing in here touches GL, so it is safe to call from worker threads and
+// can be built and run without a GL context.
+
+namespace OVRFW {
+
+//==============================================================
+// ovrDecodedImage
+// An RGBA8 image. When NumLevels > 1, Data holds the full mip chain packed
+// one level after the other, largest first, with each dimension halved and
+// clamped to 1 per level. This is the layout the GL upload path expects.
+class ovrDecodedImage
+{
+public:
+	ovrDecodedImage()
+		: Width( 0 )
+		, Height( 0 )
+		, NumLevels( 0 )
+	{
+	}
+
+	int						Width;
+	int						Height;
+	int						NumLevels;
+	std::vector< uint8_t >	Data;
+};
+
+// Returns true if the file extension is one that DecodeImageRGBA can decode
+// (.jpg .tga .png .bmp .psd .gif .hdr .pic).
+bool	IsDecodableImageFile( const char * fileName );
+
+// Decodes an image file buffer into a single RGBA8 level. If alphaBorder is
+// set, a one pixel border around the image is given zero alpha.
+bool	DecodeImageRGBA( const char * fileName, const uint8_t * buffer, const size_t bufferSize,
+				const bool alphaBorder, ovrDecodedImage & image );
+
+// Appends a full chain of 2x2 box-filtered mip levels to a single level RGBA8 image.
+void	BuildBoxFilteredMips( ovrDecodedImage & image );
+
+// Box filters a single RGBA8 level down by a whole factor, in place. The result is
+// width / factor by height / factor and is packed at the start of the buffer; source
+// rows and columns that don't fill a whole box are dropped.
+void	BoxDownsampleRGBA( uint8_t * image, const int width, const int height, const int factor );
+
+// Bilinearly resamples a single RGBA8 level to dstWidth x dstHeight. Meant for scale
+// factors between 0.5 and 2, use BoxDownsampleRGBA first to shrink by more than that.
+void	ResampleRGBA( const uint8_t * src, const int srcWidth, const int srcHeight,
+				uint8_t * dst, const int dstWidth, const int dstHeight );
+
+// Returns the number of levels in a full mip chain for the given dimensions.
+int		MipLevelsForImageSize( int width, int height );
+
+// Returns the size in bytes of numLevels RGBA8 mip levels starting at width x height.
+size_t	RGBAMipChainSize( int width, int height, const int numLevels );
+
+} // namespace OVRFW
@@ -13,11 +13,23 @@ Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All
 #define __STDC_FORMAT_MACROS 1
 
 #include "TextureManager.h"
+#include "TextureDecode.h"
+#include "TextureTranscode.h"
 
 #include "Misc/Log.h"
+#include "Misc/FileUtils.h"
+#include "Misc/Hash.h"
+#include "JobSystem.h"
 
 #include <vector>
+#include <deque>
+#include <memory>
 #include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
 
 #include "VrApi_Types.h"
 
@@ -35,13 +47,64 @@ namespace OVRFW {
 // ovrManagedTexture::Free
 void ovrManagedTexture::Free()
 {
-	FreeTexture( Texture );
+	// a pending texture only references the placeholder, which the manager owns
+	if ( !Pending )
+	{
+		FreeTexture( Texture );
+	}
+	Pending = false;
 	Source = TEXTURE_SOURCE_MAX;
 	Uri = "";
 	IconId = -1;
 	Handle = textureHandle_t();
 }
 
+//==============================================================================================
+// ovrTextureDecodeJob
+//==============================================================================================
+
+//==============================================================
+// ovrTextureDecodeJob
+// Passed from the loading thread to a decode job and back. Serial lets the upload
+// step detect that the texture slot was freed (and possibly reused) while decoding.
+class ovrTextureDecodeJob
+{
+public:
+	ovrTextureDecodeJob()
+		: Index( -1 )
+		, Serial( 0 )
+		, FilterType( ovrTextureManager::FILTER_DEFAULT )
+		, WrapType( ovrTextureManager::WRAP_DEFAULT )
+		, Succeeded( false )
+	{
+	}
+
+	int									Index;
+	uint32_t							Serial;
+	std::string							Uri;
+	std::vector< uint8_t >				Buffer;
+	ovrTextureManager::ovrTextureFilter	FilterType;
+	ovrTextureManager::ovrTextureWrap	WrapType;
+	std::string							CachePath;	// transcode to ETC2 and cache here if not empty
+	std::string							CacheFile;
+	ovrDecodedImage						Image;
+	std::vector< uint8_t >				Ktx;		// set instead of Image when transcoded
+	bool								Succeeded;
+
+	size_t								GetUploadSize() const { return Ktx.empty() ? Image.Data.size() : Ktx.size(); }
+};
+
+//==============================
+// TranscodeCacheFileName
+// FNV-1a of the source file, so edits to an image never pick up a stale cache entry.
+static std::string TranscodeCacheFileName( std::string const & cachePath, std::vector< uint8_t > const & buffer )
+{
+	uint64_t const hash = FNV1a64( buffer.data(), buffer.size() );
+	char name[64];
+	snprintf( name, sizeof( name ), "etc2_v1_%016" PRIx64 "_%zu.ktx", hash, buffer.size() );
+	return cachePath + name;
+}
+
 //==============================================================================================
 // ovrTextureManagerImpl
 //==============================================================================================
@@ -71,6 +134,17 @@ public:
 										ovrTextureFilter const filterType = FILTER_DEFAULT,
 										ovrTextureWrap const wrapType = WRAP_DEFAULT ) OVR_OVERRIDE;
 
+	virtual textureHandle_t		LoadTextureAsync( ovrFileSys & fileSys, char const * uri,
+										ovrTextureFilter const filterType = FILTER_DEFAULT,
+										ovrTextureWrap const wrapType = WRAP_DEFAULT ) OVR_OVERRIDE;
+	virtual textureHandle_t		LoadTextureAsync( char const * uri, void const * buffer, size_t const bufferSize,
+										ovrTextureFilter const filterType = FILTER_DEFAULT,
+										ovrTextureWrap const wrapType = WRAP_DEFAULT ) OVR_OVERRIDE;
+
+	virtual int					UploadPendingTextures( size_t const maxUploadBytes ) OVR_OVERRIDE;
+	virtual bool				IsTexturePending( textureHandle_t const handle ) const OVR_OVERRIDE;
+	virtual void				SetTranscodeCachePath( char const * cachePath ) OVR_OVERRIDE;
+
 	virtual void				FreeTexture( textureHandle_t const handle ) OVR_OVERRIDE;
 
 	virtual ovrManagedTexture	GetTexture( textureHandle_t const handle ) const OVR_OVERRIDE;
@@ -95,6 +169,19 @@ private:
 	mutable int					NumStringCompares;
 	mutable int					NumSearches;
 	mutable int					NumCompares;
+	int							NumAsyncLoads;
+	int							NumAsyncUploads;
+
+	// async decoding
+	GlTexture					PlaceholderTexture;
+	std::unordered_map< int, uint32_t >	PendingLoads;	// slot index -> serial of the outstanding decode
+	uint32_t					NextSerial;
+	std::string					TranscodeCachePath;
+
+	std::vector< ovrJobHandle >	DecodeHandles;	// decodes submitted to the job system
+	std::mutex					DecodeMutex;
+	std::deque< std::shared_ptr< ovrTextureDecodeJob > >	DecodedJobs;	// waiting for upload, guarded by DecodeMutex
+	std::atomic< bool >			ShuttingDown;	// set while waiting for decodes in Shutdown()
 
 private:
 	ovrTextureManagerImpl();
@@ -105,6 +192,13 @@ private:
 	int				IndexForHandle( textureHandle_t const handle ) const;
 	textureHandle_t AllocTexture();
 
+	textureHandle_t	QueueDecode( char const * uri, std::vector< uint8_t > & buffer,
+							ovrTextureFilter const filterType, ovrTextureWrap const wrapType );
+	GlTexture		GetPlaceholderTexture();
+	void			FailAsyncLoad( ovrTextureDecodeJob const & job );
+	void			StopDecodeJobs();
+	void			DecodeJob( std::shared_ptr< ovrTextureDecodeJob > const & job );
+
 	static void		SetTextureWrapping( GlTexture & tex, ovrTextureWrap const wrapType );
 	static void		SetTextureFiltering( GlTexture & tex, ovrTextureFilter const filterType );
 };
@@ -121,6 +215,10 @@ ovrTextureManagerImpl::ovrTextureManagerImpl()
 	, NumStringCompares( 0 )
 	, NumSearches( 0 )
 	, NumCompares( 0 )
+	, NumAsyncLoads( 0 )
+	, NumAsyncUploads( 0 )
+	, NextSerial( 0 )
+	, ShuttingDown( false )
 {
 }
 
@@ -143,6 +241,9 @@ void ovrTextureManagerImpl::Init()
 // ovrTextureManagerImpl::
 void ovrTextureManagerImpl::Shutdown()
 {
+	StopDecodeJobs();
+	PendingLoads.clear();
+
 	for ( auto & texture : Textures )
 	{
 		if ( texture.IsValid() )
@@ -155,6 +256,8 @@ void ovrTextureManagerImpl::Shutdown()
 	FreeTextures.resize( 0 );
 	UriHash.clear();
 
+	DeleteTexture( PlaceholderTexture );
+
 	Initialized = false;
 }
 
@@ -303,6 +406,276 @@ textureHandle_t	ovrTextureManagerImpl::LoadTexture( char const * uri, void const
 	return handle;
 }
 
+//==============================
+// ovrTextureManagerImpl::LoadTextureAsync
+textureHandle_t ovrTextureManagerImpl::LoadTextureAsync( ovrFileSys & fileSys, char const * uri,
+	ovrTextureFilter const filterType, ovrTextureWrap const wrapType )
+{
+	int idx = FindTextureIndex( uri );
+	if ( idx >= 0 )
+	{
+		NumUriLoads++;
+		return Textures[idx].GetHandle();
+	}
+
+	if ( !IsDecodableImageFile( uri ) )
+	{
+		// compressed formats are uploaded as-is, so there is nothing to gain from a worker
+		return LoadTexture( fileSys, uri, filterType, wrapType );
+	}
+
+	NumUriLoads++;
+
+	std::vector< uint8_t > buffer;
+	if ( !fileSys.ReadFile( uri, buffer ) )
+	{
+		ALOG( "LoadTextureAsync( '%s' ) failed to read file!", uri );
+		return textureHandle_t();
+	}
+
+	return QueueDecode( uri, buffer, filterType, wrapType );
+}
+
+//==============================
+// ovrTextureManagerImpl::LoadTextureAsync
+textureHandle_t ovrTextureManagerImpl::LoadTextureAsync( char const * uri, void const * buffer, size_t const bufferSize,
+		ovrTextureFilter const filterType, ovrTextureWrap const wrapType )
+{
+	int idx = FindTextureIndex( uri );
+	if ( idx >= 0 )
+	{
+		NumBufferLoads++;
+		return Textures[idx].GetHandle();
+	}
+
+	if ( !IsDecodableImageFile( uri ) || buffer == nullptr || bufferSize == 0 )
+	{
+		return LoadTexture( uri, buffer, bufferSize, filterType, wrapType );
+	}
+
+	NumBufferLoads++;
+
+	std::vector< uint8_t > copy( static_cast< uint8_t const * >( buffer ), static_cast< uint8_t const * >( buffer ) + bufferSize );
+	return QueueDecode( uri, copy, filterType, wrapType );
+}
+
+//==============================
+// ovrTextureManagerImpl::QueueDecode
+textureHandle_t ovrTextureManagerImpl::QueueDecode( char const * uri, std::vector< uint8_t > & buffer,
+		ovrTextureFilter const filterType, ovrTextureWrap const wrapType )
+{
+	textureHandle_t handle = AllocTexture();
+	if ( !handle.IsValid() )
+	{
+		return handle;
+	}
+
+	const int idx = IndexForHandle( handle );
+	Textures[idx] = ovrManagedTexture( handle, uri, GetPlaceholderTexture(), true );
+	UriHash[ std::string( uri ) ] = idx;
+
+	std::shared_ptr< ovrTextureDecodeJob > job = std::make_shared< ovrTextureDecodeJob >();
+	job->Index = idx;
+	job->Serial = ++NextSerial;
+	job->Uri = uri;
+	job->Buffer.swap( buffer );
+	job->FilterType = filterType;
+	job->WrapType = wrapType;
+	job->CachePath = TranscodeCachePath;
+
+	PendingLoads[idx] = job->Serial;
+	NumAsyncLoads++;
+
+	// drop the handles of decodes that are done so the list doesn't grow without bound
+	DecodeHandles.erase( std::remove_if( DecodeHandles.begin(), DecodeHandles.end(),
+			[]( ovrJobHandle const & h ) { return h.IsDone(); } ), DecodeHandles.end() );
+	DecodeHandles.push_back( ovrJobSystem::GetShared().Submit( JOB_PRIORITY_BACKGROUND,
+			[this, job]() { DecodeJob( job ); } ) );
+
+	return handle;
+}
+
+//==============================
+// ovrTextureManagerImpl::UploadPendingTextures
+int ovrTextureManagerImpl::UploadPendingTextures( size_t const maxUploadBytes )
+{
+	if ( PendingLoads.empty() )
+	{
+		return 0;
+	}
+
+	int numUploaded = 0;
+	size_t uploadedBytes = 0;
+	for ( ;; )
+	{
+		std::shared_ptr< ovrTextureDecodeJob > job;
+		{
+			std::lock_guard< std::mutex > lock( DecodeMutex );
+			if ( DecodedJobs.empty() )
+			{
+				break;
+			}
+			// always upload at least one so a single large image can't stall the queue
+			if ( numUploaded > 0 && uploadedBytes + DecodedJobs.front()->GetUploadSize() > maxUploadBytes )
+			{
+				break;
+			}
+			job = std::move( DecodedJobs.front() );
+			DecodedJobs.pop_front();
+		}
+
+		auto it = PendingLoads.find( job->Index );
+		if ( it == PendingLoads.end() || it->second != job->Serial )
+		{
+			// freed while it was decoding
+			continue;
+		}
+		PendingLoads.erase( it );
+
+		textureHandle_t const handle( job->Index );
+		if ( !job->Succeeded )
+		{
+			ALOG( "LoadTextureAsync( '%s' ) failed to decode!", job->Uri.c_str() );
+			FailAsyncLoad( *job );
+			continue;
+		}
+
+		GlTexture tex;
+		if ( !job->Ktx.empty() )
+		{
+			int width = 0;
+			int height = 0;
+			tex = LoadTextureFromBuffer( job->CacheFile.c_str(), job->Ktx, TextureFlags_t( TEXTUREFLAG_NO_DEFAULT ), width, height );
+		}
+		else
+		{
+			ovrDecodedImage const & image = job->Image;
+			tex = LoadRGBATextureMipsFromMemory( image.Data.data(), image.Data.size(),
+					image.Width, image.Height, image.NumLevels, false );
+		}
+
+		uploadedBytes += job->GetUploadSize();
+		numUploaded++;
+		NumAsyncUploads++;
+
+		if ( !tex.IsValid() )
+		{
+			ALOG( "LoadTextureAsync( '%s' ) failed to upload!", job->Uri.c_str() );
+			FailAsyncLoad( *job );
+			continue;
+		}
+		SetTextureWrapping( tex, job->WrapType );
+		SetTextureFiltering( tex, job->FilterType );
+		NumActualUriLoads++;
+		Textures[job->Index] = ovrManagedTexture( handle, job->Uri.c_str(), tex );
+	}
+	return numUploaded;
+}
+
+//==============================
+// ovrTextureManagerImpl::FailAsyncLoad
+// A failed sync load leaves nothing behind, so a later load of the same uri tries the file again.
+// The caller of LoadTextureAsync already holds the handle, though, so the slot can't be freed out
+// from under it: only the uri mapping is dropped and the slot keeps the placeholder until freed.
+void ovrTextureManagerImpl::FailAsyncLoad( ovrTextureDecodeJob const & job )
+{
+	auto it = UriHash.find( job.Uri );
+	if ( it != UriHash.end() && it->second == job.Index )
+	{
+		UriHash.erase( it );
+	}
+	Textures[job.Index] = ovrManagedTexture( textureHandle_t( job.Index ), "", GetPlaceholderTexture(), true );
+}
+
+//==============================
+// ovrTextureManagerImpl::IsTexturePending
+bool ovrTextureManagerImpl::IsTexturePending( textureHandle_t const handle ) const
+{
+	int idx = IndexForHandle( handle );
+	return idx >= 0 && PendingLoads.find( idx ) != PendingLoads.end();
+}
+
+//==============================
+// ovrTextureManagerImpl::SetTranscodeCachePath
+void ovrTextureManagerImpl::SetTranscodeCachePath( char const * cachePath )
+{
+	TranscodeCachePath = cachePath != nullptr ? cachePath : "";
+	if ( !TranscodeCachePath.empty() && TranscodeCachePath.back() != '/' )
+	{
+		TranscodeCachePath += '/';
+	}
+}
+
+//==============================
+// ovrTextureManagerImpl::GetPlaceholderTexture
+GlTexture ovrTextureManagerImpl::GetPlaceholderTexture()
+{
+	if ( !PlaceholderTexture.IsValid() )
+	{
+		uint8_t const gray[4 * 4 * 4] = {
+			128, 128, 128, 255, 128, 128, 128, 255, 128, 128, 128, 255, 128, 128, 128, 255,
+			128, 128, 128, 255, 128, 128, 128, 255, 128, 128, 128, 255, 128, 128, 128, 255,
+			128, 128, 128, 255, 128, 128, 128, 255, 128, 128, 128, 255, 128, 128, 128, 255,
+			128, 128, 128, 255, 128, 128, 128, 255, 128, 128, 128, 255, 128, 128, 128, 255 };
+		PlaceholderTexture = LoadRGBATextureFromMemory( gray, 4, 4, false );
+	}
+	return PlaceholderTexture;
+}
+
+//==============================
+// ovrTextureManagerImpl::StopDecodeJobs
+void ovrTextureManagerImpl::StopDecodeJobs()
+{
+	// decodes that haven't started return right away
+	ShuttingDown.store( true );
+	ovrJobSystem::GetShared().Wait( DecodeHandles.data(), static_cast< int >( DecodeHandles.size() ) );
+	DecodeHandles.clear();
+	ShuttingDown.store( false );
+
+	DecodedJobs.clear();
+}
+
+//==============================
+// ovrTextureManagerImpl::DecodeJob
+void ovrTextureManagerImpl::DecodeJob( std::shared_ptr< ovrTextureDecodeJob > const & job )
+{
+	if ( ShuttingDown.load() )
+	{
+		return;
+	}
+
+	if ( !job->CachePath.empty() )
+	{
+		job->CacheFile = TranscodeCacheFileName( job->CachePath, job->Buffer );
+		job->Succeeded = ReadWholeFile( job->CacheFile.c_str(), job->Ktx );
+	}
+
+	if ( !job->Succeeded )
+	{
+		job->Succeeded = DecodeImageRGBA( job->Uri.c_str(), job->Buffer.data(), job->Buffer.size(), false, job->Image );
+		if ( job->Succeeded )
+		{
+			BuildBoxFilteredMips( job->Image );
+		}
+		if ( job->Succeeded && !job->CachePath.empty() &&
+				EncodeETC2ToKTX( job->Image, ImageHasAlpha( job->Image ), job->Ktx ) )
+		{
+			if ( !WriteFileAtomically( job->CacheFile.c_str(), job->Ktx ) )
+			{
+				ALOGW( "Failed to write texture cache file '%s'", job->CacheFile.c_str() );
+			}
+			job->Image = ovrDecodedImage();
+		}
+	}
+	// the compressed file isn't needed any more
+	std::vector< uint8_t >().swap( job->Buffer );
+
+	{
+		std::lock_guard< std::mutex > lock( DecodeMutex );
+		DecodedJobs.push_back( job );
+	}
+}
+
 //==============================
 // ovrTextureManagerImpl::LoadRGBATexture
 textureHandle_t	ovrTextureManagerImpl::LoadRGBATexture( char const * uri, void const * imageData, 
@@ -434,6 +807,8 @@ void ovrTextureManagerImpl::FreeTexture( textureHandle_t const handle )
 		{
 			UriHash.erase( Textures[idx].GetUri() );
 		}
+		// any decode still in flight for this slot is dropped when it completes
+		PendingLoads.erase( idx );
 		Textures[idx].Free();
 		FreeTextures.push_back( idx );
 	}
@@ -558,6 +933,10 @@ void ovrTextureManagerImpl::PrintStats() const
 
 	ALOG( "NumSearches: %i", NumSearches );
 	ALOG( "NumCompares: %i", NumCompares );
+
+	ALOG( "NumAsyncLoads:   %i", NumAsyncLoads );
+	ALOG( "NumAsyncUploads: %i", NumAsyncUploads );
+	ALOG( "NumPendingLoads: %i", static_cast< int >( PendingLoads.size() ) );
 }
 
 //==============================================================================================
@@ -37,13 +37,17 @@ public:
 	ovrManagedTexture()
 		: Source( TEXTURE_SOURCE_MAX )
 		, IconId( -1 )
+		, Pending( false )
 	{
 	}
-	ovrManagedTexture( textureHandle_t const handle, char const * uri, GlTexture const & texture )
+	ovrManagedTexture( textureHandle_t const handle, char const * uri, GlTexture const & texture,
+			bool const pending = false )
 		: Handle( handle )
 		, Texture( texture )
 		, Source( TEXTURE_SOURCE_URI )
 		, Uri( uri )
+		, IconId( -1 )
+		, Pending( pending )
 	{
 	}
 
@@ -52,6 +56,7 @@ public:
 		, Texture( texture )
 		, Source( TEXTURE_SOURCE_ICON )
 		, IconId( iconId )
+		, Pending( false )
 	{
 	}
 
@@ -63,6 +68,7 @@ public:
 	std::string const &	GetUri() const { return Uri; }
 	int					GetIconId() const { return IconId; }
 	bool				IsValid() const { return Texture.IsValid(); }
+	bool				IsPending() const { return Pending; }
 
 private:
 	textureHandle_t		Handle;		// handle of the texture
@@ -70,6 +76,7 @@ private:
 	ovrTextureSource	Source;		// where this texture came from
 	std::string			Uri;		// name of the uri, if the texture was loaded from a uri
 	int					IconId;		// id of the icon, if loaded from an icon
+	bool				Pending;	// true while Texture is the shared placeholder for an async load that is pending or failed
 };
 
 class ovrTextureManager
@@ -117,6 +124,30 @@ public:
 										ovrTextureFilter const filterType = FILTER_DEFAULT,
 										ovrTextureWrap const wrapType = WRAP_DEFAULT ) = 0;
 
+	// Asynchronous loads return a handle immediately. Until the image is decoded and uploaded
+	// the handle refers to a shared placeholder texture, so it can be bound right away.
+	// Decoding and mip generation run as background jobs on ovrJobSystem::GetShared(); only the GL upload is done on
+	// the calling thread, in UploadPendingTextures(). Formats that are already GPU-ready
+	// (ktx, pvr, astc) are loaded synchronously.
+	virtual	textureHandle_t		LoadTextureAsync( class ovrFileSys & fileSys, char const * uri,
+										ovrTextureFilter const filterType = FILTER_DEFAULT,
+										ovrTextureWrap const wrapType = WRAP_DEFAULT ) = 0;
+	// the buffer is copied, so the caller may free it as soon as this returns
+	virtual textureHandle_t		LoadTextureAsync( char const * uri, void const * buffer, size_t const bufferSize,
+										ovrTextureFilter const filterType = FILTER_DEFAULT,
+										ovrTextureWrap const wrapType = WRAP_DEFAULT ) = 0;
+
+	// Uploads decoded textures until roughly maxUploadBytes have been uploaded. At least one
+	// texture is uploaded per call if any are ready. Must be called on the GL thread.
+	// Returns the number of textures uploaded.
+	virtual int					UploadPendingTextures( size_t const maxUploadBytes = 4 * 1024 * 1024 ) = 0;
+	virtual bool				IsTexturePending( textureHandle_t const handle ) const = 0;
+
+	// When set, async loads of stb_image formats are compressed to ETC2 on the decode jobs
+	// and the result is cached as a KTX file in cachePath, keyed on the file contents. Later
+	// loads of the same image read the KTX and skip decoding entirely. Pass nullptr to disable.
+	virtual void				SetTranscodeCachePath( char const * cachePath ) = 0;
+
 	virtual void				FreeTexture( textureHandle_t const handle ) = 0;
 
 	virtual ovrManagedTexture	GetTexture( textureHandle_t const handle ) const = 0;
@@ -0,0 +1,431 @@
+/************************************************************************************
+
+Filename    :   TextureTranscode.cpp
+Content     :   CPU block compression of decoded images to ETC2 / EAC.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include "TextureTranscode.h"
+
+#include <climits>
+#include <cstring>
+
+namespace OVRFW {
+
+// ETC1 / ETC2 intensity modifier tables, { small, large }.
+static const int ETC1Modifiers[8][2] =
+{
+	{ 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+};
+
+// EAC alpha modifier tables.
+static const int EACModifiers[16][8] =
+{
+	{ -3, -6,  -9, -15, 2, 5, 8, 14 },
+	{ -3, -7, -10, -13, 2, 6, 9, 12 },
+	{ -2, -5,  -8, -13, 1, 4, 7, 12 },
+	{ -2, -4,  -6, -13, 1, 3, 5, 12 },
+	{ -3, -6,  -8, -12, 2, 5, 7, 11 },
+	{ -3, -7,  -9, -11, 2, 6, 8, 10 },
+	{ -4, -7,  -8, -11, 3, 6, 7, 10 },
+	{ -3, -5,  -8, -11, 2, 4, 7, 10 },
+	{ -2, -6,  -8, -10, 1, 5, 7,  9 },
+	{ -2, -5,  -8, -10, 1, 4, 7,  9 },
+	{ -2, -4,  -8, -10, 1, 3, 7,  9 },
+	{ -2, -5,  -7, -10, 1, 4, 6,  9 },
+	{ -3, -4,  -7, -10, 2, 3, 6,  9 },
+	{ -1, -2,  -3, -10, 0, 1, 2,  9 },
+	{ -4, -6,  -8,  -9, 3, 5, 7,  8 },
+	{ -3, -5,  -7,  -9, 2, 4, 6,  8 }
+};
+
+// GL enums, so this file doesn't need the GL headers.
+static const uint32_t KTX_GL_RGB							= 0x1907;
+static const uint32_t KTX_GL_RGBA							= 0x1908;
+static const uint32_t KTX_GL_COMPRESSED_RGB8_ETC2			= 0x9274;
+static const uint32_t KTX_GL_COMPRESSED_RGBA8_ETC2_EAC		= 0x9278;
+
+static inline int ClampByte( const int v )
+{
+	return v < 0 ? 0 : ( v > 255 ? 255 : v );
+}
+
+static inline void WriteBigEndian64( uint64_t bits, uint8_t * out )
+{
+	for ( int i = 7; i >= 0; --i )
+	{
+		out[i] = static_cast< uint8_t >( bits & 0xFF );
+		bits >>= 8;
+	}
+}
+
+//==============================
+// ImageHasAlpha
+bool ImageHasAlpha( ovrDecodedImage const & image )
+{
+	const size_t numPixels = static_cast< size_t >( image.Width ) * image.Height;
+	if ( image.Data.size() < numPixels * 4 )
+	{
+		return false;
+	}
+	const uint8_t * p = image.Data.data();
+	uint8_t minAlpha = 255;
+	for ( size_t i = 0; i < numPixels; ++i )
+	{
+		minAlpha = p[i * 4 + 3] < minAlpha ? p[i * 4 + 3] : minAlpha;
+	}
+	return minAlpha < 255;
+}
+
+//==============================
+// FitETCSubBlock
+// Finds the modifier table and per-pixel modifiers that best fit 8 pixels to a base color.
+// Returns the squared error. Stops early once the error can't beat maxError.
+static int FitETCSubBlock( const int pixels[8][3], const int base[3], const int maxError,
+		int & outTable, uint8_t outIndices[8] )
+{
+	int bestError = maxError;
+	outTable = 0;
+	for ( int t = 0; t < 8; ++t )
+	{
+		// candidate colors in index order: +small, +large, -small, -large
+		int cand[4][3];
+		for ( int m = 0; m < 4; ++m )
+		{
+			const int mod = ( m & 2 ) ? -ETC1Modifiers[t][m & 1] : ETC1Modifiers[t][m & 1];
+			cand[m][0] = ClampByte( base[0] + mod );
+			cand[m][1] = ClampByte( base[1] + mod );
+			cand[m][2] = ClampByte( base[2] + mod );
+		}
+
+		int error = 0;
+		uint8_t indices[8];
+		for ( int p = 0; p < 8 && error < bestError; ++p )
+		{
+			int bestPixelError = INT_MAX;
+			for ( int m = 0; m < 4; ++m )
+			{
+				const int dr = pixels[p][0] - cand[m][0];
+				const int dg = pixels[p][1] - cand[m][1];
+				const int db = pixels[p][2] - cand[m][2];
+				const int e = dr * dr + dg * dg + db * db;
+				if ( e < bestPixelError )
+				{
+					bestPixelError = e;
+					indices[p] = static_cast< uint8_t >( m );
+				}
+			}
+			error += bestPixelError;
+		}
+
+		if ( error < bestError )
+		{
+			bestError = error;
+			outTable = t;
+			memcpy( outIndices, indices, sizeof( indices ) );
+		}
+	}
+	return bestError;
+}
+
+//==============================
+// EncodeETC2Block
+void EncodeETC2Block( const uint8_t * rgbaBlock, uint8_t * out )
+{
+	int bestError = INT_MAX;
+	uint64_t bestBits = 0;
+
+	for ( int flip = 0; flip < 2; ++flip )
+	{
+		// gather the two sub-blocks: 2x4 side by side, or 4x2 top and bottom when flipped
+		int pixels[2][8][3];
+		int pixelPos[2][8];	// bit position of each pixel in the index field (x * 4 + y)
+		int sums[2][3] = { { 0, 0, 0 }, { 0, 0, 0 } };
+		int counts[2] = { 0, 0 };
+		for ( int y = 0; y < 4; ++y )
+		{
+			for ( int x = 0; x < 4; ++x )
+			{
+				const int sb = flip ? ( y >> 1 ) : ( x >> 1 );
+				const int n = counts[sb]++;
+				const uint8_t * p = rgbaBlock + ( y * 4 + x ) * 4;
+				for ( int c = 0; c < 3; ++c )
+				{
+					pixels[sb][n][c] = p[c];
+					sums[sb][c] += p[c];
+				}
+				pixelPos[sb][n] = x * 4 + y;
+			}
+		}
+
+		for ( int diff = 0; diff < 2; ++diff )
+		{
+			int quant[2][3];
+			int base[2][3];
+			bool valid = true;
+			for ( int sb = 0; sb < 2; ++sb )
+			{
+				for ( int c = 0; c < 3; ++c )
+				{
+					// rounded average of 8 pixels scaled to 4 or 5 bits
+					if ( diff )
+					{
+						quant[sb][c] = ( sums[sb][c] * 31 + 1020 ) / 2040;
+						base[sb][c] = ( quant[sb][c] << 3 ) | ( quant[sb][c] >> 2 );
+					}
+					else
+					{
+						quant[sb][c] = ( sums[sb][c] * 15 + 1020 ) / 2040;
+						base[sb][c] = ( quant[sb][c] << 4 ) | quant[sb][c];
+					}
+				}
+			}
+			if ( diff )
+			{
+				for ( int c = 0; c < 3; ++c )
+				{
+					const int d = quant[1][c] - quant[0][c];
+					valid = valid && d >= -4 && d <= 3;
+				}
+				if ( !valid )
+				{
+					continue;
+				}
+			}
+
+			int tables[2];
+			uint8_t indices[2][8];
+			int error = FitETCSubBlock( pixels[0], base[0], bestError, tables[0], indices[0] );
+			if ( error >= bestError )
+			{
+				continue;
+			}
+			error += FitETCSubBlock( pixels[1], base[1], bestError - error, tables[1], indices[1] );
+			if ( error >= bestError )
+			{
+				continue;
+			}
+
+			uint64_t bits = 0;
+			if ( diff )
+			{
+				bits |= static_cast< uint64_t >( quant[0][0] ) << 59;
+				bits |= static_cast< uint64_t >( ( quant[1][0] - quant[0][0] ) & 7 ) << 56;
+				bits |= static_cast< uint64_t >( quant[0][1] ) << 51;
+				bits |= static_cast< uint64_t >( ( quant[1][1] - quant[0][1] ) & 7 ) << 48;
+				bits |= static_cast< uint64_t >( quant[0][2] ) << 43;
+				bits |= static_cast< uint64_t >( ( quant[1][2] - quant[0][2] ) & 7 ) << 40;
+			}
+			else
+			{
+				bits |= static_cast< uint64_t >( quant[0][0] ) << 60;
+				bits |= static_cast< uint64_t >( quant[1][0] ) << 56;
+				bits |= static_cast< uint64_t >( quant[0][1] ) << 52;
+				bits |= static_cast< uint64_t >( quant[1][1] ) << 48;
+				bits |= static_cast< uint64_t >( quant[0][2] ) << 44;
+				bits |= static_cast< uint64_t >( quant[1][2] ) << 40;
+			}
+			bits |= static_cast< uint64_t >( tables[0] ) << 37;
+			bits |= static_cast< uint64_t >( tables[1] ) << 34;
+			bits |= static_cast< uint64_t >( diff ) << 33;
+			bits |= static_cast< uint64_t >( flip ) << 32;
+			for ( int sb = 0; sb < 2; ++sb )
+			{
+				for ( int n = 0; n < 8; ++n )
+				{
+					const int pos = pixelPos[sb][n];
+					bits |= static_cast< uint64_t >( indices[sb][n] >> 1 ) << ( 16 + pos );
+					bits |= static_cast< uint64_t >( indices[sb][n] & 1 ) << pos;
+				}
+			}
+
+			bestError = error;
+			bestBits = bits;
+		}
+	}
+
+	WriteBigEndian64( bestBits, out );
+}
+
+//==============================
+// EncodeEACAlphaBlock
+void EncodeEACAlphaBlock( const uint8_t * rgbaBlock, uint8_t * out )
+{
+	// alpha in index order (x * 4 + y)
+	int alpha[16];
+	int minAlpha = 255;
+	int maxAlpha = 0;
+	for ( int y = 0; y < 4; ++y )
+	{
+		for ( int x = 0; x < 4; ++x )
+		{
+			const int a = rgbaBlock[( y * 4 + x ) * 4 + 3];
+			alpha[x * 4 + y] = a;
+			minAlpha = a < minAlpha ? a : minAlpha;
+			maxAlpha = a > maxAlpha ? a : maxAlpha;
+		}
+	}
+
+	// table 13 has a zero modifier at index 4, which reproduces a constant block exactly
+	int bestBase = minAlpha;
+	int bestMult = 1;
+	int bestTable = 13;
+	uint8_t bestIndices[16];
+	memset( bestIndices, 4, sizeof( bestIndices ) );
+
+	if ( minAlpha != maxAlpha )
+	{
+		int bestError = INT_MAX;
+		const int range = maxAlpha - minAlpha;
+		for ( int t = 0; t < 16 && bestError > 0; ++t )
+		{
+			const int * mods = EACModifiers[t];
+			const int span = mods[7] - mods[3];
+			const int m0 = ( range + span / 2 ) / span;
+			for ( int mult = m0; mult <= m0 + 1; ++mult )
+			{
+				if ( mult < 1 || mult > 15 )
+				{
+					continue;
+				}
+				// center the table's range on the block's range
+				const int base = ClampByte( ( 2 * ( minAlpha + maxAlpha ) - ( mods[3] + mods[7] ) * mult * 2 + 2 ) / 4 );
+
+				int error = 0;
+				uint8_t indices[16];
+				for ( int p = 0; p < 16 && error < bestError; ++p )
+				{
+					int bestPixelError = INT_MAX;
+					for ( int i = 0; i < 8; ++i )
+					{
+						const int d = alpha[p] - ClampByte( base + mods[i] * mult );
+						if ( d * d < bestPixelError )
+						{
+							bestPixelError = d * d;
+							indices[p] = static_cast< uint8_t >( i );
+						}
+					}
+					error += bestPixelError;
+				}
+
+				if ( error < bestError )
+				{
+					bestError = error;
+					bestBase = base;
+					bestMult = mult;
+					bestTable = t;
+					memcpy( bestIndices, indices, sizeof( indices ) );
+				}
+			}
+		}
+	}
+
+	uint64_t bits = static_cast< uint64_t >( bestBase ) << 56;
+	bits |= static_cast< uint64_t >( bestMult ) << 52;
+	bits |= static_cast< uint64_t >( bestTable ) << 48;
+	for ( int p = 0; p < 16; ++p )
+	{
+		bits |= static_cast< uint64_t >( bestIndices[p] ) << ( 45 - p * 3 );
+	}
+	WriteBigEndian64( bits, out );
+}
+
+//==============================
+// EncodeETC2ToKTX
+bool EncodeETC2ToKTX( ovrDecodedImage const & image, const bool withAlpha, std::vector< uint8_t > & ktx )
+{
+	ktx.clear();
+	if ( image.Width <= 0 || image.Height <= 0 || image.NumLevels <= 0 ||
+			image.Data.size() < RGBAMipChainSize( image.Width, image.Height, image.NumLevels ) )
+	{
+		return false;
+	}
+
+	const int blockBytes = withAlpha ? 16 : 8;
+
+	// size everything up front
+	size_t totalSize = 64;	// KTX header
+	{
+		int w = image.Width;
+		int h = image.Height;
+		for ( int level = 0; level < image.NumLevels; ++level )
+		{
+			totalSize += 4 + static_cast< size_t >( ( w + 3 ) / 4 ) * ( ( h + 3 ) / 4 ) * blockBytes;
+			w = w > 1 ? w >> 1 : 1;
+			h = h > 1 ? h >> 1 : 1;
+		}
+	}
+	ktx.resize( totalSize );
+
+	static const uint8_t identifier[12] =
+	{
+		0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'
+	};
+	const uint32_t header[13] =
+	{
+		0x04030201,		// endianness
+		0,				// glType, 0 for compressed
+		1,				// glTypeSize
+		0,				// glFormat, 0 for compressed
+		withAlpha ? KTX_GL_COMPRESSED_RGBA8_ETC2_EAC : KTX_GL_COMPRESSED_RGB8_ETC2,
+		withAlpha ? KTX_GL_RGBA : KTX_GL_RGB,
+		static_cast< uint32_t >( image.Width ),
+		static_cast< uint32_t >( image.Height ),
+		0,				// pixelDepth
+		0,				// numberOfArrayElements
+		1,				// numberOfFaces
+		static_cast< uint32_t >( image.NumLevels ),
+		0				// bytesOfKeyValueData
+	};
+	uint8_t * dst = ktx.data();
+	memcpy( dst, identifier, sizeof( identifier ) );
+	memcpy( dst + sizeof( identifier ), header, sizeof( header ) );
+	dst += 64;
+
+	const uint8_t * level = image.Data.data();
+	int w = image.Width;
+	int h = image.Height;
+	for ( int l = 0; l < image.NumLevels; ++l )
+	{
+		const int blocksX = ( w + 3 ) / 4;
+		const int blocksY = ( h + 3 ) / 4;
+		const uint32_t imageSize = static_cast< uint32_t >( blocksX * blocksY * blockBytes );
+		memcpy( dst, &imageSize, 4 );
+		dst += 4;
+
+		uint8_t block[16 * 4];
+		for ( int by = 0; by < blocksY; ++by )
+		{
+			for ( int bx = 0; bx < blocksX; ++bx )
+			{
+				// replicate edge pixels into blocks that hang off the image
+				for ( int y = 0; y < 4; ++y )
+				{
+					const int sy = by * 4 + y < h ? by * 4 + y : h - 1;
+					for ( int x = 0; x < 4; ++x )
+					{
+						const int sx = bx * 4 + x < w ? bx * 4 + x : w - 1;
+						memcpy( block + ( y * 4 + x ) * 4, level + ( static_cast< size_t >( sy ) * w + sx ) * 4, 4 );
+					}
+				}
+				if ( withAlpha )
+				{
+					EncodeEACAlphaBlock( block, dst );
+					dst += 8;
+				}
+				EncodeETC2Block( block, dst );
+				dst += 8;
+			}
+		}
+
+		level += static_cast< size_t >( w ) * h * 4;
+		w = w > 1 ? w >> 1 : 1;
+		h = h > 1 ? h >> 1 : 1;
+	}
+	return true;
+}
+
+} // namespace OVRFW
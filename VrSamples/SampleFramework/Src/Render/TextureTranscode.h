@@ -0,0 +1,39 @@
+/************************************************************************************
+
+Filename    :   TextureTranscode.h
+Content     :   CPU block compression of decoded images to ETC2 / EAC.
+Created     :   October 19, 2026
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+
+#include "TextureDecode.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Like TextureDecode, nothing in here touches GL so it can run on any thread.
+
+namespace OVRFW {
+
+// Returns true if any pixel in the first level has alpha below 255.
+bool	ImageHasAlpha( ovrDecodedImage const & image );
+
+// Encodes a 4x4 block of RGBA8 pixels (row-major, 16 pixels) to an 8 byte ETC2 RGB8
+// block. Only the ETC1 individual and differential modes are used, which any ETC2
+// decoder accepts.
+void	EncodeETC2Block( const uint8_t * rgbaBlock, uint8_t * out );
+
+// Encodes the alpha channel of a 4x4 block of RGBA8 pixels to an 8 byte EAC block.
+// The EAC block followed by the ETC2 block makes one GL_COMPRESSED_RGBA8_ETC2_EAC block.
+void	EncodeEACAlphaBlock( const uint8_t * rgbaBlock, uint8_t * out );
+
+// Compresses every level of image and writes the result as a KTX 1.1 file that
+// LoadTextureKTX can load. Uses GL_COMPRESSED_RGBA8_ETC2_EAC if withAlpha is set,
+// otherwise GL_COMPRESSED_RGB8_ETC2.
+bool	EncodeETC2ToKTX( ovrDecodedImage const & image, const bool withAlpha, std::vector< uint8_t > & ktx );
+
+} // namespace OVRFW